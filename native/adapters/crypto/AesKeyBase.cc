@@ -0,0 +1,247 @@
+#include "AesKeyBase.h"
+#include "SecureArena.h"
+#include <algorithm>
+#include <cstring>
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+// Blocks decrypted per batch in decryptCbc — lets pipelined backends keep
+// several AES rounds in flight.
+constexpr size_t CBC_DECRYPT_BATCH = 8;
+
+// Blocks of CTR keystream generated per encryptBlocks() call in GCM.
+constexpr size_t GCM_CTR_BATCH = 8;
+
+static void xorBlock(uint8_t* dst, const uint8_t* a, const uint8_t* b) {
+    for (size_t i = 0; i < 16; ++i) dst[i] = a[i] ^ b[i];
+}
+
+// Left shift by one bit, XOR Rb (0x87) on carry-out — SP 800-38B §6.1.
+static void cmacDouble(const uint8_t in[16], uint8_t out[16]) {
+    const uint8_t carry = in[0] >> 7;
+    for (size_t i = 0; i < 15; ++i) out[i] = static_cast<uint8_t>((in[i] << 1) | (in[i + 1] >> 7));
+    out[15] = static_cast<uint8_t>(in[15] << 1);
+    if (carry) out[15] ^= 0x87;
+}
+
+static uint64_t load64be(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v = (v << 8) | p[i];
+    return v;
+}
+
+static void store64be(uint8_t* p, uint64_t v) {
+    for (int i = 7; i >= 0; --i, v >>= 8) p[i] = static_cast<uint8_t>(v);
+}
+
+// Last 32 bits of a counter block, big-endian, incremented mod 2^32.
+static void inc32(uint8_t block[16]) {
+    for (int i = 15; i >= 12; --i) {
+        if (++block[i] != 0) break;
+    }
+}
+
+} // anonymous namespace
+
+void secureZero(void* ptr, size_t len) {
+    if (len == 0) return; // an empty vector's data() may be null
+#if defined(__GNUC__) || defined(__clang__)
+    // A plain memset the compiler must assume is read: full-width stores
+    // instead of one volatile byte at a time (SHA-256 wipes its 256-byte
+    // schedule per block)
+    std::memset(ptr, 0, len);
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#else
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(ptr);
+    while (len--) *p++ = 0;
+#endif
+}
+
+AesKeyBase::~AesKeyBase() {
+    secureZero(_k1, sizeof(_k1));
+    secureZero(_k2, sizeof(_k2));
+}
+
+void* AesKeyBase::operator new(size_t size) {
+    return SecureArena::instance().allocate(size);
+}
+
+void AesKeyBase::operator delete(void* p, size_t size) noexcept {
+    SecureArena::instance().deallocate(p, size);
+}
+
+void AesKeyBase::initCmacSubkeys() {
+    uint8_t l[16] = {};
+    encryptBlocks(l, l, 1);
+    cmacDouble(l, _k1);
+    cmacDouble(_k1, _k2);
+    secureZero(l, sizeof(l));
+}
+
+void AesKeyBase::encryptEcb(const uint8_t* in, uint8_t* out, size_t len) const {
+    encryptBlocks(in, out, len / 16);
+}
+
+void AesKeyBase::decryptEcb(const uint8_t* in, uint8_t* out, size_t len) const {
+    decryptBlocks(in, out, len / 16);
+}
+
+void AesKeyBase::encryptCbc(uint8_t iv[16], const uint8_t* in, uint8_t* out, size_t len) const {
+    // Inherently serial: each block depends on the previous ciphertext
+    for (size_t off = 0; off + 16 <= len; off += 16) {
+        uint8_t block[16];
+        xorBlock(block, in + off, iv);
+        encryptBlocks(block, out + off, 1);
+        std::memcpy(iv, out + off, 16);
+    }
+}
+
+void AesKeyBase::decryptCbc(uint8_t iv[16], const uint8_t* in, uint8_t* out, size_t len) const {
+    uint8_t cipher[CBC_DECRYPT_BATCH * 16];
+    size_t blocks = len / 16;
+    while (blocks > 0) {
+        const size_t n = blocks < CBC_DECRYPT_BATCH ? blocks : CBC_DECRYPT_BATCH;
+        // Keep the ciphertext: in and out may alias
+        std::memcpy(cipher, in, n * 16);
+        decryptBlocks(cipher, out, n);
+        xorBlock(out, out, iv);
+        for (size_t i = 1; i < n; ++i) xorBlock(out + i * 16, out + i * 16, cipher + (i - 1) * 16);
+        std::memcpy(iv, cipher + (n - 1) * 16, 16);
+        in += n * 16;
+        out += n * 16;
+        blocks -= n;
+    }
+    secureZero(cipher, sizeof(cipher));
+}
+
+void AesKeyBase::cmac(const uint8_t iv[16], const uint8_t* data, size_t len, uint8_t mac[16]) const {
+    uint8_t x[16];
+    std::memcpy(x, iv, 16);
+
+    // All blocks but the last go through plain CBC-MAC
+    const size_t fullBlocks = (len == 0) ? 0 : (len - 1) / 16;
+    for (size_t i = 0; i < fullBlocks; ++i) {
+        xorBlock(x, x, data + i * 16);
+        encryptBlocks(x, x, 1);
+    }
+
+    // Last block: complete → K1, partial/empty → 10* padding and K2
+    uint8_t last[16] = {};
+    const size_t rem = len - fullBlocks * 16;
+    if (rem) std::memcpy(last, data + fullBlocks * 16, rem);
+    if (rem == 16) {
+        xorBlock(last, last, _k1);
+    } else {
+        last[rem] = 0x80;
+        xorBlock(last, last, _k2);
+    }
+    xorBlock(x, x, last);
+    encryptBlocks(x, mac, 1);
+    secureZero(x, sizeof(x));
+    secureZero(last, sizeof(last));
+}
+
+void AesKeyBase::ghashBlocks(uint8_t y[16], const uint8_t h[16], const uint8_t* data, size_t blocks) const {
+    // SP 800-38D Algorithm 1 with masks instead of branches, so the time
+    // does not depend on H or the data
+    const uint64_t hHi = load64be(h), hLo = load64be(h + 8);
+    uint64_t yHi = load64be(y), yLo = load64be(y + 8);
+    for (size_t b = 0; b < blocks; ++b, data += 16) {
+        const uint64_t xHi = yHi ^ load64be(data), xLo = yLo ^ load64be(data + 8);
+        uint64_t zHi = 0, zLo = 0, vHi = hHi, vLo = hLo;
+        for (int i = 0; i < 128; ++i) {
+            const uint64_t bit = i < 64 ? (xHi >> (63 - i)) & 1 : (xLo >> (127 - i)) & 1;
+            const uint64_t take = 0 - bit;
+            zHi ^= vHi & take;
+            zLo ^= vLo & take;
+            const uint64_t reduce = 0 - (vLo & 1);
+            vLo = (vLo >> 1) | (vHi << 63);
+            vHi = (vHi >> 1) ^ (reduce & 0xE100000000000000ull);
+        }
+        yHi = zHi;
+        yLo = zLo;
+    }
+    store64be(y, yHi);
+    store64be(y + 8, yLo);
+}
+
+void AesKeyBase::ghash(uint8_t y[16], const uint8_t h[16], const uint8_t* data, size_t len) const {
+    const size_t full = len / 16;
+    if (full) ghashBlocks(y, h, data, full);
+    if (const size_t rem = len % 16) {
+        uint8_t last[16] = {};
+        std::memcpy(last, data + full * 16, rem);
+        ghashBlocks(y, h, last, 1);
+        secureZero(last, sizeof(last));
+    }
+}
+
+void AesKeyBase::gcmCtr(const uint8_t j0[16], const uint8_t* in, uint8_t* out, size_t len) const {
+    uint8_t counter[16];
+    std::memcpy(counter, j0, 16);
+    uint8_t stream[GCM_CTR_BATCH * 16];
+    while (len > 0) {
+        const size_t blocks = std::min(GCM_CTR_BATCH, (len + 15) / 16);
+        for (size_t i = 0; i < blocks; ++i) {
+            inc32(counter);
+            std::memcpy(stream + i * 16, counter, 16);
+        }
+        encryptBlocks(stream, stream, blocks);
+        const size_t n = std::min(len, blocks * 16);
+        for (size_t i = 0; i < n; ++i) out[i] = in[i] ^ stream[i];
+        in += n;
+        out += n;
+        len -= n;
+    }
+    secureZero(stream, sizeof(stream));
+}
+
+void AesKeyBase::gcmTag(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                        const uint8_t* cipher, size_t len, uint8_t j0[16], uint8_t tag[16]) const {
+    uint8_t h[16] = {};
+    encryptBlocks(h, h, 1);
+
+    uint8_t y[16] = {};
+    ghash(y, h, aad, aadLen);
+    ghash(y, h, cipher, len);
+    uint8_t lengths[16];
+    store64be(lengths, static_cast<uint64_t>(aadLen) * 8);
+    store64be(lengths + 8, static_cast<uint64_t>(len) * 8);
+    ghashBlocks(y, h, lengths, 1);
+
+    std::memcpy(j0, iv, 12);
+    j0[12] = j0[13] = j0[14] = 0;
+    j0[15] = 1;
+    encryptBlocks(j0, tag, 1);
+    xorBlock(tag, tag, y);
+    secureZero(h, sizeof(h));
+    secureZero(y, sizeof(y));
+}
+
+void AesKeyBase::gcmSeal(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                         const uint8_t* in, uint8_t* out, size_t len, uint8_t tag[16]) const {
+    uint8_t j0[16];
+    std::memcpy(j0, iv, 12);
+    j0[12] = j0[13] = j0[14] = 0;
+    j0[15] = 1;
+    gcmCtr(j0, in, out, len);
+    gcmTag(iv, aad, aadLen, out, len, j0, tag);
+}
+
+bool AesKeyBase::gcmOpen(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                         const uint8_t* in, uint8_t* out, size_t len, const uint8_t tag[16]) const {
+    uint8_t j0[16], expected[16];
+    gcmTag(iv, aad, aadLen, in, len, j0, expected);
+    uint8_t diff = 0;
+    for (size_t i = 0; i < 16; ++i) diff |= static_cast<uint8_t>(expected[i] ^ tag[i]);
+    secureZero(expected, sizeof(expected));
+    if (diff != 0) return false;
+    gcmCtr(j0, in, out, len);
+    return true;
+}
+
+} // namespace crypto
+} // namespace adapters
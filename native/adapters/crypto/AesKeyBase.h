@@ -0,0 +1,66 @@
+#pragma once
+#include "../../core/ports/ICryptoProvider.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+namespace crypto {
+
+// Overwrites `len` bytes in a way the optimiser may not elide.
+void secureZero(void* ptr, size_t len);
+
+/**
+ * Shared block-mode code for AES implementations. Derived classes provide
+ * multi-block ECB primitives; CBC, CMAC and GCM are built on top so every
+ * backend gets identical chaining semantics. Derived constructors must
+ * call initCmacSubkeys() once their key schedule is ready.
+ *
+ * GHASH defaults to a constant-time bitwise multiply; backends with a
+ * carry-less multiply instruction override ghashBlocks().
+ *
+ * Keys are allocated in the secure arena (SecureArena.h), so expanded
+ * schedules and CMAC subkeys stay in locked, dump-excluded memory.
+ */
+class AesKeyBase : public core::ports::IAesKey {
+public:
+    ~AesKeyBase() override;
+
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size) noexcept;
+
+    void encryptEcb(const uint8_t* in, uint8_t* out, size_t len) const override;
+    void decryptEcb(const uint8_t* in, uint8_t* out, size_t len) const override;
+    void encryptCbc(uint8_t iv[16], const uint8_t* in, uint8_t* out, size_t len) const override;
+    void decryptCbc(uint8_t iv[16], const uint8_t* in, uint8_t* out, size_t len) const override;
+    void cmac(const uint8_t iv[16], const uint8_t* data, size_t len, uint8_t mac[16]) const override;
+    void gcmSeal(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                 const uint8_t* in, uint8_t* out, size_t len, uint8_t tag[16]) const override;
+    bool gcmOpen(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                 const uint8_t* in, uint8_t* out, size_t len, const uint8_t tag[16]) const override;
+
+protected:
+    // ECB over `blocks` consecutive 16-byte blocks; in == out allowed.
+    virtual void encryptBlocks(const uint8_t* in, uint8_t* out, size_t blocks) const = 0;
+    virtual void decryptBlocks(const uint8_t* in, uint8_t* out, size_t blocks) const = 0;
+
+    // y = (y ^ X1) * H, then with X2, ... over `blocks` 16-byte blocks, in
+    // GCM's bit order. `h` is the hash subkey E(K, 0^128).
+    virtual void ghashBlocks(uint8_t y[16], const uint8_t h[16], const uint8_t* data, size_t blocks) const;
+
+    void initCmacSubkeys();
+
+private:
+    // GHASH over `len` bytes, the last block zero-padded.
+    void ghash(uint8_t y[16], const uint8_t h[16], const uint8_t* data, size_t len) const;
+    // CTR keystream from inc32(j0) applied to `len` bytes.
+    void gcmCtr(const uint8_t j0[16], const uint8_t* in, uint8_t* out, size_t len) const;
+    // Full tag over AAD and ciphertext; also returns J0.
+    void gcmTag(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                const uint8_t* cipher, size_t len, uint8_t j0[16], uint8_t tag[16]) const;
+
+    uint8_t _k1[16] = {};
+    uint8_t _k2[16] = {};
+};
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,208 @@
+// Built with -maes -mpclmul -mssse3 on GCC/Clang x86 (see CMakeLists.txt);
+// MSVC exposes the intrinsics without extra flags.
+#include "AesNiProvider.h"
+#include "AesKeyBase.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SECUREPASS_AESNI 1
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+namespace adapters {
+namespace crypto {
+
+#ifdef SECUREPASS_AESNI
+
+namespace {
+
+// Four independent blocks per iteration: AESENC has ~4 cycle latency but
+// 1/cycle throughput on current cores.
+constexpr size_t PIPELINE = 4;
+
+static __m128i expand128Step(__m128i key, __m128i assist) {
+    assist = _mm_shuffle_epi32(assist, 0xff);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+static __m128i expand256StepA(__m128i key, __m128i assist) {
+    return expand128Step(key, assist);
+}
+
+static __m128i expand256StepB(__m128i key, __m128i other) {
+    __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(other, 0x00), 0xaa);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+// GF(2^128) multiply on byte-reversed operands, reduced modulo GCM's
+// polynomial (Intel, "Carry-Less Multiplication and Its Usage for Computing
+// the GCM Mode", algorithm 5): the reflected product is shifted left by one
+// and then reduced in two phases.
+static __m128i gfmul(__m128i a, __m128i b) {
+    __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // 256-bit product << 1
+    __m128i carryLo = _mm_srli_epi32(lo, 31);
+    __m128i carryHi = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    const __m128i across = _mm_srli_si128(carryLo, 12);
+    lo = _mm_or_si128(lo, _mm_slli_si128(carryLo, 4));
+    hi = _mm_or_si128(_mm_or_si128(hi, _mm_slli_si128(carryHi, 4)), across);
+
+    // Reduction by x^128 + x^127 + x^126 + x^121 + 1, reflected
+    __m128i t = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+                              _mm_slli_epi32(lo, 25));
+    const __m128i spill = _mm_srli_si128(t, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+    t = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    t = _mm_xor_si128(t, spill);
+    return _mm_xor_si128(hi, _mm_xor_si128(lo, t));
+}
+
+class AesNiKey : public AesKeyBase {
+public:
+    AesNiKey(const uint8_t* key, size_t keyLen, bool clmul)
+        : _keySize(keyLen), _rounds(keyLen == 32 ? 14 : 10), _clmul(clmul) {
+        if (keyLen == 32) expand256(key);
+        else expand128(key);
+        // Equivalent inverse cipher (FIPS-197 §5.3.5): reversed keys with
+        // InvMixColumns applied to the inner round keys.
+        _dec[0] = _enc[_rounds];
+        for (int i = 1; i < _rounds; ++i) _dec[i] = _mm_aesimc_si128(_enc[_rounds - i]);
+        _dec[_rounds] = _enc[0];
+        initCmacSubkeys();
+    }
+
+    ~AesNiKey() override {
+        secureZero(_enc, sizeof(_enc));
+        secureZero(_dec, sizeof(_dec));
+    }
+
+    size_t keySize() const override { return _keySize; }
+
+protected:
+    void encryptBlocks(const uint8_t* in, uint8_t* out, size_t blocks) const override {
+        size_t b = 0;
+        for (; b + PIPELINE <= blocks; b += PIPELINE) {
+            __m128i s[PIPELINE];
+            for (size_t j = 0; j < PIPELINE; ++j)
+                s[j] = _mm_xor_si128(load(in + (b + j) * 16), _enc[0]);
+            for (int r = 1; r < _rounds; ++r)
+                for (size_t j = 0; j < PIPELINE; ++j) s[j] = _mm_aesenc_si128(s[j], _enc[r]);
+            for (size_t j = 0; j < PIPELINE; ++j)
+                store(out + (b + j) * 16, _mm_aesenclast_si128(s[j], _enc[_rounds]));
+        }
+        for (; b < blocks; ++b) {
+            __m128i s = _mm_xor_si128(load(in + b * 16), _enc[0]);
+            for (int r = 1; r < _rounds; ++r) s = _mm_aesenc_si128(s, _enc[r]);
+            store(out + b * 16, _mm_aesenclast_si128(s, _enc[_rounds]));
+        }
+    }
+
+    void decryptBlocks(const uint8_t* in, uint8_t* out, size_t blocks) const override {
+        size_t b = 0;
+        for (; b + PIPELINE <= blocks; b += PIPELINE) {
+            __m128i s[PIPELINE];
+            for (size_t j = 0; j < PIPELINE; ++j)
+                s[j] = _mm_xor_si128(load(in + (b + j) * 16), _dec[0]);
+            for (int r = 1; r < _rounds; ++r)
+                for (size_t j = 0; j < PIPELINE; ++j) s[j] = _mm_aesdec_si128(s[j], _dec[r]);
+            for (size_t j = 0; j < PIPELINE; ++j)
+                store(out + (b + j) * 16, _mm_aesdeclast_si128(s[j], _dec[_rounds]));
+        }
+        for (; b < blocks; ++b) {
+            __m128i s = _mm_xor_si128(load(in + b * 16), _dec[0]);
+            for (int r = 1; r < _rounds; ++r) s = _mm_aesdec_si128(s, _dec[r]);
+            store(out + b * 16, _mm_aesdeclast_si128(s, _dec[_rounds]));
+        }
+    }
+
+    void ghashBlocks(uint8_t y[16], const uint8_t h[16], const uint8_t* data, size_t blocks) const override {
+        if (!_clmul) {
+            AesKeyBase::ghashBlocks(y, h, data, blocks);
+            return;
+        }
+        const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i hr = _mm_shuffle_epi8(load(h), reverse);
+        __m128i acc = _mm_shuffle_epi8(load(y), reverse);
+        for (size_t b = 0; b < blocks; ++b)
+            acc = gfmul(_mm_xor_si128(acc, _mm_shuffle_epi8(load(data + b * 16), reverse)), hr);
+        store(y, _mm_shuffle_epi8(acc, reverse));
+    }
+
+private:
+    static __m128i load(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(uint8_t* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+    void expand128(const uint8_t* key) {
+        _enc[0] = load(key);
+        _enc[1]  = expand128Step(_enc[0], _mm_aeskeygenassist_si128(_enc[0], 0x01));
+        _enc[2]  = expand128Step(_enc[1], _mm_aeskeygenassist_si128(_enc[1], 0x02));
+        _enc[3]  = expand128Step(_enc[2], _mm_aeskeygenassist_si128(_enc[2], 0x04));
+        _enc[4]  = expand128Step(_enc[3], _mm_aeskeygenassist_si128(_enc[3], 0x08));
+        _enc[5]  = expand128Step(_enc[4], _mm_aeskeygenassist_si128(_enc[4], 0x10));
+        _enc[6]  = expand128Step(_enc[5], _mm_aeskeygenassist_si128(_enc[5], 0x20));
+        _enc[7]  = expand128Step(_enc[6], _mm_aeskeygenassist_si128(_enc[6], 0x40));
+        _enc[8]  = expand128Step(_enc[7], _mm_aeskeygenassist_si128(_enc[7], 0x80));
+        _enc[9]  = expand128Step(_enc[8], _mm_aeskeygenassist_si128(_enc[8], 0x1b));
+        _enc[10] = expand128Step(_enc[9], _mm_aeskeygenassist_si128(_enc[9], 0x36));
+    }
+
+    void expand256(const uint8_t* key) {
+        _enc[0] = load(key);
+        _enc[1] = load(key + 16);
+        _enc[2]  = expand256StepA(_enc[0],  _mm_aeskeygenassist_si128(_enc[1],  0x01));
+        _enc[3]  = expand256StepB(_enc[1],  _enc[2]);
+        _enc[4]  = expand256StepA(_enc[2],  _mm_aeskeygenassist_si128(_enc[3],  0x02));
+        _enc[5]  = expand256StepB(_enc[3],  _enc[4]);
+        _enc[6]  = expand256StepA(_enc[4],  _mm_aeskeygenassist_si128(_enc[5],  0x04));
+        _enc[7]  = expand256StepB(_enc[5],  _enc[6]);
+        _enc[8]  = expand256StepA(_enc[6],  _mm_aeskeygenassist_si128(_enc[7],  0x08));
+        _enc[9]  = expand256StepB(_enc[7],  _enc[8]);
+        _enc[10] = expand256StepA(_enc[8],  _mm_aeskeygenassist_si128(_enc[9],  0x10));
+        _enc[11] = expand256StepB(_enc[9],  _enc[10]);
+        _enc[12] = expand256StepA(_enc[10], _mm_aeskeygenassist_si128(_enc[11], 0x20));
+        _enc[13] = expand256StepB(_enc[11], _enc[12]);
+        _enc[14] = expand256StepA(_enc[12], _mm_aeskeygenassist_si128(_enc[13], 0x40));
+    }
+
+    size_t _keySize;
+    int _rounds;
+    bool _clmul;
+    __m128i _enc[15];
+    __m128i _dec[15];
+};
+
+} // anonymous namespace
+
+bool AesNiProvider::compiledIn() { return true; }
+
+std::unique_ptr<core::ports::IAesKey> AesNiProvider::createAesKey(const uint8_t* key, size_t keyLen) const {
+    if (keyLen != 16 && keyLen != 32) return nullptr;
+    return std::make_unique<AesNiKey>(key, keyLen, _clmul);
+}
+
+#else
+
+bool AesNiProvider::compiledIn() { return false; }
+
+std::unique_ptr<core::ports::IAesKey> AesNiProvider::createAesKey(const uint8_t*, size_t) const {
+    return nullptr;
+}
+
+#endif
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,32 @@
+#pragma once
+#include "../../core/ports/ICryptoProvider.h"
+
+namespace adapters {
+namespace crypto {
+
+/**
+ * AES-128/256 on x86 AES-NI. ECB and CBC decryption keep four blocks in
+ * flight to hide the AESENC/AESDEC latency; CBC encryption and CMAC are
+ * serial by construction and gain from the single-instruction rounds only.
+ * GCM's CTR half rides the pipelined ECB path; its GHASH uses PCLMULQDQ
+ * when the provider is built with `clmul`, else the portable multiply.
+ *
+ * Construct through createCryptoProvider(), which checks CPUID first —
+ * calling into this backend on a CPU without AES-NI faults.
+ */
+class AesNiProvider : public core::ports::ICryptoProvider {
+public:
+    explicit AesNiProvider(bool clmul = false) : _clmul(clmul) {}
+
+    // False when this translation unit was built for a non-x86 target.
+    static bool compiledIn();
+
+    const char* name() const override { return "aes-ni"; }
+    std::unique_ptr<core::ports::IAesKey> createAesKey(const uint8_t* key, size_t keyLen) const override;
+
+private:
+    bool _clmul;
+};
+
+} // namespace crypto
+} // namespace adapters
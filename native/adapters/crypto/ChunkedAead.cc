@@ -0,0 +1,89 @@
+#include "ChunkedAead.h"
+#include "SecureRandom.h"
+#include "Sha256.h"
+#include <cstring>
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+constexpr char CHUNK_KEY_INFO[] = "pwmgr-stream-v1";
+
+} // anonymous namespace
+
+bool ChunkedHeader::generate(uint32_t chunkSize, ChunkedHeader& out) {
+    if (chunkSize < kMinChunkSize || chunkSize > kMaxChunkSize) return false;
+    uint8_t random[16 + 7];
+    if (!secureRandom(random, sizeof(random))) return false;
+    out.chunkSize = chunkSize;
+    std::memcpy(out.salt.data(), random, out.salt.size());
+    std::memcpy(out.noncePrefix.data(), random + out.salt.size(), out.noncePrefix.size());
+    return true;
+}
+
+bool ChunkedHeader::parse(const uint8_t* data, size_t size, ChunkedHeader& out) {
+    if (size < kSize || data[0] != kVersion) return false;
+    const uint32_t chunkSize = uint32_t(data[1]) | uint32_t(data[2]) << 8 | uint32_t(data[3]) << 16 |
+                               uint32_t(data[4]) << 24;
+    if (chunkSize < kMinChunkSize || chunkSize > kMaxChunkSize) return false;
+    out.chunkSize = chunkSize;
+    std::memcpy(out.salt.data(), data + 5, out.salt.size());
+    std::memcpy(out.noncePrefix.data(), data + 21, out.noncePrefix.size());
+    return true;
+}
+
+void ChunkedHeader::serialize(uint8_t out[kSize]) const {
+    out[0] = kVersion;
+    for (int i = 0; i < 4; ++i) out[1 + i] = static_cast<uint8_t>(chunkSize >> (8 * i));
+    std::memcpy(out + 5, salt.data(), salt.size());
+    std::memcpy(out + 21, noncePrefix.data(), noncePrefix.size());
+}
+
+uint64_t chunkedChunkCount(uint64_t plaintextSize, uint32_t chunkSize) {
+    return plaintextSize == 0 ? 1 : (plaintextSize + chunkSize - 1) / chunkSize;
+}
+
+uint64_t chunkedSealedSize(uint64_t plaintextSize, uint32_t chunkSize) {
+    return ChunkedHeader::kSize + plaintextSize + chunkedChunkCount(plaintextSize, chunkSize) * kChunkTagSize;
+}
+
+ChunkedKey::ChunkedKey(const uint8_t* entryKey, size_t entryKeyLen, const ChunkedHeader& header)
+    : _header(header) {
+    _header.serialize(_aad);
+    hkdfSha256(_header.salt.data(), _header.salt.size(), entryKey, entryKeyLen,
+               reinterpret_cast<const uint8_t*>(CHUNK_KEY_INFO), sizeof(CHUNK_KEY_INFO) - 1,
+               _key->bytes, sizeof(_key->bytes));
+}
+
+std::unique_ptr<core::ports::IAesKey> ChunkedKey::createAesKey(const core::ports::ICryptoProvider& provider) const {
+    return provider.createAesKey(_key->bytes, sizeof(_key->bytes));
+}
+
+void ChunkedKey::nonce(uint32_t index, bool final, uint8_t out[12]) const {
+    std::memcpy(out, _header.noncePrefix.data(), _header.noncePrefix.size());
+    out[7] = static_cast<uint8_t>(index >> 24);
+    out[8] = static_cast<uint8_t>(index >> 16);
+    out[9] = static_cast<uint8_t>(index >> 8);
+    out[10] = static_cast<uint8_t>(index);
+    out[11] = final ? 0x01 : 0x00;
+}
+
+void ChunkedKey::seal(const core::ports::IAesKey& aes, uint32_t index, bool final,
+                      const uint8_t* in, size_t len, uint8_t* out) const {
+    uint8_t iv[12];
+    nonce(index, final, iv);
+    aes.gcmSeal(iv, _aad, sizeof(_aad), in, out, len, out + len);
+}
+
+bool ChunkedKey::open(const core::ports::IAesKey& aes, uint32_t index, bool final,
+                      const uint8_t* in, size_t sealedLen, uint8_t* out) const {
+    if (sealedLen < kChunkTagSize) return false;
+    uint8_t iv[12];
+    nonce(index, final, iv);
+    const size_t len = sealedLen - kChunkTagSize;
+    return aes.gcmOpen(iv, _aad, sizeof(_aad), in, out, len, in + len);
+}
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,95 @@
+#pragma once
+#include "SecureBytes.h"
+#include "../../core/ports/ICryptoProvider.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace adapters {
+namespace crypto {
+
+// GCM tag closing every chunk
+constexpr size_t kChunkTagSize = 16;
+
+/**
+ * Chunked AES-256-GCM for blobs too large to seal as one GCM message
+ * (attachments, long notes). The blob is a header followed by chunks that
+ * each authenticate on their own, so it can be sealed and opened as a
+ * stream in constant memory, any chunk can be opened without the others,
+ * and chunks can be processed in parallel:
+ *
+ *   header   28 bytes   version 0x01 | chunk size (u32 LE) | salt (16) | nonce prefix (7)
+ *   chunk i  ciphertext (chunk size bytes; the final one 0 to chunk size) | tag (16)
+ *
+ *   chunk key  HKDF-SHA256(ikm = entry key, salt = salt, info = "pwmgr-stream-v1")
+ *   nonce i    nonce prefix ‖ i (u32 BE) ‖ final (0x00 or 0x01)
+ *   AAD        the header
+ *
+ * A fresh salt per blob gives each blob its own chunk key, so nonces never
+ * repeat across blobs sealed under one entry key. The index in the nonce
+ * stops chunks being reordered; the final flag stops a blob being cut at a
+ * chunk boundary, or extended. The header is the AAD of every chunk, so it
+ * cannot be altered either. An empty blob is a single empty final chunk.
+ */
+struct ChunkedHeader {
+    static constexpr size_t kSize = 28;
+    static constexpr uint8_t kVersion = 0x01;
+    static constexpr uint32_t kMinChunkSize = 1024;
+    static constexpr uint32_t kMaxChunkSize = 16u << 20;
+    static constexpr uint32_t kDefaultChunkSize = 64u << 10;
+
+    uint32_t chunkSize = kDefaultChunkSize;
+    std::array<uint8_t, 16> salt{};
+    std::array<uint8_t, 7> noncePrefix{};
+
+    // Random salt and nonce prefix. False if the chunk size is out of range
+    // or the OS random source fails.
+    static bool generate(uint32_t chunkSize, ChunkedHeader& out);
+    // False on a short buffer, another version or a chunk size out of range
+    static bool parse(const uint8_t* data, size_t size, ChunkedHeader& out);
+    void serialize(uint8_t out[kSize]) const;
+
+    size_t sealedChunkSize() const { return size_t(chunkSize) + kChunkTagSize; }
+};
+
+// Chunks in a blob of `plaintextSize` bytes: at least one
+uint64_t chunkedChunkCount(uint64_t plaintextSize, uint32_t chunkSize);
+// Bytes of a sealed blob holding `plaintextSize` bytes, header included
+uint64_t chunkedSealedSize(uint64_t plaintextSize, uint32_t chunkSize);
+
+/**
+ * The chunk key of one blob, in the secure arena, with its header.
+ * Immutable: the threads of a batch share one and each makes its own
+ * IAesKey, which is not thread-safe.
+ */
+class ChunkedKey {
+public:
+    ChunkedKey(const uint8_t* entryKey, size_t entryKeyLen, const ChunkedHeader& header);
+
+    const ChunkedHeader& header() const { return _header; }
+    std::unique_ptr<core::ports::IAesKey> createAesKey(const core::ports::ICryptoProvider& provider) const;
+
+    // `len` is the chunk size, or up to it for the final chunk; `out`
+    // receives len + kChunkTagSize bytes.
+    void seal(const core::ports::IAesKey& aes, uint32_t index, bool final,
+              const uint8_t* in, size_t len, uint8_t* out) const;
+    // `sealedLen` includes the tag; `out` receives sealedLen - kChunkTagSize
+    // bytes, and nothing when the chunk does not authenticate.
+    bool open(const core::ports::IAesKey& aes, uint32_t index, bool final,
+              const uint8_t* in, size_t sealedLen, uint8_t* out) const;
+
+private:
+    struct Key {
+        uint8_t bytes[32];
+    };
+
+    void nonce(uint32_t index, bool final, uint8_t out[12]) const;
+
+    ChunkedHeader _header;
+    uint8_t _aad[ChunkedHeader::kSize];
+    SecureBox<Key> _key;
+};
+
+} // namespace crypto
+} // namespace adapters
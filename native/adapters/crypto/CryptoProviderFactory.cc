@@ -0,0 +1,103 @@
+#include "CryptoProviderFactory.h"
+#include "PortableAesProvider.h"
+#include "AesNiProvider.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace adapters {
+namespace crypto {
+
+bool cpuSupportsAesNi() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4] = {};
+    __cpuid(regs, 1);
+    return (regs[2] & (1 << 25)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    return (ecx & bit_AES) != 0;
+#else
+    return false;
+#endif
+}
+
+bool cpuSupportsClmul() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4] = {};
+    __cpuid(regs, 1);
+    return (regs[2] & (1 << 1)) != 0 && (regs[2] & (1 << 9)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    return (ecx & bit_PCLMUL) != 0 && (ecx & bit_SSSE3) != 0;
+#else
+    return false;
+#endif
+}
+
+bool cpuSupportsShaNi() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    const bool sse41 = (regs[2] & (1 << 19)) != 0;
+    __cpuidex(regs, 7, 0);
+    return sse41 && (regs[1] & (1 << 29)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_SSE4_1) == 0) return false;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    return (ebx & bit_SHA) != 0;
+#else
+    return false;
+#endif
+}
+
+bool cpuSupportsAvx2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    if ((regs[2] & (1 << 27)) == 0 || (regs[2] & (1 << 28)) == 0) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    if ((ecx & bit_OSXSAVE) == 0 || (ecx & bit_AVX) == 0) return false;
+    // XCR0: the OS saves XMM and YMM state on context switch
+    unsigned int xcr0Lo = 0, xcr0Hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+    if ((xcr0Lo & 0x6) != 0x6) return false;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    return (ebx & bit_AVX2) != 0;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<const core::ports::ICryptoProvider> createCryptoProvider(CryptoBackend backend) {
+    static const auto portable = std::make_shared<const PortableAesProvider>();
+    static const auto aesNi = std::make_shared<const AesNiProvider>(cpuSupportsClmul());
+    static const bool haveAesNi = AesNiProvider::compiledIn() && cpuSupportsAesNi();
+
+    if (backend == CryptoBackend::Auto) {
+        const char* pinned = std::getenv("SECUREPASS_CRYPTO");
+        if (pinned && std::strcmp(pinned, "portable") == 0) backend = CryptoBackend::Portable;
+        else backend = CryptoBackend::AesNi;
+    }
+    if (backend == CryptoBackend::AesNi && haveAesNi) return aesNi;
+    return portable;
+}
+
+} // namespace crypto
+} // namespace adapters
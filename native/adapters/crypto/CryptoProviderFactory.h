@@ -0,0 +1,34 @@
+#pragma once
+#include "../../core/ports/ICryptoProvider.h"
+#include <memory>
+
+namespace adapters {
+namespace crypto {
+
+enum class CryptoBackend {
+    Auto,     // AES-NI when CPUID reports it, otherwise portable
+    Portable,
+    AesNi,    // falls back to portable when the CPU lacks AES-NI
+};
+
+// CPUID leaf 1, ECX bit 25. Always false on non-x86 builds.
+bool cpuSupportsAesNi();
+
+// PCLMULQDQ and SSSE3 (leaf 1, ECX bits 1 and 9), used for GCM's GHASH.
+bool cpuSupportsClmul();
+
+// SHA extensions plus SSE4.1 (leaf 7 EBX bit 29; leaf 1 ECX bit 19), used
+// for SHA-256.
+bool cpuSupportsShaNi();
+
+// AVX2 (leaf 7 EBX bit 5) with the OS saving YMM state (OSXSAVE, XCR0).
+bool cpuSupportsAvx2();
+
+// Returns a shared, stateless provider for `backend`. With Auto the
+// SECUREPASS_CRYPTO environment variable ("portable" or "aes-ni") can pin
+// the backend for A/B comparisons on the same machine.
+std::shared_ptr<const core::ports::ICryptoProvider> createCryptoProvider(
+    CryptoBackend backend = CryptoBackend::Auto);
+
+} // namespace crypto
+} // namespace adapters
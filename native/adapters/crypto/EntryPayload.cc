@@ -0,0 +1,320 @@
+#include "EntryPayload.h"
+#include <climits>
+#include <cstdint>
+#include <string>
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+constexpr std::string_view FIELD_NAMES[kEntryFieldCount] = {"username", "password", "totpSecret", "notes"};
+
+// Nesting a skipped value may reach; our payloads are flat
+constexpr size_t kMaxSkipDepth = 64;
+
+struct Cursor {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+    }
+    bool consume(uint8_t c) {
+        skipSpace();
+        if (p == end || *p != c) return false;
+        ++p;
+        return true;
+    }
+};
+
+static bool readHex4(Cursor& c, uint32_t& out) {
+    if (c.end - c.p < 4) return false;
+    out = 0;
+    for (int i = 0; i < 4; ++i) {
+        const uint8_t h = *c.p++;
+        uint32_t v;
+        if (h >= '0' && h <= '9') v = h - '0';
+        else if (h >= 'a' && h <= 'f') v = h - 'a' + 10;
+        else if (h >= 'A' && h <= 'F') v = h - 'A' + 10;
+        else return false;
+        out = (out << 4) | v;
+    }
+    return true;
+}
+
+template <typename Out>
+static void appendUtf8(Out& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<uint8_t>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<uint8_t>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<uint8_t>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<uint8_t>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<uint8_t>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<uint8_t>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<uint8_t>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<uint8_t>(0x80 | (cp & 0x3F)));
+    }
+}
+
+// The rest of a string whose opening quote was consumed, decoded to UTF-8
+// into `out`, or only scanned when `out` is null. Unpaired surrogates
+// become U+FFFD, as Buffer.from(string) would encode them.
+template <typename Out>
+static bool readString(Cursor& c, Out* out) {
+    while (c.p < c.end) {
+        // Copy plain runs in one go
+        const uint8_t* run = c.p;
+        while (c.p < c.end && *c.p != '"' && *c.p != '\\' && *c.p >= 0x20) ++c.p;
+        if (out && c.p > run) out->insert(out->end(), run, c.p);
+        if (c.p == c.end) return false;
+
+        const uint8_t ch = *c.p++;
+        if (ch == '"') return true;
+        if (ch != '\\' || c.p == c.end) return false; // control character or dangling escape
+
+        uint32_t cp;
+        switch (*c.p++) {
+        case '"': cp = '"'; break;
+        case '\\': cp = '\\'; break;
+        case '/': cp = '/'; break;
+        case 'b': cp = '\b'; break;
+        case 'f': cp = '\f'; break;
+        case 'n': cp = '\n'; break;
+        case 'r': cp = '\r'; break;
+        case 't': cp = '\t'; break;
+        case 'u':
+            if (!readHex4(c, cp)) return false;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                Cursor low{c.p + 2, c.end};
+                uint32_t second;
+                if (c.end - c.p >= 6 && c.p[0] == '\\' && c.p[1] == 'u' && readHex4(low, second) &&
+                    second >= 0xDC00 && second <= 0xDFFF) {
+                    c.p = low.p;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (second - 0xDC00);
+                } else {
+                    cp = 0xFFFD;
+                }
+            } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                cp = 0xFFFD;
+            }
+            break;
+        default:
+            return false;
+        }
+        if (out) appendUtf8(*out, cp);
+    }
+    return false;
+}
+
+static bool isLiteralChar(uint8_t c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E';
+}
+
+// Moves past one value of any type
+static bool skipValue(Cursor& c) {
+    c.skipSpace();
+    if (c.p == c.end) return false;
+    if (*c.p == '"') {
+        ++c.p;
+        return readString<std::string>(c, nullptr);
+    }
+    if (*c.p == '{' || *c.p == '[') {
+        uint8_t closers[kMaxSkipDepth];
+        size_t depth = 0;
+        while (c.p < c.end) {
+            const uint8_t ch = *c.p++;
+            if (ch == '"') {
+                if (!readString<std::string>(c, nullptr)) return false;
+            } else if (ch == '{' || ch == '[') {
+                if (depth == kMaxSkipDepth) return false;
+                closers[depth++] = ch == '{' ? '}' : ']';
+            } else if (ch == '}' || ch == ']') {
+                if (depth == 0 || closers[--depth] != ch) return false;
+                if (depth == 0) return true;
+            }
+        }
+        return false;
+    }
+    // Number, true, false or null
+    const uint8_t* start = c.p;
+    while (c.p < c.end && isLiteralChar(*c.p)) ++c.p;
+    return c.p > start;
+}
+
+static void appendVarint(SecureBytes& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static size_t varintSize(uint32_t value) {
+    size_t n = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++n;
+    }
+    return n;
+}
+
+static bool readVarint(const uint8_t* data, size_t size, size_t& pos, uint32_t& out) {
+    out = 0;
+    for (unsigned shift = 0; shift < 35 && pos < size; shift += 7) {
+        const uint8_t b = data[pos++];
+        if (shift == 28 && b > 0x0F) return false; // past 32 bits
+        out |= static_cast<uint32_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static bool consumeNull(Cursor& c) {
+    if (c.end - c.p < 4 || std::string_view(reinterpret_cast<const char*>(c.p), 4) != "null") return false;
+    c.p += 4;
+    return true;
+}
+
+} // anonymous namespace
+
+std::string_view entryFieldName(EntryField field) {
+    return FIELD_NAMES[static_cast<size_t>(field)];
+}
+
+bool entryFieldFromName(std::string_view name, EntryField& out) {
+    for (size_t i = 0; i < kEntryFieldCount; ++i) {
+        if (FIELD_NAMES[i] == name) {
+            out = static_cast<EntryField>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool readEntryFieldsJson(const uint8_t* data, size_t size, uint32_t mask, EntryFields& out) {
+    out.present = 0;
+    for (SecureBytes& value : out.values) value.clear();
+
+    Cursor c{data, data + size};
+    if (!c.consume('{')) return false;
+    if (!c.consume('}')) {
+        std::string key;
+        do {
+            key.clear();
+            if (!c.consume('"') || !readString(c, &key) || !c.consume(':')) return false;
+
+            EntryField field;
+            if (!entryFieldFromName(key, field) || !(mask & entryFieldBit(field))) {
+                if (!skipValue(c)) return false;
+                continue;
+            }
+            const uint32_t bit = entryFieldBit(field);
+            SecureBytes& value = out.values[static_cast<size_t>(field)];
+            value.clear();
+            c.skipSpace();
+            if (c.p < c.end && *c.p == '"') {
+                ++c.p;
+                if (!readString(c, &value)) return false;
+                out.present |= bit;
+            } else if (consumeNull(c)) {
+                out.present &= ~bit;
+            } else {
+                return false;
+            }
+        } while (c.consume(','));
+        if (!c.consume('}')) return false;
+    }
+    c.skipSpace();
+    return c.p == c.end;
+}
+
+bool encodeEntryPayload(const EntryFields& fields, SecureBytes& out) {
+    size_t size = 1;
+    for (EntryField field : kEntryFields) {
+        if (!fields.has(field)) continue;
+        const size_t length = fields[field].size();
+        if (length > UINT32_MAX) return false;
+        size += 1 + varintSize(static_cast<uint32_t>(length)) + length;
+    }
+    out.clear();
+    out.reserve(size);
+    out.push_back(kEntryPayloadV2);
+    for (EntryField field : kEntryFields) {
+        if (!fields.has(field)) continue;
+        const SecureBytes& value = fields[field];
+        out.push_back(static_cast<uint8_t>(field));
+        appendVarint(out, static_cast<uint32_t>(value.size()));
+        out.insert(out.end(), value.begin(), value.end());
+    }
+    return true;
+}
+
+void encodeEntryPayloadJson(const EntryFields& fields, SecureBytes& out) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    out.clear();
+    out.push_back('{');
+    for (EntryField field : kEntryFields) {
+        if (!fields.has(field)) continue;
+        if (out.size() > 1) out.push_back(',');
+        const std::string_view name = entryFieldName(field);
+        out.push_back('"');
+        out.insert(out.end(), name.begin(), name.end());
+        out.insert(out.end(), {'"', ':', '"'});
+        // The escapes JSON.stringify() emits; UTF-8 sequences pass through
+        for (const uint8_t c : fields[field]) {
+            switch (c) {
+            case '"': out.insert(out.end(), {'\\', '"'}); break;
+            case '\\': out.insert(out.end(), {'\\', '\\'}); break;
+            case '\b': out.insert(out.end(), {'\\', 'b'}); break;
+            case '\f': out.insert(out.end(), {'\\', 'f'}); break;
+            case '\n': out.insert(out.end(), {'\\', 'n'}); break;
+            case '\r': out.insert(out.end(), {'\\', 'r'}); break;
+            case '\t': out.insert(out.end(), {'\\', 't'}); break;
+            default:
+                if (c < 0x20) {
+                    out.insert(out.end(), {'\\', 'u', '0', '0', static_cast<uint8_t>(HEX[c >> 4]),
+                                           static_cast<uint8_t>(HEX[c & 0x0F])});
+                } else {
+                    out.push_back(c);
+                }
+            }
+        }
+        out.push_back('"');
+    }
+    out.push_back('}');
+}
+
+bool readEntryFieldsTlv(const uint8_t* data, size_t size, uint32_t mask, EntryFields& out) {
+    out.present = 0;
+    for (SecureBytes& value : out.values) value.clear();
+
+    if (size == 0 || data[0] != kEntryPayloadV2) return false;
+    size_t pos = 1;
+    int lastTag = -1;
+    while (pos < size) {
+        const uint8_t tag = data[pos++];
+        uint32_t length;
+        if (tag <= lastTag || !readVarint(data, size, pos, length) || length > size - pos) return false;
+        lastTag = tag;
+        if (tag < kEntryFieldCount && (mask & (1u << tag))) {
+            out.values[tag].assign(data + pos, data + pos + length);
+            out.present |= 1u << tag;
+        }
+        pos += length;
+    }
+    return true;
+}
+
+bool readEntryFields(const uint8_t* data, size_t size, uint32_t mask, EntryFields& out) {
+    if (size > 0 && data[0] == kEntryPayloadV2) return readEntryFieldsTlv(data, size, mask, out);
+    return readEntryFieldsJson(data, size, mask, out);
+}
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,84 @@
+#pragma once
+#include "SecureBytes.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace adapters {
+namespace crypto {
+
+// The plaintext fields of a vault entry (EntryPayload in keyDerivation.ts)
+enum class EntryField : uint8_t {
+    Username,
+    Password,
+    TotpSecret,
+    Notes,
+};
+
+constexpr size_t kEntryFieldCount = 4;
+constexpr std::array<EntryField, kEntryFieldCount> kEntryFields = {
+    EntryField::Username, EntryField::Password, EntryField::TotpSecret, EntryField::Notes,
+};
+constexpr uint32_t kAllEntryFields = (1u << kEntryFieldCount) - 1;
+
+constexpr uint32_t entryFieldBit(EntryField field) { return 1u << static_cast<unsigned>(field); }
+
+// The EntryPayload property name: "username", "password", "totpSecret", "notes"
+std::string_view entryFieldName(EntryField field);
+// Inverse of entryFieldName(); false for any other name
+bool entryFieldFromName(std::string_view name, EntryField& out);
+
+// Fields read out of one payload, as UTF-8 in zeroizing buffers. A field is
+// present when its bit is set; absent fields stay empty.
+struct EntryFields {
+    uint32_t present = 0;
+    std::array<SecureBytes, kEntryFieldCount> values;
+
+    bool has(EntryField field) const { return (present & entryFieldBit(field)) != 0; }
+    const SecureBytes& operator[](EntryField field) const { return values[static_cast<size_t>(field)]; }
+};
+
+/**
+ * Payload formats. v1 is the UTF-8 JSON object encryptEntry() used to write,
+ * so it always starts with '{' (or JSON whitespace). v2 starts with this
+ * version byte, followed by one record per present field in ascending tag
+ * order:
+ *
+ *   tag    1 byte      EntryField value; tags past Notes are skipped
+ *   length LEB128      byte length of the value, at most 2^32 - 1
+ *   value  UTF-8
+ */
+constexpr uint8_t kEntryPayloadV2 = 0x02;
+
+// Writes `fields` as a v2 payload, replacing `out`. False if a value does
+// not fit the length field.
+bool encodeEntryPayload(const EntryFields& fields, SecureBytes& out);
+
+// Writes `fields` as a v1 payload, replacing `out`: the bytes of
+// JSON.stringify() on an object with the present fields in tag order. v1 is
+// still the format written until every synced device reads v2.
+void encodeEntryPayloadJson(const EntryFields& fields, SecureBytes& out);
+
+// Reads the fields in `mask` out of a v2 payload. Records are skipped by
+// length, so values that are not asked for are never read. False on a
+// truncated record, an overlong length or tags out of order.
+bool readEntryFieldsTlv(const uint8_t* data, size_t size, uint32_t mask, EntryFields& out);
+
+/**
+ * Reads the fields in `mask` out of a v1 payload without materialising
+ * the rest: other members are scanned past, never copied. A later
+ * duplicate key wins, as in JSON.parse(); a null value counts as absent.
+ *
+ * Returns false when the payload is not a JSON object, or a requested field
+ * holds something other than a string or null. Skipped values are only
+ * checked for balanced nesting: the payload is authenticated before it
+ * gets here, so this is a reader for our own output, not a validator.
+ */
+bool readEntryFieldsJson(const uint8_t* data, size_t size, uint32_t mask, EntryFields& out);
+
+// readEntryFieldsTlv() or readEntryFieldsJson(), by the payload's first byte
+bool readEntryFields(const uint8_t* data, size_t size, uint32_t mask, EntryFields& out);
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,181 @@
+#include "PortableAesProvider.h"
+#include "AesKeyBase.h"
+#include <cstring>
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+static const uint8_t SBOX[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+static const uint8_t INV_SBOX[256] = {
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d,
+};
+
+static uint8_t xtime(uint8_t x) {
+    return static_cast<uint8_t>((x << 1) ^ ((x >> 7) * 0x1b));
+}
+
+static uint8_t gmul(uint8_t a, uint8_t b) {
+    uint8_t p = 0;
+    while (b) {
+        if (b & 1) p ^= a;
+        a = xtime(a);
+        b >>= 1;
+    }
+    return p;
+}
+
+class PortableAesKey : public AesKeyBase {
+public:
+    PortableAesKey(const uint8_t* key, size_t keyLen) : _keySize(keyLen) {
+        expandKey(key);
+        initCmacSubkeys();
+    }
+
+    ~PortableAesKey() override { secureZero(_roundKeys, sizeof(_roundKeys)); }
+
+    size_t keySize() const override { return _keySize; }
+
+protected:
+    void encryptBlocks(const uint8_t* in, uint8_t* out, size_t blocks) const override {
+        for (size_t b = 0; b < blocks; ++b) encryptBlock(in + b * 16, out + b * 16);
+    }
+
+    void decryptBlocks(const uint8_t* in, uint8_t* out, size_t blocks) const override {
+        for (size_t b = 0; b < blocks; ++b) decryptBlock(in + b * 16, out + b * 16);
+    }
+
+private:
+    int rounds() const { return _keySize == 32 ? 14 : 10; }
+
+    // FIPS-197 §5.2
+    void expandKey(const uint8_t* key) {
+        const int nk = static_cast<int>(_keySize / 4);
+        const int words = 4 * (rounds() + 1);
+        std::memcpy(_roundKeys, key, _keySize);
+        uint8_t rcon = 0x01;
+        for (int i = nk; i < words; ++i) {
+            uint8_t t[4];
+            std::memcpy(t, _roundKeys + (i - 1) * 4, 4);
+            if (i % nk == 0) {
+                const uint8_t t0 = t[0];
+                t[0] = static_cast<uint8_t>(SBOX[t[1]] ^ rcon);
+                t[1] = SBOX[t[2]];
+                t[2] = SBOX[t[3]];
+                t[3] = SBOX[t0];
+                rcon = xtime(rcon);
+            } else if (nk > 6 && i % nk == 4) {
+                for (auto& v : t) v = SBOX[v];
+            }
+            for (int j = 0; j < 4; ++j)
+                _roundKeys[i * 4 + j] = static_cast<uint8_t>(_roundKeys[(i - nk) * 4 + j] ^ t[j]);
+        }
+    }
+
+    void addRoundKey(uint8_t s[16], int round) const {
+        for (int i = 0; i < 16; ++i) s[i] ^= _roundKeys[round * 16 + i];
+    }
+
+    void encryptBlock(const uint8_t* in, uint8_t* out) const {
+        uint8_t s[16];
+        std::memcpy(s, in, 16);
+        addRoundKey(s, 0);
+        for (int round = 1; round <= rounds(); ++round) {
+            // SubBytes + ShiftRows (state is column-major: s[col*4 + row])
+            uint8_t t[16];
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 4; ++r)
+                    t[c * 4 + r] = SBOX[s[((c + r) % 4) * 4 + r]];
+            // MixColumns, skipped in the final round
+            if (round != rounds()) {
+                for (int c = 0; c < 4; ++c) {
+                    uint8_t* col = t + c * 4;
+                    const uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                    const uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+                    col[0] ^= all ^ xtime(a0 ^ a1);
+                    col[1] ^= all ^ xtime(a1 ^ a2);
+                    col[2] ^= all ^ xtime(a2 ^ a3);
+                    col[3] ^= all ^ xtime(a3 ^ a0);
+                }
+            }
+            std::memcpy(s, t, 16);
+            addRoundKey(s, round);
+        }
+        std::memcpy(out, s, 16);
+        secureZero(s, sizeof(s));
+    }
+
+    void decryptBlock(const uint8_t* in, uint8_t* out) const {
+        uint8_t s[16];
+        std::memcpy(s, in, 16);
+        addRoundKey(s, rounds());
+        for (int round = rounds() - 1; round >= 0; --round) {
+            // InvShiftRows + InvSubBytes
+            uint8_t t[16];
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 4; ++r)
+                    t[((c + r) % 4) * 4 + r] = INV_SBOX[s[c * 4 + r]];
+            std::memcpy(s, t, 16);
+            addRoundKey(s, round);
+            if (round != 0) {
+                for (int c = 0; c < 4; ++c) {
+                    uint8_t* col = s + c * 4;
+                    const uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                    col[0] = gmul(a0, 14) ^ gmul(a1, 11) ^ gmul(a2, 13) ^ gmul(a3, 9);
+                    col[1] = gmul(a0, 9) ^ gmul(a1, 14) ^ gmul(a2, 11) ^ gmul(a3, 13);
+                    col[2] = gmul(a0, 13) ^ gmul(a1, 9) ^ gmul(a2, 14) ^ gmul(a3, 11);
+                    col[3] = gmul(a0, 11) ^ gmul(a1, 13) ^ gmul(a2, 9) ^ gmul(a3, 14);
+                }
+            }
+        }
+        std::memcpy(out, s, 16);
+        secureZero(s, sizeof(s));
+    }
+
+    size_t _keySize;
+    uint8_t _roundKeys[16 * 15] = {};
+};
+
+} // anonymous namespace
+
+std::unique_ptr<core::ports::IAesKey> PortableAesProvider::createAesKey(const uint8_t* key, size_t keyLen) const {
+    if (keyLen != 16 && keyLen != 32) return nullptr;
+    return std::make_unique<PortableAesKey>(key, keyLen);
+}
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,19 @@
+#pragma once
+#include "../../core/ports/ICryptoProvider.h"
+
+namespace adapters {
+namespace crypto {
+
+/**
+ * Plain C++ AES-128/256 (FIPS-197), byte-oriented with S-box lookups.
+ * Runs everywhere; used when the CPU has no AES instructions and as the
+ * reference backend in benchmarks.
+ */
+class PortableAesProvider : public core::ports::ICryptoProvider {
+public:
+    const char* name() const override { return "portable"; }
+    std::unique_ptr<core::ports::IAesKey> createAesKey(const uint8_t* key, size_t keyLen) const override;
+};
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,325 @@
+#include "Scrypt.h"
+#include "AesKeyBase.h"
+#include "SecureBytes.h"
+#include "Sha256.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+static inline uint32_t load32le(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+static inline void store32le(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v);
+    p[1] = uint8_t(v >> 8);
+    p[2] = uint8_t(v >> 16);
+    p[3] = uint8_t(v >> 24);
+}
+
+constexpr size_t kBlockWords = 16; // one Salsa20 block, 64 bytes
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+// The SSE2 rounds keep the diagonals of the 4x4 Salsa matrix in one
+// register each: inside ROMix, slot s of a block holds word 5s mod 16, so
+// word i lives at slot 13i mod 16. Word 0, which integerify() reads, stays
+// at slot 0.
+static inline size_t slot(size_t i) { return (i * 13) & 15; }
+
+#define SCRYPT_ROTL(v, n) _mm_or_si128(_mm_slli_epi32((v), (n)), _mm_srli_epi32((v), 32 - (n)))
+
+static inline void salsa20_8(__m128i& x0, __m128i& x1, __m128i& x2, __m128i& x3) {
+    const __m128i b0 = x0, b1 = x1, b2 = x2, b3 = x3;
+    for (int i = 0; i < 8; i += 2) {
+        // Columns
+        x1 = _mm_xor_si128(x1, SCRYPT_ROTL(_mm_add_epi32(x0, x3), 7));
+        x2 = _mm_xor_si128(x2, SCRYPT_ROTL(_mm_add_epi32(x1, x0), 9));
+        x3 = _mm_xor_si128(x3, SCRYPT_ROTL(_mm_add_epi32(x2, x1), 13));
+        x0 = _mm_xor_si128(x0, SCRYPT_ROTL(_mm_add_epi32(x3, x2), 18));
+        x1 = _mm_shuffle_epi32(x1, 0x93);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x39);
+        // Rows
+        x3 = _mm_xor_si128(x3, SCRYPT_ROTL(_mm_add_epi32(x0, x1), 7));
+        x2 = _mm_xor_si128(x2, SCRYPT_ROTL(_mm_add_epi32(x3, x0), 9));
+        x1 = _mm_xor_si128(x1, SCRYPT_ROTL(_mm_add_epi32(x2, x3), 13));
+        x0 = _mm_xor_si128(x0, SCRYPT_ROTL(_mm_add_epi32(x1, x2), 18));
+        x1 = _mm_shuffle_epi32(x1, 0x39);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x93);
+    }
+    x0 = _mm_add_epi32(x0, b0);
+    x1 = _mm_add_epi32(x1, b1);
+    x2 = _mm_add_epi32(x2, b2);
+    x3 = _mm_add_epi32(x3, b3);
+}
+
+#undef SCRYPT_ROTL
+
+// Y = BlockMix(B ^ mix), with mix optional. Even output blocks go to the
+// first half of Y, odd ones to the second.
+static void blockMix(const uint32_t* in, const uint32_t* mix, uint32_t* out, uint32_t r) {
+    const __m128i* b = reinterpret_cast<const __m128i*>(in);
+    const __m128i* m = reinterpret_cast<const __m128i*>(mix);
+    const size_t last = (2 * size_t(r) - 1) * 4;
+    __m128i x0 = _mm_loadu_si128(b + last), x1 = _mm_loadu_si128(b + last + 1);
+    __m128i x2 = _mm_loadu_si128(b + last + 2), x3 = _mm_loadu_si128(b + last + 3);
+    if (m) {
+        x0 = _mm_xor_si128(x0, _mm_loadu_si128(m + last));
+        x1 = _mm_xor_si128(x1, _mm_loadu_si128(m + last + 1));
+        x2 = _mm_xor_si128(x2, _mm_loadu_si128(m + last + 2));
+        x3 = _mm_xor_si128(x3, _mm_loadu_si128(m + last + 3));
+    }
+    for (size_t i = 0; i < 2 * size_t(r); ++i) {
+        __m128i y0 = _mm_loadu_si128(b + 4 * i), y1 = _mm_loadu_si128(b + 4 * i + 1);
+        __m128i y2 = _mm_loadu_si128(b + 4 * i + 2), y3 = _mm_loadu_si128(b + 4 * i + 3);
+        if (m) {
+            y0 = _mm_xor_si128(y0, _mm_loadu_si128(m + 4 * i));
+            y1 = _mm_xor_si128(y1, _mm_loadu_si128(m + 4 * i + 1));
+            y2 = _mm_xor_si128(y2, _mm_loadu_si128(m + 4 * i + 2));
+            y3 = _mm_xor_si128(y3, _mm_loadu_si128(m + 4 * i + 3));
+        }
+        x0 = _mm_xor_si128(x0, y0);
+        x1 = _mm_xor_si128(x1, y1);
+        x2 = _mm_xor_si128(x2, y2);
+        x3 = _mm_xor_si128(x3, y3);
+        salsa20_8(x0, x1, x2, x3);
+        __m128i* y = reinterpret_cast<__m128i*>(out + ((i & 1) * r + i / 2) * kBlockWords);
+        _mm_storeu_si128(y, x0);
+        _mm_storeu_si128(y + 1, x1);
+        _mm_storeu_si128(y + 2, x2);
+        _mm_storeu_si128(y + 3, x3);
+    }
+}
+
+#else
+
+static inline size_t slot(size_t i) { return i; }
+
+static inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+static void salsa20_8(uint32_t b[kBlockWords]) {
+    uint32_t x[kBlockWords];
+    std::copy(b, b + kBlockWords, x);
+    for (int i = 0; i < 8; i += 2) {
+        // Columns
+        x[4] ^= rotl(x[0] + x[12], 7);   x[8] ^= rotl(x[4] + x[0], 9);
+        x[12] ^= rotl(x[8] + x[4], 13);  x[0] ^= rotl(x[12] + x[8], 18);
+        x[9] ^= rotl(x[5] + x[1], 7);    x[13] ^= rotl(x[9] + x[5], 9);
+        x[1] ^= rotl(x[13] + x[9], 13);  x[5] ^= rotl(x[1] + x[13], 18);
+        x[14] ^= rotl(x[10] + x[6], 7);  x[2] ^= rotl(x[14] + x[10], 9);
+        x[6] ^= rotl(x[2] + x[14], 13);  x[10] ^= rotl(x[6] + x[2], 18);
+        x[3] ^= rotl(x[15] + x[11], 7);  x[7] ^= rotl(x[3] + x[15], 9);
+        x[11] ^= rotl(x[7] + x[3], 13);  x[15] ^= rotl(x[11] + x[7], 18);
+        // Rows
+        x[1] ^= rotl(x[0] + x[3], 7);    x[2] ^= rotl(x[1] + x[0], 9);
+        x[3] ^= rotl(x[2] + x[1], 13);   x[0] ^= rotl(x[3] + x[2], 18);
+        x[6] ^= rotl(x[5] + x[4], 7);    x[7] ^= rotl(x[6] + x[5], 9);
+        x[4] ^= rotl(x[7] + x[6], 13);   x[5] ^= rotl(x[4] + x[7], 18);
+        x[11] ^= rotl(x[10] + x[9], 7);  x[8] ^= rotl(x[11] + x[10], 9);
+        x[9] ^= rotl(x[8] + x[11], 13);  x[10] ^= rotl(x[9] + x[8], 18);
+        x[12] ^= rotl(x[15] + x[14], 7); x[13] ^= rotl(x[12] + x[15], 9);
+        x[14] ^= rotl(x[13] + x[12], 13); x[15] ^= rotl(x[14] + x[13], 18);
+    }
+    for (size_t i = 0; i < kBlockWords; ++i) b[i] += x[i];
+}
+
+// Y = BlockMix(B ^ mix), with mix optional. Even output blocks go to the
+// first half of Y, odd ones to the second.
+static void blockMix(const uint32_t* in, const uint32_t* mix, uint32_t* out, uint32_t r) {
+    uint32_t x[kBlockWords];
+    const size_t last = (2 * size_t(r) - 1) * kBlockWords;
+    for (size_t k = 0; k < kBlockWords; ++k) x[k] = in[last + k] ^ (mix ? mix[last + k] : 0);
+    for (size_t i = 0; i < 2 * size_t(r); ++i) {
+        const size_t at = i * kBlockWords;
+        for (size_t k = 0; k < kBlockWords; ++k) x[k] ^= in[at + k] ^ (mix ? mix[at + k] : 0);
+        salsa20_8(x);
+        std::copy(x, x + kBlockWords, out + ((i & 1) * r + i / 2) * kBlockWords);
+    }
+}
+
+#endif
+
+// RFC 7914 ROMix over one lane. `v` holds N blocks of 32r words, `xy` two.
+static void roMix(uint8_t* lane, uint32_t r, uint64_t N, uint32_t* v, uint32_t* xy) {
+    const size_t words = 32 * size_t(r);
+    uint32_t* x = xy;
+    uint32_t* y = xy + words;
+    for (size_t k = 0; k < words; ++k) {
+        x[k - k % kBlockWords + slot(k % kBlockWords)] = load32le(lane + 4 * k);
+    }
+
+    for (uint64_t i = 0; i < N; ++i) {
+        std::copy(x, x + words, v + i * words);
+        blockMix(x, nullptr, y, r);
+        std::swap(x, y);
+    }
+    const size_t tail = (2 * size_t(r) - 1) * kBlockWords;
+    for (uint64_t i = 0; i < N; ++i) {
+        // integerify(): the first 8 bytes of the last block, little-endian
+        const uint64_t j = (uint64_t(x[tail]) | (uint64_t(x[tail + slot(1)]) << 32)) & (N - 1);
+        blockMix(x, v + j * words, y, r);
+        std::swap(x, y);
+    }
+
+    for (size_t k = 0; k < words; ++k) {
+        store32le(lane + 4 * k, x[k - k % kBlockWords + slot(k % kBlockWords)]);
+    }
+}
+
+} // anonymous namespace
+
+ScryptStatus scrypt(const uint8_t* password, size_t passwordLen,
+                    const uint8_t* salt, size_t saltLen,
+                    const ScryptParams& params, size_t maxmem,
+                    uint8_t* out, size_t outLen,
+                    WorkStealingPool* pool) {
+    const uint64_t N = params.N;
+    const uint32_t r = params.r, p = params.p;
+    if (N < 2 || (N & (N - 1)) != 0 || r == 0 || p == 0 || uint64_t(r) * p >= (uint64_t(1) << 30))
+        return ScryptStatus::BadParams;
+
+    // One lane: the N-block table plus the two working blocks
+    const size_t laneWords = 32 * size_t(r);
+    if (N > std::numeric_limits<size_t>::max() / sizeof(uint32_t) / laneWords - 2)
+        return ScryptStatus::MemoryLimit;
+    const size_t scratchWords = (size_t(N) + 2) * laneWords;
+    const size_t scratchBytes = scratchWords * sizeof(uint32_t);
+    if (scratchBytes > maxmem) return ScryptStatus::MemoryLimit;
+
+    const size_t laneBytes = 4 * laneWords;
+    SecureBytes b(size_t(p) * laneBytes);
+    pbkdf2Sha256(password, passwordLen, salt, saltLen, 1, b.data(), b.size());
+
+    std::atomic<bool> outOfMemory{false};
+    const auto runLanes = [&](size_t begin, size_t end) {
+        std::unique_ptr<uint32_t[]> scratch(new (std::nothrow) uint32_t[scratchWords]);
+        if (!scratch) {
+            outOfMemory.store(true, std::memory_order_relaxed);
+            return;
+        }
+        uint32_t* v = scratch.get();
+        for (size_t lane = begin; lane < end; ++lane) {
+            roMix(b.data() + lane * laneBytes, r, N, v, v + size_t(N) * laneWords);
+        }
+        secureZero(v, scratchBytes);
+    };
+
+    if (!pool || p == 1) {
+        runLanes(0, p);
+    } else {
+        // As many lanes at once as maxmem allows, and no more than can run
+        const size_t wave = std::max<size_t>(1, std::min({size_t(p), maxmem / scratchBytes, pool->concurrency()}));
+        for (size_t start = 0; start < p && !outOfMemory.load(std::memory_order_relaxed); start += wave) {
+            const size_t count = std::min(wave, size_t(p) - start);
+            pool->parallelFor(count, 1, [&](size_t begin, size_t end) { runLanes(start + begin, start + end); });
+        }
+    }
+    if (outOfMemory.load(std::memory_order_relaxed)) return ScryptStatus::OutOfMemory;
+
+    pbkdf2Sha256(password, passwordLen, b.data(), b.size(), 1, out, outLen);
+    return ScryptStatus::Ok;
+}
+
+namespace {
+
+// Wall-clock time of one derivation with a fixed password and salt
+static double timeScrypt(const ScryptParams& params, size_t maxmem, WorkStealingPool* pool, ScryptStatus& status) {
+    static const uint8_t password[] = "calibrate";
+    static const uint8_t salt[16] = {};
+    uint8_t key[32];
+    const auto start = std::chrono::steady_clock::now();
+    status = scrypt(password, sizeof(password) - 1, salt, sizeof(salt), params, maxmem, key, sizeof(key), pool);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static size_t scratchBytes(uint64_t N, uint32_t r) { return (size_t(N) + 2) * 128 * size_t(r); }
+
+} // anonymous namespace
+
+ScryptStatus calibrateScrypt(const ScryptCalibration& limits, WorkStealingPool* pool,
+                             ScryptCalibrationResult& out) {
+    const ScryptParams floor = limits.floor;
+    const uint32_t r = floor.r;
+    if (floor.N < 2 || (floor.N & (floor.N - 1)) != 0 || r == 0 || floor.p == 0 ||
+        floor.N > limits.maxN || floor.p > limits.maxP || uint64_t(r) * limits.maxP >= (uint64_t(1) << 30))
+        return ScryptStatus::BadParams;
+    if (floor.N > std::numeric_limits<size_t>::max() / 128 / r - 2 || scratchBytes(floor.N, r) > limits.maxmem)
+        return ScryptStatus::MemoryLimit;
+
+    // Cost of one lane scales with N; time a small N and extrapolate
+    ScryptStatus status;
+    ScryptParams probe{std::min<uint64_t>(floor.N, uint64_t(1) << 14), r, 1};
+    double probeMs = timeScrypt(probe, limits.maxmem, nullptr, status);
+    if (status != ScryptStatus::Ok) return status;
+    probeMs = std::min(probeMs, timeScrypt(probe, limits.maxmem, nullptr, status));
+    const double msPerBlock = probeMs / double(probe.N);
+
+    uint64_t nCap = limits.maxN;
+    while (nCap > floor.N && scratchBytes(nCap, r) > limits.maxmem) nCap >>= 1;
+
+    ScryptParams pick = floor;
+    while (pick.N < nCap && msPerBlock * double(pick.N * 2) * double(pick.p) <= limits.targetMs) pick.N <<= 1;
+
+    // Lanes that really overlap: pool threads, cores and memory all bound it
+    size_t sideBySide = 1;
+    if (pool) {
+        const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+        sideBySide = std::max<size_t>(1, std::min({pool->concurrency(), cores, limits.maxmem / scratchBytes(pick.N, r)}));
+    }
+    const auto predictMs = [&](const ScryptParams& p) {
+        return msPerBlock * double(p.N) * double((p.p + sideBySide - 1) / sideBySide);
+    };
+    if (pick.N == nCap) {
+        while (pick.p < limits.maxP) {
+            ScryptParams next = pick;
+            next.p += 1;
+            if (predictMs(next) > limits.targetMs) break;
+            pick = next;
+        }
+    }
+
+    // Check the extrapolation; memory bandwidth can make large N dearer
+    // than the probe suggests
+    double measuredMs = timeScrypt(pick, limits.maxmem, pool, status);
+    if (status != ScryptStatus::Ok) return status;
+    while (measuredMs > limits.targetMs * 1.25 && (pick.p > floor.p || pick.N > floor.N)) {
+        if (pick.p > floor.p)
+            pick.p = std::max<uint32_t>(floor.p, pick.p > sideBySide ? uint32_t(pick.p - sideBySide) : 1);
+        else
+            pick.N >>= 1;
+        measuredMs = timeScrypt(pick, limits.maxmem, pool, status);
+        if (status != ScryptStatus::Ok) return status;
+    }
+
+    out.params = pick;
+    out.measuredMs = measuredMs;
+    return ScryptStatus::Ok;
+}
+
+const char* scryptBackend() {
+#if defined(__SSE2__) || defined(_M_X64)
+    return "sse2";
+#else
+    return "portable";
+#endif
+}
+
+} // namespace crypto
+} // namespace adapters
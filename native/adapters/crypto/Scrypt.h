@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+namespace crypto {
+
+class WorkStealingPool;
+
+struct ScryptParams {
+    uint64_t N = 1 << 15; // CPU/memory cost, a power of two
+    uint32_t r = 8;       // block size factor
+    uint32_t p = 1;       // parallel lanes
+};
+
+enum class ScryptStatus : uint8_t {
+    Ok,
+    BadParams,   // N not a power of two > 1, r or p zero, or r * p >= 2^30
+    MemoryLimit, // one lane needs more than maxmem
+    OutOfMemory,
+};
+
+/**
+ * RFC 7914 scrypt, byte-compatible with Node's crypto.scrypt().
+ *
+ * Each of the p lanes runs ROMix over its own 128 * r * N byte table, so
+ * lanes are independent and run side by side on `pool` (serially when it
+ * is null). `maxmem` bounds the tables alive at once: if p tables do not fit,
+ * the lanes run in waves of as many as do. Unlike Node, the limit is only
+ * an error when a single lane is over it.
+ *
+ * BlockMix uses SSE2 Salsa20/8 on x86-64 and portable C++ elsewhere; see
+ * scryptBackend(). The tables are wiped before they are freed.
+ */
+ScryptStatus scrypt(const uint8_t* password, size_t passwordLen,
+                    const uint8_t* salt, size_t saltLen,
+                    const ScryptParams& params, size_t maxmem,
+                    uint8_t* out, size_t outLen,
+                    WorkStealingPool* pool = nullptr);
+
+// Bounds for calibrateScrypt(). r is taken from `floor` and never changes.
+struct ScryptCalibration {
+    double targetMs = 250;                    // wall-clock budget for one derivation
+    size_t maxmem = 256u * 1024 * 1024;       // as passed to scrypt() when deriving
+    ScryptParams floor;                       // never return anything weaker
+    uint64_t maxN = uint64_t(1) << 20;
+    uint32_t maxP = 16;
+};
+
+struct ScryptCalibrationResult {
+    ScryptParams params;
+    double measuredMs = 0; // one derivation with `params` on this machine
+};
+
+/**
+ * Picks the strongest parameters that derive within targetMs here. N is
+ * raised first, as memory is what makes scrypt expensive to attack; p only
+ * grows once N is at maxN or the maxmem ceiling. Lanes the pool can run side
+ * by side are counted as free. The choice is timed once and stepped back if
+ * it overshoots the target by more than a quarter. On hardware too slow for
+ * `floor` the floor is returned as is. Takes roughly twice targetMs.
+ */
+ScryptStatus calibrateScrypt(const ScryptCalibration& limits, WorkStealingPool* pool,
+                             ScryptCalibrationResult& out);
+
+// "sse2" or "portable".
+const char* scryptBackend();
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,178 @@
+#include "SecureArena.h"
+#include "AesKeyBase.h"
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+static size_t systemPageSize() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    const long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+#endif
+}
+
+} // anonymous namespace
+
+SecureArena& SecureArena::instance() {
+    static SecureArena* arena = new SecureArena();
+    return *arena;
+}
+
+SecureArena::SecureArena(size_t bytes) : _pageSize(systemPageSize()) {
+    const size_t pages = (bytes + _pageSize - 1) / _pageSize;
+    if (pages == 0) return;
+    const size_t dataBytes = pages * _pageSize;
+    _mappedBytes = dataBytes + 2 * _pageSize;
+
+#if defined(_WIN32)
+    auto* mem = static_cast<uint8_t*>(VirtualAlloc(nullptr, _mappedBytes, MEM_RESERVE, PAGE_NOACCESS));
+    if (!mem) return;
+    if (!VirtualAlloc(mem + _pageSize, dataBytes, MEM_COMMIT, PAGE_READWRITE)) {
+        VirtualFree(mem, 0, MEM_RELEASE);
+        return;
+    }
+    _base = mem + _pageSize;
+    _locked = VirtualLock(_base, dataBytes) != 0;
+#else
+    void* mapped = mmap(nullptr, _mappedBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) return;
+    auto* mem = static_cast<uint8_t*>(mapped);
+    if (mprotect(mem + _pageSize, dataBytes, PROT_READ | PROT_WRITE) != 0) {
+        munmap(mem, _mappedBytes);
+        return;
+    }
+    _base = mem + _pageSize;
+#if defined(MADV_DONTDUMP)
+    _dumpExcluded = madvise(_base, dataBytes, MADV_DONTDUMP) == 0;
+#elif defined(MADV_NOCORE)
+    _dumpExcluded = madvise(_base, dataBytes, MADV_NOCORE) == 0;
+#endif
+    _locked = mlock(_base, dataBytes) == 0;
+#endif
+
+    _pages.resize(pages);
+    const size_t words = (_pageSize / kMinCell + 63) / 64;
+    for (Page& page : _pages) page.bits.assign(words, 0);
+}
+
+SecureArena::~SecureArena() {
+    if (!_base) return;
+    const size_t dataBytes = _pages.size() * _pageSize;
+    secureZero(_base, dataBytes);
+#if defined(_WIN32)
+    if (_locked) VirtualUnlock(_base, dataBytes);
+    VirtualFree(_base - _pageSize, 0, MEM_RELEASE);
+#else
+    if (_locked) munlock(_base, dataBytes);
+    munmap(_base - _pageSize, _mappedBytes);
+#endif
+}
+
+size_t SecureArena::cellSizeFor(size_t size) {
+    size_t cell = kMinCell;
+    while (cell < size) cell <<= 1;
+    return cell;
+}
+
+void* SecureArena::heapAllocate(size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_heapFallbacks;
+    }
+    return ::operator new(size);
+}
+
+void* SecureArena::allocate(size_t size) {
+    if (!_base || size > kMaxCell) return heapAllocate(size);
+    const size_t cell = cellSizeFor(size);
+    const size_t cells = _pageSize / cell;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    Page* target = nullptr;
+    Page* unassigned = nullptr;
+    for (Page& page : _pages) {
+        if (page.cellSize == cell && page.used < cells) {
+            target = &page;
+            break;
+        }
+        if (!unassigned && page.cellSize == 0) unassigned = &page;
+    }
+    if (!target) {
+        if (!unassigned) {
+            lock.unlock();
+            return heapAllocate(size);
+        }
+        target = unassigned;
+        target->cellSize = cell;
+    }
+
+    size_t index = 0;
+    for (size_t w = 0;; ++w) {
+        if (target->bits[w] != ~uint64_t(0)) {
+            uint64_t free = ~target->bits[w];
+            size_t bit = 0;
+            while ((free & 1) == 0) {
+                free >>= 1;
+                ++bit;
+            }
+            index = w * 64 + bit;
+            target->bits[w] |= uint64_t(1) << bit;
+            break;
+        }
+    }
+    ++target->used;
+    _inUse += cell;
+    if (_inUse > _peakInUse) _peakInUse = _inUse;
+    return _base + static_cast<size_t>(target - _pages.data()) * _pageSize + index * cell;
+}
+
+void SecureArena::deallocate(void* p, size_t size) noexcept {
+    if (!p) return;
+    if (!owns(p)) {
+        secureZero(p, size);
+        ::operator delete(p);
+        return;
+    }
+    const size_t offset = static_cast<size_t>(static_cast<uint8_t*>(p) - _base);
+    Page& page = _pages[offset / _pageSize];
+    // The cell stays reserved until its bit is cleared, so the wipe needs
+    // no lock; cellSize cannot change while the cell is live
+    const size_t cell = page.cellSize;
+    secureZero(p, cell);
+
+    const size_t index = (offset % _pageSize) / cell;
+    std::lock_guard<std::mutex> lock(_mutex);
+    page.bits[index / 64] &= ~(uint64_t(1) << (index % 64));
+    _inUse -= cell;
+    if (--page.used == 0) page.cellSize = 0;
+}
+
+SecureArena::Stats SecureArena::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats s;
+    s.locked = _locked;
+    s.dumpExcluded = _dumpExcluded;
+    s.pageSize = _pageSize;
+    s.capacity = _pages.size() * _pageSize;
+    s.inUse = _inUse;
+    s.peakInUse = _peakInUse;
+    s.heapFallbacks = _heapFallbacks;
+    return s;
+}
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace adapters {
+namespace crypto {
+
+/**
+ * Locked memory for key material, reserved once and carved into
+ * fixed-size cells.
+ *
+ * The arena maps its pages up front between two PROT_NONE guard pages,
+ * pins them with mlock() (VirtualLock() on Windows) and, on Linux, leaves
+ * them out of core dumps with MADV_DONTDUMP. Allocation never makes a
+ * syscall: each page serves one power-of-two cell size between kMinCell
+ * and kMaxCell (a slab), and a page returns to the free set when its last
+ * cell is released. Cells are wiped on free, so a fresh cell is always
+ * zero.
+ *
+ * Requests larger than kMaxCell, and requests made while the arena is
+ * full, come from the ordinary heap instead, wiped on free; stats() counts
+ * them. If the OS refuses to lock the pages (RLIMIT_MEMLOCK), the arena
+ * still serves cells with stats().locked false.
+ *
+ * Thread-safe.
+ */
+class SecureArena {
+public:
+    static constexpr size_t kMinCell = 32;
+    static constexpr size_t kMaxCell = 1024;
+    // 64 KiB fits the traditional RLIMIT_MEMLOCK default and Windows'
+    // default minimum working set
+    static constexpr size_t kDefaultBytes = 64 * 1024;
+
+    struct Stats {
+        bool locked = false;       // pages pinned in RAM
+        bool dumpExcluded = false; // pages left out of core dumps
+        size_t pageSize = 0;
+        size_t capacity = 0;       // bytes of cell pages
+        size_t inUse = 0;          // bytes in live cells
+        size_t peakInUse = 0;
+        uint64_t heapFallbacks = 0; // allocations the arena could not serve
+    };
+
+    // Process-wide arena of kDefaultBytes, mapped on first use and never
+    // unmapped, so static objects may release cells at exit.
+    static SecureArena& instance();
+
+    explicit SecureArena(size_t bytes = kDefaultBytes);
+    ~SecureArena();
+
+    SecureArena(const SecureArena&) = delete;
+    SecureArena& operator=(const SecureArena&) = delete;
+
+    // Never returns null; throws std::bad_alloc only if the heap fallback
+    // does. `size` must be passed back to deallocate().
+    void* allocate(size_t size);
+    void deallocate(void* p, size_t size) noexcept;
+
+    bool owns(const void* p) const {
+        const auto* b = static_cast<const uint8_t*>(p);
+        return _base && b >= _base && b < _base + _pages.size() * _pageSize;
+    }
+
+    Stats stats() const;
+
+private:
+    struct Page {
+        size_t cellSize = 0;         // 0: unassigned
+        size_t used = 0;
+        std::vector<uint64_t> bits;  // one per cell, set while allocated
+    };
+
+    static size_t cellSizeFor(size_t size);
+    void* heapAllocate(size_t size);
+
+    uint8_t* _base = nullptr; // first cell page, after the leading guard page
+    size_t _pageSize = 0;
+    size_t _mappedBytes = 0;  // cell pages plus both guard pages
+    bool _locked = false;
+    bool _dumpExcluded = false;
+
+    mutable std::mutex _mutex;
+    std::vector<Page> _pages;
+    size_t _inUse = 0;
+    size_t _peakInUse = 0;
+    uint64_t _heapFallbacks = 0;
+};
+
+} // namespace crypto
+} // namespace adapters
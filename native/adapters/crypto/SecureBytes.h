@@ -0,0 +1,94 @@
+#pragma once
+#include "AesKeyBase.h"
+#include "SecureArena.h"
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace adapters {
+namespace crypto {
+
+// std::allocator that wipes every block before releasing it, including the
+// old buffer when a vector grows.
+template <typename T>
+struct ZeroizingAllocator {
+    using value_type = T;
+
+    ZeroizingAllocator() noexcept = default;
+    template <typename U>
+    ZeroizingAllocator(const ZeroizingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) { return std::allocator<T>{}.allocate(n); }
+    void deallocate(T* p, size_t n) noexcept {
+        secureZero(p, n * sizeof(T));
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const ZeroizingAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const ZeroizingAllocator<U>&) const noexcept { return false; }
+};
+
+// Allocator backed by SecureArena::instance(): locked, dump-excluded cells
+// for blocks up to SecureArena::kMaxCell, the zeroizing heap above that.
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) { return static_cast<T*>(SecureArena::instance().allocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) noexcept { SecureArena::instance().deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+};
+
+// Byte buffer for plaintext: zeroized when freed or reallocated.
+using SecureBytes = std::vector<uint8_t, ZeroizingAllocator<uint8_t>>;
+
+// Byte buffer for keys and secrets: held in the secure arena.
+using KeyBytes = std::vector<uint8_t, ArenaAllocator<uint8_t>>;
+
+/**
+ * Sole owner of one T in a secure arena cell, value-initialized and wiped
+ * on destruction. For fixed-size key holders (std::array keys, option
+ * structs made of them) that would otherwise sit in a heap object or be
+ * copied through the stack. Move-only.
+ */
+template <typename T>
+class SecureBox {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "SecureBox holds plain key bytes");
+    static_assert(alignof(T) <= SecureArena::kMinCell, "arena cells are kMinCell-aligned");
+
+public:
+    SecureBox() : _value(new (SecureArena::instance().allocate(sizeof(T))) T()) {}
+    ~SecureBox() {
+        if (_value) SecureArena::instance().deallocate(_value, sizeof(T));
+    }
+
+    SecureBox(SecureBox&& other) noexcept : _value(std::exchange(other._value, nullptr)) {}
+    SecureBox& operator=(SecureBox&& other) noexcept {
+        std::swap(_value, other._value);
+        return *this;
+    }
+    SecureBox(const SecureBox&) = delete;
+    SecureBox& operator=(const SecureBox&) = delete;
+
+    T& operator*() const { return *_value; }
+    T* operator->() const { return _value; }
+
+private:
+    T* _value;
+};
+
+} // namespace crypto
+} // namespace adapters
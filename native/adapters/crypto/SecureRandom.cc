@@ -0,0 +1,56 @@
+#include "SecureRandom.h"
+#include "AesKeyBase.h"
+
+#if defined(_WIN32)
+#include <algorithm>
+#include <windows.h>
+#include <bcrypt.h>
+#elif defined(__APPLE__)
+#include <stdlib.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <sys/random.h>
+#else
+#include <cstdio>
+#endif
+
+namespace adapters {
+namespace crypto {
+
+bool secureRandom(uint8_t* out, size_t len) {
+#if defined(_WIN32)
+    // BCryptGenRandom takes a ULONG length
+    for (size_t done = 0; done < len;) {
+        const ULONG n = static_cast<ULONG>(std::min<size_t>(len - done, 0x7fffffff));
+        if (BCryptGenRandom(nullptr, out + done, n, BCRYPT_USE_SYSTEM_PREFERRED_RNG) != 0) {
+            secureZero(out, len);
+            return false;
+        }
+        done += n;
+    }
+    return true;
+#elif defined(__APPLE__)
+    arc4random_buf(out, len);
+    return true;
+#elif defined(__linux__)
+    for (size_t done = 0; done < len;) {
+        const ssize_t n = getrandom(out + done, len - done, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            secureZero(out, len);
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+#else
+    FILE* f = std::fopen("/dev/urandom", "rb");
+    const bool ok = f && std::fread(out, 1, len, f) == len;
+    if (f) std::fclose(f);
+    if (!ok) secureZero(out, len);
+    return ok;
+#endif
+}
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+namespace crypto {
+
+// Fills `out` from the OS CSPRNG: getrandom() on Linux, arc4random_buf()
+// on Apple, BCryptGenRandom() on Windows, /dev/urandom elsewhere. Returns
+// false (with `out` zeroed) if the source fails. std::random_device is not
+// used: its quality is implementation-defined, and GCM nonces must never
+// repeat.
+bool secureRandom(uint8_t* out, size_t len);
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,80 @@
+#include "SessionKeyring.h"
+#include <algorithm>
+#include <utility>
+
+namespace adapters {
+namespace crypto {
+
+SessionKeyring::~SessionKeyring() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+    if (_expiryThread.joinable()) _expiryThread.join();
+}
+
+void SessionKeyring::set(std::shared_ptr<const VaultKeys> keys, std::chrono::milliseconds ttl) {
+    std::shared_ptr<const VaultKeys> old;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        old = std::exchange(_keys, std::move(keys));
+        if (ttl.count() > 0) {
+            _expiresAt = Clock::now() + ttl;
+            if (!_expiryThread.joinable()) _expiryThread = std::thread([this] { expiryLoop(); });
+        } else {
+            _expiresAt.reset();
+        }
+    }
+    _cv.notify_all();
+    // `old` wipes the previous IKM here unless a batch still holds it
+}
+
+void SessionKeyring::clear() {
+    std::shared_ptr<const VaultKeys> old;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        old.swap(_keys);
+        _expiresAt.reset();
+    }
+    _cv.notify_all();
+}
+
+std::shared_ptr<const VaultKeys> SessionKeyring::get() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_expiresAt && Clock::now() >= *_expiresAt) return nullptr;
+    return _keys;
+}
+
+std::optional<std::chrono::milliseconds> SessionKeyring::remaining() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_keys || !_expiresAt) return std::nullopt;
+    const auto left = std::chrono::ceil<std::chrono::milliseconds>(*_expiresAt - Clock::now());
+    return std::max(left, std::chrono::milliseconds::zero());
+}
+
+void SessionKeyring::expiryLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop) {
+        if (!_expiresAt) {
+            _cv.wait(lock);
+            continue;
+        }
+        // set() may move the deadline while we wait, so re-read it each pass
+        const Clock::time_point deadline = *_expiresAt;
+        if (Clock::now() < deadline) {
+            _cv.wait_until(lock, deadline);
+            continue;
+        }
+        std::shared_ptr<const VaultKeys> expired;
+        expired.swap(_keys);
+        _expiresAt.reset();
+        // Release outside the lock: the last reference wipes the IKM
+        lock.unlock();
+        expired.reset();
+        lock.lock();
+    }
+}
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,65 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace adapters {
+namespace crypto {
+
+class VaultKeys;
+
+/**
+ * Holds one VaultKeys for a bounded window: the entry root a card tap
+ * produced, kept so that later decrypts in the same unlock window skip the
+ * reader.
+ *
+ * With a non-zero TTL a watchdog thread drops the keys at the deadline even
+ * if nothing asks for them again; get() also refuses keys past their
+ * deadline, so a late wake-up never extends the window. The IKM is wiped
+ * when the last snapshot is released (see VaultKeys), so a batch already
+ * running finishes on its own reference.
+ *
+ * The deadline runs on the steady clock, which does not advance while the
+ * machine sleeps on every platform; callers end the window on suspend.
+ *
+ * Thread-safe.
+ */
+class SessionKeyring {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SessionKeyring() = default;
+    ~SessionKeyring();
+
+    SessionKeyring(const SessionKeyring&) = delete;
+    SessionKeyring& operator=(const SessionKeyring&) = delete;
+
+    // Replaces the held keys. A zero ttl keeps them until clear(); the
+    // watchdog thread starts with the first non-zero ttl.
+    void set(std::shared_ptr<const VaultKeys> keys, std::chrono::milliseconds ttl);
+    void clear();
+
+    // Snapshot for one batch; null when none is held or it has expired.
+    std::shared_ptr<const VaultKeys> get() const;
+
+    // Time left in the window; nullopt when no keys are held or they do not
+    // expire.
+    std::optional<std::chrono::milliseconds> remaining() const;
+
+private:
+    void expiryLoop();
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::shared_ptr<const VaultKeys> _keys;
+    std::optional<Clock::time_point> _expiresAt;
+
+    std::thread _expiryThread;
+    bool _stop = false;
+};
+
+} // namespace crypto
+} // namespace adapters
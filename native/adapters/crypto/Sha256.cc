@@ -0,0 +1,193 @@
+#include "Sha256.h"
+#include "AesKeyBase.h"
+#include "Sha256Batch.h"
+#include "Sha256Kernels.h"
+#include <algorithm>
+#include <cstring>
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+static inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+static inline uint32_t load32be(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+static inline void store32be(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v >> 24);
+    p[1] = uint8_t(v >> 16);
+    p[2] = uint8_t(v >> 8);
+    p[3] = uint8_t(v);
+}
+
+} // anonymous namespace
+
+Sha256::~Sha256() {
+    secureZero(_h, sizeof(_h));
+    secureZero(_buffer, sizeof(_buffer));
+}
+
+void Sha256::reset() {
+    std::memcpy(_h, sha256kernels::IV, sizeof(_h));
+    _buffered = 0;
+    _length = 0;
+}
+
+void Sha256::compress(const uint8_t block[kBlockSize]) {
+    // SHA-NI when the CPU has it; AVX2 only pays off across several messages
+    static const auto kernel = sha256Kernel() == Sha256Kernel::ShaNi ? sha256kernels::compressShaNi
+                                                                     : sha256kernels::compressScalar;
+    kernel(_h, block);
+}
+
+namespace sha256kernels {
+
+void compressScalar(uint32_t h[8], const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) w[i] = load32be(block + 4 * i);
+    for (int i = 16; i < 64; ++i) {
+        const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+    uint32_t e = h[4], f = h[5], g = h[6], hh = h[7];
+    for (int i = 0; i < 64; ++i) {
+        const uint32_t t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+        const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        hh = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+    secureZero(w, sizeof(w));
+}
+
+} // namespace sha256kernels
+
+void Sha256::update(const uint8_t* data, size_t len) {
+    _length += len;
+    if (_buffered > 0) {
+        const size_t n = std::min(len, kBlockSize - _buffered);
+        std::memcpy(_buffer + _buffered, data, n);
+        _buffered += n;
+        data += n;
+        len -= n;
+        if (_buffered < kBlockSize) return;
+        compress(_buffer);
+        _buffered = 0;
+    }
+    for (; len >= kBlockSize; data += kBlockSize, len -= kBlockSize) compress(data);
+    if (len > 0) {
+        std::memcpy(_buffer, data, len);
+        _buffered = len;
+    }
+}
+
+void Sha256::final(uint8_t digest[kDigestSize]) {
+    const uint64_t bits = _length * 8;
+    uint8_t pad[kBlockSize + 8] = {0x80};
+    const size_t padLen = (_buffered < 56 ? 56 : 120) - _buffered;
+    for (int i = 0; i < 8; ++i) pad[padLen + i] = uint8_t(bits >> (56 - 8 * i));
+    update(pad, padLen + 8);
+    for (int i = 0; i < 8; ++i) store32be(digest + 4 * i, _h[i]);
+    secureZero(_h, sizeof(_h));
+    secureZero(_buffer, sizeof(_buffer));
+}
+
+HmacSha256::HmacSha256(const uint8_t* key, size_t keyLen) {
+    uint8_t block[Sha256::kBlockSize] = {};
+    if (keyLen > Sha256::kBlockSize) {
+        Sha256 h;
+        h.update(key, keyLen);
+        h.final(block);
+    } else if (keyLen > 0) {
+        std::memcpy(block, key, keyLen);
+    }
+    uint8_t pad[Sha256::kBlockSize];
+    for (size_t i = 0; i < sizeof(pad); ++i) pad[i] = block[i] ^ 0x36;
+    _inner.update(pad, sizeof(pad));
+    for (size_t i = 0; i < sizeof(pad); ++i) pad[i] = block[i] ^ 0x5c;
+    _outer.update(pad, sizeof(pad));
+    secureZero(block, sizeof(block));
+    secureZero(pad, sizeof(pad));
+}
+
+HmacSha256::~HmacSha256() = default; // Sha256 members zeroize themselves
+
+void HmacSha256::mac(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen,
+                     const uint8_t* c, size_t cLen, uint8_t out[Sha256::kDigestSize]) const {
+    uint8_t innerDigest[Sha256::kDigestSize];
+    Sha256 inner = _inner;
+    if (aLen) inner.update(a, aLen);
+    if (bLen) inner.update(b, bLen);
+    if (cLen) inner.update(c, cLen);
+    inner.final(innerDigest);
+
+    Sha256 outer = _outer;
+    outer.update(innerDigest, sizeof(innerDigest));
+    outer.final(out);
+    secureZero(innerDigest, sizeof(innerDigest));
+}
+
+void hkdfSha256(const uint8_t* salt, size_t saltLen,
+                const uint8_t* ikm, size_t ikmLen,
+                const uint8_t* info, size_t infoLen,
+                uint8_t* out, size_t outLen) {
+    // Extract: an empty salt is HashLen zero bytes, which HMAC pads to the
+    // same block as no key at all
+    uint8_t prk[Sha256::kDigestSize];
+    HmacSha256(salt, saltLen).mac(ikm, ikmLen, nullptr, 0, nullptr, 0, prk);
+
+    // Expand: T(i) = HMAC(PRK, T(i-1) | info | i)
+    HmacSha256 expand(prk, sizeof(prk));
+    uint8_t t[Sha256::kDigestSize];
+    size_t tLen = 0;
+    for (uint8_t counter = 1; outLen > 0 && counter != 0; ++counter) {
+        expand.mac(t, tLen, info, infoLen, &counter, 1, t);
+        tLen = sizeof(t);
+        const size_t n = std::min(outLen, sizeof(t));
+        std::memcpy(out, t, n);
+        out += n;
+        outLen -= n;
+    }
+    secureZero(prk, sizeof(prk));
+    secureZero(t, sizeof(t));
+}
+
+void pbkdf2Sha256(const uint8_t* password, size_t passwordLen,
+                  const uint8_t* salt, size_t saltLen, uint32_t iterations,
+                  uint8_t* out, size_t outLen) {
+    const HmacSha256 prf(password, passwordLen);
+    uint8_t u[Sha256::kDigestSize];
+    uint8_t t[Sha256::kDigestSize];
+    for (uint32_t block = 1; outLen > 0; ++block) {
+        uint8_t index[4];
+        store32be(index, block);
+        prf.mac(salt, saltLen, index, sizeof(index), nullptr, 0, u);
+        std::memcpy(t, u, sizeof(t));
+        for (uint32_t i = 1; i < iterations; ++i) {
+            prf.mac(u, sizeof(u), nullptr, 0, nullptr, 0, u);
+            for (size_t k = 0; k < sizeof(t); ++k) t[k] ^= u[k];
+        }
+        const size_t n = std::min(outLen, sizeof(t));
+        std::memcpy(out, t, n);
+        out += n;
+        outLen -= n;
+    }
+    secureZero(u, sizeof(u));
+    secureZero(t, sizeof(t));
+}
+
+} // namespace crypto
+} // namespace adapters
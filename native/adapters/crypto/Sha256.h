@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+namespace crypto {
+
+/**
+ * FIPS 180-4 SHA-256, portable C++. Incremental: update() any number of
+ * times, then final(). The state is zeroized by final() and on destruction.
+ */
+class Sha256 {
+public:
+    static constexpr size_t kDigestSize = 32;
+    static constexpr size_t kBlockSize = 64;
+
+    Sha256() { reset(); }
+    ~Sha256();
+
+    void reset();
+    void update(const uint8_t* data, size_t len);
+    void final(uint8_t digest[kDigestSize]);
+
+private:
+    void compress(const uint8_t block[kBlockSize]);
+
+    uint32_t _h[8];
+    uint8_t _buffer[kBlockSize];
+    size_t _buffered = 0;
+    uint64_t _length = 0; // bytes hashed so far
+};
+
+/**
+ * RFC 2104 HMAC-SHA256. The padded inner and outer key states are computed
+ * once at construction, so one object can MAC many messages under the same
+ * key: each mac() costs two compressions plus the message.
+ */
+class HmacSha256 {
+public:
+    HmacSha256(const uint8_t* key, size_t keyLen);
+    ~HmacSha256();
+
+    HmacSha256(const HmacSha256&) = delete;
+    HmacSha256& operator=(const HmacSha256&) = delete;
+
+    // One-shot MAC over the concatenation of up to three segments.
+    void mac(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen,
+             const uint8_t* c, size_t cLen, uint8_t out[Sha256::kDigestSize]) const;
+
+private:
+    Sha256 _inner; // state after the ipad block
+    Sha256 _outer; // state after the opad block
+};
+
+// RFC 5869 HKDF-SHA256: Extract(salt, ikm) then Expand(prk, info, outLen).
+// outLen may be at most 255 * 32 bytes. The PRK never leaves this call.
+void hkdfSha256(const uint8_t* salt, size_t saltLen,
+                const uint8_t* ikm, size_t ikmLen,
+                const uint8_t* info, size_t infoLen,
+                uint8_t* out, size_t outLen);
+
+// RFC 8018 PBKDF2-HMAC-SHA256. scrypt uses it with one iteration to spread
+// the password over its lanes and to fold them back into the key.
+void pbkdf2Sha256(const uint8_t* password, size_t passwordLen,
+                  const uint8_t* salt, size_t saltLen, uint32_t iterations,
+                  uint8_t* out, size_t outLen);
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,197 @@
+#include "Sha256Batch.h"
+#include "AesKeyBase.h"
+#include "CryptoProviderFactory.h"
+#include "Sha256Kernels.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+constexpr size_t kLanes = 8;
+constexpr size_t kBlock = Sha256::kBlockSize;
+
+static inline void store32be(uint8_t* p, uint32_t v) {
+    p[0] = uint8_t(v >> 24);
+    p[1] = uint8_t(v >> 16);
+    p[2] = uint8_t(v >> 8);
+    p[3] = uint8_t(v);
+}
+
+static inline void store64be(uint8_t* p, uint64_t v) {
+    store32be(p, uint32_t(v >> 32));
+    store32be(p + 4, uint32_t(v));
+}
+
+// One block into each of `count` (at most kLanes) states
+static void compressLanes(Sha256Kernel kernel, uint32_t (*h)[8], const uint8_t* const* blocks, size_t count) {
+    if (kernel == Sha256Kernel::Avx2 && count > 1) {
+        if (count == kLanes) {
+            sha256kernels::compressAvx2x8(h, blocks);
+            return;
+        }
+        // Fill the idle lanes with copies of lane 0 and drop their results
+        uint32_t state[kLanes][8];
+        const uint8_t* in[kLanes];
+        for (size_t i = 0; i < kLanes; ++i) {
+            std::memcpy(state[i], h[i < count ? i : 0], sizeof(state[i]));
+            in[i] = blocks[i < count ? i : 0];
+        }
+        sha256kernels::compressAvx2x8(state, in);
+        for (size_t i = 0; i < count; ++i) std::memcpy(h[i], state[i], sizeof(state[i]));
+        secureZero(state, sizeof(state));
+        return;
+    }
+    const auto one = kernel == Sha256Kernel::ShaNi ? sha256kernels::compressShaNi : sha256kernels::compressScalar;
+    for (size_t i = 0; i < count; ++i) one(h[i], blocks[i]);
+}
+
+// HMAC over up to kLanes keys and one shared message
+static void hmacLanes(Sha256Kernel kernel, const uint8_t* const* keys, const size_t* keyLens, size_t count,
+                      const uint8_t* msg, size_t msgLen, uint8_t (*out)[Sha256::kDigestSize]) {
+    uint8_t key[kLanes][kBlock];
+    uint8_t pad[kLanes][kBlock];
+    uint32_t inner[kLanes][8], outer[kLanes][8];
+    const uint8_t* blocks[kLanes];
+
+    for (size_t i = 0; i < count; ++i) {
+        std::memset(key[i], 0, kBlock);
+        if (keyLens[i] > kBlock) {
+            Sha256 h;
+            h.update(keys[i], keyLens[i]);
+            h.final(key[i]);
+        } else if (keyLens[i] > 0) {
+            std::memcpy(key[i], keys[i], keyLens[i]);
+        }
+    }
+
+    // Inner hash: ipad block, then the message blocks every lane shares
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t k = 0; k < kBlock; ++k) pad[i][k] = key[i][k] ^ 0x36;
+        std::memcpy(inner[i], sha256kernels::IV, sizeof(inner[i]));
+        blocks[i] = pad[i];
+    }
+    compressLanes(kernel, inner, blocks, count);
+
+    size_t offset = 0;
+    for (; msgLen - offset >= kBlock; offset += kBlock) {
+        std::fill(blocks, blocks + count, msg + offset);
+        compressLanes(kernel, inner, blocks, count);
+    }
+    uint8_t tail[2 * kBlock] = {};
+    const size_t rest = msgLen - offset;
+    if (rest > 0) std::memcpy(tail, msg + offset, rest);
+    tail[rest] = 0x80;
+    const size_t tailLen = rest < kBlock - 8 ? kBlock : 2 * kBlock;
+    store64be(tail + tailLen - 8, (uint64_t(kBlock) + msgLen) * 8);
+    for (size_t at = 0; at < tailLen; at += kBlock) {
+        std::fill(blocks, blocks + count, tail + at);
+        compressLanes(kernel, inner, blocks, count);
+    }
+
+    // Outer hash: opad block, then the inner digest in one padded block
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t k = 0; k < kBlock; ++k) pad[i][k] = key[i][k] ^ 0x5c;
+        std::memcpy(outer[i], sha256kernels::IV, sizeof(outer[i]));
+        blocks[i] = pad[i];
+    }
+    compressLanes(kernel, outer, blocks, count);
+    for (size_t i = 0; i < count; ++i) {
+        std::memset(pad[i], 0, kBlock);
+        for (size_t w = 0; w < 8; ++w) store32be(pad[i] + 4 * w, inner[i][w]);
+        pad[i][Sha256::kDigestSize] = 0x80;
+        store64be(pad[i] + kBlock - 8, (kBlock + Sha256::kDigestSize) * 8);
+    }
+    compressLanes(kernel, outer, blocks, count);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t w = 0; w < 8; ++w) store32be(out[i] + 4 * w, outer[i][w]);
+    }
+
+    secureZero(key, sizeof(key));
+    secureZero(pad, sizeof(pad));
+    secureZero(inner, sizeof(inner));
+    secureZero(outer, sizeof(outer));
+    secureZero(tail, sizeof(tail));
+}
+
+} // anonymous namespace
+
+bool sha256KernelAvailable(Sha256Kernel kernel) {
+    // CPUID once: it traps to the hypervisor under virtualization
+    static const bool haveShaNi = sha256kernels::x86KernelsCompiledIn() && cpuSupportsShaNi();
+    static const bool haveAvx2 = sha256kernels::x86KernelsCompiledIn() && cpuSupportsAvx2();
+    switch (kernel) {
+    case Sha256Kernel::Scalar: return true;
+    case Sha256Kernel::ShaNi: return haveShaNi;
+    case Sha256Kernel::Avx2: return haveAvx2;
+    }
+    return false;
+}
+
+Sha256Kernel sha256Kernel() {
+    static const Sha256Kernel kernel = [] {
+        const char* pinned = std::getenv("SECUREPASS_CRYPTO");
+        if (pinned && std::strcmp(pinned, "portable") == 0) return Sha256Kernel::Scalar;
+        if (sha256KernelAvailable(Sha256Kernel::ShaNi)) return Sha256Kernel::ShaNi;
+        if (sha256KernelAvailable(Sha256Kernel::Avx2)) return Sha256Kernel::Avx2;
+        return Sha256Kernel::Scalar;
+    }();
+    return kernel;
+}
+
+const char* sha256KernelName(Sha256Kernel kernel) {
+    switch (kernel) {
+    case Sha256Kernel::Scalar: return "scalar";
+    case Sha256Kernel::ShaNi: return "sha-ni";
+    case Sha256Kernel::Avx2: return "avx2";
+    }
+    return "scalar";
+}
+
+void hmacSha256Batch(const uint8_t* const* keys, const size_t* keyLens, size_t count,
+                     const uint8_t* msg, size_t msgLen, uint8_t (*out)[Sha256::kDigestSize],
+                     Sha256Kernel kernel) {
+    if (!sha256KernelAvailable(kernel)) kernel = Sha256Kernel::Scalar;
+    for (size_t base = 0; base < count; base += kLanes) {
+        const size_t n = std::min(kLanes, count - base);
+        hmacLanes(kernel, keys + base, keyLens + base, n, msg, msgLen, out + base);
+    }
+}
+
+void hkdfSha256Batch(const uint8_t* const* salts, const size_t* saltLens, size_t count,
+                     const uint8_t* ikm, size_t ikmLen, const uint8_t* info, size_t infoLen,
+                     uint8_t (*out)[Sha256::kDigestSize], Sha256Kernel kernel) {
+    if (!sha256KernelAvailable(kernel)) kernel = Sha256Kernel::Scalar;
+
+    // Expand with a 32-byte output is a single HMAC over info | 0x01
+    uint8_t shortInfo[kBlock];
+    std::vector<uint8_t> longInfo;
+    uint8_t* expandMsg = shortInfo;
+    if (infoLen >= sizeof(shortInfo)) {
+        longInfo.resize(infoLen + 1);
+        expandMsg = longInfo.data();
+    }
+    if (infoLen > 0) std::memcpy(expandMsg, info, infoLen);
+    expandMsg[infoLen] = 1;
+
+    uint8_t prk[kLanes][Sha256::kDigestSize];
+    const uint8_t* prkKeys[kLanes];
+    size_t prkLens[kLanes];
+    for (size_t i = 0; i < kLanes; ++i) {
+        prkKeys[i] = prk[i];
+        prkLens[i] = sizeof(prk[i]);
+    }
+    for (size_t base = 0; base < count; base += kLanes) {
+        const size_t n = std::min(kLanes, count - base);
+        hmacLanes(kernel, salts + base, saltLens + base, n, ikm, ikmLen, prk);
+        hmacLanes(kernel, prkKeys, prkLens, n, expandMsg, infoLen + 1, out + base);
+    }
+    secureZero(prk, sizeof(prk));
+}
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,46 @@
+#pragma once
+#include "Sha256.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+namespace crypto {
+
+enum class Sha256Kernel : uint8_t {
+    Scalar, // portable C++, one message at a time
+    ShaNi,  // SHA extensions, one message at a time
+    Avx2,   // eight messages at once, one per 32-bit lane
+};
+
+// Best kernel this CPU supports, chosen once: SHA-NI, then AVX2, then
+// scalar. SECUREPASS_CRYPTO=portable pins it to scalar, like the AES backend.
+Sha256Kernel sha256Kernel();
+
+// "scalar", "sha-ni" or "avx2".
+const char* sha256KernelName(Sha256Kernel kernel);
+
+// False if this build or CPU cannot run `kernel`.
+bool sha256KernelAvailable(Sha256Kernel kernel);
+
+/**
+ * HMAC-SHA256 of one message under `count` independent keys:
+ * out[i] = HMAC(keys[i], msg). Every key is padded to the same block, so all
+ * messages have the same block structure and the kernel can compress them
+ * in lockstep, eight at a time with AVX2. Keys over 64 bytes are hashed
+ * first, one at a time.
+ */
+void hmacSha256Batch(const uint8_t* const* keys, const size_t* keyLens, size_t count,
+                     const uint8_t* msg, size_t msgLen, uint8_t (*out)[Sha256::kDigestSize],
+                     Sha256Kernel kernel = sha256Kernel());
+
+/**
+ * 32-byte HKDF-SHA256 for `count` salts sharing ikm and info:
+ * out[i] == hkdfSha256(salts[i], ikm, info, 32). This is the vault's
+ * per-entry key derivation, with the entry id as salt.
+ */
+void hkdfSha256Batch(const uint8_t* const* salts, const size_t* saltLens, size_t count,
+                     const uint8_t* ikm, size_t ikmLen, const uint8_t* info, size_t infoLen,
+                     uint8_t (*out)[Sha256::kDigestSize], Sha256Kernel kernel = sha256Kernel());
+
+} // namespace crypto
+} // namespace adapters
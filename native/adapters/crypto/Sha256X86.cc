@@ -0,0 +1,153 @@
+// Built with -msha -msse4.1 -mssse3 -mavx2 on GCC/Clang x86 (see
+// CMakeLists.txt); MSVC exposes the intrinsics without extra flags. Nothing
+// here runs unless CPUID reported the instructions (Sha256Batch.cc).
+#include "Sha256Kernels.h"
+#include "AesKeyBase.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SECUREPASS_SHA_X86 1
+#include <immintrin.h>
+#endif
+
+namespace adapters {
+namespace crypto {
+namespace sha256kernels {
+
+#ifdef SECUREPASS_SHA_X86
+
+bool x86KernelsCompiledIn() { return true; }
+
+// ─── SHA-NI ──────────────────────────────────────────────────────────────────
+
+void compressShaNi(uint32_t h[8], const uint8_t* block) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+
+    // The round instructions take the state as ABEF / CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h)), 0xB1);      // CDAB
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + 4)), 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);                                                    // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                                         // CDGH
+    const __m128i abefStart = state0, cdghStart = state1;
+
+    __m128i msg[4];
+    for (int i = 0; i < 16; ++i) {
+        __m128i& w = msg[i & 3];
+        if (i < 4) {
+            w = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i)), byteSwap);
+        } else {
+            // W[4i..4i+3] from the previous sixteen words
+            w = _mm_sha256msg1_epu32(w, msg[(i + 1) & 3]);
+            w = _mm_add_epi32(w, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+            w = _mm_sha256msg2_epu32(w, msg[(i + 3) & 3]);
+        }
+        __m128i wk = _mm_add_epi32(w, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 4 * i)));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+        wk = _mm_shuffle_epi32(wk, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+    }
+
+    state0 = _mm_add_epi32(state0, abefStart);
+    state1 = _mm_add_epi32(state1, cdghStart);
+    tmp = _mm_shuffle_epi32(state0, 0x1B);      // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);   // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);    // HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h + 4), state1);
+}
+
+// ─── AVX2, eight messages ────────────────────────────────────────────────────
+
+namespace {
+
+// Rows in, columns out: r[j] word i becomes r[i] word j
+static inline void transpose8(__m256i r[8]) {
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+static inline __m256i rotr(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+static inline __m256i add(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+static inline __m256i xor3(__m256i a, __m256i b, __m256i c) {
+    return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+} // anonymous namespace
+
+void compressAvx2x8(uint32_t (*h)[8], const uint8_t* const blocks[8]) {
+    const __m256i byteSwap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    // w[t] holds message word t of all eight blocks
+    __m256i w[16];
+    for (int half = 0; half < 2; ++half) {
+        __m256i* rows = w + 8 * half;
+        for (int lane = 0; lane < 8; ++lane) {
+            rows[lane] = _mm256_shuffle_epi8(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[lane] + 32 * half)), byteSwap);
+        }
+        transpose8(rows);
+    }
+
+    __m256i s[8];
+    for (int lane = 0; lane < 8; ++lane) s[lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h[lane]));
+    transpose8(s);
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], hh = s[7];
+
+    for (int t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            const __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+            const __m256i s0 = xor3(rotr(w15, 7), rotr(w15, 18), _mm256_srli_epi32(w15, 3));
+            const __m256i s1 = xor3(rotr(w2, 17), rotr(w2, 19), _mm256_srli_epi32(w2, 10));
+            w[t & 15] = add(add(w[t & 15], s0), add(w[(t - 7) & 15], s1));
+        }
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i t1 = add(add(hh, xor3(rotr(e, 6), rotr(e, 11), rotr(e, 25))),
+                               add(add(ch, _mm256_set1_epi32(static_cast<int>(K[t]))), w[t & 15]));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        const __m256i t2 = add(xor3(rotr(a, 2), rotr(a, 13), rotr(a, 22)), maj);
+        hh = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, t2);
+    }
+
+    s[0] = add(s[0], a); s[1] = add(s[1], b); s[2] = add(s[2], c); s[3] = add(s[3], d);
+    s[4] = add(s[4], e); s[5] = add(s[5], f); s[6] = add(s[6], g); s[7] = add(s[7], hh);
+    transpose8(s);
+    for (int lane = 0; lane < 8; ++lane) _mm256_storeu_si256(reinterpret_cast<__m256i*>(h[lane]), s[lane]);
+
+    secureZero(w, sizeof(w));
+}
+
+#else
+
+bool x86KernelsCompiledIn() { return false; }
+void compressShaNi(uint32_t[8], const uint8_t*) {}
+void compressAvx2x8(uint32_t (*)[8], const uint8_t* const[8]) {}
+
+#endif
+
+} // namespace sha256kernels
+} // namespace crypto
+} // namespace adapters
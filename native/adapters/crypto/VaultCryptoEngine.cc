@@ -0,0 +1,289 @@
+#include "VaultCryptoEngine.h"
+#include "CryptoProviderFactory.h"
+#include "SecureRandom.h"
+#include "Sha256.h"
+#include "Sha256Batch.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+namespace adapters {
+namespace crypto {
+
+namespace {
+
+constexpr char ENTRY_KEY_INFO[] = "pwmgr-entry-v1";
+constexpr size_t GCM_IV_SIZE = 12;
+
+// Collects the next kKeyBatch jobs from [i, end) that `live` accepts,
+// advancing i past them. Returns how many were found.
+template <typename Job, typename Live>
+static size_t nextKeyGroup(std::vector<Job>& jobs, size_t& i, size_t end, Live live,
+                           const std::string* (&ids)[VaultCryptoEngine::kKeyBatch],
+                           size_t (&index)[VaultCryptoEngine::kKeyBatch]) {
+    size_t n = 0;
+    for (; i < end && n < VaultCryptoEngine::kKeyBatch; ++i) {
+        if (!live(jobs[i])) continue;
+        ids[n] = &jobs[i].entryId;
+        index[n++] = i;
+    }
+    return n;
+}
+
+// One group's entry keys, in a secure arena cell (wiped when released)
+struct EntryKeyGroup {
+    uint8_t keys[VaultCryptoEngine::kKeyBatch][VaultKeys::kEntryKeySize];
+};
+
+// Calls fn(job, entryKey) for every job in [begin, end) that `live` accepts,
+// deriving the keys kKeyBatch at a time.
+template <typename Job, typename Live, typename Fn>
+static void withEntryKeys(const VaultKeys& keys, std::vector<Job>& jobs, size_t begin, size_t end,
+                          Live live, Fn fn) {
+    SecureBox<EntryKeyGroup> group;
+    const std::string* ids[VaultCryptoEngine::kKeyBatch];
+    size_t index[VaultCryptoEngine::kKeyBatch];
+    for (size_t i = begin, n; (n = nextKeyGroup(jobs, i, end, live, ids, index)) > 0;) {
+        keys.deriveEntryKeys(ids, n, group->keys);
+        for (size_t k = 0; k < n; ++k) fn(index[k], group->keys[k]);
+    }
+}
+
+// One entry key, in a secure arena cell
+struct EntryKey {
+    uint8_t bytes[VaultKeys::kEntryKeySize];
+};
+
+static std::unique_ptr<ChunkedKey> chunkedKey(const VaultKeys& keys, const std::string& blobId,
+                                              const ChunkedHeader& header) {
+    SecureBox<EntryKey> entryKey;
+    keys.deriveEntryKey(blobId, entryKey->bytes);
+    return std::make_unique<ChunkedKey>(entryKey->bytes, sizeof(entryKey->bytes), header);
+}
+
+// Chunks `len` plaintext bytes make: whole chunks only unless `final`,
+// where the last one takes the rest. 0 when they do not split.
+static size_t plainChunkCount(size_t len, size_t chunkSize, bool final) {
+    if (!final) return len > 0 && len % chunkSize == 0 ? len / chunkSize : 0;
+    return len == 0 ? 1 : (len + chunkSize - 1) / chunkSize;
+}
+
+// Chunks in `len` sealed bytes. A final chunk may be short, down to a bare
+// tag, so a blob ending on a full chunk differs from one with an empty
+// final chunk after it. 0 when they do not split.
+static size_t sealedChunkCount(size_t len, size_t sealedChunkSize, bool final) {
+    if (!final) return len > 0 && len % sealedChunkSize == 0 ? len / sealedChunkSize : 0;
+    if (len < kChunkTagSize) return 0;
+    const size_t whole = (len - kChunkTagSize) / sealedChunkSize;
+    return len - whole * sealedChunkSize <= sealedChunkSize ? whole + 1 : 0;
+}
+
+} // anonymous namespace
+
+VaultKeys::VaultKeys(const uint8_t* cardSecret, size_t cardLen, const uint8_t* machineSecret, size_t machineLen) {
+    _ikm.reserve(cardLen + machineLen);
+    _ikm.insert(_ikm.end(), cardSecret, cardSecret + cardLen);
+    _ikm.insert(_ikm.end(), machineSecret, machineSecret + machineLen);
+}
+
+void VaultKeys::deriveEntryKey(const std::string& entryId, uint8_t out[kEntryKeySize]) const {
+    hkdfSha256(reinterpret_cast<const uint8_t*>(entryId.data()), entryId.size(),
+               _ikm.data(), _ikm.size(),
+               reinterpret_cast<const uint8_t*>(ENTRY_KEY_INFO), sizeof(ENTRY_KEY_INFO) - 1,
+               out, kEntryKeySize);
+}
+
+void VaultKeys::deriveEntryKeys(const std::string* const* entryIds, size_t count,
+                                uint8_t (*out)[kEntryKeySize]) const {
+    static_assert(kEntryKeySize == Sha256::kDigestSize, "one HKDF expand block per entry key");
+    constexpr size_t kChunk = 64;
+    const uint8_t* salts[kChunk];
+    size_t saltLens[kChunk];
+    for (size_t base = 0; base < count; base += kChunk) {
+        const size_t n = std::min(kChunk, count - base);
+        for (size_t i = 0; i < n; ++i) {
+            salts[i] = reinterpret_cast<const uint8_t*>(entryIds[base + i]->data());
+            saltLens[i] = entryIds[base + i]->size();
+        }
+        hkdfSha256Batch(salts, saltLens, n, _ikm.data(), _ikm.size(),
+                        reinterpret_cast<const uint8_t*>(ENTRY_KEY_INFO), sizeof(ENTRY_KEY_INFO) - 1,
+                        out + base);
+    }
+}
+
+VaultCryptoEngine::VaultCryptoEngine(std::shared_ptr<const core::ports::ICryptoProvider> provider, size_t threads)
+    : _provider(provider ? std::move(provider) : createCryptoProvider()), _threads(threads) {}
+
+WorkStealingPool& VaultCryptoEngine::pool() const {
+    std::call_once(_poolOnce, [this] { _pool = std::make_unique<WorkStealingPool>(_threads); });
+    return *_pool;
+}
+
+void VaultCryptoEngine::forEachChunk(size_t count, const std::function<void(size_t, size_t)>& fn,
+                                     size_t grain) const {
+    if (_threads == 1 || count < grain * 2) {
+        if (count > 0) fn(0, count);
+        return;
+    }
+    pool().parallelFor(count, grain, fn);
+}
+
+void VaultCryptoEngine::setKeys(const uint8_t* cardSecret, size_t cardLen,
+                                const uint8_t* machineSecret, size_t machineLen,
+                                std::chrono::milliseconds ttl) {
+    _keys.set(std::make_shared<const VaultKeys>(cardSecret, cardLen, machineSecret, machineLen), ttl);
+}
+
+void VaultCryptoEngine::clearKeys() {
+    _keys.clear();
+}
+
+std::shared_ptr<const VaultKeys> VaultCryptoEngine::keys() const {
+    return _keys.get();
+}
+
+bool VaultCryptoEngine::seal(const VaultKeys& keys, std::vector<SealJob>& jobs) const {
+    // One CSPRNG call covers every nonce in the batch
+    std::vector<uint8_t> nonces(jobs.size() * GCM_IV_SIZE);
+    if (!nonces.empty() && !secureRandom(nonces.data(), nonces.size())) return false;
+
+    forEachChunk(jobs.size(), [&](size_t begin, size_t end) {
+        withEntryKeys(keys, jobs, begin, end, [](const SealJob&) { return true; },
+                      [&](size_t i, const uint8_t* entryKey) {
+            SealJob& job = jobs[i];
+            std::memcpy(job.iv.data(), nonces.data() + i * GCM_IV_SIZE, GCM_IV_SIZE);
+            const auto aes = _provider->createAesKey(entryKey, VaultKeys::kEntryKeySize);
+            job.ciphertext.resize(job.plaintext.size());
+            aes->gcmSeal(job.iv.data(), nullptr, 0, job.plaintext.data(), job.ciphertext.data(),
+                         job.plaintext.size(), job.tag.data());
+        });
+    });
+    return true;
+}
+
+void VaultCryptoEngine::open(const VaultKeys& keys, std::vector<OpenJob>& jobs) const {
+    forEachChunk(jobs.size(), [&](size_t begin, size_t end) {
+        withEntryKeys(keys, jobs, begin, end, [](const OpenJob& job) { return job.status == VaultStatus::Ok; },
+                      [&](size_t i, const uint8_t* entryKey) {
+            OpenJob& job = jobs[i];
+            const auto aes = _provider->createAesKey(entryKey, VaultKeys::kEntryKeySize);
+            job.plaintext.resize(job.ciphertext.size());
+            if (!aes->gcmOpen(job.iv.data(), nullptr, 0, job.ciphertext.data(), job.plaintext.data(),
+                              job.ciphertext.size(), job.tag.data())) {
+                job.plaintext.clear();
+                job.status = VaultStatus::AuthFailed;
+            }
+        });
+    });
+}
+
+void VaultCryptoEngine::openFields(const VaultKeys& keys, std::vector<FieldsJob>& jobs, uint32_t mask) const {
+    forEachChunk(jobs.size(), [&](size_t begin, size_t end) {
+        SecureBytes plaintext; // reused across the chunk, wiped on release
+        withEntryKeys(keys, jobs, begin, end, [](const FieldsJob& job) { return job.status == VaultStatus::Ok; },
+                      [&](size_t i, const uint8_t* entryKey) {
+            FieldsJob& job = jobs[i];
+            const auto aes = _provider->createAesKey(entryKey, VaultKeys::kEntryKeySize);
+            plaintext.resize(job.ciphertext.size());
+            if (!aes->gcmOpen(job.iv.data(), nullptr, 0, job.ciphertext.data(), plaintext.data(),
+                              job.ciphertext.size(), job.tag.data())) {
+                job.status = VaultStatus::AuthFailed;
+                return;
+            }
+            if (!readEntryFields(plaintext.data(), plaintext.size(), mask, job.fields))
+                job.status = VaultStatus::Malformed;
+            secureZero(plaintext.data(), plaintext.size());
+        });
+    });
+}
+
+VaultStatus VaultCryptoEngine::sealChunks(const VaultKeys& keys, const std::string& blobId,
+                                          const ChunkedHeader& header, uint32_t firstIndex,
+                                          const uint8_t* in, size_t len, bool final,
+                                          std::vector<uint8_t>& out) const {
+    const size_t unit = header.chunkSize;
+    const size_t count = plainChunkCount(len, unit, final);
+    if (count == 0 || count - 1 > UINT32_MAX - firstIndex) return VaultStatus::BadInput;
+
+    const auto key = chunkedKey(keys, blobId, header);
+    const size_t base = out.size();
+    out.resize(base + len + count * kChunkTagSize);
+    forEachChunk(count, [&](size_t begin, size_t end) {
+        const auto aes = key->createAesKey(*_provider);
+        for (size_t i = begin; i < end; ++i) {
+            const size_t chunkLen = std::min(unit, len - i * unit);
+            key->seal(*aes, static_cast<uint32_t>(firstIndex + i), final && i == count - 1, in + i * unit,
+                      chunkLen, out.data() + base + i * (unit + kChunkTagSize));
+        }
+    }, kBlobChunkGrain);
+    return VaultStatus::Ok;
+}
+
+VaultStatus VaultCryptoEngine::openChunks(const VaultKeys& keys, const std::string& blobId,
+                                          const ChunkedHeader& header, uint32_t firstIndex,
+                                          const uint8_t* in, size_t len, bool final, SecureBytes& out) const {
+    const size_t unit = header.sealedChunkSize();
+    const size_t count = sealedChunkCount(len, unit, final);
+    if (count == 0 || count - 1 > UINT32_MAX - firstIndex) return VaultStatus::BadInput;
+
+    const auto key = chunkedKey(keys, blobId, header);
+    out.resize(len - count * kChunkTagSize);
+    std::atomic<bool> failed{false};
+    forEachChunk(count, [&](size_t begin, size_t end) {
+        const auto aes = key->createAesKey(*_provider);
+        for (size_t i = begin; i < end && !failed.load(std::memory_order_relaxed); ++i) {
+            const size_t sealedLen = std::min(unit, len - i * unit);
+            if (!key->open(*aes, static_cast<uint32_t>(firstIndex + i), final && i == count - 1, in + i * unit,
+                           sealedLen, out.data() + i * header.chunkSize))
+                failed.store(true, std::memory_order_relaxed);
+        }
+    }, kBlobChunkGrain);
+    if (failed.load()) {
+        secureZero(out.data(), out.size());
+        out.clear();
+        return VaultStatus::AuthFailed;
+    }
+    return VaultStatus::Ok;
+}
+
+bool VaultCryptoEngine::rekey(const VaultKeys& from, const VaultKeys& to, std::vector<RekeyJob>& jobs) const {
+    std::vector<uint8_t> nonces(jobs.size() * GCM_IV_SIZE);
+    if (!nonces.empty() && !secureRandom(nonces.data(), nonces.size())) return false;
+
+    forEachChunk(jobs.size(), [&](size_t begin, size_t end) {
+        SecureBox<EntryKeyGroup> sourceKeys, targetKeys;
+        const std::string* ids[kKeyBatch];
+        size_t index[kKeyBatch];
+        SecureBytes plaintext; // reused across the chunk, wiped on release
+        const auto live = [](const RekeyJob& job) { return job.status == VaultStatus::Ok; };
+        for (size_t next = begin, n; (n = nextKeyGroup(jobs, next, end, live, ids, index)) > 0;) {
+            from.deriveEntryKeys(ids, n, sourceKeys->keys);
+            to.deriveEntryKeys(ids, n, targetKeys->keys);
+            for (size_t k = 0; k < n; ++k) {
+                const size_t i = index[k];
+                RekeyJob& job = jobs[i];
+
+                const auto source = _provider->createAesKey(sourceKeys->keys[k], VaultKeys::kEntryKeySize);
+                plaintext.resize(job.ciphertext.size());
+                if (!source->gcmOpen(job.iv.data(), nullptr, 0, job.ciphertext.data(), plaintext.data(),
+                                     job.ciphertext.size(), job.tag.data())) {
+                    job.status = VaultStatus::AuthFailed;
+                    continue;
+                }
+
+                const auto target = _provider->createAesKey(targetKeys->keys[k], VaultKeys::kEntryKeySize);
+                std::memcpy(job.newIv.data(), nonces.data() + i * GCM_IV_SIZE, GCM_IV_SIZE);
+                job.newCiphertext.resize(plaintext.size());
+                target->gcmSeal(job.newIv.data(), nullptr, 0, plaintext.data(), job.newCiphertext.data(),
+                                plaintext.size(), job.newTag.data());
+                secureZero(plaintext.data(), plaintext.size());
+            }
+        }
+    });
+    return true;
+}
+
+} // namespace crypto
+} // namespace adapters
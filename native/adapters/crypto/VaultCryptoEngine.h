@@ -0,0 +1,196 @@
+#pragma once
+#include "ChunkedAead.h"
+#include "EntryPayload.h"
+#include "SecureBytes.h"
+#include "SessionKeyring.h"
+#include "WorkStealingPool.h"
+#include "../../core/ports/ICryptoProvider.h"
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace adapters {
+namespace crypto {
+
+/**
+ * The vault's entry root: cardSecret ‖ machineSecret, held in the secure
+ * arena. Immutable once built, so a batch can keep using its snapshot
+ * after the engine's keys are replaced or cleared; the bytes are wiped
+ * when the last snapshot is released.
+ */
+class VaultKeys {
+public:
+    static constexpr size_t kEntryKeySize = 32;
+
+    VaultKeys(const uint8_t* cardSecret, size_t cardLen, const uint8_t* machineSecret, size_t machineLen);
+
+    VaultKeys(const VaultKeys&) = delete;
+    VaultKeys& operator=(const VaultKeys&) = delete;
+
+    // HKDF-SHA256(ikm = cardSecret ‖ machineSecret, salt = entryId,
+    // info = "pwmgr-entry-v1"), the same key as deriveEntryKey() in
+    // keyDerivation.ts.
+    void deriveEntryKey(const std::string& entryId, uint8_t out[kEntryKeySize]) const;
+    // deriveEntryKey() for `count` entries at once, out[i] for *entryIds[i],
+    // through hkdfSha256Batch(): SHA-NI, or eight entries per AVX2 pass.
+    void deriveEntryKeys(const std::string* const* entryIds, size_t count, uint8_t (*out)[kEntryKeySize]) const;
+
+private:
+    KeyBytes _ikm;
+};
+
+enum class VaultStatus : uint8_t {
+    Ok,
+    AuthFailed, // tag mismatch: tampered row, wrong entry id or wrong keys
+    BadInput,   // IV or tag of the wrong length; never attempted
+    Malformed,  // authenticated, but the plaintext is not an entry payload
+};
+
+struct SealJob {
+    std::string entryId;
+    SecureBytes plaintext;
+
+    std::vector<uint8_t>    ciphertext;
+    std::array<uint8_t, 12> iv{};
+    std::array<uint8_t, 16> tag{};
+};
+
+struct OpenJob {
+    std::string entryId;
+    std::vector<uint8_t>    ciphertext;
+    std::array<uint8_t, 12> iv{};
+    std::array<uint8_t, 16> tag{};
+    VaultStatus status = VaultStatus::Ok; // set BadInput to skip the job
+
+    SecureBytes plaintext; // empty unless status is Ok
+};
+
+// An entry opened for a few of its payload fields: the plaintext is parsed
+// where it was decrypted and wiped there, only `fields` leaves the engine.
+struct FieldsJob {
+    std::string entryId;
+    std::vector<uint8_t>    ciphertext;
+    std::array<uint8_t, 12> iv{};
+    std::array<uint8_t, 16> tag{};
+    VaultStatus status = VaultStatus::Ok; // set BadInput to skip the job
+
+    EntryFields fields; // valid when status is Ok
+};
+
+// An entry moving from one VaultKeys to another: opened under the source
+// keys and sealed again, with a fresh IV, under the target keys.
+struct RekeyJob {
+    std::string entryId;
+    std::vector<uint8_t>    ciphertext;
+    std::array<uint8_t, 12> iv{};
+    std::array<uint8_t, 16> tag{};
+    VaultStatus status = VaultStatus::Ok; // set BadInput to skip the job
+
+    // Valid when status is Ok
+    std::vector<uint8_t>    newCiphertext;
+    std::array<uint8_t, 12> newIv{};
+    std::array<uint8_t, 16> newTag{};
+};
+
+/**
+ * Batch AES-256-GCM over vault entries, format-compatible with
+ * encryptEntry()/decryptEntry() in keyDerivation.ts: a fresh random 12-byte
+ * IV per seal, no AAD, a 16-byte tag.
+ *
+ * seal(), open() and rekey() are pure functions of their arguments and may
+ * run on any thread; key management is serialized by an internal mutex.
+ * Entry keys are derived kKeyBatch at a time into a secure arena cell and
+ * wiped once that group is done; AES schedules (also arena cells) and
+ * rekey plaintext exist only for one job.
+ *
+ * Batches of kParallelGrain * 2 entries or more are spread over a
+ * WorkStealingPool, started on first use; the calling thread takes part.
+ */
+class VaultCryptoEngine {
+public:
+    // Entries per pool task: large enough that scheduling stays well under
+    // 1% of the HKDF + GCM work.
+    static constexpr size_t kParallelGrain = 32;
+    // Entry keys derived per hkdfSha256Batch() call: two AVX2 passes.
+    static constexpr size_t kKeyBatch = 16;
+    // Blob chunks per pool task: four default 64 KiB chunks, about 60 us
+    // of AES-NI GCM.
+    static constexpr size_t kBlobChunkGrain = 4;
+
+    // A null provider selects createCryptoProvider()'s default backend.
+    // `threads` sizes the pool (0: WorkStealingPool's default, 1: batches
+    // run on the calling thread only).
+    explicit VaultCryptoEngine(std::shared_ptr<const core::ports::ICryptoProvider> provider = nullptr,
+                               size_t threads = 0);
+
+    // A non-zero ttl makes the keys a session: they are dropped once it
+    // elapses (see SessionKeyring). Zero keeps them until clearKeys().
+    void setKeys(const uint8_t* cardSecret, size_t cardLen, const uint8_t* machineSecret, size_t machineLen,
+                 std::chrono::milliseconds ttl = std::chrono::milliseconds::zero());
+    // Drops the engine's reference; batches already queued finish on theirs.
+    void clearKeys();
+    // Snapshot for one batch; null when no keys are set or they expired.
+    std::shared_ptr<const VaultKeys> keys() const;
+    // Time until the keys expire; nullopt when none are set or no ttl was given.
+    std::optional<std::chrono::milliseconds> keysExpireIn() const { return _keys.remaining(); }
+
+    const char* backend() const { return _provider->name(); }
+
+    // Fills ciphertext, iv and tag of every job. Returns false, leaving
+    // the jobs unsealed, if the OS random source fails.
+    bool seal(const VaultKeys& keys, std::vector<SealJob>& jobs) const;
+    // Sets status and plaintext of every job whose status is Ok on entry.
+    void open(const VaultKeys& keys, std::vector<OpenJob>& jobs) const;
+    // open() followed by readEntryFields() for every job whose status is
+    // Ok on entry, keeping the fields in `mask`. A payload that does not
+    // parse ends Malformed.
+    void openFields(const VaultKeys& keys, std::vector<FieldsJob>& jobs, uint32_t mask) const;
+    // Moves every job whose status is Ok from `from` to `to`; a job that
+    // does not authenticate under `from` ends AuthFailed with no output.
+    // Returns false, leaving the jobs untouched, if the OS random source
+    // fails.
+    bool rekey(const VaultKeys& from, const VaultKeys& to, std::vector<RekeyJob>& jobs) const;
+
+    // Seals `len` bytes as chunks firstIndex, firstIndex + 1, ... of the
+    // chunked blob `header` describes (see ChunkedAead.h), under blobId's
+    // entry key, appending them to `out`. Without `final`, `len` must be a
+    // non-zero multiple of the chunk size; with it, the last chunk takes
+    // the rest, and a zero `len` seals the empty final chunk. BadInput,
+    // with nothing appended, when `len` does not fit or the indices would
+    // pass 2^32.
+    VaultStatus sealChunks(const VaultKeys& keys, const std::string& blobId, const ChunkedHeader& header,
+                           uint32_t firstIndex, const uint8_t* in, size_t len, bool final,
+                           std::vector<uint8_t>& out) const;
+    // The inverse: `in` holds whole sealed chunks from firstIndex on, the
+    // last of them final when `final`. AuthFailed, with `out` left empty,
+    // if any chunk does not authenticate.
+    VaultStatus openChunks(const VaultKeys& keys, const std::string& blobId, const ChunkedHeader& header,
+                           uint32_t firstIndex, const uint8_t* in, size_t len, bool final,
+                           SecureBytes& out) const;
+
+    // Threads a large batch runs on, the caller included.
+    size_t concurrency() const { return _threads == 1 ? 1 : pool().concurrency(); }
+
+private:
+    // Runs fn over [0, count) in `grain`-sized chunks, on the pool when
+    // there are at least two chunks.
+    void forEachChunk(size_t count, const std::function<void(size_t, size_t)>& fn,
+                      size_t grain = kParallelGrain) const;
+    WorkStealingPool& pool() const;
+
+    std::shared_ptr<const core::ports::ICryptoProvider> _provider;
+
+    size_t _threads;
+    mutable std::once_flag _poolOnce;
+    mutable std::unique_ptr<WorkStealingPool> _pool;
+
+    SessionKeyring _keys;
+};
+
+} // namespace crypto
+} // namespace adapters
@@ -0,0 +1,129 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace adapters {
+namespace crypto {
+
+WorkStealingPool::WorkStealingPool(size_t threads) {
+    if (threads == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        threads = hw > 1 ? hw - 1 : 1;
+    }
+    _lanes = std::make_unique<Lane[]>(threads + 1);
+    _threads.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) _threads.emplace_back([this, i] { workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto& t : _threads) t.join();
+}
+
+void WorkStealingPool::parallelFor(size_t count, size_t grain,
+                                   const std::function<void(size_t begin, size_t end)>& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1) {
+        fn(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run(_runMutex);
+    // The job is published before any lane holds work: a thread still on
+    // its way out of the previous call may pick up a chunk of this one
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _fn = &fn;
+        _count = count;
+        _grain = grain;
+        _remaining.store(chunks, std::memory_order_relaxed);
+    }
+    const size_t lanes = concurrency();
+    const size_t callerLane = lanes - 1;
+    for (size_t i = 0; i < lanes; ++i) {
+        std::lock_guard<std::mutex> lock(_lanes[i].mutex);
+        _lanes[i].next = chunks * i / lanes;
+        _lanes[i].end = chunks * (i + 1) / lanes;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    participate(callerLane);
+
+    // Every chunk is finished, but a pool thread may still be scanning
+    // lanes; wait until all have left before `fn` goes out of scope
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    _done.wait(lock, [this] { return _remaining.load(std::memory_order_acquire) == 0 && _busy == 0; });
+    _fn = nullptr;
+}
+
+void WorkStealingPool::workerLoop(size_t lane) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    for (;;) {
+        _wake.wait(lock, [&] { return _stopping || _generation != seen; });
+        if (_stopping) return;
+        seen = _generation;
+        ++_busy;
+        lock.unlock();
+        participate(lane);
+        lock.lock();
+        --_busy;
+        if (_busy == 0) _done.notify_all();
+    }
+}
+
+void WorkStealingPool::participate(size_t lane) {
+    size_t chunk = 0;
+    while (takeOwn(lane, chunk) || steal(lane, chunk)) {
+        const size_t begin = chunk * _grain;
+        (*_fn)(begin, std::min(_count, begin + _grain));
+        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _done.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::takeOwn(size_t lane, size_t& chunk) {
+    Lane& own = _lanes[lane];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.next >= own.end) return false;
+    chunk = own.next++;
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t lane, size_t& chunk) {
+    const size_t lanes = concurrency();
+    for (size_t offset = 1; offset < lanes; ++offset) {
+        Lane& victim = _lanes[(lane + offset) % lanes];
+        size_t begin = 0, end = 0;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.next >= victim.end) continue;
+            const size_t left = victim.end - victim.next;
+            // Take the back half, at least one chunk
+            begin = victim.end - std::max<size_t>(left / 2, 1);
+            end = victim.end;
+            victim.end = begin;
+        }
+        chunk = begin;
+        Lane& own = _lanes[lane];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.next = begin + 1;
+        own.end = end;
+        return true;
+    }
+    return false;
+}
+
+} // namespace crypto
+} // namespace adapters
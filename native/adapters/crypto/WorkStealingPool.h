@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace adapters {
+namespace crypto {
+
+/**
+ * Fixed set of threads for CPU-bound batch work.
+ *
+ * parallelFor() cuts [0, count) into chunks of `grain` and deals each
+ * participant (the pool threads plus the calling thread) a contiguous run of
+ * chunks. A participant works through its own run from the front; when it
+ * runs dry it steals the back half of the busiest-looking other run. Uneven
+ * items (long notes next to short passwords) therefore even out without a
+ * shared queue every chunk has to go through.
+ *
+ * One parallelFor() runs at a time; concurrent callers queue on a mutex.
+ * `fn` must not throw.
+ */
+class WorkStealingPool {
+public:
+    // 0 selects hardware_concurrency() - 1, leaving a core for the caller's
+    // process; at least one thread is started.
+    explicit WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Pool threads plus the calling thread.
+    size_t concurrency() const { return _threads.size() + 1; }
+
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& fn);
+
+private:
+    // Chunk indices [next, end) still owned by one participant
+    struct Lane {
+        std::mutex mutex;
+        size_t next = 0;
+        size_t end = 0;
+    };
+
+    void workerLoop(size_t lane);
+    // Runs chunks until no lane has work left.
+    void participate(size_t lane);
+    bool takeOwn(size_t lane, size_t& chunk);
+    bool steal(size_t lane, size_t& chunk);
+
+    std::vector<std::thread> _threads;
+    std::unique_ptr<Lane[]> _lanes; // one per thread, the caller's last
+
+    std::mutex _runMutex; // one parallelFor at a time
+
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    uint64_t _generation = 0;
+    bool _stopping = false;
+    size_t _busy = 0; // pool threads inside participate()
+
+    // Current job; written under _wakeMutex before _generation moves
+    const std::function<void(size_t, size_t)>* _fn = nullptr;
+    size_t _count = 0;
+    size_t _grain = 1;
+    std::atomic<size_t> _remaining{0}; // chunks not yet finished
+};
+
+} // namespace crypto
+} // namespace adapters
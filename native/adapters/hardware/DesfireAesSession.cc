@@ -0,0 +1,421 @@
+#include "DesfireAesSession.h"
+#include "../crypto/AesKeyBase.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+constexpr uint8_t DF_CMD_AUTHENTICATE_AES       = 0xAA;
+constexpr uint8_t DF_CMD_AUTHENTICATE_EV2_FIRST = 0x71;
+constexpr uint8_t DF_CMD_AUTHENTICATE_EV2_NEXT  = 0x77;
+constexpr uint8_t DF_CMD_READ_DATA              = 0xBD;
+constexpr uint8_t DF_STATUS_OK                  = 0x00;
+constexpr uint8_t DF_STATUS_ILLEGAL_COMMAND     = 0x1C;
+constexpr uint8_t DF_STATUS_MORE                = 0xAF;
+
+static core::ports::NfcError statusError(uint8_t command, uint8_t status) {
+    std::ostringstream oss;
+    oss << "DESFire command 0x" << std::hex << std::setw(2) << std::setfill('0')
+        << static_cast<int>(command) << " failed: " << desfireStatusName(status)
+        << " (0x" << std::setw(2) << static_cast<int>(status) << ")";
+    return core::ports::NfcError{"HARDWARE_ERROR", oss.str()};
+}
+
+static void rotateLeft1(const uint8_t in[16], uint8_t out[16]) {
+    for (size_t i = 0; i < 15; ++i) out[i] = in[i + 1];
+    out[15] = in[0];
+}
+
+static void randomDeviceFill(uint8_t* out, size_t len) {
+    std::random_device rd;
+    for (size_t i = 0; i < len; i += 4) {
+        const uint32_t v = rd();
+        for (size_t j = 0; j < 4 && i + j < len; ++j) out[i + j] = static_cast<uint8_t>(v >> (8 * j));
+    }
+}
+
+static void put24(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+}
+
+static core::ports::Result<std::vector<uint8_t>> expectFrame(
+    core::ports::Result<std::vector<uint8_t>>&& res, uint8_t command, uint8_t status, size_t dataLen) {
+    if (std::holds_alternative<core::ports::NfcError>(res)) return std::move(res);
+    const auto& resp = std::get<std::vector<uint8_t>>(res);
+    if (resp.empty()) return core::ports::NfcError{"HARDWARE_ERROR", "Empty DESFire response"};
+    if (resp[0] != status) return statusError(command, resp[0]);
+    if (resp.size() != 1 + dataLen) return core::ports::NfcError{"HARDWARE_ERROR", "Unexpected DESFire response length"};
+    return std::move(res);
+}
+
+} // anonymous namespace
+
+bool desfireSupportsEv2(uint8_t hwMajorVersion) {
+    return hwMajorVersion >= 0x12;
+}
+
+uint32_t desfireCrc32(const uint8_t* data, size_t len, uint32_t crc) {
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return crc;
+}
+
+const char* desfireStatusName(uint8_t status) {
+    switch (status) {
+        case 0x00: return "OPERATION_OK";
+        case 0x0C: return "NO_CHANGES";
+        case 0x0E: return "OUT_OF_EEPROM_ERROR";
+        case 0x1C: return "ILLEGAL_COMMAND_CODE";
+        case 0x1E: return "INTEGRITY_ERROR";
+        case 0x40: return "NO_SUCH_KEY";
+        case 0x7E: return "LENGTH_ERROR";
+        case 0x9D: return "PERMISSION_DENIED";
+        case 0x9E: return "PARAMETER_ERROR";
+        case 0xA0: return "APPLICATION_NOT_FOUND";
+        case 0xA1: return "APPL_INTEGRITY_ERROR";
+        case 0xAE: return "AUTHENTICATION_ERROR";
+        case 0xAF: return "ADDITIONAL_FRAME";
+        case 0xBE: return "BOUNDARY_ERROR";
+        case 0xC1: return "PICC_INTEGRITY_ERROR";
+        case 0xCA: return "COMMAND_ABORTED";
+        case 0xCD: return "PICC_DISABLED_ERROR";
+        case 0xCE: return "COUNT_ERROR";
+        case 0xDE: return "DUPLICATE_ERROR";
+        case 0xEE: return "EEPROM_ERROR";
+        case 0xF0: return "FILE_NOT_FOUND";
+        case 0xF1: return "FILE_INTEGRITY_ERROR";
+        default:   return "UNKNOWN_STATUS";
+    }
+}
+
+DesfireAesSession::DesfireAesSession(std::shared_ptr<const core::ports::ICryptoProvider> crypto,
+                                     Transceive transceive,
+                                     RandomFill random,
+                                     bool preferEv2)
+    : _crypto(std::move(crypto)),
+      _transceive(std::move(transceive)),
+      _random(random ? std::move(random) : RandomFill(randomDeviceFill)),
+      _preferEv2(preferEv2) {}
+
+DesfireAesSession::~DesfireAesSession() {
+    reset();
+}
+
+void DesfireAesSession::reset() {
+    _scheme = Scheme::None;
+    _encKey.reset();
+    _macKey.reset();
+    crypto::secureZero(_iv, sizeof(_iv));
+    crypto::secureZero(_ti, sizeof(_ti));
+    _cmdCtr = 0;
+}
+
+core::ports::Result<std::vector<uint8_t>> DesfireAesSession::exchange(const std::vector<uint8_t>& frame) {
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> next = frame;
+    for (;;) {
+        auto res = _transceive(next);
+        if (std::holds_alternative<core::ports::NfcError>(res)) {
+            return std::get<core::ports::NfcError>(res);
+        }
+        const auto& resp = std::get<std::vector<uint8_t>>(res);
+        if (resp.empty()) return core::ports::NfcError{"HARDWARE_ERROR", "Empty DESFire response"};
+        data.insert(data.end(), resp.begin() + 1, resp.end());
+        if (resp[0] == DF_STATUS_OK) return data;
+        if (resp[0] != DF_STATUS_MORE) return statusError(frame[0], resp[0]);
+        next.assign(1, DF_STATUS_MORE);
+    }
+}
+
+core::ports::Result<bool> DesfireAesSession::authenticate(uint8_t keyNo, const std::array<uint8_t, 16>& key) {
+    auto staticKey = _crypto->createAesKey(key.data(), key.size());
+    if (!staticKey) return core::ports::NfcError{"HARDWARE_ERROR", "Could not expand AES key"};
+
+    if (_preferEv2 && !_ev2Unsupported) {
+        // NonFirst only continues a live EV2 transaction
+        const bool first = _scheme != Scheme::Ev2;
+        auto res = authenticateEv2(keyNo, *staticKey, first);
+        if (!first || !_ev2Unsupported) return res;
+        // Card predates EV2: fall through to legacy AES
+    }
+    return authenticateEv1(keyNo, *staticKey);
+}
+
+// AuthenticateAES (EV1). One CBC chain runs across the whole handshake,
+// starting from a zero IV: E(RndB) from the card, E(RndA || RndB<<<8) from
+// the host, E(RndA<<<8) from the card.
+core::ports::Result<bool> DesfireAesSession::authenticateEv1(uint8_t keyNo, const core::ports::IAesKey& staticKey) {
+    reset();
+    auto r1 = expectFrame(_transceive({DF_CMD_AUTHENTICATE_AES, keyNo}),
+                          DF_CMD_AUTHENTICATE_AES, DF_STATUS_MORE, 16);
+    if (std::holds_alternative<core::ports::NfcError>(r1)) return std::get<core::ports::NfcError>(r1);
+    const auto& challenge = std::get<std::vector<uint8_t>>(r1);
+
+    uint8_t iv[16] = {};
+    uint8_t rndB[16];
+    staticKey.decryptCbc(iv, challenge.data() + 1, rndB, 16);
+
+    uint8_t token[32];
+    uint8_t rndA[16];
+    _random(rndA, sizeof(rndA));
+    std::memcpy(token, rndA, 16);
+    rotateLeft1(rndB, token + 16);
+    std::vector<uint8_t> frame(33);
+    frame[0] = DF_STATUS_MORE;
+    staticKey.encryptCbc(iv, token, frame.data() + 1, 32);
+    crypto::secureZero(token, sizeof(token));
+
+    core::ports::Result<bool> result = true;
+    auto r2 = expectFrame(_transceive(frame), DF_CMD_AUTHENTICATE_AES, DF_STATUS_OK, 16);
+    if (std::holds_alternative<core::ports::NfcError>(r2)) {
+        result = std::get<core::ports::NfcError>(r2);
+    } else {
+        uint8_t rndAr[16];
+        uint8_t expected[16];
+        staticKey.decryptCbc(iv, std::get<std::vector<uint8_t>>(r2).data() + 1, rndAr, 16);
+        rotateLeft1(rndA, expected);
+        if (std::memcmp(rndAr, expected, 16) != 0) {
+            result = core::ports::NfcError{"HARDWARE_ERROR", "Card failed mutual authentication"};
+        } else {
+            // Session key: RndA[0..3] RndB[0..3] RndA[12..15] RndB[12..15]
+            uint8_t sk[16];
+            std::memcpy(sk,      rndA,      4);
+            std::memcpy(sk + 4,  rndB,      4);
+            std::memcpy(sk + 8,  rndA + 12, 4);
+            std::memcpy(sk + 12, rndB + 12, 4);
+            _encKey = _crypto->createAesKey(sk, sizeof(sk));
+            crypto::secureZero(sk, sizeof(sk));
+            _scheme = Scheme::Ev1;
+        }
+        crypto::secureZero(rndAr, sizeof(rndAr));
+        crypto::secureZero(expected, sizeof(expected));
+    }
+    crypto::secureZero(rndA, sizeof(rndA));
+    crypto::secureZero(rndB, sizeof(rndB));
+    return result;
+}
+
+// AuthenticateEV2First / NonFirst. Every cryptogram is a fresh CBC with a
+// zero IV. First returns TI || RndA' || PDcap2 || PCDcap2 and resets the
+// command counter; NonFirst returns RndA' only and keeps TI and CmdCtr.
+core::ports::Result<bool> DesfireAesSession::authenticateEv2(uint8_t keyNo, const core::ports::IAesKey& staticKey, bool first) {
+    const uint8_t command = first ? DF_CMD_AUTHENTICATE_EV2_FIRST : DF_CMD_AUTHENTICATE_EV2_NEXT;
+    std::vector<uint8_t> start{command, keyNo};
+    if (first) start.push_back(0x00); // LenCap: no PCDcap2 sent
+
+    auto r1 = _transceive(start);
+    if (std::holds_alternative<core::ports::NfcError>(r1)) { reset(); return std::get<core::ports::NfcError>(r1); }
+    {
+        const auto& resp = std::get<std::vector<uint8_t>>(r1);
+        if (first && !resp.empty() && resp[0] == DF_STATUS_ILLEGAL_COMMAND) {
+            _ev2Unsupported = true;
+            reset();
+            return statusError(command, resp[0]);
+        }
+    }
+    r1 = expectFrame(std::move(r1), command, DF_STATUS_MORE, 16);
+    if (std::holds_alternative<core::ports::NfcError>(r1)) { reset(); return std::get<core::ports::NfcError>(r1); }
+
+    uint8_t iv[16] = {};
+    uint8_t rndB[16];
+    staticKey.decryptCbc(iv, std::get<std::vector<uint8_t>>(r1).data() + 1, rndB, 16);
+
+    uint8_t token[32];
+    uint8_t rndA[16];
+    _random(rndA, sizeof(rndA));
+    std::memcpy(token, rndA, 16);
+    rotateLeft1(rndB, token + 16);
+    std::vector<uint8_t> frame(33);
+    frame[0] = DF_STATUS_MORE;
+    std::memset(iv, 0, sizeof(iv));
+    staticKey.encryptCbc(iv, token, frame.data() + 1, 32);
+    crypto::secureZero(token, sizeof(token));
+
+    const size_t answerLen = first ? 32 : 16;
+    auto r2 = expectFrame(_transceive(frame), command, DF_STATUS_OK, answerLen);
+    core::ports::Result<bool> result = true;
+    if (std::holds_alternative<core::ports::NfcError>(r2)) {
+        reset();
+        result = std::get<core::ports::NfcError>(r2);
+    } else {
+        uint8_t answer[32];
+        std::memset(iv, 0, sizeof(iv));
+        staticKey.decryptCbc(iv, std::get<std::vector<uint8_t>>(r2).data() + 1, answer, answerLen);
+        const uint8_t* rndAr = first ? answer + 4 : answer;
+        uint8_t expected[16];
+        rotateLeft1(rndA, expected);
+        if (std::memcmp(rndAr, expected, 16) != 0) {
+            reset();
+            result = core::ports::NfcError{"HARDWARE_ERROR", "Card failed mutual authentication"};
+        } else {
+            // SV1/SV2 = label || 00 01 00 80 || RndA[15:14] ||
+            //           (RndA[13:8] ^ RndB[15:10]) || RndB[9:0] || RndA[7:0]
+            // (NXP numbers bytes MSB-first, so RndA[15:14] is rndA[0..1].)
+            uint8_t sv[32] = {0xA5, 0x5A, 0x00, 0x01, 0x00, 0x80};
+            std::memcpy(sv + 6, rndA, 2);
+            for (size_t i = 0; i < 6; ++i) sv[8 + i] = rndA[2 + i] ^ rndB[i];
+            std::memcpy(sv + 14, rndB + 6, 10);
+            std::memcpy(sv + 24, rndA + 8, 8);
+
+            const uint8_t zero[16] = {};
+            uint8_t sesEnc[16];
+            uint8_t sesMac[16];
+            staticKey.cmac(zero, sv, sizeof(sv), sesEnc);
+            sv[0] = 0x5A;
+            sv[1] = 0xA5;
+            staticKey.cmac(zero, sv, sizeof(sv), sesMac);
+            _encKey = _crypto->createAesKey(sesEnc, sizeof(sesEnc));
+            _macKey = _crypto->createAesKey(sesMac, sizeof(sesMac));
+            if (first) {
+                std::memcpy(_ti, answer, 4);
+                _cmdCtr = 0;
+            }
+            _scheme = Scheme::Ev2;
+            crypto::secureZero(sv, sizeof(sv));
+            crypto::secureZero(sesEnc, sizeof(sesEnc));
+            crypto::secureZero(sesMac, sizeof(sesMac));
+        }
+        crypto::secureZero(answer, sizeof(answer));
+        crypto::secureZero(expected, sizeof(expected));
+    }
+    crypto::secureZero(rndA, sizeof(rndA));
+    crypto::secureZero(rndB, sizeof(rndB));
+    return result;
+}
+
+void DesfireAesSession::macEv2(uint8_t code, const uint8_t* payload, size_t len, uint8_t mact[8]) const {
+    std::vector<uint8_t> input;
+    input.reserve(7 + len);
+    input.push_back(code);
+    input.push_back(static_cast<uint8_t>(_cmdCtr));
+    input.push_back(static_cast<uint8_t>(_cmdCtr >> 8));
+    input.insert(input.end(), _ti, _ti + 4);
+    input.insert(input.end(), payload, payload + len);
+    const uint8_t zero[16] = {};
+    uint8_t mac[16];
+    _macKey->cmac(zero, input.data(), input.size(), mac);
+    for (size_t i = 0; i < 8; ++i) mact[i] = mac[2 * i + 1];
+}
+
+void DesfireAesSession::ivEv2(uint8_t label0, uint8_t label1, uint8_t iv[16]) const {
+    uint8_t block[16] = {label0, label1};
+    std::memcpy(block + 2, _ti, 4);
+    block[6] = static_cast<uint8_t>(_cmdCtr);
+    block[7] = static_cast<uint8_t>(_cmdCtr >> 8);
+    _encKey->encryptEcb(block, iv, 16);
+}
+
+core::ports::Result<std::vector<uint8_t>> DesfireAesSession::readDataEnciphered(
+    uint8_t fileNo, uint32_t offset, uint32_t length) {
+    if (!authenticated()) return core::ports::NfcError{"HARDWARE_ERROR", "ReadData without an authenticated session"};
+    if (length == 0) return core::ports::NfcError{"HARDWARE_ERROR", "Enciphered ReadData needs an explicit length"};
+
+    std::vector<uint8_t> frame{DF_CMD_READ_DATA, fileNo};
+    put24(frame, offset);
+    put24(frame, length);
+    return _scheme == Scheme::Ev2 ? readDataEv2(frame, length) : readDataEv1(frame, length);
+}
+
+core::ports::Result<std::vector<uint8_t>> DesfireAesSession::readDataEv1(
+    const std::vector<uint8_t>& frame, uint32_t length) {
+    // The command is MACed into the IV chain but the MAC is not sent
+    _encKey->cmac(_iv, frame.data(), frame.size(), _iv);
+
+    auto res = exchange(frame);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        reset();
+        return std::get<core::ports::NfcError>(res);
+    }
+    auto& cipher = std::get<std::vector<uint8_t>>(res);
+
+    // Plaintext: data || CRC32(data || status) || zero padding to 16
+    const size_t expectedLen = ((length + 4 + 15) / 16) * 16;
+    if (cipher.size() != expectedLen) {
+        reset();
+        return core::ports::NfcError{"HARDWARE_ERROR", "Unexpected enciphered ReadData length"};
+    }
+    _encKey->decryptCbc(_iv, cipher.data(), cipher.data(), cipher.size());
+
+    const uint8_t status = DF_STATUS_OK;
+    uint32_t crc = desfireCrc32(cipher.data(), length);
+    crc = desfireCrc32(&status, 1, crc);
+    const uint8_t* crcBytes = cipher.data() + length;
+    const uint32_t cardCrc = static_cast<uint32_t>(crcBytes[0]) |
+                             (static_cast<uint32_t>(crcBytes[1]) << 8) |
+                             (static_cast<uint32_t>(crcBytes[2]) << 16) |
+                             (static_cast<uint32_t>(crcBytes[3]) << 24);
+    const bool paddingZero = std::all_of(cipher.begin() + length + 4, cipher.end(),
+                                         [](uint8_t b) { return b == 0x00; });
+    if (crc != cardCrc || !paddingZero) {
+        crypto::secureZero(cipher.data(), cipher.size());
+        reset();
+        return core::ports::NfcError{"HARDWARE_ERROR", "DESFire ReadData integrity check failed"};
+    }
+
+    std::vector<uint8_t> out(cipher.begin(), cipher.begin() + length);
+    crypto::secureZero(cipher.data(), cipher.size());
+    return out;
+}
+
+// EV2 full mode: command carries MACt over Cmd || CmdCtr || TI || header;
+// response is E(data || 80 00..) || MACt over RC || CmdCtr+1 || TI || E(..).
+core::ports::Result<std::vector<uint8_t>> DesfireAesSession::readDataEv2(
+    const std::vector<uint8_t>& frame, uint32_t length) {
+    std::vector<uint8_t> command = frame;
+    uint8_t mact[8];
+    macEv2(frame[0], frame.data() + 1, frame.size() - 1, mact);
+    command.insert(command.end(), mact, mact + 8);
+
+    auto res = exchange(command);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        reset();
+        return std::get<core::ports::NfcError>(res);
+    }
+    ++_cmdCtr;
+    auto& resp = std::get<std::vector<uint8_t>>(res);
+
+    const size_t cipherLen = ((length + 16) / 16) * 16; // M2 padding always adds a byte
+    if (resp.size() != cipherLen + 8) {
+        reset();
+        return core::ports::NfcError{"HARDWARE_ERROR", "Unexpected enciphered ReadData length"};
+    }
+
+    uint8_t expectedMac[8];
+    macEv2(DF_STATUS_OK, resp.data(), cipherLen, expectedMac);
+    uint8_t diff = 0;
+    for (size_t i = 0; i < 8; ++i) diff |= static_cast<uint8_t>(expectedMac[i] ^ resp[cipherLen + i]);
+    if (diff != 0) {
+        reset();
+        return core::ports::NfcError{"HARDWARE_ERROR", "DESFire ReadData integrity check failed"};
+    }
+
+    uint8_t iv[16];
+    ivEv2(0x5A, 0xA5, iv);
+    _encKey->decryptCbc(iv, resp.data(), resp.data(), cipherLen);
+    const bool paddingOk = resp[length] == 0x80 &&
+        std::all_of(resp.begin() + length + 1, resp.begin() + cipherLen,
+                    [](uint8_t b) { return b == 0x00; });
+    if (!paddingOk) {
+        crypto::secureZero(resp.data(), resp.size());
+        reset();
+        return core::ports::NfcError{"HARDWARE_ERROR", "DESFire ReadData integrity check failed"};
+    }
+
+    std::vector<uint8_t> out(resp.begin(), resp.begin() + length);
+    crypto::secureZero(resp.data(), resp.size());
+    crypto::secureZero(iv, sizeof(iv));
+    return out;
+}
+
+} // namespace hardware
+} // namespace adapters
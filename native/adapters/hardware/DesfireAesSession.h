@@ -0,0 +1,102 @@
+#pragma once
+#include "../../core/ports/INfcReader.h"
+#include "../../core/ports/ICryptoProvider.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * DESFire AES secure channel running on an injected ICryptoProvider, so
+ * the hot card path uses AES-NI where available instead of the software
+ * AES inside NfcCpp. Two schemes:
+ *
+ *   EV1 — AuthenticateAES (0xAA), CMAC IV chaining, CRC32 in ciphertext.
+ *   EV2 — AuthenticateEV2First (0x71) / NonFirst (0x77), separate ENC/MAC
+ *         session keys, transaction identifier (TI) and command counter.
+ *
+ * With preferEv2 set the first authenticate() runs EV2First; later calls
+ * re-authenticate with the shorter NonFirst exchange, which keeps TI and
+ * the command counter. A card that rejects 0x71 as an illegal command
+ * drops the session to EV1 for good.
+ *
+ * The transport sends one native DESFire frame (command byte + data) and
+ * returns the card's answer as status byte + data. Session keys keep their
+ * expanded schedules and CMAC subkeys for the session's lifetime.
+ *
+ * Not thread-safe; one session per card transaction.
+ */
+class DesfireAesSession {
+public:
+    using Transceive = std::function<core::ports::Result<std::vector<uint8_t>>(const std::vector<uint8_t>& frame)>;
+    using RandomFill = std::function<void(uint8_t* out, size_t len)>;
+
+    enum class Scheme { None, Ev1, Ev2 };
+
+    // `random` defaults to std::random_device; tests and benchmarks inject
+    // a deterministic source.
+    DesfireAesSession(std::shared_ptr<const core::ports::ICryptoProvider> crypto,
+                      Transceive transceive,
+                      RandomFill random = nullptr,
+                      bool preferEv2 = false);
+    ~DesfireAesSession();
+
+    core::ports::Result<bool> authenticate(uint8_t keyNo, const std::array<uint8_t, 16>& key);
+
+    // ReadData (0xBD) on a file with communication mode "fully enciphered".
+    // Verifies the CRC32 (EV1) or response MAC (EV2) and returns `length` bytes.
+    core::ports::Result<std::vector<uint8_t>> readDataEnciphered(uint8_t fileNo, uint32_t offset, uint32_t length);
+
+    bool authenticated() const { return _encKey != nullptr; }
+    Scheme scheme() const { return _scheme; }
+    bool ev2Unsupported() const { return _ev2Unsupported; } // card answered 0x71 with ILLEGAL_COMMAND
+    uint16_t commandCounter() const { return _cmdCtr; }
+    const core::ports::ICryptoProvider& crypto() const { return *_crypto; }
+
+private:
+    core::ports::Result<bool> authenticateEv1(uint8_t keyNo, const core::ports::IAesKey& key);
+    core::ports::Result<bool> authenticateEv2(uint8_t keyNo, const core::ports::IAesKey& key, bool first);
+    core::ports::Result<std::vector<uint8_t>> readDataEv1(const std::vector<uint8_t>& frame, uint32_t length);
+    core::ports::Result<std::vector<uint8_t>> readDataEv2(const std::vector<uint8_t>& frame, uint32_t length);
+
+    // EV2 truncated MAC (odd bytes of the CMAC) over
+    // code || CmdCtr || TI || payload with SesAuthMACKey.
+    void macEv2(uint8_t code, const uint8_t* payload, size_t len, uint8_t mact[8]) const;
+    // EV2 IV: E(SesAuthENCKey, label || TI || CmdCtr || 0^8)
+    void ivEv2(uint8_t label0, uint8_t label1, uint8_t iv[16]) const;
+
+    // Sends `frame`, follows 0xAF continuation frames and returns the
+    // concatenated data with the final status byte stripped.
+    core::ports::Result<std::vector<uint8_t>> exchange(const std::vector<uint8_t>& frame);
+    void reset();
+
+    std::shared_ptr<const core::ports::ICryptoProvider> _crypto;
+    Transceive _transceive;
+    RandomFill _random;
+    bool _preferEv2;
+    bool _ev2Unsupported = false;
+
+    Scheme _scheme = Scheme::None;
+    std::unique_ptr<core::ports::IAesKey> _encKey; // EV1: the session key
+    std::unique_ptr<core::ports::IAesKey> _macKey; // EV2 only
+    uint8_t _iv[16] = {};                          // EV1 IV chain
+    uint8_t _ti[4] = {};                           // EV2 transaction identifier
+    uint16_t _cmdCtr = 0;                          // EV2 command counter
+};
+
+// True for GetVersion hardware major versions that implement EV2 secure
+// messaging (EV2 = 0x12, EV3 = 0x33, Light = 0x30).
+bool desfireSupportsEv2(uint8_t hwMajorVersion);
+
+// DESFire CRC32 (IEEE 802.3 polynomial, preset 0xFFFFFFFF, no final XOR).
+uint32_t desfireCrc32(const uint8_t* data, size_t len, uint32_t crc = 0xFFFFFFFFu);
+
+// Human-readable name for a DESFire status byte, e.g. "AUTHENTICATION_ERROR".
+const char* desfireStatusName(uint8_t status);
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,159 @@
+#include "FaultInjectingSerialBus.h"
+#include "Pn532Frames.h"
+#include "../timing/SteadyClock.h"
+#include <algorithm>
+#include <chrono>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+// Chunk pulled from the inner bus per read while no frame is complete
+constexpr size_t INNER_READ_CHUNK = 64;
+
+static etl::unexpected<error::Error> ioError() {
+    return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Io));
+}
+
+} // anonymous namespace
+
+FaultInjectingSerialBus::FaultInjectingSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner,
+                                                 FaultProfile profile,
+                                                 std::shared_ptr<core::ports::IClock> clock)
+    : SerialBusDecorator(std::move(inner)),
+      _profile(std::move(profile)),
+      _clock(clock ? std::move(clock) : timing::steadyClock()),
+      _rng(_profile.seed) {}
+
+bool FaultInjectingSerialBus::roll(double probability) {
+    if (probability <= 0.0) return false;
+    return std::uniform_real_distribution<double>(0.0, 1.0)(_rng) < probability;
+}
+
+etl::expected<void, error::Error> FaultInjectingSerialBus::init() {
+    _disconnected = false;
+    _staging.clear();
+    _ready.clear();
+    return inner().init();
+}
+
+etl::expected<void, error::Error> FaultInjectingSerialBus::write(const etl::ivector<uint8_t>& data) {
+    if (_disconnected) return ioError();
+    if (roll(_profile.disconnectRate)) {
+        _disconnected = true;
+        ++_counters.disconnects;
+        return ioError();
+    }
+    if (_profile.dropByteRate <= 0.0) return inner().write(data);
+
+    etl::vector<uint8_t, 512> kept;
+    if (data.size() > kept.max_size()) return inner().write(data);
+    for (auto b : data) {
+        if (roll(_profile.dropByteRate)) {
+            ++_counters.droppedBytes;
+            continue;
+        }
+        kept.push_back(b);
+    }
+    return inner().write(kept);
+}
+
+etl::expected<size_t, error::Error> FaultInjectingSerialBus::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    if (_disconnected) return ioError();
+    if (roll(_profile.delayProbability)) {
+        const uint32_t hi = std::max(_profile.delayMinMs, _profile.delayMaxMs);
+        const uint32_t ms = std::uniform_int_distribution<uint32_t>(_profile.delayMinMs, hi)(_rng);
+        _clock->sleepFor(std::chrono::milliseconds(ms));
+        ++_counters.delays;
+    }
+
+    const auto deadline = _clock->now() + std::chrono::milliseconds(timeoutMs);
+    while (_ready.empty()) {
+        const auto now = _clock->now();
+        const uint32_t remaining = now >= deadline ? 0 : static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count());
+
+        etl::vector<uint8_t, INNER_READ_CHUNK> chunk;
+        auto got = inner().read(chunk, chunk.max_size(), remaining);
+        if (!got.has_value()) {
+            if (_staging.empty()) return got;
+            // Nothing more is coming: hand over the partial frame as is
+            _ready.insert(_ready.end(), _staging.begin(), _staging.end());
+            _staging.clear();
+            break;
+        }
+        _staging.insert(_staging.end(), chunk.begin(), chunk.end());
+        releaseFrames();
+    }
+
+    size_t n = 0;
+    while (n < length && !_ready.empty() && buffer.size() < buffer.max_size()) {
+        buffer.push_back(_ready.front());
+        _ready.pop_front();
+        ++n;
+    }
+    return n;
+}
+
+etl::expected<size_t, error::Error> FaultInjectingSerialBus::available() {
+    if (_disconnected) return ioError();
+    if (!_ready.empty()) return _ready.size();
+    auto pending = inner().available();
+    if (!pending.has_value() || pending.value() == 0) return pending;
+    // Report only what read() will hand over without waiting; pulling the
+    // bytes through here keeps drops from making the count a promise.
+    etl::vector<uint8_t, INNER_READ_CHUNK> chunk;
+    auto got = inner().read(chunk, std::min(pending.value(), INNER_READ_CHUNK), 0);
+    if (got.has_value()) {
+        _staging.insert(_staging.end(), chunk.begin(), chunk.end());
+        releaseFrames();
+    }
+    return _ready.size();
+}
+
+etl::expected<void, error::Error> FaultInjectingSerialBus::flush() {
+    if (_disconnected) return ioError();
+    _staging.clear();
+    _ready.clear();
+    return inner().flush();
+}
+
+void FaultInjectingSerialBus::releaseFrames() {
+    for (;;) {
+        const FrameScan scan = scanFrame(_staging.data(), _staging.size());
+        if (scan.status == FrameScanStatus::Incomplete) {
+            _ready.insert(_ready.end(), _staging.begin(), _staging.begin() + static_cast<std::ptrdiff_t>(scan.start));
+            _staging.erase(_staging.begin(), _staging.begin() + static_cast<std::ptrdiff_t>(scan.start));
+            return;
+        }
+
+        const size_t end = scan.start + scan.length;
+        std::vector<uint8_t> frame(_staging.begin(), _staging.begin() + static_cast<std::ptrdiff_t>(end));
+        _staging.erase(_staging.begin(), _staging.begin() + static_cast<std::ptrdiff_t>(end));
+
+        if (scan.status == FrameScanStatus::Information) {
+            if (roll(_profile.corruptChecksumRate)) {
+                frame.back() ^= 0x5A; // DCS
+                ++_counters.corruptedFrames;
+            }
+            if (roll(_profile.truncateFrameRate) && scan.dataLength > 1) {
+                const size_t keep = std::uniform_int_distribution<size_t>(
+                    scan.dataOffset + 1, scan.dataOffset + scan.dataLength - 1)(_rng);
+                frame.resize(keep);
+                ++_counters.truncatedFrames;
+            }
+        }
+        for (auto b : frame) {
+            if (roll(_profile.dropByteRate)) {
+                ++_counters.droppedBytes;
+                continue;
+            }
+            _ready.push_back(b);
+        }
+    }
+}
+
+} // namespace hardware
+} // namespace adapters
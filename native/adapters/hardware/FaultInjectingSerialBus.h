@@ -0,0 +1,84 @@
+#pragma once
+#include "SerialBusDecorator.h"
+#include "../../core/ports/IClock.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+// Link faults to inject, all drawn from one seeded generator so a run is
+// reproducible. Rates are probabilities in [0, 1].
+struct FaultProfile {
+    std::string name;
+    uint32_t seed = 1;
+
+    // Per read() call: stall for a uniform [delayMinMs, delayMaxMs] first.
+    double   delayProbability = 0.0;
+    uint32_t delayMinMs = 0;
+    uint32_t delayMaxMs = 0;
+
+    double dropByteRate        = 0.0; // per byte, both directions
+    double corruptChecksumRate = 0.0; // per PN532 information frame: DCS flipped
+    double truncateFrameRate   = 0.0; // per PN532 information frame: tail cut off
+    double disconnectRate      = 0.0; // per written frame: link lost until init()
+};
+
+struct FaultCounters {
+    uint64_t delays = 0;
+    uint64_t droppedBytes = 0;
+    uint64_t corruptedFrames = 0;
+    uint64_t truncatedFrames = 0;
+    uint64_t disconnects = 0;
+};
+
+/**
+ * Serial decorator that degrades a healthy link according to a
+ * FaultProfile, for exercising retry and recovery paths without a flaky
+ * cable. Received bytes are held back until they form complete PN532
+ * frames so checksum and truncation faults land on frame boundaries;
+ * a partial frame still pending when the inner bus times out is passed
+ * through untouched.
+ *
+ * A disconnect fails the triggering write and every later call with an
+ * I/O error until init() is called again, like a USB-serial bridge that
+ * re-enumerated.
+ *
+ * Delays and read deadlines are taken on `clock` (steady when null), so
+ * with a virtual clock shared with the inner bus a latency profile adds
+ * simulated time only.
+ */
+class FaultInjectingSerialBus : public SerialBusDecorator {
+public:
+    FaultInjectingSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner, FaultProfile profile,
+                            std::shared_ptr<core::ports::IClock> clock = nullptr);
+
+    const FaultProfile& profile() const { return _profile; }
+    const FaultCounters& counters() const { return _counters; }
+
+    etl::expected<void, error::Error>   init() override;
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+    etl::expected<size_t, error::Error> available() override;
+    etl::expected<void, error::Error>   flush() override;
+
+private:
+    bool roll(double probability);
+    // Moves every complete frame in _staging to _ready, faults applied.
+    void releaseFrames();
+
+    FaultProfile _profile;
+    std::shared_ptr<core::ports::IClock> _clock;
+    FaultCounters _counters;
+    std::mt19937 _rng;
+    bool _disconnected = false;
+    std::vector<uint8_t> _staging; // from the inner bus, not yet framed
+    std::deque<uint8_t> _ready;    // faults applied, waiting for read()
+};
+
+} // namespace hardware
+} // namespace adapters
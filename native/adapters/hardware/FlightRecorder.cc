@@ -0,0 +1,182 @@
+#include "FlightRecorder.h"
+#include "Pn532Frames.h"
+#include "../timing/SteadyClock.h"
+#include <algorithm>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+constexpr uint8_t PN532_CMD_IN_COMMUNICATE_THRU = 0x42;
+constexpr uint8_t DESFIRE_ADDITIONAL_FRAME = 0xAF;
+
+// Card frame inside an InDataExchange (D4 40 Tg ...) or InCommunicateThru
+// (D4 42 ...) frame, after TFI and command code.
+static size_t cardFrameOffset(uint8_t command) {
+    return command == PN532_CMD_IN_DATA_EXCHANGE ? 3 : 2;
+}
+
+static bool isCardExchange(uint8_t command) {
+    return command == PN532_CMD_IN_DATA_EXCHANGE || command == PN532_CMD_IN_COMMUNICATE_THRU;
+}
+
+// DESFire command wrapped in ISO 7816: 90 INS 00 00 Lc ..
+static bool isIsoWrapped(const uint8_t* frame, size_t len) {
+    return len >= 5 && frame[0] == 0x90 && frame[2] == 0x00 && frame[3] == 0x00;
+}
+
+// Longest native frame (command byte included) of the DESFire commands
+// whose payloads may be kept; 0 for every other command. The length bound
+// keeps a non-DESFire command that shares a code (MIFARE Classic
+// authentication is 0x60 + key) out of the record.
+static size_t publicCommandMaxLength(uint8_t command) {
+    switch (command) {
+        case 0x5A: return 4; // SelectApplication AID
+        case 0x6A: return 1; // GetApplicationIDs
+        case 0x60: return 1; // GetVersion
+        case 0x6E: return 1; // FreeMemory
+        case 0x6F: return 1; // GetFileIDs
+        case 0x45: return 1; // GetKeySettings
+        case 0x64: return 2; // GetKeyVersion KeyNo
+        case 0xF5: return 2; // GetFileSettings FileNo
+        default:   return 0;
+    }
+}
+
+static const char* kindName(uint8_t kind) {
+    static const char* const names[] = {"info", "ack", "nack", "error", "checksum", "timeout", "io"};
+    return kind < sizeof(names) / sizeof(names[0]) ? names[kind] : "info";
+}
+
+} // anonymous namespace
+
+FlightRecorder::FlightRecorder(std::shared_ptr<core::ports::IClock> clock)
+    : _clock(clock ? std::move(clock) : timing::steadyClock()) {}
+
+FlightRecorder::Entry& FlightRecorder::push() {
+    Entry& e = _ring[_next];
+    e = Entry{};
+    _next = (_next + 1) % kCapacity;
+    if (_count < kCapacity) ++_count;
+    return e;
+}
+
+void FlightRecorder::onFrame(const FrameEvent& event) {
+    const bool fromHost = event.direction == FrameDirection::HostToPn532;
+    Kind kind = Kind::Info;
+    switch (event.status) {
+        case FrameScanStatus::Ack:           kind = Kind::Ack; break;
+        case FrameScanStatus::Nack:          kind = Kind::Nack; break;
+        case FrameScanStatus::ErrorFrame:    kind = Kind::Error; break;
+        case FrameScanStatus::ChecksumError: kind = Kind::Checksum; break;
+        case FrameScanStatus::Information:   kind = Kind::Info; break;
+        case FrameScanStatus::Incomplete:    return;
+    }
+
+    const uint8_t* data = event.data;
+    const size_t len = kind == Kind::Info ? event.dataLength : 0;
+    uint8_t code = len >= 2 ? data[1] : 0;
+    int16_t desfire = -1;
+    size_t kept = std::min(len, kBytesKept);
+    bool redacted = false;
+
+    if (len >= 2 && fromHost && data[0] == PN532_TFI_HOST_TO_PN532 && isCardExchange(code)) {
+        const size_t offset = cardFrameOffset(code);
+        if (len > offset) {
+            const uint8_t* card = data + offset;
+            const size_t cardLen = len - offset;
+            const bool wrapped = isIsoWrapped(card, cardLen);
+            const uint8_t command = wrapped ? card[1] : card[0];
+            // Native length: wrapped frames carry Lc data bytes after INS
+            const size_t nativeLen = wrapped ? 1 + card[4] : cardLen;
+            if (command != DESFIRE_ADDITIONAL_FRAME || !_cardExchangePending) {
+                const size_t maxLen = publicCommandMaxLength(command);
+                _chainRedacted = maxLen == 0 || nativeLen > maxLen;
+            }
+            _chainWrapped = wrapped;
+            desfire = command;
+            redacted = _chainRedacted;
+            if (redacted) kept = offset + (wrapped ? 2 : 1); // up to INS
+        }
+        _cardExchangePending = true;
+    } else if (len >= 3 && !fromHost && data[0] == PN532_TFI_PN532_TO_HOST && _cardExchangePending &&
+               isCardExchange(static_cast<uint8_t>(code - 1))) {
+        // D5 41/43, PN532 status, then the card's answer
+        const uint8_t* card = data + 3;
+        const size_t cardLen = len - 3;
+        if ((data[2] & 0x3F) == 0x00 && cardLen > 0) {
+            if (!_chainWrapped) desfire = card[0];
+            else if (cardLen >= 2 && card[cardLen - 2] == 0x91) desfire = card[cardLen - 1];
+        }
+        redacted = _chainRedacted;
+        if (redacted) kept = std::min<size_t>(len, _chainWrapped ? 3 : 4); // through the status
+        // An 0xAF answer keeps the chain open for the host's continuation
+        if (desfire != DESFIRE_ADDITIONAL_FRAME) _cardExchangePending = false;
+    } else if (len >= 2 && fromHost && data[0] == PN532_TFI_HOST_TO_PN532) {
+        _cardExchangePending = false; // any other command ends a DESFire chain
+    }
+
+    const auto at = _clock->now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry& e = push();
+    e.at = at;
+    e.kind = kind;
+    e.fromHost = fromHost;
+    e.redacted = redacted;
+    e.code = code;
+    e.desfire = desfire;
+    e.length = static_cast<uint16_t>(std::min<size_t>(len, UINT16_MAX));
+    e.byteCount = static_cast<uint8_t>(kept);
+    std::copy(data, data + kept, e.bytes.begin());
+}
+
+void FlightRecorder::onReadTimeout() {
+    const auto at = _clock->now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_count > 0) {
+        Entry& last = _ring[(_next + kCapacity - 1) % kCapacity];
+        if (last.kind == Kind::Timeout && last.repeat < UINT16_MAX) {
+            ++last.repeat;
+            last.at = at;
+            return;
+        }
+    }
+    Entry& e = push();
+    e.at = at;
+    e.kind = Kind::Timeout;
+}
+
+void FlightRecorder::onIoError(FrameDirection direction) {
+    const auto at = _clock->now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry& e = push();
+    e.at = at;
+    e.kind = Kind::Io;
+    e.fromHost = direction == FrameDirection::HostToPn532;
+}
+
+std::vector<core::ports::RecordedFrame> FlightRecorder::snapshot(core::ports::IClock::TimePoint reference) const {
+    std::vector<core::ports::RecordedFrame> frames;
+    std::lock_guard<std::mutex> lock(_mutex);
+    frames.reserve(_count);
+    const size_t first = (_next + kCapacity - _count) % kCapacity;
+    for (size_t i = 0; i < _count; ++i) {
+        const Entry& e = _ring[(first + i) % kCapacity];
+        core::ports::RecordedFrame f;
+        f.offsetUs = std::chrono::duration_cast<std::chrono::microseconds>(e.at - reference).count();
+        f.fromHost = e.fromHost;
+        f.kind = kindName(static_cast<uint8_t>(e.kind));
+        f.code = e.code;
+        f.desfire = e.desfire;
+        f.length = e.length;
+        f.repeat = e.repeat;
+        f.redacted = e.redacted;
+        f.bytes.assign(e.bytes.begin(), e.bytes.begin() + e.byteCount);
+        frames.push_back(std::move(f));
+    }
+    return frames;
+}
+
+} // namespace hardware
+} // namespace adapters
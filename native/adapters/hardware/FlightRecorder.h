@@ -0,0 +1,76 @@
+#pragma once
+#include "MonitoredSerialBus.h"
+#include "../../core/ports/IClock.h"
+#include "../../core/ports/INfcReader.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * Always-on record of the last kCapacity PN532 frames, for failure reports.
+ *
+ * Memory is fixed at construction. Per frame it stores the direction, time,
+ * command code, DESFire command or status, length and the first kBytesKept
+ * bytes. Card payloads are kept only for DESFire commands that carry no
+ * secrets (selection, listing, versions, settings). Authentication, key
+ * changes, data reads and writes, and their 0xAF continuations keep only
+ * the header bytes. Consecutive read timeouts fold into one entry.
+ *
+ * Frame callbacks run under the adapter mutex; snapshot() may be called
+ * from any thread.
+ */
+class FlightRecorder : public ISerialObserver {
+public:
+    static constexpr size_t kCapacity = 64;
+    static constexpr size_t kBytesKept = 16;
+
+    // Frame times are taken on `clock`; null selects the steady clock.
+    explicit FlightRecorder(std::shared_ptr<core::ports::IClock> clock = nullptr);
+
+    void onFrame(const FrameEvent& event) override;
+    void onReadTimeout() override;
+    void onIoError(FrameDirection direction) override;
+
+    // The ring oldest first, times relative to `reference`.
+    std::vector<core::ports::RecordedFrame> snapshot(core::ports::IClock::TimePoint reference) const;
+
+    core::ports::IClock::TimePoint now() const { return _clock->now(); }
+
+private:
+    enum class Kind : uint8_t { Info, Ack, Nack, Error, Checksum, Timeout, Io };
+
+    struct Entry {
+        core::ports::IClock::TimePoint at;
+        Kind     kind = Kind::Info;
+        bool     fromHost = false;
+        bool     redacted = false;
+        uint8_t  code = 0;
+        int16_t  desfire = -1;
+        uint16_t length = 0;
+        uint16_t repeat = 1;
+        uint8_t  byteCount = 0;
+        std::array<uint8_t, kBytesKept> bytes{};
+    };
+
+    // Appends under _mutex, overwriting the oldest entry when full.
+    Entry& push();
+
+    std::shared_ptr<core::ports::IClock> _clock;
+
+    mutable std::mutex _mutex; // uncontended except against snapshot()
+    std::array<Entry, kCapacity> _ring;
+    size_t _next = 0;
+    size_t _count = 0;
+
+    // DESFire chain state — touched only from frame callbacks
+    bool _chainRedacted = true;
+    bool _chainWrapped = false;
+    bool _cardExchangePending = false;
+};
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,89 @@
+#include "MonitoredSerialBus.h"
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+// Upper bound for unframed bytes kept while waiting for a start code;
+// a PN532 extended frame is at most ~270 bytes.
+constexpr size_t MAX_PENDING = 1024;
+
+static bool isTimeout(const error::Error& err) {
+    return (err.is<error::HardwareError>() && err.get<error::HardwareError>() == error::HardwareError::Timeout) ||
+           (err.is<error::Pn532Error>()    && err.get<error::Pn532Error>()    == error::Pn532Error::Timeout);
+}
+
+} // anonymous namespace
+
+MonitoredSerialBus::MonitoredSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner)
+    : SerialBusDecorator(std::move(inner)) {}
+
+void MonitoredSerialBus::addObserver(ISerialObserver* observer) {
+    _observers.push_back(observer);
+}
+
+etl::expected<void, error::Error> MonitoredSerialBus::write(const etl::ivector<uint8_t>& data) {
+    auto result = inner().write(data);
+    if (!result.has_value()) {
+        for (auto* o : _observers) o->onIoError(FrameDirection::HostToPn532);
+        return result;
+    }
+
+    for (auto* o : _observers) o->onBytes(FrameDirection::HostToPn532, data.size());
+    _txPending.insert(_txPending.end(), data.begin(), data.end());
+    drainFrames(FrameDirection::HostToPn532, _txPending);
+    return result;
+}
+
+etl::expected<size_t, error::Error> MonitoredSerialBus::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    auto result = inner().read(buffer, length, timeoutMs);
+    if (!result.has_value()) {
+        if (isTimeout(result.error())) {
+            for (auto* o : _observers) o->onReadTimeout();
+        } else {
+            for (auto* o : _observers) o->onIoError(FrameDirection::Pn532ToHost);
+        }
+        return result;
+    }
+
+    // The new bytes are the last `count` in the buffer, whether the backend
+    // appends to or refills it.
+    const size_t count = result.value() <= buffer.size() ? result.value() : buffer.size();
+    if (count > 0) {
+        for (auto* o : _observers) o->onBytes(FrameDirection::Pn532ToHost, count);
+        _rxPending.insert(_rxPending.end(), buffer.end() - static_cast<std::ptrdiff_t>(count), buffer.end());
+        drainFrames(FrameDirection::Pn532ToHost, _rxPending);
+    }
+    return result;
+}
+
+void MonitoredSerialBus::drainFrames(FrameDirection direction, std::vector<uint8_t>& pending) {
+    size_t offset = 0;
+    for (;;) {
+        const FrameScan scan = scanFrame(pending.data() + offset, pending.size() - offset);
+        if (scan.status == FrameScanStatus::Incomplete) {
+            offset += scan.start;
+            break;
+        }
+
+        FrameEvent event;
+        event.direction   = direction;
+        event.status      = scan.status;
+        event.frame       = pending.data() + offset + scan.start;
+        event.frameLength = scan.length;
+        if (scan.status == FrameScanStatus::Information) {
+            event.data       = pending.data() + offset + scan.dataOffset;
+            event.dataLength = scan.dataLength;
+        }
+        for (auto* o : _observers) o->onFrame(event);
+        offset += scan.start + scan.length;
+    }
+
+    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(offset));
+    if (pending.size() > MAX_PENDING) pending.clear();
+}
+
+} // namespace hardware
+} // namespace adapters
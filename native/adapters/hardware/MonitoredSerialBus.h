@@ -0,0 +1,57 @@
+#pragma once
+#include "SerialBusDecorator.h"
+#include "Pn532Frames.h"
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+enum class FrameDirection { HostToPn532, Pn532ToHost };
+
+// One PN532 frame seen on the wire. Pointers are only valid during the callback.
+struct FrameEvent {
+    FrameDirection  direction;
+    FrameScanStatus status;              // never Incomplete
+    const uint8_t*  frame       = nullptr; // from the start code through DCS
+    size_t          frameLength = 0;
+    const uint8_t*  data        = nullptr; // TFI + PD, Information frames only
+    size_t          dataLength  = 0;
+};
+
+class ISerialObserver {
+public:
+    virtual ~ISerialObserver() = default;
+    virtual void onFrame(const FrameEvent& /*event*/) {}
+    virtual void onBytes(FrameDirection /*direction*/, size_t /*count*/) {}
+    virtual void onReadTimeout() {}
+    virtual void onIoError(FrameDirection /*direction*/) {}
+};
+
+/**
+ * Serial decorator that reassembles PN532 frames in both directions and
+ * reports them to observers. Sits below Pn532Driver and the raw channel,
+ * so it sees every byte regardless of who sent it.
+ *
+ * Observers are registered before the bus is used and must outlive it.
+ * Callbacks run on the thread doing the I/O (i.e. under the adapter mutex).
+ */
+class MonitoredSerialBus : public SerialBusDecorator {
+public:
+    explicit MonitoredSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner);
+
+    void addObserver(ISerialObserver* observer);
+
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+
+private:
+    // Emits every complete frame in `pending` and drops the consumed bytes.
+    void drainFrames(FrameDirection direction, std::vector<uint8_t>& pending);
+
+    std::vector<ISerialObserver*> _observers;
+    std::vector<uint8_t> _txPending;
+    std::vector<uint8_t> _rxPending;
+};
+
+} // namespace hardware
+} // namespace adapters
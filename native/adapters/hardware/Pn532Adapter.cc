@@ -1,5 +1,18 @@
 #include "Pn532Adapter.h"
 #include "SerialBusPlatform.h"
+#include "Pn532Frames.h"
+#include "Pn532RawChannel.h"
+#include "MonitoredSerialBus.h"
+#include "SerialWaker.h"
+#include "ReaderTelemetry.h"
+#include "SpanTracer.h"
+#include "TracingSerialBus.h"
+#include "DesfireAesSession.h"
+#include "FlightRecorder.h"
+#include "TimedMutex.h"
+#include "../crypto/AesKeyBase.h"
+#include "../crypto/CryptoProviderFactory.h"
+#include "../timing/SteadyClock.h"
 #include "Comms/Serial/ISerialBus.hpp"
 #include "Pn532/Pn532Driver.h"
 #include "Pn532/Commands/PerformSelfTest.h"
@@ -11,6 +24,7 @@
 #include "Nfc/Desfire/DesfireCard.h"
 #include "Error/Error.h"
 #include "Utils/Logging.h"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -19,11 +33,24 @@ namespace hardware {
 
 namespace {
 
-// Convert a 16-byte std::array key into an etl::vector for DESFire API calls.
-static etl::vector<uint8_t, 24> toEtlKey(const std::array<uint8_t, 16>& arr) {
-    etl::vector<uint8_t, 24> v;
-    for (auto b : arr) v.push_back(b);
-    return v;
+// A 16-byte key as the etl::vector the DESFire API takes, wiped when it
+// goes out of scope. Pass `EtlKey(key).bytes` so the copy lives only for
+// the call.
+struct EtlKey {
+    explicit EtlKey(const std::array<uint8_t, 16>& arr) {
+        for (auto b : arr) bytes.push_back(b);
+    }
+    ~EtlKey() { crypto::secureZero(bytes.data(), bytes.size()); }
+    EtlKey(const EtlKey&) = delete;
+    EtlKey& operator=(const EtlKey&) = delete;
+
+    etl::vector<uint8_t, 24> bytes;
+};
+
+// ChangeKey options carry copies of both keys
+static void wipeKeys(nfc::ChangeKeyCommandOptions& opts) {
+    crypto::secureZero(opts.newKey.data(), opts.newKey.size());
+    crypto::secureZero(opts.oldKey.data(), opts.oldKey.size());
 }
 
 // Translate an etl error::Error into a core NfcError, preserving known error codes.
@@ -42,17 +69,74 @@ static core::ports::NfcError errFromEtl(const error::Error& err) {
     return core::ports::NfcError{"HARDWARE_ERROR", std::string(err.toString().c_str())};
 }
 
+// Response timeout for the short housekeeping commands sent over the raw channel
+constexpr uint32_t RAW_COMMAND_TIMEOUT_MS = 100;
+
+// Response timeout for card commands relayed with InDataExchange
+constexpr uint32_t CARD_COMMAND_TIMEOUT_MS = 500;
+
+// Cards whose GetVersion hardware generation is remembered (EV1 vs EV2+)
+constexpr size_t CARD_GENERATION_CACHE_SIZE = 32;
+
+// GetGeneralStatus sampling: periodically while the reader sits idle and
+// awake, and after a burst of activity — but never more often than the
+// minimum interval, so Latency mode does not add a command per operation.
+constexpr std::chrono::seconds HEALTH_SAMPLE_INTERVAL{30};
+constexpr std::chrono::seconds HEALTH_SAMPLE_MIN_INTERVAL{5};
+
+// Latency mode keeps no idle timeout, but still lets the reader settle
+// before idle work: longer than the 200 ms card-probe interval, so a
+// polling loop never finds the idle thread holding the reader.
+constexpr std::chrono::milliseconds LATENCY_IDLE_SETTLE{250};
+
 } // anonymous namespace
 
-Pn532Adapter::Pn532Adapter() {}
+Pn532Adapter::Pn532Adapter(std::shared_ptr<const core::ports::ICryptoProvider> cryptoProvider,
+                           std::shared_ptr<core::ports::IClock> clock)
+    : _crypto(cryptoProvider ? std::move(cryptoProvider) : crypto::createCryptoProvider()),
+      _clock(clock ? std::move(clock) : timing::steadyClock()),
+      _telemetry(std::make_unique<ReaderTelemetry>(_clock)),
+      _tracer(std::make_unique<SpanTracer>(_clock)),
+      _recorder(std::make_unique<FlightRecorder>(_clock)),
+      _ioWaker(std::make_shared<SerialWaker>()) {
+    _idleThread = std::thread([this] { idleLoop(); });
+}
 
 Pn532Adapter::~Pn532Adapter() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    {
+        std::lock_guard<std::mutex> idleLock(_idleMutex);
+        _stopIdleThread = true;
+    }
+    _idleCv.notify_all();
+    if (_idleThread.joinable()) _idleThread.join();
+
+    std::lock_guard<TimedMutex> lock(_mutex);
     disconnectNoLock();
 }
 
+Pn532Adapter::OperationScope::OperationScope(Pn532Adapter& adapter, bool usesRf)
+    : _adapter(adapter), _usesRf(usesRf) {
+    _adapter._ioWaker->clear(); // a cancel aimed at an earlier operation does not carry over
+    if (_adapter._poweredDown) {
+        auto woke = _adapter.wakeNoLock();
+        if (std::holds_alternative<core::ports::NfcError>(woke)) {
+            _wakeError = std::get<core::ports::NfcError>(woke);
+        }
+    }
+}
+
+Pn532Adapter::OperationScope::~OperationScope() {
+    // InListPassiveTarget raises the field and nothing in the card flows drops it
+    if (_usesRf && !_wakeError) _adapter._rfFieldOn = true;
+    _adapter.noteActivity();
+}
+
 void Pn532Adapter::disconnectNoLock() {
     if (!_serial) return;
+    // Leave the PN532 awake so the next owner of the port can talk to it
+    if (_poweredDown && _raw) (void)wakeNoLock();
+    _connected = false;
+    _raw.reset();
     _cardManager.reset();  // holds refs to _apduAdapter
     _apduAdapter.reset();  // holds ref to _pn532
     _pn532.reset();        // destroy driver first — it holds a reference to serial
@@ -61,24 +145,46 @@ void Pn532Adapter::disconnectNoLock() {
 }
 
 core::ports::Result<std::string> Pn532Adapter::connect(const std::string& port) {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "connect", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     try {
         if (_serial) {
             return core::ports::NfcError{"HARDWARE_ERROR", "Already connected to a port."};
         }
 
-        auto serial = createPlatformSerialBus(port, 115200);
-        if (!serial) {
+        auto platformSerial = _serialFactory
+            ? _serialFactory(port)
+            : createPlatformSerialBus(port, 115200, SerialBackend::Auto, _ioWaker);
+        if (!platformSerial) {
             return core::ports::NfcError{
                 "NOT_SUPPORTED",
                 "Serial backend is not available on this platform yet."
             };
         }
 
+        _telemetry->reset();
+        const comms::serial::ISerialBus& platformBus = *platformSerial; // owned by `serial` below
+        auto traced = std::make_unique<TracingSerialBus>(std::move(platformSerial), *_tracer);
+        TracingSerialBus* tracing = traced.get(); // owned by `monitored`
+        auto monitored = std::make_unique<MonitoredSerialBus>(std::move(traced));
+        monitored->addObserver(_telemetry.get());
+        monitored->addObserver(tracing);
+        monitored->addObserver(_recorder.get());
+        std::unique_ptr<comms::serial::ISerialBus> serial = std::move(monitored);
+
         auto initResult = serial->init();
         if (!initResult.has_value()) {
             return core::ports::NfcError{"HARDWARE_ERROR", "Failed to initialize serial port: " + port};
         }
+        _telemetry->recordLinkTuning(serialLinkTuning(platformBus));
+
+        // HSU wake-up preamble: harmless to an awake PN532, and gets one left
+        // in PowerDown by a previous session (or crashed process) listening again.
+        {
+            etl::vector<uint8_t, 16> wake;
+            for (auto b : hsuWakePreamble()) wake.push_back(b);
+            (void)serial->write(wake);
+        }
 
         auto pn532 = std::make_unique<pn532::Pn532Driver>(*serial);
         pn532->init();
@@ -92,6 +198,14 @@ core::ports::Result<std::string> Pn532Adapter::connect(const std::string& port)
         nfc::ReaderCapabilities caps = nfc::ReaderCapabilities::pn532();
         _apduAdapter = std::make_unique<pn532::Pn532ApduAdapter>(*_pn532);
         _cardManager = std::make_unique<nfc::CardManager>(*_apduAdapter, *_apduAdapter, caps);
+        _raw = std::make_unique<Pn532RawChannel>(*_serial, _ioWaker.get(), _clock.get());
+
+        _rfFieldOn = false;
+        _poweredDown = false;
+        _wakeCount = 0;
+        _lastWakeLatencyUs = 0;
+        _connected = true;
+        noteActivity(); // arm the idle policy for the fresh connection
 
         return "Successfully connected to PN532 on " + port;
     } catch (const std::exception& e) {
@@ -99,8 +213,14 @@ core::ports::Result<std::string> Pn532Adapter::connect(const std::string& port)
     }
 }
 
+void Pn532Adapter::setSerialBusFactory(SerialBusFactory factory) {
+    std::lock_guard<TimedMutex> lock(_mutex);
+    _serialFactory = std::move(factory);
+}
+
 core::ports::Result<bool> Pn532Adapter::disconnect() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "disconnect", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     try {
         disconnectNoLock();
         return true;
@@ -118,11 +238,15 @@ void Pn532Adapter::setLogCallback(core::ports::NfcLogCallback callback) {
 }
 
 core::ports::Result<std::string> Pn532Adapter::getFirmwareVersion() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "getFirmwareVersion", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) {
         return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
     }
 
+    OperationScope op(*this, false);
+    if (op.wakeError()) return *op.wakeError();
+
     auto result = _pn532->getFirmwareVersion();
     if (!result.has_value()) {
         const auto& err = result.error();
@@ -147,11 +271,15 @@ core::ports::Result<std::string> Pn532Adapter::getFirmwareVersion() {
 }
 
 core::ports::Result<core::ports::SelfTestReport> Pn532Adapter::runSelfTests(core::ports::SelfTestProgressCb onResult) {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "runSelfTests", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) {
         return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
     }
 
+    OperationScope op(*this, false);
+    if (op.wakeError()) return *op.wakeError();
+
     // Canonical order is contractual — must match SELF_TEST_NAMES[] in INfcReader.h
     static constexpr struct { const char* name; pn532::TestType type; } TESTS[5] = {
         { "ROM Check",     pn532::TestType::RomChecksum       },
@@ -191,11 +319,15 @@ core::ports::Result<core::ports::SelfTestReport> Pn532Adapter::runSelfTests(core
 }
 
 core::ports::Result<core::ports::CardVersionInfo> Pn532Adapter::getCardVersion() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "getCardVersion", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) {
         return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
     }
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) {
         const auto& err = detectResult.error();
@@ -251,6 +383,8 @@ core::ports::Result<core::ports::CardVersionInfo> Pn532Adapter::getCardVersion()
     //   Bytes  7-13: Software info (vendorId, swType, swSubtype, swMajor, swMinor, storageCode, protocol)
     //   Bytes 14-27: UID (7 bytes) + batch info
     if (versionData.size() >= 14) {
+        rememberCardHwMajorNoLock(std::vector<uint8_t>(cardInfo.uid.begin(), cardInfo.uid.end()), versionData[3]);
+
         std::ostringstream hwSS;
         hwSS << static_cast<int>(versionData[3]) << "." << static_cast<int>(versionData[4]);
         info.hwVersion = hwSS.str();
@@ -305,9 +439,13 @@ core::ports::Result<core::ports::CardVersionInfo> Pn532Adapter::getCardVersion()
 // ---------------------------------------------------------------------------
 
 core::ports::Result<std::vector<uint8_t>> Pn532Adapter::peekCardUid() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "peekCardUid", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
 
@@ -318,9 +456,13 @@ core::ports::Result<std::vector<uint8_t>> Pn532Adapter::peekCardUid() {
 }
 
 core::ports::Result<bool> Pn532Adapter::isCardInitialised() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "isCardInitialised", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
     if (detectResult.value().type != CardType::MifareDesfire)
@@ -352,9 +494,13 @@ core::ports::Result<bool> Pn532Adapter::isCardInitialised() {
 }
 
 core::ports::Result<core::ports::CardProbeResult> Pn532Adapter::probeCard() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "probeCard", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     // Single InListPassiveTarget call — shared by both uid extraction and AID check
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
@@ -400,11 +546,32 @@ core::ports::Result<core::ports::CardProbeResult> Pn532Adapter::probeCard() {
     return probe;
 }
 
-core::ports::Result<bool> Pn532Adapter::initCard(const core::ports::CardInitOptions& opts) {
+// Card init runs as a resumable sequence. The card is inspected first
+// (plain commands, no authentication) and every step already present on the
+// card is skipped, so a card pulled mid-init is finished in one short
+// transaction on the next tap instead of FormatPICC + full reinit.
+//
+//   configurePicc      PICC auth (default key), disable random UID   — skipped if app exists
+//   createApplication  AID with 2 AES keys                          — skipped if app exists
+//   createFile         File 00, 32 B backup, read=key1, rest=key0   — skipped if file exists
+//   changeReadKey      key 1 -> readKey, version 1                  — skipped if key 1 version is 1
+//   writeSecret        card secret + 16 reserved bytes, commit      — skipped if File 00 holds a secret
+//   changeMasterKey    key 0 -> appMasterKey, version 1             — skipped if key 0 is not default
+//
+// The master key is changed last so key 0 still authenticates with the
+// default key until everything else is in place; key version 1 on key 0
+// marks a completed init. Cards provisioned before this ordering carry
+// appMasterKey as version 0, which is why authentication falls back to
+// appMasterKey when the default key is rejected.
+core::ports::Result<core::ports::CardInitReport> Pn532Adapter::initCard(const core::ports::CardInitOptions& opts) {
     const std::array<uint8_t, 16> zeros16 = {};
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "initCard", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
     if (detectResult.value().type != CardType::MifareDesfire)
@@ -424,87 +591,182 @@ core::ports::Result<bool> Pn532Adapter::initCard(const core::ports::CardInitOpti
     etl::array<uint8_t, 3> appAid;
     for (size_t i = 0; i < 3; ++i) appAid[i] = opts.aid[i];
 
-    // Step 1 — Select PICC and authenticate with default ISO key
-    auto r1 = desfireCard->selectApplication(piccAid);
-    if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
+    const std::vector<uint8_t> uid(detectResult.value().uid.begin(), detectResult.value().uid.end());
 
-    auto r2 = desfireCard->authenticate(0, toEtlKey(zeros16), DesfireAuthMode::ISO);
-    if (!r2.has_value()) { _cardManager->clearSession(); return errFromEtl(r2.error()); }
+    core::ports::CardInitReport report;
+    auto step = [&report](const char* name, bool run) {
+        (run ? report.stepsRun : report.stepsSkipped).emplace_back(name);
+        return run;
+    };
 
-    // Step 2 — Disable random UID
-    auto r3 = desfireCard->setConfigurationPicc(0x00, DesfireAuthMode::ISO);
-    if (!r3.has_value()) { _cardManager->clearSession(); return errFromEtl(r3.error()); }
+    // ── Inspect ──────────────────────────────────────────────────────────────
+    bool appPresent = false;
+    bool filePresent = false;
+    bool readKeySet = false;
+    bool secretPresent = false;
+    uint8_t masterKeyVersion = 0;
+    {
+        auto r1 = desfireCard->selectApplication(piccAid);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
 
-    // Step 3 — Create application (2 AES keys)
-    auto r4 = desfireCard->createApplication(appAid, 0x0F, 2, DesfireKeyType::AES);
-    if (!r4.has_value()) { _cardManager->clearSession(); return errFromEtl(r4.error()); }
+        auto aids = desfireCard->getApplicationIds();
+        if (!aids.has_value()) { _cardManager->clearSession(); return errFromEtl(aids.error()); }
+        for (const auto& aid : aids.value()) {
+            if (aid == appAid) { appPresent = true; break; }
+        }
+    }
 
-    // Step 4 — Select application
-    auto r5 = desfireCard->selectApplication(appAid);
-    if (!r5.has_value()) { _cardManager->clearSession(); return errFromEtl(r5.error()); }
+    if (appPresent) {
+        auto r1 = desfireCard->selectApplication(appAid);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
+
+        // GetKeyVersion (0x64) and GetFileIDs (0x6F) are plain commands while
+        // unauthenticated; the app is created with key settings 0x0F, so the
+        // file directory is readable without a key.
+        auto kv0 = desfireCommandNoLock(0x64, {0x00});
+        if (std::holds_alternative<core::ports::NfcError>(kv0)) { _cardManager->clearSession(); return std::get<core::ports::NfcError>(kv0); }
+        auto kv1 = desfireCommandNoLock(0x64, {0x01});
+        if (std::holds_alternative<core::ports::NfcError>(kv1)) { _cardManager->clearSession(); return std::get<core::ports::NfcError>(kv1); }
+        auto fids = desfireCommandNoLock(0x6F, {});
+        if (std::holds_alternative<core::ports::NfcError>(fids)) { _cardManager->clearSession(); return std::get<core::ports::NfcError>(fids); }
+
+        const auto& kv0Data = std::get<std::vector<uint8_t>>(kv0);
+        const auto& kv1Data = std::get<std::vector<uint8_t>>(kv1);
+        const auto& fileIds = std::get<std::vector<uint8_t>>(fids);
+        masterKeyVersion = kv0Data.empty() ? 0 : kv0Data[0];
+        readKeySet = !kv1Data.empty() && kv1Data[0] == 1;
+        filePresent = std::find(fileIds.begin(), fileIds.end(), 0x00) != fileIds.end();
+
+        // A committed secret is the only step that cannot be seen without a
+        // key. The read key proves it (and proves the card is ours).
+        if (readKeySet && filePresent) {
+            DesfireAesSession aes = makeAesSessionNoLock(uid);
+            auto r2 = aes.authenticate(1, opts.readKey);
+            noteAesSessionNoLock(uid, aes);
+            if (std::holds_alternative<core::ports::NfcError>(r2)) { _cardManager->clearSession(); return std::get<core::ports::NfcError>(r2); }
+            auto r3 = aes.readDataEnciphered(0, 0, 16);
+            if (std::holds_alternative<core::ports::NfcError>(r3)) { _cardManager->clearSession(); return std::get<core::ports::NfcError>(r3); }
+            auto& secret = std::get<std::vector<uint8_t>>(r3);
+            for (auto b : secret) {
+                if (b != 0x00) { secretPresent = true; break; }
+            }
+            crypto::secureZero(secret.data(), secret.size());
+
+            // Fully provisioned: only key 0 ownership is left to confirm. On
+            // EV2 cards this is a NonFirst re-auth in the same transaction.
+            if (secretPresent && masterKeyVersion == 1) {
+                auto r4 = aes.authenticate(0, opts.appMasterKey);
+                _cardManager->clearSession();
+                if (std::holds_alternative<core::ports::NfcError>(r4)) return std::get<core::ports::NfcError>(r4);
+                report.resumed = true;
+                for (const char* name : {"configurePicc", "createApplication", "createFile",
+                                         "changeReadKey", "writeSecret", "changeMasterKey"}) {
+                    step(name, false);
+                }
+                return report;
+            }
 
-    // Step 5 — Authenticate with default AES key 0
-    auto r6 = desfireCard->authenticate(0, toEtlKey(zeros16), DesfireAuthMode::AES);
-    if (!r6.has_value()) { _cardManager->clearSession(); return errFromEtl(r6.error()); }
+            auto r4 = desfireCard->selectApplication(appAid); // drop the key-1 session
+            if (!r4.has_value()) { _cardManager->clearSession(); return errFromEtl(r4.error()); }
+        }
+        report.resumed = true;
+    }
 
-    // Step 6 — Create encrypted backup data file (32 bytes; read=key1, rest=key0)
-    auto r7 = desfireCard->createBackupDataFile(0, 0x03, 0x01, 0x00, 0x00, 0x00, 32);
-    if (!r7.has_value()) { _cardManager->clearSession(); return errFromEtl(r7.error()); }
+    // ── Provision ────────────────────────────────────────────────────────────
+    const bool needsApp = !appPresent;
+    if (step("configurePicc", needsApp)) {
+        auto r1 = desfireCard->authenticate(0, EtlKey(zeros16).bytes, DesfireAuthMode::ISO);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
 
-    // Step 7 — Change key 1 to readKey (authenticated as key 0, so oldKey required)
-    {
+        auto r2 = desfireCard->setConfigurationPicc(0x00, DesfireAuthMode::ISO);
+        if (!r2.has_value()) { _cardManager->clearSession(); return errFromEtl(r2.error()); }
+    }
+
+    if (step("createApplication", needsApp)) {
+        auto r1 = desfireCard->createApplication(appAid, 0x0F, 2, DesfireKeyType::AES);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
+
+        auto r2 = desfireCard->selectApplication(appAid);
+        if (!r2.has_value()) { _cardManager->clearSession(); return errFromEtl(r2.error()); }
+    }
+
+    // Authenticate as key 0: default key unless a completed (version 1) or
+    // legacy-ordered init already replaced it.
+    bool masterKeySet = masterKeyVersion == 1;
+    if (!masterKeySet) {
+        auto r1 = desfireCard->authenticate(0, EtlKey(zeros16).bytes, DesfireAuthMode::AES);
+        if (!r1.has_value()) {
+            if (!appPresent) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
+            masterKeySet = true;
+        }
+    }
+    if (masterKeySet) {
+        auto r1 = desfireCard->authenticate(0, EtlKey(opts.appMasterKey).bytes, DesfireAuthMode::AES);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
+    }
+
+    if (step("createFile", !filePresent)) {
+        auto r1 = desfireCard->createBackupDataFile(0, 0x03, 0x01, 0x00, 0x00, 0x00, 32);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
+    }
+
+    // Authenticated as key 0, so the old key is required
+    if (step("changeReadKey", !readKeySet)) {
         nfc::ChangeKeyCommandOptions ckOpts;
         ckOpts.keyNo       = 1;
         ckOpts.authMode    = DesfireAuthMode::AES;
         ckOpts.newKeyType  = DesfireKeyType::AES;
         ckOpts.oldKeyType  = DesfireKeyType::AES;
-        ckOpts.newKey      = toEtlKey(opts.readKey);
+        ckOpts.newKey      = EtlKey(opts.readKey).bytes;
         ckOpts.newKeyVersion = 1;
-        ckOpts.oldKey      = toEtlKey(zeros16);
+        ckOpts.oldKey      = EtlKey(zeros16).bytes;
         nfc::ChangeKeyCommand ck1(ckOpts);
-        auto r8 = desfireCard->executeCommand(ck1);
-        if (!r8.has_value()) { _cardManager->clearSession(); return errFromEtl(r8.error()); }
+        auto r1 = desfireCard->executeCommand(ck1);
+        wipeKeys(ckOpts);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
     }
 
-    // Step 8 — Change key 0 to appMasterKey (self-change; no oldKey)
-    {
+    // 16-byte card secret + 16 zero-byte reserved block. Never overwrites a
+    // committed secret: the vault's entry keys are derived from it.
+    if (step("writeSecret", !secretPresent)) {
+        etl::vector<uint8_t, 32> payload;
+        for (auto b : opts.cardSecret) payload.push_back(b);
+        for (size_t i = 0; i < 16; ++i) payload.push_back(0x00);
+        auto r1 = desfireCard->writeData(0, 0, payload);
+        crypto::secureZero(payload.data(), payload.size());
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
+
+        auto r2 = desfireCard->commitTransaction();
+        if (!r2.has_value()) { _cardManager->clearSession(); return errFromEtl(r2.error()); }
+    }
+
+    // Self-change, so no old key
+    if (step("changeMasterKey", !masterKeySet)) {
         nfc::ChangeKeyCommandOptions ckOpts;
         ckOpts.keyNo       = 0;
         ckOpts.authMode    = DesfireAuthMode::AES;
         ckOpts.newKeyType  = DesfireKeyType::AES;
-        ckOpts.newKey      = toEtlKey(opts.appMasterKey);
-        ckOpts.newKeyVersion = 0;
-        // oldKey intentionally omitted (self-change)
+        ckOpts.newKey      = EtlKey(opts.appMasterKey).bytes;
+        ckOpts.newKeyVersion = 1;
         nfc::ChangeKeyCommand ck0(ckOpts);
-        auto r9 = desfireCard->executeCommand(ck0);
-        if (!r9.has_value()) { _cardManager->clearSession(); return errFromEtl(r9.error()); }
-    }
-
-    // Step 9 — Re-authenticate with new master key
-    auto r10 = desfireCard->authenticate(0, toEtlKey(opts.appMasterKey), DesfireAuthMode::AES);
-    if (!r10.has_value()) { _cardManager->clearSession(); return errFromEtl(r10.error()); }
-
-    // Step 10 — Write 16-byte card secret + 16 zero-byte reserved block
-    {
-        etl::vector<uint8_t, 32> payload;
-        for (auto b : opts.cardSecret) payload.push_back(b);
-        for (size_t i = 0; i < 16; ++i) payload.push_back(0x00);
-        auto r11 = desfireCard->writeData(0, 0, payload);
-        if (!r11.has_value()) { _cardManager->clearSession(); return errFromEtl(r11.error()); }
+        auto r1 = desfireCard->executeCommand(ck0);
+        wipeKeys(ckOpts);
+        if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
     }
 
-    // Step 11 — Commit
-    auto r12 = desfireCard->commitTransaction();
     _cardManager->clearSession();
-    if (!r12.has_value()) return errFromEtl(r12.error());
-    return true;
+    return report;
 }
 
 core::ports::Result<std::vector<uint8_t>> Pn532Adapter::readCardSecret(
     const std::array<uint8_t, 16>& readKey) {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "readCardSecret", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
     if (detectResult.value().type != CardType::MifareDesfire)
@@ -524,21 +786,30 @@ core::ports::Result<std::vector<uint8_t>> Pn532Adapter::readCardSecret(
     auto r1 = desfireCard->selectApplication(appAid);
     if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
 
-    auto r2 = desfireCard->authenticate(1, toEtlKey(readKey), DesfireAuthMode::AES);
-    if (!r2.has_value()) { _cardManager->clearSession(); return errFromEtl(r2.error()); }
+    // Authenticate + read on the adapter's own secure channel so the AES and
+    // CMAC work runs on the selected crypto provider (AES-NI when present)
+    const std::vector<uint8_t> uid(detectResult.value().uid.begin(), detectResult.value().uid.end());
+    DesfireAesSession aes = makeAesSessionNoLock(uid);
+    auto r2 = aes.authenticate(1, readKey);
+    noteAesSessionNoLock(uid, aes);
+    if (std::holds_alternative<core::ports::NfcError>(r2)) {
+        _cardManager->clearSession();
+        return std::get<core::ports::NfcError>(r2);
+    }
 
-    auto r3 = desfireCard->readData(0, 0, 16);
+    auto r3 = aes.readDataEnciphered(0, 0, 16);
     _cardManager->clearSession();
-    if (!r3.has_value()) return errFromEtl(r3.error());
-
-    const auto& data = r3.value();
-    return std::vector<uint8_t>(data.begin(), data.end());
+    return r3;
 }
 
 core::ports::Result<uint32_t> Pn532Adapter::cardFreeMemory() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "cardFreeMemory", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
     if (detectResult.value().type != CardType::MifareDesfire)
@@ -566,9 +837,13 @@ core::ports::Result<uint32_t> Pn532Adapter::cardFreeMemory() {
 
 core::ports::Result<bool> Pn532Adapter::formatCard() {
     const std::array<uint8_t, 16> zeros16 = {};
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "formatCard", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
     if (detectResult.value().type != CardType::MifareDesfire)
@@ -588,7 +863,7 @@ core::ports::Result<bool> Pn532Adapter::formatCard() {
     auto r1 = desfireCard->selectApplication(piccAid);
     if (!r1.has_value()) { _cardManager->clearSession(); return errFromEtl(r1.error()); }
 
-    auto r2 = desfireCard->authenticate(0, toEtlKey(zeros16), DesfireAuthMode::ISO);
+    auto r2 = desfireCard->authenticate(0, EtlKey(zeros16).bytes, DesfireAuthMode::ISO);
     if (!r2.has_value()) { _cardManager->clearSession(); return errFromEtl(r2.error()); }
 
     auto r3 = desfireCard->formatPicc();
@@ -598,9 +873,13 @@ core::ports::Result<bool> Pn532Adapter::formatCard() {
 }
 
 core::ports::Result<std::vector<std::array<uint8_t, 3>>> Pn532Adapter::getCardApplicationIds() {
-    std::lock_guard<std::mutex> lock(_mutex);
+    TraceSpan trace(*_tracer, "getCardApplicationIds", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
     if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
 
+    OperationScope op(*this, true);
+    if (op.wakeError()) return *op.wakeError();
+
     auto detectResult = _cardManager->detectCard();
     if (!detectResult.has_value()) return errFromEtl(detectResult.error());
     if (detectResult.value().type != CardType::MifareDesfire)
@@ -631,5 +910,344 @@ core::ports::Result<std::vector<std::array<uint8_t, 3>>> Pn532Adapter::getCardAp
     return result;
 }
 
+// ---------------------------------------------------------------------------
+// Reader power management
+// ---------------------------------------------------------------------------
+
+core::ports::Result<bool> Pn532Adapter::setPowerPolicy(const core::ports::ReaderPowerPolicy& policy) {
+    TraceSpan trace(*_tracer, "setPowerPolicy", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
+    {
+        std::lock_guard<std::mutex> idleLock(_idleMutex);
+        _powerPolicy = policy;
+    }
+
+    // Latency mode wants the reader ready now rather than after the next operation
+    if (_pn532 && policy.mode == core::ports::ReaderPowerMode::Latency && _poweredDown) {
+        auto woke = wakeNoLock();
+        if (std::holds_alternative<core::ports::NfcError>(woke)) return woke;
+    }
+    noteActivity(); // re-evaluate the idle state under the new policy
+    return true;
+}
+
+core::ports::Result<core::ports::ReaderPowerStatus> Pn532Adapter::getPowerStatus() {
+    std::lock_guard<TimedMutex> lock(_mutex);
+    core::ports::ReaderPowerStatus status;
+    {
+        std::lock_guard<std::mutex> idleLock(_idleMutex);
+        status.policy = _powerPolicy;
+    }
+    status.rfFieldOn         = _rfFieldOn;
+    status.poweredDown       = _poweredDown;
+    status.wakeCount         = _wakeCount;
+    status.lastWakeLatencyUs = _lastWakeLatencyUs;
+    return status;
+}
+
+core::ports::Result<bool> Pn532Adapter::wakeReader() {
+    TraceSpan trace(*_tracer, "wakeReader", "operation");
+    std::lock_guard<TimedMutex> lock(_mutex);
+    if (!_pn532) return core::ports::NfcError{"NOT_CONNECTED", "Not connected to PN532"};
+
+    OperationScope op(*this, false);
+    if (op.wakeError()) return *op.wakeError();
+
+    // Raise the field early so the card is powered by the time detection runs
+    if (!_rfFieldOn) return setRfFieldNoLock(true);
+    return true;
+}
+
+// No _mutex: the point is to reach the thread that holds it. The waker
+// lives as long as the adapter, so this is safe across connect/disconnect.
+void Pn532Adapter::cancelPendingIo() {
+    _ioWaker->wake();
+}
+
+core::ports::Result<bool> Pn532Adapter::wakeNoLock() {
+    // SAMConfiguration (normal mode) doubles as the first command after the
+    // wake preamble, so its round trip is the wake-to-first-command latency.
+    const auto start = _clock->now();
+    auto res = _raw->transceive(PN532_CMD_SAM_CONFIGURATION, {0x01, 0x14, 0x01},
+                                RAW_COMMAND_TIMEOUT_MS, true);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        return std::get<core::ports::NfcError>(res);
+    }
+    const auto elapsed = _clock->now() - start;
+    _lastWakeLatencyUs = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    ++_wakeCount;
+    _poweredDown = false;
+    _rfFieldOn = false;
+    return true;
+}
+
+core::ports::Result<bool> Pn532Adapter::powerDownNoLock() {
+    // WakeUpEnable: HSU (bit 4) so the next host frame wakes the chip, and
+    // the RF level detector (bit 3) so a card or phone field wakes it too.
+    auto res = _raw->transceive(PN532_CMD_POWER_DOWN, {0x18}, RAW_COMMAND_TIMEOUT_MS);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        return std::get<core::ports::NfcError>(res);
+    }
+    const auto& status = std::get<std::vector<uint8_t>>(res);
+    if (!status.empty() && (status[0] & 0x3F) != 0x00) {
+        return core::ports::NfcError{"HARDWARE_ERROR", "PN532 refused PowerDown"};
+    }
+    _poweredDown = true;
+    _rfFieldOn = false;
+    return true;
+}
+
+core::ports::Result<bool> Pn532Adapter::setRfFieldNoLock(bool on) {
+    // RFConfiguration CfgItem 0x01: bit 1 AutoRFCA, bit 0 RF on
+    const uint8_t field = on ? 0x03 : 0x02;
+    auto res = _raw->transceive(PN532_CMD_RF_CONFIGURATION, {0x01, field}, RAW_COMMAND_TIMEOUT_MS);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        return std::get<core::ports::NfcError>(res);
+    }
+    _rfFieldOn = on;
+    return true;
+}
+
+void Pn532Adapter::noteActivity() {
+    {
+        std::lock_guard<std::mutex> idleLock(_idleMutex);
+        _lastActivity = _clock->now();
+        _idleWorkPending = true;
+    }
+    _idleCv.notify_all();
+}
+
+void Pn532Adapter::idleLoop() {
+    std::unique_lock<std::mutex> idleLock(_idleMutex);
+    while (!_stopIdleThread) {
+        if (!_idleWorkPending) {
+            const auto waited = _clock->waitUntil(_idleCv, idleLock, _clock->now() + HEALTH_SAMPLE_INTERVAL);
+            if (waited == std::cv_status::timeout && !_stopIdleThread && !_idleWorkPending) {
+                idleLock.unlock();
+                sampleHealthIfIdle();
+                idleLock.lock();
+            }
+            continue;
+        }
+
+        const auto mode = _powerPolicy.mode;
+        const auto delay = (mode == core::ports::ReaderPowerMode::Latency)
+            ? LATENCY_IDLE_SETTLE
+            : std::chrono::milliseconds(_powerPolicy.idleTimeoutMs);
+        const auto deadline = _lastActivity + delay;
+        if (_clock->now() < deadline) {
+            _clock->waitUntil(_idleCv, idleLock, deadline);
+            continue;
+        }
+
+        _idleWorkPending = false;
+        idleLock.unlock();
+        const bool applied = applyIdleState(mode);
+        idleLock.lock();
+
+        // Reader was busy: try again one idle period after now
+        if (!applied && !_idleWorkPending) {
+            _lastActivity = _clock->now();
+            _idleWorkPending = true;
+        }
+    }
+}
+
+bool Pn532Adapter::applyIdleState(core::ports::ReaderPowerMode mode) {
+    std::unique_lock<TimedMutex> lock(_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return false;
+    if (!_pn532) return true;
+    TraceSpan trace(*_tracer, "applyIdleState", "idle");
+    _ioWaker->clear();
+
+    // Sample before the idle action so the last error of the burst is captured
+    if (!_poweredDown && _telemetry->sampleDue(HEALTH_SAMPLE_MIN_INTERVAL)) {
+        (void)sampleHealthNoLock();
+    }
+
+    // Failures are left for the next operation to surface — it will wake
+    // or re-detect as needed.
+    switch (mode) {
+        case core::ports::ReaderPowerMode::Latency:
+            // Only after a wake or a field drop: the card flows keep the field
+            // up, and a redundant RFConfiguration would hold the reader for nothing
+            if (_poweredDown) (void)wakeNoLock();
+            if (!_poweredDown && !_rfFieldOn) (void)setRfFieldNoLock(true);
+            break;
+        case core::ports::ReaderPowerMode::Balanced:
+            if (!_poweredDown && _rfFieldOn) (void)setRfFieldNoLock(false);
+            break;
+        case core::ports::ReaderPowerMode::LowPower:
+            if (!_poweredDown) (void)powerDownNoLock();
+            break;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// DESFire native commands
+// ---------------------------------------------------------------------------
+
+core::ports::Result<std::vector<uint8_t>> Pn532Adapter::desfireExchangeNoLock(
+    const std::vector<uint8_t>& frame) {
+    std::vector<uint8_t> params;
+    params.reserve(1 + frame.size());
+    params.push_back(0x01); // Tg: the target listed by detectCard()
+    params.insert(params.end(), frame.begin(), frame.end());
+
+    auto res = _raw->transceiveView(PN532_CMD_IN_DATA_EXCHANGE, params.data(), params.size(),
+                                    CARD_COMMAND_TIMEOUT_MS);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        return std::get<core::ports::NfcError>(res);
+    }
+
+    // Response: PN532 status, then the card's status byte and data
+    const auto resp = std::get<std::span<const uint8_t>>(res);
+    if (resp.empty()) return core::ports::NfcError{"HARDWARE_ERROR", "Empty InDataExchange response"};
+    if ((resp[0] & 0x3F) == 0x01) return core::ports::NfcError{"IO_TIMEOUT", "Card did not answer"};
+    if ((resp[0] & 0x3F) != 0x00) {
+        std::ostringstream oss;
+        oss << "InDataExchange failed, PN532 status 0x" << std::hex << std::setw(2)
+            << std::setfill('0') << static_cast<int>(resp[0] & 0x3F);
+        return core::ports::NfcError{"HARDWARE_ERROR", oss.str()};
+    }
+    if (resp.size() < 2) return core::ports::NfcError{"NO_CARD", "Card left the field"};
+    return std::vector<uint8_t>(resp.begin() + 1, resp.end());
+}
+
+core::ports::Result<std::vector<uint8_t>> Pn532Adapter::desfireCommandNoLock(
+    uint8_t command, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> frame;
+    frame.reserve(1 + data.size());
+    frame.push_back(command);
+    frame.insert(frame.end(), data.begin(), data.end());
+
+    auto res = desfireExchangeNoLock(frame);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        return std::get<core::ports::NfcError>(res);
+    }
+    const auto& resp = std::get<std::vector<uint8_t>>(res);
+    if (resp[0] != 0x00) {
+        std::ostringstream oss;
+        oss << "DESFire command 0x" << std::hex << std::setw(2) << std::setfill('0')
+            << static_cast<int>(command) << " failed: " << desfireStatusName(resp[0])
+            << " (0x" << std::setw(2) << static_cast<int>(resp[0]) << ")";
+        return core::ports::NfcError{"HARDWARE_ERROR", oss.str()};
+    }
+    return std::vector<uint8_t>(resp.begin() + 1, resp.end());
+}
+
+DesfireAesSession Pn532Adapter::makeAesSessionNoLock(const std::vector<uint8_t>& uid) {
+    auto cached = _cardHwMajor.find(uid);
+    if (cached == _cardHwMajor.end()) {
+        // First sight of this card: one GetVersion, then cached. A failed
+        // query is not fatal — the session starts on EV1 AES.
+        auto hwMajor = readCardHwMajorNoLock();
+        const uint8_t value = std::holds_alternative<uint8_t>(hwMajor) ? std::get<uint8_t>(hwMajor) : 0x01;
+        cached = rememberCardHwMajorNoLock(uid, value);
+    }
+    return DesfireAesSession(_crypto, [this](const std::vector<uint8_t>& frame) {
+        return desfireExchangeNoLock(frame);
+    }, nullptr, desfireSupportsEv2(cached->second));
+}
+
+void Pn532Adapter::noteAesSessionNoLock(const std::vector<uint8_t>& uid, const DesfireAesSession& session) {
+    // GetVersion said EV2 but the card refused 0x71: stop trying on this card
+    if (session.ev2Unsupported()) rememberCardHwMajorNoLock(uid, 0x01);
+}
+
+core::ports::Result<uint8_t> Pn532Adapter::readCardHwMajorNoLock() {
+    // GetVersion answers in three frames (hardware, software, UID/batch);
+    // run the chain to completion so the card is ready for the next command.
+    uint8_t hwMajor = 0;
+    std::vector<uint8_t> frame{0x60};
+    for (int part = 0; part < 3; ++part) {
+        auto res = desfireExchangeNoLock(frame);
+        if (std::holds_alternative<core::ports::NfcError>(res)) return std::get<core::ports::NfcError>(res);
+        const auto& resp = std::get<std::vector<uint8_t>>(res);
+        if (part == 0 && resp.size() >= 5) hwMajor = resp[4];
+        if (resp[0] == 0x00) break;
+        if (resp[0] != 0xAF) return core::ports::NfcError{"HARDWARE_ERROR", "GetVersion failed"};
+        frame.assign(1, 0xAF);
+    }
+    return hwMajor;
+}
+
+std::map<std::vector<uint8_t>, uint8_t>::iterator Pn532Adapter::rememberCardHwMajorNoLock(
+    const std::vector<uint8_t>& uid, uint8_t hwMajor) {
+    // A handful of cards per install; bound it anyway against UID-randomising cards
+    if (_cardHwMajor.size() >= CARD_GENERATION_CACHE_SIZE && !_cardHwMajor.count(uid)) _cardHwMajor.clear();
+    return _cardHwMajor.insert_or_assign(uid, hwMajor).first;
+}
+
+// ---------------------------------------------------------------------------
+// Diagnostics
+// ---------------------------------------------------------------------------
+
+core::ports::Result<core::ports::ReaderHealthSnapshot> Pn532Adapter::getReaderHealth() {
+    // Deliberately lock-free with respect to _mutex: callers poll this while
+    // long card operations are in flight.
+    core::ports::ReaderHealthSnapshot snap = _telemetry->snapshot();
+    snap.connected = _connected;
+    snap.lock = _mutex.stats();
+    return snap;
+}
+
+core::ports::Result<bool> Pn532Adapter::setTracing(bool enabled) {
+    // No _mutex: the tracer is thread-safe, and tracing can be switched on
+    // while a slow operation is in flight
+    _tracer->setEnabled(enabled);
+    return true;
+}
+
+core::ports::Result<std::string> Pn532Adapter::exportTrace(bool clear) {
+    return _tracer->exportChromeJson(clear);
+}
+
+void Pn532Adapter::captureFailureReport(const std::string& operation, const core::ports::NfcError& error) {
+    // Outcomes of normal use, not faults: keep the last real failure
+    if (error.code == "NO_CARD" || error.code == "NOT_CONNECTED" || error.code == "CANCELLED") return;
+
+    const auto at = _recorder->now();
+    core::ports::FailureReport report;
+    report.available = true;
+    report.operation = operation;
+    report.code = error.code;
+    report.message = error.message;
+    report.frames = _recorder->snapshot(at);
+
+    std::lock_guard<std::mutex> lock(_failureMutex);
+    _lastFailure = std::move(report);
+    _lastFailureAt = at;
+}
+
+core::ports::Result<core::ports::FailureReport> Pn532Adapter::getLastFailureReport() {
+    std::lock_guard<std::mutex> lock(_failureMutex);
+    core::ports::FailureReport report = _lastFailure;
+    if (report.available) {
+        const auto age = _recorder->now() - _lastFailureAt;
+        report.ageMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(age).count());
+    }
+    return report;
+}
+
+core::ports::Result<bool> Pn532Adapter::sampleHealthNoLock() {
+    auto res = _raw->transceive(PN532_CMD_GET_GENERAL_STATUS, {}, RAW_COMMAND_TIMEOUT_MS);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        return std::get<core::ports::NfcError>(res);
+    }
+    _telemetry->recordGeneralStatus(std::get<std::vector<uint8_t>>(res));
+    return true;
+}
+
+void Pn532Adapter::sampleHealthIfIdle() {
+    std::unique_lock<TimedMutex> lock(_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || !_pn532 || _poweredDown) return;
+    TraceSpan trace(*_tracer, "sampleHealth", "idle");
+    _ioWaker->clear();
+    if (_telemetry->sampleDue(HEALTH_SAMPLE_MIN_INTERVAL)) (void)sampleHealthNoLock();
+}
+
 } // namespace hardware
 } // namespace adapters
@@ -1,8 +1,19 @@
 #pragma once
 #include "../../core/ports/INfcReader.h"
+#include "../../core/ports/ICryptoProvider.h"
+#include "../../core/ports/IClock.h"
+#include "DesfireAesSession.h"
+#include "TimedMutex.h"
 #include <string>
 #include <mutex>
+#include <map>
 #include <memory>
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 
 namespace comms {
 namespace serial {
@@ -22,9 +33,19 @@ class CardManager;
 namespace adapters {
 namespace hardware {
 
+class FlightRecorder;
+class Pn532RawChannel;
+class ReaderTelemetry;
+class SerialWaker;
+class SpanTracer;
+
 class Pn532Adapter : public core::ports::INfcReader {
 public:
-    Pn532Adapter();
+    // `cryptoProvider` backs the adapter's DESFire secure channel; null
+    // selects the best provider for this CPU. `clock` drives every timeout,
+    // idle timer and latency measurement; null selects the steady clock.
+    explicit Pn532Adapter(std::shared_ptr<const core::ports::ICryptoProvider> cryptoProvider = nullptr,
+                          std::shared_ptr<core::ports::IClock> clock = nullptr);
     ~Pn532Adapter() override;
     core::ports::Result<std::string>             connect(const std::string& port) override;
     core::ports::Result<bool>                    disconnect() override;
@@ -37,20 +58,121 @@ public:
     core::ports::Result<std::vector<uint8_t>>                  peekCardUid() override;
     core::ports::Result<bool>                                  isCardInitialised() override;
     core::ports::Result<core::ports::CardProbeResult>          probeCard() override;
-    core::ports::Result<bool>                                  initCard(const core::ports::CardInitOptions& opts) override;
+    core::ports::Result<core::ports::CardInitReport>           initCard(const core::ports::CardInitOptions& opts) override;
     core::ports::Result<std::vector<uint8_t>>                  readCardSecret(const std::array<uint8_t, 16>& readKey) override;
     core::ports::Result<uint32_t>                              cardFreeMemory() override;
     core::ports::Result<bool>                                  formatCard() override;
     core::ports::Result<std::vector<std::array<uint8_t, 3>>>   getCardApplicationIds() override;
 
+    // Reader power management
+    core::ports::Result<bool>                                  setPowerPolicy(const core::ports::ReaderPowerPolicy& policy) override;
+    core::ports::Result<core::ports::ReaderPowerStatus>        getPowerStatus() override;
+    core::ports::Result<bool>                                  wakeReader() override;
+    void                                                       cancelPendingIo() override;
+
+    // Diagnostics
+    core::ports::Result<core::ports::ReaderHealthSnapshot>     getReaderHealth() override;
+    core::ports::Result<bool>                                  setTracing(bool enabled) override;
+    core::ports::Result<std::string>                           exportTrace(bool clear) override;
+    void                                                       captureFailureReport(const std::string& operation,
+                                                                                    const core::ports::NfcError& error) override;
+    core::ports::Result<core::ports::FailureReport>            getLastFailureReport() override;
+
+    // Builds the bus connect() opens instead of the platform backend, for
+    // simulators and fault injection. Takes effect on the next connect();
+    // telemetry still wraps whatever it returns.
+    using SerialBusFactory = std::function<std::unique_ptr<comms::serial::ISerialBus>(const std::string& port)>;
+    void setSerialBusFactory(SerialBusFactory factory);
+
 private:
+    // Per-operation bookkeeping, constructed right after the NOT_CONNECTED
+    // check: wakes the PN532 if the power policy put it to sleep and
+    // restarts the idle timer when the operation returns.
+    class OperationScope {
+    public:
+        OperationScope(Pn532Adapter& adapter, bool usesRf);
+        ~OperationScope();
+        const std::optional<core::ports::NfcError>& wakeError() const { return _wakeError; }
+    private:
+        Pn532Adapter& _adapter;
+        bool _usesRf;
+        std::optional<core::ports::NfcError> _wakeError;
+    };
+
     void disconnectNoLock();
 
-    std::mutex _mutex;
+    // Power policy helpers — callers hold _mutex
+    core::ports::Result<bool> wakeNoLock();
+    core::ports::Result<bool> powerDownNoLock();
+    core::ports::Result<bool> setRfFieldNoLock(bool on);
+
+    // Idle thread: applies the policy's idle state once the reader has been
+    // quiet for idleTimeoutMs (a short settle delay in Latency mode). Uses
+    // try_lock on _mutex so it never queues behind a real operation; one
+    // that arrives mid-exchange still waits for that exchange to finish.
+    void noteActivity();
+    void idleLoop();
+    bool applyIdleState(core::ports::ReaderPowerMode mode);
+
+    // DESFire native frame relayed to target 1 with InDataExchange; returns
+    // the card's status byte + data. Callers hold _mutex.
+    core::ports::Result<std::vector<uint8_t>> desfireExchangeNoLock(const std::vector<uint8_t>& frame);
+
+    // Plain (unauthenticated) command NfcCpp does not expose. Returns the
+    // data after a 0x00 status; any other status is an error.
+    core::ports::Result<std::vector<uint8_t>> desfireCommandNoLock(
+        uint8_t command, const std::vector<uint8_t>& data);
+
+    // Secure channel over desfireExchangeNoLock on the adapter's provider.
+    // EV2 secure messaging is preferred when the card's GetVersion hardware
+    // generation (cached per UID) is EV2 or later; EV1 AES otherwise.
+    DesfireAesSession makeAesSessionNoLock(const std::vector<uint8_t>& uid);
+    void noteAesSessionNoLock(const std::vector<uint8_t>& uid, const DesfireAesSession& session);
+    core::ports::Result<uint8_t> readCardHwMajorNoLock();
+    std::map<std::vector<uint8_t>, uint8_t>::iterator rememberCardHwMajorNoLock(
+        const std::vector<uint8_t>& uid, uint8_t hwMajor);
+
+    // GetGeneralStatus sampling for getReaderHealth()
+    core::ports::Result<bool> sampleHealthNoLock();
+    void sampleHealthIfIdle();
+
+    TimedMutex _mutex; // serialises every operation; wait/hold times go to getReaderHealth()
+    std::shared_ptr<const core::ports::ICryptoProvider> _crypto;
+    std::shared_ptr<core::ports::IClock> _clock;
     std::unique_ptr<comms::serial::ISerialBus> _serial;
     std::unique_ptr<pn532::Pn532Driver> _pn532;
     std::unique_ptr<pn532::Pn532ApduAdapter> _apduAdapter;
     std::unique_ptr<nfc::CardManager> _cardManager;
+    std::unique_ptr<Pn532RawChannel> _raw;
+    std::unique_ptr<ReaderTelemetry> _telemetry; // outlives every serial bus it observes
+    std::unique_ptr<SpanTracer> _tracer;         // likewise; thread-safe, used without _mutex
+    std::unique_ptr<FlightRecorder> _recorder;   // likewise; thread-safe, used without _mutex
+    std::shared_ptr<SerialWaker> _ioWaker;       // set once in the constructor; safe without _mutex
+    SerialBusFactory _serialFactory;             // guarded by _mutex
+    std::atomic<bool> _connected{false};
+
+    // Last failure report and when it was captured — guarded by _failureMutex
+    std::mutex _failureMutex;
+    core::ports::FailureReport _lastFailure;
+    core::ports::IClock::TimePoint _lastFailureAt;
+
+    // GetVersion hardware major version per card UID — guarded by _mutex
+    std::map<std::vector<uint8_t>, uint8_t> _cardHwMajor;
+
+    // Power state — guarded by _mutex
+    bool _rfFieldOn = false;
+    bool _poweredDown = false;
+    uint32_t _wakeCount = 0;
+    uint32_t _lastWakeLatencyUs = 0;
+
+    // Idle scheduling — guarded by _idleMutex
+    std::mutex _idleMutex;
+    std::condition_variable _idleCv;
+    core::ports::ReaderPowerPolicy _powerPolicy;
+    core::ports::IClock::TimePoint _lastActivity;
+    bool _idleWorkPending = false;
+    bool _stopIdleThread = false;
+    std::thread _idleThread;
 };
 
 } // namespace hardware
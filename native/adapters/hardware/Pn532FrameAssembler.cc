@@ -0,0 +1,109 @@
+#include "Pn532FrameAssembler.h"
+#include "Comms/Serial/ISerialBus.hpp"
+#include <algorithm>
+#include <cstring>
+#include <etl/vector.h>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+// Largest single bus read. Matches a full-speed USB bulk packet run; the
+// ring's free space caps it further.
+constexpr size_t READ_CHUNK = 256;
+
+} // anonymous namespace
+
+void Pn532FrameAssembler::reset() {
+    _head = 0;
+    _count = 0;
+    _pendingLength = 0;
+}
+
+Pn532FrameAssembler::Frame Pn532FrameAssembler::next() {
+    _pendingLength = 0;
+    linearize();
+
+    Frame out;
+    const FrameScan scan = scanFrame(_ring.data() + _head, _count);
+    drop(scan.start); // noise, or bytes that can never start a frame
+    if (scan.status == FrameScanStatus::Incomplete) return out;
+
+    const uint8_t* base = _ring.data() + _head;
+    out.status = scan.status;
+    out.frame  = std::span<const uint8_t>(base, scan.length);
+    if (scan.status == FrameScanStatus::Information) {
+        out.data = std::span<const uint8_t>(base + (scan.dataOffset - scan.start), scan.dataLength);
+    }
+    _pendingLength = scan.length;
+    return out;
+}
+
+void Pn532FrameAssembler::consume() {
+    drop(_pendingLength);
+    _pendingLength = 0;
+}
+
+etl::expected<size_t, error::Error> Pn532FrameAssembler::fill(
+    comms::serial::ISerialBus& bus, uint32_t timeoutMs) {
+    _pendingLength = 0; // views may move below
+
+    size_t added = 0;
+    bool waited = false;
+    for (;;) {
+        const size_t room = CAPACITY - _count;
+        if (room == 0) {
+            if (added > 0) return added;
+            return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Io));
+        }
+
+        // Bulk when the backend already holds bytes; otherwise block for one
+        // and come back for whatever arrived with it
+        size_t want = 1;
+        ++_busCalls;
+        auto avail = bus.available();
+        const bool bulk = avail.has_value() && avail.value() > 0;
+        if (bulk) {
+            want = std::min({avail.value(), room, READ_CHUNK});
+        } else if (waited) {
+            return added;
+        }
+
+        etl::vector<uint8_t, READ_CHUNK> chunk;
+        ++_busCalls;
+        auto result = bus.read(chunk, want, timeoutMs);
+        if (!result.has_value()) {
+            if (added > 0) return added;
+            return etl::unexpected<error::Error>(result.error());
+        }
+
+        // Copy into the ring in at most two pieces around the wrap point
+        const size_t n = std::min(chunk.size(), room);
+        const size_t tail = (_head + _count) % CAPACITY;
+        const size_t first = std::min(n, CAPACITY - tail);
+        std::memcpy(_ring.data() + tail, chunk.data(), first);
+        std::memcpy(_ring.data(), chunk.data() + first, n - first);
+        _count += n;
+        added += n;
+
+        if (bulk) return added;
+        waited = true;
+    }
+}
+
+void Pn532FrameAssembler::linearize() {
+    if (_head + _count <= CAPACITY) return;
+    std::rotate(_ring.begin(), _ring.begin() + static_cast<std::ptrdiff_t>(_head), _ring.end());
+    _head = 0;
+}
+
+void Pn532FrameAssembler::drop(size_t n) {
+    n = std::min(n, _count);
+    _head = (_head + n) % CAPACITY;
+    _count -= n;
+    if (_count == 0) _head = 0; // keeps most frames clear of the wrap point
+}
+
+} // namespace hardware
+} // namespace adapters
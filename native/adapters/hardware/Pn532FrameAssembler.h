@@ -0,0 +1,79 @@
+#pragma once
+#include "Pn532Frames.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <etl/expected.h>
+#include "Error/Error.h"
+
+namespace comms {
+namespace serial {
+class ISerialBus;
+}
+}
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * Receive side of a PN532 HSU link: a fixed ring of bytes read from the
+ * bus in bulk, scanned for ACK/NACK/information frames in place.
+ *
+ * fill() waits for the first byte, then takes everything the backend has
+ * already buffered in a single read, so a frame costs a handful of bus
+ * calls instead of one per byte. next() validates LEN/LCS/DCS where the
+ * bytes sit and returns views into the ring; nothing is allocated after
+ * construction. A frame that would straddle the end of the ring is made
+ * contiguous first (at most one rotate per lap of the ring).
+ *
+ * Views returned by next() stay valid until consume(), fill() or reset().
+ * Not thread-safe; owned by one channel under the adapter mutex.
+ */
+class Pn532FrameAssembler {
+public:
+    // Largest PN532 frame is ~270 bytes (264 data bytes in extended framing);
+    // the rest leaves room for a stray ACK and postambles behind it.
+    static constexpr size_t CAPACITY = 512;
+
+    struct Frame {
+        FrameScanStatus          status = FrameScanStatus::Incomplete;
+        std::span<const uint8_t> frame; // start code through DCS
+        std::span<const uint8_t> data;  // TFI + PD, Information frames only
+    };
+
+    // Drops every buffered byte.
+    void reset();
+
+    // First complete frame in the ring, or Incomplete. Noise in front of it
+    // is discarded; the frame itself stays until consume().
+    Frame next();
+
+    // Drops the frame last returned by next().
+    void consume();
+
+    // Receives more bytes: waits up to `timeoutMs` for one, then drains
+    // whatever else the bus reports as available. Returns the number of
+    // bytes added; a full ring is reported as an I/O error.
+    etl::expected<size_t, error::Error> fill(comms::serial::ISerialBus& bus, uint32_t timeoutMs);
+
+    size_t buffered() const { return _count; }
+
+    // Bus read()/available() calls made by fill() since construction.
+    uint64_t busCalls() const { return _busCalls; }
+
+private:
+    // Makes the buffered bytes contiguous when they wrap the end of the ring.
+    void linearize();
+    void drop(size_t n);
+
+    std::array<uint8_t, CAPACITY> _ring{};
+    size_t _head  = 0; // index of the oldest buffered byte
+    size_t _count = 0;
+    size_t _pendingLength = 0; // bytes consume() drops, from _head
+    uint64_t _busCalls = 0;
+};
+
+} // namespace hardware
+} // namespace adapters
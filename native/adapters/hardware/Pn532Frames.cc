@@ -0,0 +1,129 @@
+#include "Pn532Frames.h"
+
+namespace adapters {
+namespace hardware {
+
+FrameScan scanFrame(const uint8_t* data, size_t size) {
+    FrameScan scan;
+    size_t i = 0;
+    while (i + 1 < size) {
+        if (data[i] != 0x00 || data[i + 1] != 0xFF) {
+            ++i;
+            continue;
+        }
+
+        scan.start = i;
+        if (size - i < 4) return scan; // need at least LEN + LCS
+
+        const uint8_t len = data[i + 2];
+        const uint8_t lcs = data[i + 3];
+
+        if (len == 0x00 && lcs == 0xFF) {
+            scan.status = FrameScanStatus::Ack;
+            scan.length = 4;
+            return scan;
+        }
+
+        if (len == 0xFF && lcs == 0x00) {
+            scan.status = FrameScanStatus::Nack;
+            scan.length = 4;
+            return scan;
+        }
+
+        size_t dataOffset = i + 4;
+        size_t dataLength = len;
+        if (len == 0xFF && lcs == 0xFF) {
+            // Extended frame: LENM LENL LCS follow the FF FF marker
+            if (size - i < 7) return scan;
+            const uint8_t lenM  = data[i + 4];
+            const uint8_t lenL  = data[i + 5];
+            const uint8_t lcsX  = data[i + 6];
+            if (static_cast<uint8_t>(lenM + lenL + lcsX) != 0) {
+                scan.status = FrameScanStatus::ChecksumError;
+                scan.length = 7;
+                return scan;
+            }
+            dataOffset = i + 7;
+            dataLength = (static_cast<size_t>(lenM) << 8) | lenL;
+        } else if (static_cast<uint8_t>(len + lcs) != 0) {
+            scan.status = FrameScanStatus::ChecksumError;
+            scan.length = 4;
+            return scan;
+        }
+
+        // TFI..PDn + DCS must be present
+        if (size - dataOffset < dataLength + 1) return scan;
+
+        uint8_t sum = 0;
+        for (size_t k = 0; k < dataLength; ++k) sum = static_cast<uint8_t>(sum + data[dataOffset + k]);
+        sum = static_cast<uint8_t>(sum + data[dataOffset + dataLength]);
+
+        scan.length     = (dataOffset - i) + dataLength + 1;
+        scan.dataOffset = dataOffset;
+        scan.dataLength = dataLength;
+        if (sum != 0) {
+            scan.status = FrameScanStatus::ChecksumError;
+        } else if (dataLength == 1 && data[dataOffset] == 0x7F) {
+            scan.status = FrameScanStatus::ErrorFrame;
+        } else {
+            scan.status = FrameScanStatus::Information;
+        }
+        return scan;
+    }
+
+    // No start code yet — keep a trailing 0x00 in case FF is still in flight
+    scan.start = (size > 0 && data[size - 1] == 0x00) ? size - 1 : size;
+    return scan;
+}
+
+std::vector<uint8_t> buildCommandFrame(uint8_t command, const uint8_t* params, size_t paramsLen) {
+    std::vector<uint8_t> frame(paramsLen + 12);
+    frame.resize(writeCommandFrame(command, params, paramsLen, frame.data(), frame.size()));
+    return frame;
+}
+
+size_t writeCommandFrame(uint8_t command, const uint8_t* params, size_t paramsLen,
+                         uint8_t* out, size_t capacity) {
+    const size_t len = 2 + paramsLen; // TFI + command code + params
+    const size_t total = len + (len <= 0xFF ? 7 : 10);
+    if (len > 0xFFFF || total > capacity) return 0;
+
+    size_t i = 0;
+    out[i++] = 0x00; // preamble
+    out[i++] = 0x00; // start code
+    out[i++] = 0xFF;
+    if (len <= 0xFF) {
+        out[i++] = static_cast<uint8_t>(len);
+        out[i++] = static_cast<uint8_t>(0x100 - len);
+    } else {
+        const uint8_t lenM = static_cast<uint8_t>(len >> 8);
+        const uint8_t lenL = static_cast<uint8_t>(len & 0xFF);
+        out[i++] = 0xFF;
+        out[i++] = 0xFF;
+        out[i++] = lenM;
+        out[i++] = lenL;
+        out[i++] = static_cast<uint8_t>(0x100 - ((lenM + lenL) & 0xFF));
+    }
+
+    uint8_t sum = PN532_TFI_HOST_TO_PN532 + command;
+    out[i++] = PN532_TFI_HOST_TO_PN532;
+    out[i++] = command;
+    for (size_t k = 0; k < paramsLen; ++k) {
+        out[i++] = params[k];
+        sum = static_cast<uint8_t>(sum + params[k]);
+    }
+    out[i++] = static_cast<uint8_t>(0x100 - sum);
+    out[i++] = 0x00; // postamble
+    return i;
+}
+
+const std::vector<uint8_t>& hsuWakePreamble() {
+    static const std::vector<uint8_t> preamble = {
+        0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    return preamble;
+}
+
+} // namespace hardware
+} // namespace adapters
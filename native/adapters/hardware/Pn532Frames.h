@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+// PN532 HSU frame helpers (user manual §6.2.1).
+//
+// Normal information frame:
+//   00 00 FF LEN LCS TFI PD0..PDn DCS 00
+// Extended information frame:
+//   00 00 FF FF FF LENM LENL LCS TFI PD0..PDn DCS 00
+// ACK:   00 00 FF 00 FF 00
+// NACK:  00 00 FF FF 00 00
+// Error: 00 00 FF 01 FF 7F 81 00
+//
+// The adapter drives the PN532 through Pn532Driver for everything NfcCpp
+// supports; these helpers cover the handful of commands it does not expose
+// (PowerDown, RFConfiguration, GetGeneralStatus, and DESFire native
+// commands relayed with InDataExchange) and frame-level inspection.
+
+constexpr uint8_t PN532_TFI_HOST_TO_PN532 = 0xD4;
+constexpr uint8_t PN532_TFI_PN532_TO_HOST = 0xD5;
+
+// Command codes used outside Pn532Driver
+constexpr uint8_t PN532_CMD_GET_GENERAL_STATUS = 0x04;
+constexpr uint8_t PN532_CMD_SAM_CONFIGURATION  = 0x14;
+constexpr uint8_t PN532_CMD_POWER_DOWN         = 0x16;
+constexpr uint8_t PN532_CMD_RF_CONFIGURATION   = 0x32;
+constexpr uint8_t PN532_CMD_IN_DATA_EXCHANGE   = 0x40;
+
+enum class FrameScanStatus {
+    Incomplete,    // no complete frame in the buffer yet
+    Ack,
+    Nack,
+    Information,   // normal or extended information frame, checksums valid
+    ErrorFrame,    // application-level error frame (TFI 0x7F)
+    ChecksumError, // LCS or DCS mismatch — frame must be discarded
+};
+
+struct FrameScan {
+    FrameScanStatus status = FrameScanStatus::Incomplete;
+    size_t start      = 0; // offset of the first start-code byte (00 FF)
+    size_t length     = 0; // bytes from start through DCS (postamble excluded)
+    size_t dataOffset = 0; // offset of TFI for information frames
+    size_t dataLength = 0; // TFI + PD bytes
+};
+
+// Scans data[0..size) for the first complete frame. Bytes before `start`
+// are noise (preamble, postamble of a previous frame, or line garbage)
+// and may be dropped by the caller. When the status is Incomplete, `start`
+// points at the earliest candidate start code so the caller can keep
+// that tail and append more bytes.
+FrameScan scanFrame(const uint8_t* data, size_t size);
+
+// Builds a host→PN532 information frame for `command` with `params`.
+// Extended framing is used automatically when TFI + PD exceed 255 bytes.
+std::vector<uint8_t> buildCommandFrame(uint8_t command, const uint8_t* params, size_t paramsLen);
+
+// Same frame written into `out`; returns its length, or 0 when it does not
+// fit in `capacity`.
+size_t writeCommandFrame(uint8_t command, const uint8_t* params, size_t paramsLen,
+                         uint8_t* out, size_t capacity);
+
+// Bytes to send ahead of a command to bring the PN532 out of PowerDown over
+// HSU: 0x55 0x55 followed by a long preamble so the oscillator can start
+// before the start code arrives (user manual §7.2.11).
+const std::vector<uint8_t>& hsuWakePreamble();
+
+} // namespace hardware
+} // namespace adapters
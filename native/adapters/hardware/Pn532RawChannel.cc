@@ -0,0 +1,152 @@
+#include "Pn532RawChannel.h"
+#include "Pn532Frames.h"
+#include "SerialWaker.h"
+#include "../timing/SteadyClock.h"
+#include "Comms/Serial/ISerialBus.hpp"
+#include "Error/Error.h"
+#include <chrono>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+// The PN532 ACKs within ~1 ms of the last command byte; the margin covers
+// USB-serial bridge latency timers.
+constexpr uint32_t ACK_TIMEOUT_MS = 30;
+
+// Extra ACK budget after a wake preamble: oscillator start-up plus the
+// preamble's own transfer time at 115200 baud.
+constexpr uint32_t WAKE_ACK_EXTRA_MS = 20;
+
+// Largest single write: wake preamble + extended frame for a full APDU
+constexpr size_t MAX_WRITE = 300;
+
+static core::ports::NfcError ioError(const error::Error& err) {
+    const bool isTimeout =
+        (err.is<error::HardwareError>() && err.get<error::HardwareError>() == error::HardwareError::Timeout) ||
+        (err.is<error::Pn532Error>()    && err.get<error::Pn532Error>()    == error::Pn532Error::Timeout);
+    return core::ports::NfcError{
+        isTimeout ? "IO_TIMEOUT" : "HARDWARE_ERROR",
+        std::string(err.toString().c_str())
+    };
+}
+
+} // anonymous namespace
+
+Pn532RawChannel::Pn532RawChannel(comms::serial::ISerialBus& serial, const SerialWaker* waker,
+                                 core::ports::IClock* clock)
+    : _serial(serial), _waker(waker), _clock(clock ? *clock : *timing::steadyClock()) {}
+
+core::ports::Result<std::vector<uint8_t>> Pn532RawChannel::transceive(
+    uint8_t command,
+    const std::vector<uint8_t>& params,
+    uint32_t timeoutMs,
+    bool wakeFirst) {
+    auto res = transceiveView(command, params.data(), params.size(), timeoutMs, wakeFirst);
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        return std::get<core::ports::NfcError>(res);
+    }
+    const auto payload = std::get<std::span<const uint8_t>>(res);
+    return std::vector<uint8_t>(payload.begin(), payload.end());
+}
+
+core::ports::Result<std::span<const uint8_t>> Pn532RawChannel::transceiveView(
+    uint8_t command,
+    const uint8_t* params,
+    size_t paramsLen,
+    uint32_t timeoutMs,
+    bool wakeFirst) {
+    _rx.reset();
+
+    etl::vector<uint8_t, MAX_WRITE> out;
+    if (wakeFirst) {
+        for (auto b : hsuWakePreamble()) out.push_back(b);
+    }
+    const size_t offset = out.size();
+    out.resize(MAX_WRITE);
+    const size_t frameLen = writeCommandFrame(command, params, paramsLen, out.data() + offset, MAX_WRITE - offset);
+    if (frameLen == 0) {
+        return core::ports::NfcError{"HARDWARE_ERROR", "PN532 command frame too large"};
+    }
+    out.resize(offset + frameLen);
+
+    auto writeResult = _serial.write(out);
+    if (!writeResult.has_value()) return ioError(writeResult.error());
+
+    auto ack = readFrame(Expect::Ack, command, ACK_TIMEOUT_MS + (wakeFirst ? WAKE_ACK_EXTRA_MS : 0));
+    if (std::holds_alternative<core::ports::NfcError>(ack)) return ack;
+
+    return readFrame(Expect::Response, command, timeoutMs);
+}
+
+core::ports::Result<std::span<const uint8_t>> Pn532RawChannel::readFrame(
+    Expect expect, uint8_t command, uint32_t timeoutMs) {
+    const auto deadline = _clock.now() + std::chrono::milliseconds(timeoutMs);
+
+    for (;;) {
+        const Pn532FrameAssembler::Frame frame = _rx.next();
+
+        switch (frame.status) {
+            case FrameScanStatus::Incomplete:
+                break;
+
+            case FrameScanStatus::Ack:
+                _rx.consume();
+                if (expect == Expect::Ack) return std::span<const uint8_t>{};
+                continue; // stray ACK while waiting for the response
+
+            case FrameScanStatus::Nack:
+                _rx.consume();
+                return core::ports::NfcError{"HARDWARE_ERROR", "PN532 rejected the frame (NACK)"};
+
+            case FrameScanStatus::ChecksumError:
+                _rx.consume();
+                return core::ports::NfcError{"HARDWARE_ERROR", "PN532 frame checksum mismatch"};
+
+            case FrameScanStatus::ErrorFrame:
+                _rx.consume();
+                return core::ports::NfcError{"HARDWARE_ERROR", "PN532 reported a syntax error frame"};
+
+            case FrameScanStatus::Information: {
+                if (expect == Expect::Ack) {
+                    _rx.consume();
+                    return core::ports::NfcError{"HARDWARE_ERROR", "PN532 sent a response before ACK"};
+                }
+                const auto data = frame.data;
+                if (data.size() < 2 ||
+                    data[0] != PN532_TFI_PN532_TO_HOST ||
+                    data[1] != static_cast<uint8_t>(command + 1)) {
+                    _rx.consume();
+                    return core::ports::NfcError{"HARDWARE_ERROR", "Unexpected PN532 response frame"};
+                }
+                // Left in the ring: the view stays valid until the next
+                // transceive resets it
+                return data.subspan(2);
+            }
+        }
+
+        const auto now = _clock.now();
+        if (now >= deadline) {
+            return core::ports::NfcError{"IO_TIMEOUT",
+                expect == Expect::Ack ? "Timed out waiting for PN532 ACK"
+                                      : "Timed out waiting for PN532 response"};
+        }
+        const auto remainingMs = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1);
+
+        // Waits for the first byte, then takes everything already buffered
+        auto fillResult = _rx.fill(_serial, remainingMs);
+        if (!fillResult.has_value()) {
+            const auto err = ioError(fillResult.error());
+            if (_waker && _waker->woken()) {
+                return core::ports::NfcError{"CANCELLED", "PN532 command cancelled"};
+            }
+            if (err.code == "IO_TIMEOUT") continue; // re-check deadline
+            return err;
+        }
+    }
+}
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,71 @@
+#pragma once
+#include "../../core/ports/IClock.h"
+#include "../../core/ports/INfcReader.h"
+#include "Pn532FrameAssembler.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace comms {
+namespace serial {
+class ISerialBus;
+}
+}
+
+namespace adapters {
+namespace hardware {
+
+class SerialWaker;
+
+/**
+ * Minimal PN532 command channel that talks HSU frames directly over the
+ * serial bus, for the commands Pn532Driver does not expose.
+ *
+ * Not thread-safe: callers must hold the adapter mutex so the channel never
+ * interleaves with a driver transaction on the same bus.
+ */
+class Pn532RawChannel {
+public:
+    // When `waker` is set, a wake-up during a wait ends the transceive with
+    // CANCELLED instead of running out the timeout. Deadlines are kept on
+    // `clock` (the steady clock when null), which must outlive the channel.
+    explicit Pn532RawChannel(comms::serial::ISerialBus& serial, const SerialWaker* waker = nullptr,
+                             core::ports::IClock* clock = nullptr);
+
+    // Sends `command` with `params`, waits for the ACK and returns the
+    // response payload (bytes after D5 <command+1>). When `wakeFirst` is set
+    // the HSU wake preamble is sent in the same write so a powered-down
+    // PN532 wakes up and executes the command in one round trip.
+    core::ports::Result<std::vector<uint8_t>> transceive(
+        uint8_t command,
+        const std::vector<uint8_t>& params,
+        uint32_t timeoutMs,
+        bool wakeFirst = false);
+
+    // Same exchange without allocating: the payload is a view into the
+    // receive ring, valid until the next call on this channel.
+    core::ports::Result<std::span<const uint8_t>> transceiveView(
+        uint8_t command,
+        const uint8_t* params,
+        size_t paramsLen,
+        uint32_t timeoutMs,
+        bool wakeFirst = false);
+
+    // Bus calls made to receive frames since construction.
+    uint64_t rxBusCalls() const { return _rx.busCalls(); }
+
+private:
+    enum class Expect { Ack, Response };
+
+    // Reads until a frame of the expected kind is complete or the timeout
+    // expires. For a response, the payload view points into _rx.
+    core::ports::Result<std::span<const uint8_t>> readFrame(Expect expect, uint8_t command, uint32_t timeoutMs);
+
+    comms::serial::ISerialBus& _serial;
+    const SerialWaker* _waker;
+    core::ports::IClock& _clock;
+    Pn532FrameAssembler _rx; // bytes received but not yet consumed
+};
+
+} // namespace hardware
+} // namespace adapters
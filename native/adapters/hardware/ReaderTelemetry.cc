@@ -0,0 +1,189 @@
+#include "ReaderTelemetry.h"
+#include "../timing/SteadyClock.h"
+#include <algorithm>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+static uint32_t bitrateKbps(uint8_t code) {
+    switch (code) {
+        case 0x00: return 106;
+        case 0x01: return 212;
+        case 0x02: return 424;
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+ReaderTelemetry::ReaderTelemetry(std::shared_ptr<core::ports::IClock> clock)
+    : _clock(clock ? std::move(clock) : timing::steadyClock()) {}
+
+const char* pn532ErrorName(uint8_t code) {
+    switch (code & 0x3F) { // bit 6 is the NAD-present flag, not part of the code
+        case 0x00: return "none";
+        case 0x01: return "timeout";
+        case 0x02: return "CRC error";
+        case 0x03: return "parity error";
+        case 0x04: return "anticollision bit count error";
+        case 0x05: return "Mifare framing error";
+        case 0x06: return "anticollision bit collision";
+        case 0x07: return "communication buffer too small";
+        case 0x09: return "RF buffer overflow";
+        case 0x0A: return "RF field not switched on in time";
+        case 0x0B: return "RF protocol error";
+        case 0x0D: return "temperature error";
+        case 0x0E: return "internal buffer overflow";
+        case 0x10: return "invalid parameter";
+        case 0x12: return "DEP unsupported command";
+        case 0x13: return "DEP invalid data format";
+        case 0x14: return "Mifare authentication error";
+        case 0x23: return "UID check byte wrong";
+        case 0x25: return "DEP invalid device state";
+        case 0x26: return "operation not allowed";
+        case 0x27: return "command not acceptable in context";
+        case 0x29: return "target released by initiator";
+        case 0x2A: return "card ID mismatch";
+        case 0x2B: return "card disappeared";
+        case 0x2C: return "NFCID3 mismatch";
+        case 0x2D: return "over-current";
+        case 0x2E: return "NAD missing in DEP frame";
+    }
+    return "unknown";
+}
+
+void ReaderTelemetry::reset() {
+    _bytesOut = 0;
+    _bytesIn = 0;
+    _framesOut = 0;
+    _framesIn = 0;
+    _acks = 0;
+    _nacks = 0;
+    _checksumErrors = 0;
+    _errorFrames = 0;
+    _retries = 0;
+    _timeouts = 0;
+    _ioErrors = 0;
+    _lastCommand.clear();
+    _awaitingResponse = false;
+
+    std::lock_guard<std::mutex> lock(_statusMutex);
+    _statusValid = false;
+    _linkTuning.clear();
+}
+
+void ReaderTelemetry::recordLinkTuning(std::vector<core::ports::LinkTuningResult> tuning) {
+    std::lock_guard<std::mutex> lock(_statusMutex);
+    _linkTuning = std::move(tuning);
+}
+
+void ReaderTelemetry::onFrame(const FrameEvent& event) {
+    const bool outbound = event.direction == FrameDirection::HostToPn532;
+    (outbound ? _framesOut : _framesIn).fetch_add(1, std::memory_order_relaxed);
+
+    switch (event.status) {
+        case FrameScanStatus::Ack:
+            _acks.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case FrameScanStatus::Nack:
+            _nacks.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case FrameScanStatus::ChecksumError:
+            if (!outbound) _checksumErrors.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case FrameScanStatus::ErrorFrame:
+            _errorFrames.fetch_add(1, std::memory_order_relaxed);
+            _awaitingResponse = false;
+            break;
+        case FrameScanStatus::Information:
+            if (outbound) {
+                // The same command frame again with no response in between
+                // is a driver-level retry.
+                const bool same =
+                    _awaitingResponse &&
+                    _lastCommand.size() == event.frameLength &&
+                    std::equal(_lastCommand.begin(), _lastCommand.end(), event.frame);
+                if (same) _retries.fetch_add(1, std::memory_order_relaxed);
+                _lastCommand.assign(event.frame, event.frame + event.frameLength);
+                _awaitingResponse = true;
+            } else {
+                _awaitingResponse = false;
+            }
+            break;
+        case FrameScanStatus::Incomplete:
+            break;
+    }
+}
+
+void ReaderTelemetry::onBytes(FrameDirection direction, size_t count) {
+    auto& counter = (direction == FrameDirection::HostToPn532) ? _bytesOut : _bytesIn;
+    counter.fetch_add(count, std::memory_order_relaxed);
+}
+
+void ReaderTelemetry::onReadTimeout() {
+    _timeouts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ReaderTelemetry::onIoError(FrameDirection /*direction*/) {
+    _ioErrors.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ReaderTelemetry::recordGeneralStatus(const std::vector<uint8_t>& payload) {
+    // Err, Field, NbTg, NbTg × [Tg, BrRx, BrTx, Type], SAM status
+    if (payload.size() < 3) return;
+
+    std::lock_guard<std::mutex> lock(_statusMutex);
+    _statusValid   = true;
+    _sampledAt     = _clock->now();
+    _lastError     = payload[0];
+    _externalField = payload[1] != 0;
+    _targetCount   = payload[2];
+    if (_targetCount > 0 && payload.size() >= 7) {
+        _bitrateRxKbps = bitrateKbps(payload[4]);
+        _bitrateTxKbps = bitrateKbps(payload[5]);
+    } else {
+        _bitrateRxKbps = 0;
+        _bitrateTxKbps = 0;
+    }
+}
+
+bool ReaderTelemetry::sampleDue(std::chrono::milliseconds interval) const {
+    std::lock_guard<std::mutex> lock(_statusMutex);
+    return !_statusValid || _clock->now() - _sampledAt >= interval;
+}
+
+core::ports::ReaderHealthSnapshot ReaderTelemetry::snapshot() const {
+    core::ports::ReaderHealthSnapshot snap;
+    snap.bytesOut       = _bytesOut.load(std::memory_order_relaxed);
+    snap.bytesIn        = _bytesIn.load(std::memory_order_relaxed);
+    snap.framesOut      = _framesOut.load(std::memory_order_relaxed);
+    snap.framesIn       = _framesIn.load(std::memory_order_relaxed);
+    snap.acks           = _acks.load(std::memory_order_relaxed);
+    snap.nacks          = _nacks.load(std::memory_order_relaxed);
+    snap.checksumErrors = _checksumErrors.load(std::memory_order_relaxed);
+    snap.errorFrames    = _errorFrames.load(std::memory_order_relaxed);
+    snap.retries        = _retries.load(std::memory_order_relaxed);
+    snap.timeouts       = _timeouts.load(std::memory_order_relaxed);
+    snap.ioErrors       = _ioErrors.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_statusMutex);
+    snap.linkTuning  = _linkTuning;
+    snap.statusValid = _statusValid;
+    if (_statusValid) {
+        snap.statusAgeMs = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                _clock->now() - _sampledAt).count());
+        snap.lastError            = _lastError;
+        snap.lastErrorName        = pn532ErrorName(_lastError);
+        snap.externalFieldPresent = _externalField;
+        snap.targetCount          = _targetCount;
+        snap.targetBitrateRxKbps  = _bitrateRxKbps;
+        snap.targetBitrateTxKbps  = _bitrateTxKbps;
+    }
+    return snap;
+}
+
+} // namespace hardware
+} // namespace adapters
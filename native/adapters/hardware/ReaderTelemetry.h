@@ -0,0 +1,78 @@
+#pragma once
+#include "MonitoredSerialBus.h"
+#include "../../core/ports/IClock.h"
+#include "../../core/ports/INfcReader.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * Reader health counters fed by MonitoredSerialBus, plus the most recent
+ * PN532 GetGeneralStatus sample.
+ *
+ * Frame callbacks run under the adapter mutex; snapshot() may be called
+ * from any thread and only reads atomics and the sample under its own lock.
+ */
+class ReaderTelemetry : public ISerialObserver {
+public:
+    // Sample ages are measured on `clock`; null selects the steady clock.
+    explicit ReaderTelemetry(std::shared_ptr<core::ports::IClock> clock = nullptr);
+
+    void reset();
+
+    void onFrame(const FrameEvent& event) override;
+    void onBytes(FrameDirection direction, size_t count) override;
+    void onReadTimeout() override;
+    void onIoError(FrameDirection direction) override;
+
+    // Records a GetGeneralStatus response payload (bytes after D5 05).
+    void recordGeneralStatus(const std::vector<uint8_t>& payload);
+
+    // Low-latency settings the serial backend applied at connect.
+    void recordLinkTuning(std::vector<core::ports::LinkTuningResult> tuning);
+
+    // True when no status sample was taken within `interval`.
+    bool sampleDue(std::chrono::milliseconds interval) const;
+
+    core::ports::ReaderHealthSnapshot snapshot() const;
+
+private:
+    std::shared_ptr<core::ports::IClock> _clock;
+
+    std::atomic<uint64_t> _bytesOut{0};
+    std::atomic<uint64_t> _bytesIn{0};
+    std::atomic<uint64_t> _framesOut{0};
+    std::atomic<uint64_t> _framesIn{0};
+    std::atomic<uint64_t> _acks{0};
+    std::atomic<uint64_t> _nacks{0};
+    std::atomic<uint64_t> _checksumErrors{0};
+    std::atomic<uint64_t> _errorFrames{0};
+    std::atomic<uint64_t> _retries{0};
+    std::atomic<uint64_t> _timeouts{0};
+    std::atomic<uint64_t> _ioErrors{0};
+
+    // Retry detection — touched only from frame callbacks
+    std::vector<uint8_t> _lastCommand;
+    bool _awaitingResponse = false;
+
+    mutable std::mutex _statusMutex;
+    bool _statusValid = false;
+    core::ports::IClock::TimePoint _sampledAt;
+    uint8_t _lastError = 0;
+    bool _externalField = false;
+    uint8_t _targetCount = 0;
+    uint32_t _bitrateRxKbps = 0;
+    uint32_t _bitrateTxKbps = 0;
+    std::vector<core::ports::LinkTuningResult> _linkTuning;
+};
+
+// Short name for a PN532 error code (user manual §7.1, table 3).
+const char* pn532ErrorName(uint8_t code);
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,37 @@
+#include "SerialBusDecorator.h"
+
+namespace adapters {
+namespace hardware {
+
+SerialBusDecorator::SerialBusDecorator(std::unique_ptr<comms::serial::ISerialBus> inner)
+    : _inner(std::move(inner)) {}
+
+SerialBusDecorator::~SerialBusDecorator() = default;
+
+etl::expected<void, error::Error> SerialBusDecorator::init() {
+    return _inner->init();
+}
+
+etl::expected<void, error::Error> SerialBusDecorator::write(const etl::ivector<uint8_t>& data) {
+    return _inner->write(data);
+}
+
+etl::expected<size_t, error::Error> SerialBusDecorator::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    return _inner->read(buffer, length, timeoutMs);
+}
+
+etl::expected<size_t, error::Error> SerialBusDecorator::available() {
+    return _inner->available();
+}
+
+etl::expected<void, error::Error> SerialBusDecorator::flush() {
+    return _inner->flush();
+}
+
+void SerialBusDecorator::close() {
+    _inner->close();
+}
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,33 @@
+#pragma once
+#include "Comms/Serial/ISerialBus.hpp"
+#include <memory>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * Forwards every ISerialBus call to an owned inner bus. Decorators override
+ * only the calls they care about, which keeps the ISerialBus surface that
+ * this tree depends on in one place.
+ */
+class SerialBusDecorator : public comms::serial::ISerialBus {
+public:
+    explicit SerialBusDecorator(std::unique_ptr<comms::serial::ISerialBus> inner);
+    ~SerialBusDecorator() override;
+
+    etl::expected<void, error::Error>   init() override;
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+    etl::expected<size_t, error::Error> available() override;
+    etl::expected<void, error::Error>   flush() override;
+    void                                close() override;
+
+protected:
+    comms::serial::ISerialBus& inner() { return *_inner; }
+
+private:
+    std::unique_ptr<comms::serial::ISerialBus> _inner;
+};
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,337 @@
+#include "SerialBusLinux.h"
+
+#if defined(__linux__)
+
+#include "Error/Error.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+// A PN532 frame is at most ~270 bytes; at 115200 baud that drains in
+// ~25 ms, so a stalled write is a dead link, not a slow one.
+constexpr uint32_t WRITE_TIMEOUT_MS = 1000;
+
+static speed_t speedFor(uint32_t baudrate) {
+    switch (baudrate) {
+        case 9600:   return B9600;
+        case 19200:  return B19200;
+        case 38400:  return B38400;
+        case 57600:  return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default:     return B0;
+    }
+}
+
+// FTDI bridges hold short packets for this long before sending them up
+// the USB pipe (default 16 ms); 1 ms is the driver's minimum.
+constexpr int LOW_LATENCY_TIMER_MS = 1;
+
+// sysfs latency_timer of the USB-serial device behind `port`, following
+// /dev/serial/by-id style symlinks; empty when the driver has none.
+static std::string latencyTimerPath(const std::string& port) {
+    char resolved[PATH_MAX];
+    if (!::realpath(port.c_str(), resolved)) return {};
+    const char* name = std::strrchr(resolved, '/');
+    name = name ? name + 1 : resolved;
+    std::string path = std::string("/sys/class/tty/") + name + "/device/latency_timer";
+    return ::access(path.c_str(), F_OK) == 0 ? path : std::string{};
+}
+
+static bool readIntFile(const std::string& path, int& value) {
+    std::ifstream in(path);
+    return static_cast<bool>(in >> value);
+}
+
+static bool writeIntFile(const std::string& path, int value) {
+    std::ofstream out(path);
+    out << value;
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+static etl::unexpected<error::Error> timeoutError() {
+    return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Timeout));
+}
+
+static etl::unexpected<error::Error> ioError() {
+    return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Io));
+}
+
+} // anonymous namespace
+
+SerialBusLinux::SerialBusLinux(std::string port, uint32_t baudrate, std::shared_ptr<SerialWaker> waker,
+                               bool lowLatency)
+    : _port(std::move(port)), _baudrate(baudrate), _waker(std::move(waker)), _lowLatency(lowLatency) {}
+
+SerialBusLinux::~SerialBusLinux() {
+    close();
+}
+
+etl::expected<void, error::Error> SerialBusLinux::init() {
+    close();
+
+    const speed_t speed = speedFor(_baudrate);
+    if (speed == B0) {
+        _lastErrno = EINVAL;
+        return ioError();
+    }
+
+    _fd = ::open(_port.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (_fd < 0) {
+        _lastErrno = errno;
+        return ioError();
+    }
+
+    termios tio{};
+    if (::tcgetattr(_fd, &tio) != 0) {
+        _lastErrno = errno;
+        close();
+        return ioError();
+    }
+    ::cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    // Pure non-blocking reads: waiting is done in ppoll, never in the tty layer
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    ::cfsetispeed(&tio, speed);
+    ::cfsetospeed(&tio, speed);
+    if (::tcsetattr(_fd, TCSANOW, &tio) != 0) {
+        _lastErrno = errno;
+        close();
+        return ioError();
+    }
+    _tuning.clear();
+    record("vmin_vtime", true, "VMIN=0 VTIME=0: reads return at once, waits happen in ppoll");
+    if (_lowLatency) applyLowLatency();
+
+    ::tcflush(_fd, TCIOFLUSH);
+    _rxHead = _rxTail = 0;
+    _lastErrno = 0;
+    return {};
+}
+
+etl::expected<void, error::Error> SerialBusLinux::write(const etl::ivector<uint8_t>& data) {
+    if (_fd < 0) return ioError();
+
+    const auto deadline = Clock::now() + std::chrono::milliseconds(WRITE_TIMEOUT_MS);
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const ssize_t n = ::write(_fd, data.data() + offset, data.size() - offset);
+        if (n > 0) {
+            offset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno != EAGAIN) {
+            _lastErrno = errno;
+            return ioError();
+        }
+        switch (waitFor(POLLOUT, deadline, false)) {
+            case WaitResult::Ready:   break;
+            case WaitResult::Timeout:
+            case WaitResult::Woken:   return timeoutError();
+            case WaitResult::Error:   return ioError();
+        }
+    }
+    return {};
+}
+
+etl::expected<size_t, error::Error> SerialBusLinux::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    if (_fd < 0) return ioError();
+
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    size_t got = 0;
+    for (;;) {
+        while (got < length && buffered() > 0 && buffer.size() < buffer.max_size()) {
+            buffer.push_back(_rx[_rxHead++]);
+            ++got;
+        }
+        if (buffered() == 0) _rxHead = _rxTail = 0;
+        if (got == length || buffer.size() == buffer.max_size()) return got;
+
+        const long added = drainKernelBuffer();
+        if (added < 0) return ioError();
+        if (added > 0) continue;
+
+        switch (waitFor(POLLIN, deadline, true)) {
+            case WaitResult::Ready:
+                continue;
+            case WaitResult::Timeout:
+            case WaitResult::Woken:
+                if (got > 0) return got;
+                return timeoutError();
+            case WaitResult::Error:
+                return ioError();
+        }
+    }
+}
+
+etl::expected<size_t, error::Error> SerialBusLinux::available() {
+    if (_fd < 0) return ioError();
+    if (drainKernelBuffer() < 0) return ioError();
+    return buffered();
+}
+
+etl::expected<void, error::Error> SerialBusLinux::flush() {
+    if (_fd < 0) return ioError();
+    // Input only: discarding queued output could cut a command frame short
+    ::tcflush(_fd, TCIFLUSH);
+    _rxHead = _rxTail = 0;
+    return {};
+}
+
+void SerialBusLinux::close() {
+    if (_fd >= 0) {
+        restoreLowLatency();
+        ::close(_fd); // also drops TIOCEXCL
+        _fd = -1;
+    }
+    _rxHead = _rxTail = 0;
+}
+
+void SerialBusLinux::applyLowLatency() {
+    // Exclusive access: a second process (ModemManager probing, a stray
+    // terminal) interleaving bytes corrupts PN532 frames in both directions
+    if (::ioctl(_fd, TIOCEXCL) == 0) {
+        record("exclusive", true, "TIOCEXCL: other non-root opens of the port fail with EBUSY");
+    } else {
+        record("exclusive", false, std::string("TIOCEXCL failed: ") + std::strerror(errno));
+    }
+
+    // ASYNC_LOW_LATENCY asks the driver to push received bytes to the tty
+    // layer immediately instead of batching them for the flip buffer work
+    serial_struct ss{};
+    if (::ioctl(_fd, TIOCGSERIAL, &ss) != 0) {
+        record("low_latency", false, std::string("TIOCGSERIAL not supported: ") + std::strerror(errno));
+    } else if (ss.flags & ASYNC_LOW_LATENCY) {
+        record("low_latency", true, "ASYNC_LOW_LATENCY already set by the driver");
+    } else {
+        const int original = ss.flags;
+        ss.flags |= ASYNC_LOW_LATENCY;
+        if (::ioctl(_fd, TIOCSSERIAL, &ss) == 0) {
+            _restoreSerialFlags = true;
+            _savedSerialFlags = original;
+            record("low_latency", true, "ASYNC_LOW_LATENCY: received bytes reach readers without deferral");
+        } else {
+            record("low_latency", false, std::string("TIOCSSERIAL failed: ") + std::strerror(errno));
+        }
+    }
+
+    // FTDI only: the bridge's own packet timer dominates short-frame latency
+    const std::string path = latencyTimerPath(_port);
+    int current = 0;
+    if (path.empty()) {
+        record("latency_timer", false, "no latency_timer attribute (not an FTDI bridge)");
+    } else if (!readIntFile(path, current)) {
+        record("latency_timer", false, "cannot read " + path);
+    } else if (current <= LOW_LATENCY_TIMER_MS) {
+        record("latency_timer", true, "latency_timer already " + std::to_string(current) + " ms");
+    } else if (writeIntFile(path, LOW_LATENCY_TIMER_MS)) {
+        _latencyTimerPath = path;
+        _savedLatencyTimerMs = current;
+        record("latency_timer", true,
+               "latency_timer " + std::to_string(current) + " ms -> " +
+               std::to_string(LOW_LATENCY_TIMER_MS) + " ms: short frames leave the bridge up to " +
+               std::to_string(current - LOW_LATENCY_TIMER_MS) + " ms sooner");
+    } else {
+        record("latency_timer", false,
+               "latency_timer is " + std::to_string(current) + " ms and not writable (needs a udev rule)");
+    }
+}
+
+void SerialBusLinux::restoreLowLatency() {
+    if (_restoreSerialFlags) {
+        serial_struct ss{};
+        if (::ioctl(_fd, TIOCGSERIAL, &ss) == 0) {
+            ss.flags = _savedSerialFlags;
+            (void)::ioctl(_fd, TIOCSSERIAL, &ss);
+        }
+        _restoreSerialFlags = false;
+    }
+    if (!_latencyTimerPath.empty()) {
+        (void)writeIntFile(_latencyTimerPath, _savedLatencyTimerMs);
+        _latencyTimerPath.clear();
+    }
+}
+
+void SerialBusLinux::record(const char* setting, bool applied, std::string detail) {
+    _tuning.push_back(core::ports::LinkTuningResult{setting, applied, std::move(detail)});
+}
+
+SerialBusLinux::WaitResult SerialBusLinux::waitFor(short events, Clock::time_point deadline, bool interruptible) {
+    const int wakeFd = (interruptible && _waker) ? _waker->fd() : -1;
+    for (;;) {
+        if (interruptible && _waker && _waker->woken()) return WaitResult::Woken;
+
+        const auto now = Clock::now();
+        if (now >= deadline) return WaitResult::Timeout;
+        const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(remaining / 1000000000);
+        ts.tv_nsec = static_cast<long>(remaining % 1000000000);
+
+        pollfd fds[2] = {{_fd, events, 0}, {wakeFd, POLLIN, 0}};
+        const int n = ::ppoll(fds, wakeFd >= 0 ? 2 : 1, &ts, nullptr);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            _lastErrno = errno;
+            return WaitResult::Error;
+        }
+        if (n == 0) continue; // loop re-checks the deadline
+        if (wakeFd >= 0 && (fds[1].revents & POLLIN)) return WaitResult::Woken;
+        if (fds[0].revents & events) return WaitResult::Ready;
+        if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            _lastErrno = EIO; // adapter unplugged or port closed under us
+            return WaitResult::Error;
+        }
+    }
+}
+
+long SerialBusLinux::drainKernelBuffer() {
+    if (_rxHead > 0 && _rxTail == _rx.size()) {
+        std::memmove(_rx.data(), _rx.data() + _rxHead, buffered());
+        _rxTail -= _rxHead;
+        _rxHead = 0;
+    }
+    long added = 0;
+    while (_rxTail < _rx.size()) {
+        const size_t room = _rx.size() - _rxTail;
+        const ssize_t n = ::read(_fd, _rx.data() + _rxTail, room);
+        if (n > 0) {
+            _rxTail += static_cast<size_t>(n);
+            added += n;
+            if (static_cast<size_t>(n) < room) break; // short read: kernel queue is empty
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno != EAGAIN) {
+            _lastErrno = errno;
+            return -1;
+        }
+        break; // EAGAIN or 0: nothing more right now
+    }
+    return added;
+}
+
+} // namespace hardware
+} // namespace adapters
+
+#endif // __linux__
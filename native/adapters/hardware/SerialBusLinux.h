@@ -0,0 +1,100 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include "Comms/Serial/ISerialBus.hpp"
+#include "SerialWaker.h"
+#include "../../core/ports/INfcReader.h"
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * Event-driven Linux serial backend. The tty is opened O_NONBLOCK in raw
+ * mode with VMIN = VTIME = 0, and every wait is a ppoll() on the tty plus
+ * the optional SerialWaker's eventfd against a CLOCK_MONOTONIC deadline:
+ *
+ *   - bytes are returned as soon as the kernel has them, not after a
+ *     VTIME tick (0.1 s granularity) or a rounded-up millisecond sleep;
+ *   - timeouts are exact to the poll resolution and never stretch across
+ *     retries, since the remaining time is recomputed from the deadline;
+ *   - SerialWaker::wake() from another thread ends the wait at once and
+ *     the read reports a timeout, which NfcCpp and Pn532RawChannel
+ *     already unwind from.
+ *
+ * One read() syscall drains everything the kernel has buffered into a
+ * small user-space buffer, so the single-byte reads the PN532 drivers
+ * issue are served without further syscalls.
+ *
+ * With `lowLatency` set, init() also takes the port exclusively
+ * (TIOCEXCL), sets ASYNC_LOW_LATENCY and drops an FTDI latency_timer to
+ * 1 ms. Each step is best effort and recorded in tuning(); close() puts
+ * the driver flags and the latency timer back as it found them.
+ */
+class SerialBusLinux : public comms::serial::ISerialBus {
+public:
+    SerialBusLinux(std::string port, uint32_t baudrate, std::shared_ptr<SerialWaker> waker = nullptr,
+                   bool lowLatency = true);
+    ~SerialBusLinux() override;
+
+    etl::expected<void, error::Error>   init() override;
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+    etl::expected<size_t, error::Error> available() override;
+    etl::expected<void, error::Error>   flush() override;
+    void                                close() override;
+
+    // errno of the last failed system call, 0 when none
+    int lastErrno() const { return _lastErrno; }
+
+    // Outcome of each low-latency setting tried by the last init()
+    const std::vector<core::ports::LinkTuningResult>& tuning() const { return _tuning; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class WaitResult { Ready, Timeout, Woken, Error };
+
+    // Waits for `events` on the tty until `deadline`. Only interruptible
+    // waits watch the waker; writes always finish the frame they started.
+    WaitResult waitFor(short events, Clock::time_point deadline, bool interruptible);
+
+    // Moves whatever the kernel has buffered into _rx without blocking.
+    // Returns the number of bytes added, or -1 on a hard error.
+    long drainKernelBuffer();
+
+    size_t buffered() const { return _rxTail - _rxHead; }
+
+    // Applies the low-latency settings to the open fd and fills _tuning.
+    void applyLowLatency();
+    void restoreLowLatency();
+
+    void record(const char* setting, bool applied, std::string detail);
+
+    std::string _port;
+    uint32_t _baudrate;
+    std::shared_ptr<SerialWaker> _waker;
+    bool _lowLatency;
+    int _fd = -1;
+    int _lastErrno = 0;
+
+    std::vector<core::ports::LinkTuningResult> _tuning;
+    bool _restoreSerialFlags = false;
+    int _savedSerialFlags = 0;
+    std::string _latencyTimerPath; // empty unless we changed it
+    int _savedLatencyTimerMs = 0;
+
+    std::array<uint8_t, 512> _rx{};
+    size_t _rxHead = 0;
+    size_t _rxTail = 0;
+};
+
+} // namespace hardware
+} // namespace adapters
+
+#endif // __linux__
@@ -1,5 +1,8 @@
 #include "SerialBusPlatform.h"
+#include "SerialWaker.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <etl/string.h>
 
 #if defined(_WIN32)
@@ -8,25 +11,56 @@
 #include "Comms/Serial/SerialBusPosix.hpp"
 #endif
 
+#if defined(__linux__)
+#include "SerialBusLinux.h"
+#endif
+
 namespace adapters {
 namespace hardware {
 
 std::unique_ptr<comms::serial::ISerialBus> createPlatformSerialBus(
     const std::string& port,
-    std::uint32_t baudrate
+    std::uint32_t baudrate,
+    SerialBackend backend,
+    std::shared_ptr<SerialWaker> waker
 ) {
+    if (backend == SerialBackend::Auto) {
+        const char* pinned = std::getenv("SECUREPASS_SERIAL");
+        backend = (pinned && std::strcmp(pinned, "termios") == 0) ? SerialBackend::Termios
+                                                                  : SerialBackend::Event;
+    }
+
 #if defined(_WIN32)
+    (void)backend;
+    (void)waker;
     etl::string<256> etlPort(port.c_str());
     return std::make_unique<comms::serial::SerialBusWin>(etlPort, baudrate);
 #elif defined(__APPLE__) || defined(__linux__)
+#if defined(__linux__)
+    if (backend == SerialBackend::Event) {
+        return std::make_unique<SerialBusLinux>(port, baudrate, std::move(waker));
+    }
+#endif
+    (void)waker;
     etl::string<256> etlPort(port.c_str());
     return std::make_unique<comms::serial::SerialBusPosix>(etlPort, baudrate);
 #else
     (void)port;
     (void)baudrate;
+    (void)backend;
+    (void)waker;
     return nullptr;
 #endif
 }
 
+std::vector<core::ports::LinkTuningResult> serialLinkTuning(const comms::serial::ISerialBus& bus) {
+#if defined(__linux__)
+    if (const auto* eventBus = dynamic_cast<const SerialBusLinux*>(&bus)) return eventBus->tuning();
+#else
+    (void)bus;
+#endif
+    return {};
+}
+
 } // namespace hardware
 } // namespace adapters
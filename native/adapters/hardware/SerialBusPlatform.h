@@ -1,8 +1,10 @@
 #pragma once
 
+#include "../../core/ports/INfcReader.h"
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace comms {
 namespace serial {
@@ -13,15 +15,34 @@ class ISerialBus;
 namespace adapters {
 namespace hardware {
 
+class SerialWaker;
+
+enum class SerialBackend {
+    Auto,    // Event where available; SECUREPASS_SERIAL=termios pins Termios
+    Termios, // NfcCpp's SerialBusPosix / SerialBusWin
+    Event,   // SerialBusLinux: non-blocking fd + ppoll (Linux only)
+};
+
 /**
  * Creates the platform-specific serial bus implementation.
  * Returns null when no backend is available for the current platform.
+ * Asking for Event where it does not exist falls back to Termios.
+ *
+ * `waker` lets another thread interrupt a blocked read; only the Event
+ * backend honours it.
  */
 std::unique_ptr<comms::serial::ISerialBus> createPlatformSerialBus(
     const std::string& port,
-    std::uint32_t baudrate
+    std::uint32_t baudrate,
+    SerialBackend backend = SerialBackend::Auto,
+    std::shared_ptr<SerialWaker> waker = nullptr
 );
 
+/**
+ * Low-latency settings the bus applied in its last init(), one entry per
+ * setting tried. Empty for backends that leave the tty as they found it.
+ */
+std::vector<core::ports::LinkTuningResult> serialLinkTuning(const comms::serial::ISerialBus& bus);
+
 } // namespace hardware
 } // namespace adapters
-
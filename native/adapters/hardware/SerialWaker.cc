@@ -0,0 +1,45 @@
+#include "SerialWaker.h"
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cstdint>
+#endif
+
+namespace adapters {
+namespace hardware {
+
+SerialWaker::SerialWaker() {
+#if defined(__linux__)
+    _fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#endif
+}
+
+SerialWaker::~SerialWaker() {
+#if defined(__linux__)
+    if (_fd >= 0) ::close(_fd);
+#endif
+}
+
+void SerialWaker::wake() {
+    _woken.store(true, std::memory_order_release);
+#if defined(__linux__)
+    if (_fd >= 0) {
+        const uint64_t one = 1;
+        (void)!::write(_fd, &one, sizeof(one));
+    }
+#endif
+}
+
+void SerialWaker::clear() {
+    _woken.store(false, std::memory_order_release);
+#if defined(__linux__)
+    if (_fd >= 0) {
+        uint64_t value = 0;
+        (void)!::read(_fd, &value, sizeof(value)); // EAGAIN when already clear
+    }
+#endif
+}
+
+} // namespace hardware
+} // namespace adapters
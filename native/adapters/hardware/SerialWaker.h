@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * Cross-thread wake-up for a serial backend that waits in poll(). wake()
+ * interrupts the current wait — and every later one — until clear() is
+ * called, so a cancel that lands between two reads of the same operation
+ * is not lost. Owners clear it at the start of each operation.
+ *
+ * On Linux the wake-up is an eventfd that the backend polls next to the
+ * tty; elsewhere only the flag exists and fd() is -1.
+ *
+ * wake(), clear() and woken() are safe to call from any thread.
+ */
+class SerialWaker {
+public:
+    SerialWaker();
+    ~SerialWaker();
+
+    SerialWaker(const SerialWaker&) = delete;
+    SerialWaker& operator=(const SerialWaker&) = delete;
+
+    void wake();
+    void clear();
+    bool woken() const { return _woken.load(std::memory_order_acquire); }
+
+    // Readable while woken; -1 when the platform has no eventfd.
+    int fd() const { return _fd; }
+
+private:
+    std::atomic<bool> _woken{false};
+    int _fd = -1;
+};
+
+} // namespace hardware
+} // namespace adapters
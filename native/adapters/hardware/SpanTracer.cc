@@ -0,0 +1,158 @@
+#include "SpanTracer.h"
+#include "../timing/SteadyClock.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+std::atomic<uint64_t> g_nextTracerId{1};
+
+// Last buffer this thread recorded into, per tracer id. One entry is
+// enough: a thread normally records for a single adapter.
+struct ThreadCache {
+    uint64_t tracerId = 0;
+    void* buffer = nullptr;
+};
+thread_local ThreadCache t_cache;
+
+static int64_t sinceEpochNs(core::ports::IClock::TimePoint t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+static void appendArgs(std::string& out, const TraceArg (&args)[2]) {
+    char buf[64];
+    bool first = true;
+    for (const auto& a : args) {
+        if (!a.key) continue;
+        out += first ? "\"args\":{" : ",";
+        first = false;
+        if (a.hex) {
+            std::snprintf(buf, sizeof(buf), "\"%s\":\"0x%02" PRIx64 "\"", a.key, static_cast<uint64_t>(a.value));
+        } else {
+            std::snprintf(buf, sizeof(buf), "\"%s\":%" PRId64, a.key, a.value);
+        }
+        out += buf;
+    }
+    if (!first) out += "},";
+}
+
+} // anonymous namespace
+
+SpanTracer::SpanTracer(std::shared_ptr<core::ports::IClock> clock, size_t eventsPerThread)
+    : _clock(clock ? std::move(clock) : timing::steadyClock()),
+      _eventsPerThread(std::max<size_t>(eventsPerThread, 16)),
+      _id(g_nextTracerId.fetch_add(1, std::memory_order_relaxed)) {}
+
+SpanTracer::~SpanTracer() = default;
+
+void SpanTracer::complete(const char* name, const char* category,
+                          core::ports::IClock::TimePoint start, core::ports::IClock::TimePoint end,
+                          TraceArg a0, TraceArg a1) {
+    if (!enabled()) return;
+    const int64_t startNs = sinceEpochNs(start);
+    record(Event{name, category, startNs, std::max<int64_t>(sinceEpochNs(end) - startNs, 0), {a0, a1}});
+}
+
+void SpanTracer::instant(const char* name, const char* category, core::ports::IClock::TimePoint at,
+                         TraceArg a0, TraceArg a1) {
+    if (!enabled()) return;
+    record(Event{name, category, sinceEpochNs(at), -1, {a0, a1}});
+}
+
+SpanTracer::ThreadBuffer* SpanTracer::bufferForThisThread() {
+    if (t_cache.tracerId == _id) return static_cast<ThreadBuffer*>(t_cache.buffer);
+
+    // First span from this thread, or it last recorded for another tracer.
+    // Buffers live as long as the tracer, and ids are never reused, so the
+    // cache cannot point at a freed buffer when the id matches.
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    const auto self = std::this_thread::get_id();
+    ThreadBuffer* found = nullptr;
+    for (auto& b : _buffers) {
+        if (b->owner == self) found = b.get();
+    }
+    if (!found) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->ring.resize(_eventsPerThread);
+        buffer->tid = static_cast<uint32_t>(_buffers.size() + 1);
+        buffer->owner = self;
+        found = buffer.get();
+        _buffers.push_back(std::move(buffer));
+    }
+    t_cache = ThreadCache{_id, found};
+    return found;
+}
+
+void SpanTracer::record(const Event& event) {
+    ThreadBuffer* b = bufferForThisThread();
+    std::lock_guard<std::mutex> lock(b->mutex);
+    if (b->wrapped) ++b->overwritten;
+    b->ring[b->next] = event;
+    if (++b->next == b->ring.size()) {
+        b->next = 0;
+        b->wrapped = true;
+    }
+}
+
+void SpanTracer::clear() {
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& b : _buffers) {
+        std::lock_guard<std::mutex> bufferLock(b->mutex);
+        b->next = 0;
+        b->wrapped = false;
+        b->overwritten = 0;
+    }
+}
+
+std::string SpanTracer::exportChromeJson(bool clear) {
+    std::string out;
+    out.reserve(4096);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"PN532 adapter\"}}";
+
+    char buf[160];
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& b : _buffers) {
+        std::lock_guard<std::mutex> bufferLock(b->mutex);
+        std::snprintf(buf, sizeof(buf),
+                      ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                      "\"args\":{\"name\":\"thread %u\",\"overwrittenSpans\":%" PRIu64 "}}",
+                      b->tid, b->tid, b->overwritten);
+        out += buf;
+
+        const size_t count = b->wrapped ? b->ring.size() : b->next;
+        const size_t first = b->wrapped ? b->next : 0;
+        for (size_t i = 0; i < count; ++i) {
+            const Event& e = b->ring[(first + i) % b->ring.size()];
+            out += ",\n{\"name\":\"";
+            out += e.name;
+            out += "\",\"cat\":\"";
+            out += e.category;
+            out += "\",";
+            appendArgs(out, e.args);
+            if (e.durationNs < 0) {
+                std::snprintf(buf, sizeof(buf), "\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                              static_cast<double>(e.startNs) / 1000.0, b->tid);
+            } else {
+                std::snprintf(buf, sizeof(buf), "\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                              static_cast<double>(e.startNs) / 1000.0,
+                              static_cast<double>(e.durationNs) / 1000.0, b->tid);
+            }
+            out += buf;
+        }
+        if (clear) {
+            b->next = 0;
+            b->wrapped = false;
+            b->overwritten = 0;
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,129 @@
+#pragma once
+#include "../../core/ports/IClock.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace adapters {
+namespace hardware {
+
+// A numeric span argument. `key` must be a string literal (or otherwise
+// outlive the tracer); `hex` renders the value as "0x.." in the export.
+struct TraceArg {
+    const char* key = nullptr;
+    int64_t value = 0;
+    bool hex = false;
+};
+
+/**
+ * Span recorder exported as Chrome trace_event JSON (Perfetto,
+ * chrome://tracing).
+ *
+ * Each thread records into its own fixed-size ring, allocated the first
+ * time that thread records while tracing is enabled; when a ring is full
+ * the oldest spans are overwritten. Names and categories are not copied,
+ * so they must be string literals. While disabled, recording is a single
+ * relaxed atomic load.
+ *
+ * Timestamps come from `clock`, so a simulation on a VirtualClock produces
+ * a trace in simulated time.
+ */
+class SpanTracer {
+public:
+    static constexpr size_t kDefaultEventsPerThread = 8192;
+
+    explicit SpanTracer(std::shared_ptr<core::ports::IClock> clock = nullptr,
+                        size_t eventsPerThread = kDefaultEventsPerThread);
+    ~SpanTracer();
+
+    SpanTracer(const SpanTracer&) = delete;
+    SpanTracer& operator=(const SpanTracer&) = delete;
+
+    void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    core::ports::IClock::TimePoint now() const { return _clock->now(); }
+
+    // Complete event ("X") from `start` to `end`.
+    void complete(const char* name, const char* category,
+                  core::ports::IClock::TimePoint start, core::ports::IClock::TimePoint end,
+                  TraceArg a0 = {}, TraceArg a1 = {});
+
+    // Thread-scoped instant event ("i").
+    void instant(const char* name, const char* category, core::ports::IClock::TimePoint at,
+                 TraceArg a0 = {}, TraceArg a1 = {});
+
+    // {"traceEvents": [...]} with every span still in the rings, plus
+    // process and thread names. `clear` empties the rings afterwards.
+    std::string exportChromeJson(bool clear);
+
+    void clear();
+
+private:
+    struct Event {
+        const char* name;
+        const char* category;
+        int64_t startNs;
+        int64_t durationNs; // < 0 for instant events
+        TraceArg args[2];
+    };
+
+    struct ThreadBuffer {
+        std::mutex mutex; // uncontended except while exporting
+        std::vector<Event> ring;
+        size_t next = 0;
+        bool wrapped = false;
+        uint64_t overwritten = 0;
+        uint32_t tid = 0;
+        std::thread::id owner;
+    };
+
+    void record(const Event& event);
+    ThreadBuffer* bufferForThisThread();
+
+    std::shared_ptr<core::ports::IClock> _clock;
+    const size_t _eventsPerThread;
+    const uint64_t _id; // distinguishes tracers in the per-thread cache
+    std::atomic<bool> _enabled{false};
+
+    std::mutex _buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+};
+
+/**
+ * RAII complete event: starts on construction, recorded on destruction.
+ * Nothing is recorded when tracing was disabled at construction.
+ */
+class TraceSpan {
+public:
+    TraceSpan(SpanTracer& tracer, const char* name, const char* category)
+        : _tracer(tracer.enabled() ? &tracer : nullptr), _name(name), _category(category) {
+        if (_tracer) _start = _tracer->now();
+    }
+    ~TraceSpan() {
+        if (_tracer) _tracer->complete(_name, _category, _start, _tracer->now(), _args[0], _args[1]);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // Sets argument slot 0 or 1.
+    void arg(size_t slot, const char* key, int64_t value, bool hex = false) {
+        if (slot < 2) _args[slot] = TraceArg{key, value, hex};
+    }
+
+private:
+    SpanTracer* _tracer;
+    const char* _name;
+    const char* _category;
+    core::ports::IClock::TimePoint _start;
+    TraceArg _args[2];
+};
+
+} // namespace hardware
+} // namespace adapters
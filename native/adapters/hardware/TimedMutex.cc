@@ -0,0 +1,35 @@
+#include "TimedMutex.h"
+#include <bit>
+
+namespace adapters {
+namespace hardware {
+
+void TimedMutex::record(Histogram& h, Clock::duration d) {
+    const auto us = static_cast<uint64_t>(std::max<int64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(d).count(), 0));
+    h.totalUs.fetch_add(us, std::memory_order_relaxed);
+    uint64_t max = h.maxUs.load(std::memory_order_relaxed);
+    while (us > max && !h.maxUs.compare_exchange_weak(max, us, std::memory_order_relaxed)) {}
+    // bit_width: 0 -> 0, 1 -> 1, 2..3 -> 2, 4..7 -> 3, ...
+    const size_t bucket = std::min<size_t>(std::bit_width(us), core::ports::AdapterLockStats::kBuckets - 1);
+    h.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+core::ports::AdapterLockStats TimedMutex::stats() const {
+    core::ports::AdapterLockStats s;
+    s.acquisitions = _acquisitions.load(std::memory_order_relaxed);
+    s.contended    = _contended.load(std::memory_order_relaxed);
+    s.tryFailures  = _tryFailures.load(std::memory_order_relaxed);
+    s.waitTotalUs  = _wait.totalUs.load(std::memory_order_relaxed);
+    s.waitMaxUs    = _wait.maxUs.load(std::memory_order_relaxed);
+    s.holdTotalUs  = _hold.totalUs.load(std::memory_order_relaxed);
+    s.holdMaxUs    = _hold.maxUs.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < core::ports::AdapterLockStats::kBuckets; ++i) {
+        s.waitBuckets[i] = _wait.buckets[i].load(std::memory_order_relaxed);
+        s.holdBuckets[i] = _hold.buckets[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,77 @@
+#pragma once
+#include "../../core/ports/INfcReader.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * std::mutex that measures how long callers wait for it and how long it is
+ * held, for contention diagnostics. Satisfies Lockable, so it works with
+ * lock_guard and unique_lock.
+ *
+ * An uncontended lock() costs one try_lock and one steady_clock read more
+ * than a plain mutex; unlock() one clock read and a few relaxed atomics.
+ * Times are wall time on the steady clock whatever the adapter's IClock,
+ * since they describe this process rather than the reader.
+ */
+class TimedMutex {
+public:
+    void lock() {
+        if (_mutex.try_lock()) {
+            _acquiredAt = Clock::now();
+            _acquisitions.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto start = Clock::now();
+        _mutex.lock();
+        _acquiredAt = Clock::now();
+        _acquisitions.fetch_add(1, std::memory_order_relaxed);
+        _contended.fetch_add(1, std::memory_order_relaxed);
+        record(_wait, _acquiredAt - start);
+    }
+
+    bool try_lock() {
+        if (!_mutex.try_lock()) {
+            _tryFailures.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _acquiredAt = Clock::now();
+        _acquisitions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void unlock() {
+        const auto held = Clock::now() - _acquiredAt;
+        _mutex.unlock();
+        record(_hold, held);
+    }
+
+    // Safe from any thread; fields are read individually, so a snapshot
+    // taken while the lock changes hands may be off by one acquisition.
+    core::ports::AdapterLockStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Histogram {
+        std::atomic<uint64_t> totalUs{0};
+        std::atomic<uint64_t> maxUs{0};
+        std::atomic<uint64_t> buckets[core::ports::AdapterLockStats::kBuckets] = {};
+    };
+
+    static void record(Histogram& h, Clock::duration d);
+
+    std::mutex _mutex;
+    Clock::time_point _acquiredAt; // written and read by the owner only
+    std::atomic<uint64_t> _acquisitions{0};
+    std::atomic<uint64_t> _contended{0};
+    std::atomic<uint64_t> _tryFailures{0};
+    Histogram _wait;
+    Histogram _hold;
+};
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,224 @@
+#include "TracingSerialBus.h"
+#include <algorithm>
+
+namespace adapters {
+namespace hardware {
+
+namespace {
+
+constexpr uint8_t PN532_CMD_IN_COMMUNICATE_THRU = 0x42;
+constexpr uint8_t DESFIRE_ADDITIONAL_FRAME = 0xAF;
+
+// Card frame inside an InDataExchange (D4 40 Tg ...) or InCommunicateThru
+// (D4 42 ...) command, after TFI and command code.
+static size_t cardFrameOffset(uint8_t command) {
+    return command == PN532_CMD_IN_DATA_EXCHANGE ? 3 : 2;
+}
+
+// DESFire command wrapped in ISO 7816: 90 INS 00 00 Lc ..
+static bool isIsoWrapped(const uint8_t* frame, size_t len) {
+    return len >= 5 && frame[0] == 0x90 && frame[2] == 0x00 && frame[3] == 0x00;
+}
+
+// DESFire status of a card response: first byte native, 91 xx wrapped.
+static int desfireStatusOf(const uint8_t* frame, size_t len, bool wrapped) {
+    if (len == 0) return -1;
+    if (wrapped) return len >= 2 && frame[len - 2] == 0x91 ? frame[len - 1] : -1;
+    return frame[0];
+}
+
+} // anonymous namespace
+
+const char* pn532CommandName(uint8_t command) {
+    switch (command) {
+        case 0x00: return "Diagnose";
+        case 0x02: return "GetFirmwareVersion";
+        case 0x04: return "GetGeneralStatus";
+        case 0x06: return "ReadRegister";
+        case 0x08: return "WriteRegister";
+        case 0x0C: return "ReadGPIO";
+        case 0x0E: return "WriteGPIO";
+        case 0x10: return "SetSerialBaudRate";
+        case 0x12: return "SetParameters";
+        case 0x14: return "SAMConfiguration";
+        case 0x16: return "PowerDown";
+        case 0x32: return "RFConfiguration";
+        case 0x40: return "InDataExchange";
+        case 0x42: return "InCommunicateThru";
+        case 0x44: return "InDeselect";
+        case 0x4A: return "InListPassiveTarget";
+        case 0x4E: return "InPSL";
+        case 0x50: return "InATR";
+        case 0x52: return "InRelease";
+        case 0x54: return "InSelect";
+        case 0x60: return "InAutoPoll";
+        default:   return "PN532 command";
+    }
+}
+
+const char* desfireCommandName(uint8_t command) {
+    switch (command) {
+        case 0x0A: return "Authenticate";
+        case 0x1A: return "AuthenticateISO";
+        case 0xAA: return "AuthenticateAES";
+        case 0x71: return "AuthenticateEV2First";
+        case 0x77: return "AuthenticateEV2NonFirst";
+        case 0x54: return "ChangeKeySettings";
+        case 0x45: return "GetKeySettings";
+        case 0xC4: return "ChangeKey";
+        case 0x64: return "GetKeyVersion";
+        case 0xCA: return "CreateApplication";
+        case 0xDA: return "DeleteApplication";
+        case 0x6A: return "GetApplicationIDs";
+        case 0x5A: return "SelectApplication";
+        case 0xFC: return "FormatPICC";
+        case 0x60: return "GetVersion";
+        case 0x6E: return "FreeMemory";
+        case 0x51: return "GetCardUID";
+        case 0x6F: return "GetFileIDs";
+        case 0xF5: return "GetFileSettings";
+        case 0x5F: return "ChangeFileSettings";
+        case 0xCD: return "CreateStdDataFile";
+        case 0xCB: return "CreateBackupDataFile";
+        case 0xDF: return "DeleteFile";
+        case 0xBD: return "ReadData";
+        case 0x3D: return "WriteData";
+        case 0xC7: return "CommitTransaction";
+        case 0xA7: return "AbortTransaction";
+        case 0xA4: return "ISOSelect";
+        default:   return "DESFire command";
+    }
+}
+
+TracingSerialBus::TracingSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner, SpanTracer& tracer)
+    : SerialBusDecorator(std::move(inner)), _tracer(tracer) {}
+
+etl::expected<void, error::Error> TracingSerialBus::write(const etl::ivector<uint8_t>& data) {
+    if (!_tracer.enabled()) return inner().write(data);
+
+    _lastWriteStart = _tracer.now();
+    auto result = inner().write(data);
+    _tracer.complete(result.has_value() ? "write" : "write (error)", "serial", _lastWriteStart, _tracer.now(),
+                     TraceArg{"bytes", static_cast<int64_t>(data.size())});
+    return result;
+}
+
+etl::expected<size_t, error::Error> TracingSerialBus::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    if (!_tracer.enabled()) return inner().read(buffer, length, timeoutMs);
+
+    const auto start = _tracer.now();
+    auto result = inner().read(buffer, length, timeoutMs);
+    _lastReadEnd = _tracer.now();
+    if (result.has_value()) {
+        _tracer.complete("read", "serial", start, _lastReadEnd,
+                         TraceArg{"bytes", static_cast<int64_t>(result.value())},
+                         TraceArg{"timeoutMs", timeoutMs});
+    } else {
+        _tracer.complete("read (no data)", "serial", start, _lastReadEnd,
+                         TraceArg{"requested", static_cast<int64_t>(length)},
+                         TraceArg{"timeoutMs", timeoutMs});
+    }
+    return result;
+}
+
+void TracingSerialBus::onFrame(const FrameEvent& event) {
+    if (!_tracer.enabled()) {
+        // Spans opened before tracing was switched off are abandoned
+        _pn532.reset();
+        _desfire.reset();
+        return;
+    }
+
+    if (event.direction == FrameDirection::HostToPn532) {
+        if (event.status == FrameScanStatus::Information && event.dataLength >= 2 &&
+            event.data[0] == PN532_TFI_HOST_TO_PN532) {
+            onCommandFrame(event.data, event.dataLength);
+        }
+        return;
+    }
+
+    switch (event.status) {
+        case FrameScanStatus::Ack:
+            if (_pn532) _tracer.instant("ACK", "pn532", _tracer.now());
+            break;
+        case FrameScanStatus::Information:
+            if (event.dataLength >= 2 && event.data[0] == PN532_TFI_PN532_TO_HOST) {
+                onResponseFrame(event.data, event.dataLength);
+            }
+            break;
+        case FrameScanStatus::Nack:
+        case FrameScanStatus::ErrorFrame:
+        case FrameScanStatus::ChecksumError:
+            _tracer.instant(event.status == FrameScanStatus::Nack ? "NACK"
+                            : event.status == FrameScanStatus::ErrorFrame ? "error frame"
+                            : "checksum error", "pn532", _tracer.now());
+            break;
+        case FrameScanStatus::Incomplete:
+            break;
+    }
+}
+
+void TracingSerialBus::onCommandFrame(const uint8_t* data, size_t len) {
+    closeUnanswered();
+
+    const uint8_t command = data[1];
+    _pn532 = OpenSpan{command, _lastWriteStart, false};
+
+    if (command != PN532_CMD_IN_DATA_EXCHANGE && command != PN532_CMD_IN_COMMUNICATE_THRU) return;
+    const size_t offset = cardFrameOffset(command);
+    if (len <= offset) return;
+    const uint8_t* card = data + offset;
+    const bool wrapped = isIsoWrapped(card, len - offset);
+    const uint8_t desfire = wrapped ? card[1] : card[0];
+
+    if (desfire == DESFIRE_ADDITIONAL_FRAME && _desfire) return; // continuation of the open chain
+    if (_desfire) endDesfire(_lastWriteStart, -1); // previous chain never finished
+    _desfire = OpenSpan{desfire, _lastWriteStart, wrapped};
+}
+
+void TracingSerialBus::onResponseFrame(const uint8_t* data, size_t len) {
+    if (!_pn532 || data[1] != static_cast<uint8_t>(_pn532->command + 1)) return;
+
+    const auto end = _tracer.now();
+    const uint8_t command = _pn532->command;
+    _tracer.complete(pn532CommandName(command), "pn532", _pn532->start, end,
+                     TraceArg{"cmd", command, true},
+                     TraceArg{"responseBytes", static_cast<int64_t>(len - 2)});
+    _pn532.reset();
+
+    if (!_desfire || (command != PN532_CMD_IN_DATA_EXCHANGE && command != PN532_CMD_IN_COMMUNICATE_THRU)) return;
+
+    // D5 41/43, PN532 status, then the card's answer
+    if (len < 3 || (data[2] & 0x3F) != 0x00) {
+        endDesfire(end, -1);
+        return;
+    }
+    const int status = desfireStatusOf(data + 3, len - 3, _desfire->isoWrapped);
+    if (status == DESFIRE_ADDITIONAL_FRAME) return; // more frames to come
+    endDesfire(end, status);
+}
+
+void TracingSerialBus::closeUnanswered() {
+    if (_pn532) {
+        const auto end = std::max(_lastReadEnd, _pn532->start);
+        _tracer.complete(pn532CommandName(_pn532->command), "pn532", _pn532->start, end,
+                         TraceArg{"cmd", _pn532->command, true}, TraceArg{"answered", 0});
+        _pn532.reset();
+    }
+}
+
+void TracingSerialBus::endDesfire(core::ports::IClock::TimePoint end, int64_t status) {
+    if (!_desfire) return;
+    if (status < 0) {
+        _tracer.complete(desfireCommandName(_desfire->command), "desfire", _desfire->start, end,
+                         TraceArg{"cmd", _desfire->command, true}, TraceArg{"answered", 0});
+    } else {
+        _tracer.complete(desfireCommandName(_desfire->command), "desfire", _desfire->start, end,
+                         TraceArg{"cmd", _desfire->command, true}, TraceArg{"status", status, true});
+    }
+    _desfire.reset();
+}
+
+} // namespace hardware
+} // namespace adapters
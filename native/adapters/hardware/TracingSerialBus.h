@@ -0,0 +1,61 @@
+#pragma once
+#include "MonitoredSerialBus.h"
+#include "SpanTracer.h"
+#include <optional>
+
+namespace adapters {
+namespace hardware {
+
+/**
+ * Serial decorator that records the bottom three levels of a trace:
+ *
+ *   desfire  one span per DESFire command relayed with InDataExchange or
+ *            InCommunicateThru, across its 0xAF continuation frames
+ *   pn532    command frame written -> response frame read, with an "ACK"
+ *            instant in between
+ *   serial   every write() and read() call on the platform bus
+ *
+ * It wraps the platform bus for the serial spans and is registered as an
+ * observer of the MonitoredSerialBus above it for the frame spans, so
+ * traffic from Pn532Driver and from Pn532RawChannel is traced alike.
+ * Callbacks run under the adapter mutex. With tracing disabled every call
+ * is a pass-through after one atomic load.
+ */
+class TracingSerialBus : public SerialBusDecorator, public ISerialObserver {
+public:
+    TracingSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner, SpanTracer& tracer);
+
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+
+    void onFrame(const FrameEvent& event) override;
+
+private:
+    struct OpenSpan {
+        uint8_t command = 0;
+        core::ports::IClock::TimePoint start;
+        bool isoWrapped = false; // DESFire command sent as 90 INS 00 00 ..
+    };
+
+    void onCommandFrame(const uint8_t* data, size_t len);
+    void onResponseFrame(const uint8_t* data, size_t len);
+    // Ends the span of a PN532 command that got no response frame.
+    void closeUnanswered();
+    // `status` < 0: the chain ended without a card status.
+    void endDesfire(core::ports::IClock::TimePoint end, int64_t status);
+
+    SpanTracer& _tracer;
+    core::ports::IClock::TimePoint _lastWriteStart;
+    core::ports::IClock::TimePoint _lastReadEnd;
+    std::optional<OpenSpan> _pn532;
+    std::optional<OpenSpan> _desfire;
+};
+
+// PN532 command name (user manual §7), or "PN532 command".
+const char* pn532CommandName(uint8_t command);
+
+// DESFire native command name, or "DESFire command".
+const char* desfireCommandName(uint8_t command);
+
+} // namespace hardware
+} // namespace adapters
@@ -0,0 +1,26 @@
+#include "SteadyClock.h"
+#include <thread>
+
+namespace adapters {
+namespace timing {
+
+SteadyClock::TimePoint SteadyClock::now() const {
+    return std::chrono::steady_clock::now();
+}
+
+void SteadyClock::sleepFor(std::chrono::nanoseconds duration) {
+    std::this_thread::sleep_for(duration);
+}
+
+std::cv_status SteadyClock::waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                                      TimePoint deadline) {
+    return cv.wait_until(lock, deadline);
+}
+
+std::shared_ptr<core::ports::IClock> steadyClock() {
+    static const std::shared_ptr<core::ports::IClock> instance = std::make_shared<SteadyClock>();
+    return instance;
+}
+
+} // namespace timing
+} // namespace adapters
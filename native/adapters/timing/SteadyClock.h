@@ -0,0 +1,21 @@
+#pragma once
+#include "../../core/ports/IClock.h"
+#include <memory>
+
+namespace adapters {
+namespace timing {
+
+// std::chrono::steady_clock and real sleeps.
+class SteadyClock : public core::ports::IClock {
+public:
+    TimePoint now() const override;
+    void sleepFor(std::chrono::nanoseconds duration) override;
+    std::cv_status waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                             TimePoint deadline) override;
+};
+
+// Process-wide instance; what every component uses when none is injected.
+std::shared_ptr<core::ports::IClock> steadyClock();
+
+} // namespace timing
+} // namespace adapters
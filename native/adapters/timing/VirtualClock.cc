@@ -0,0 +1,27 @@
+#include "VirtualClock.h"
+
+namespace adapters {
+namespace timing {
+
+VirtualClock::TimePoint VirtualClock::now() const {
+    return TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(_ns.load())));
+}
+
+void VirtualClock::sleepFor(std::chrono::nanoseconds duration) {
+    advance(duration);
+}
+
+std::cv_status VirtualClock::waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                                       TimePoint deadline) {
+    while (now() < deadline) {
+        if (cv.wait_for(lock, POLL_INTERVAL) == std::cv_status::no_timeout) return std::cv_status::no_timeout;
+    }
+    return std::cv_status::timeout;
+}
+
+void VirtualClock::advance(std::chrono::nanoseconds duration) {
+    if (duration.count() > 0) _ns.fetch_add(duration.count());
+}
+
+} // namespace timing
+} // namespace adapters
@@ -0,0 +1,44 @@
+#pragma once
+#include "../../core/ports/IClock.h"
+#include <atomic>
+#include <cstdint>
+
+namespace adapters {
+namespace timing {
+
+/**
+ * Simulated time that only moves when told to. Starts at the clock's
+ * epoch.
+ *
+ * sleepFor() advances the clock by the requested amount and returns at
+ * once: the sleeping thread is taken to be the one driving the simulation
+ * (typically blocked in a simulated serial read), so nothing else would
+ * have moved time meanwhile. A read timeout of 1 s therefore costs a few
+ * nanoseconds, while deadlines computed from now() still expire exactly
+ * where they would on hardware.
+ *
+ * waitUntil() is for background threads (idle timers). It returns timeout
+ * as soon as the clock has been advanced past the deadline, checking every
+ * POLL_INTERVAL of real time, and no_timeout when the condition variable
+ * is notified.
+ */
+class VirtualClock : public core::ports::IClock {
+public:
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{1};
+
+    TimePoint now() const override;
+    void sleepFor(std::chrono::nanoseconds duration) override;
+    std::cv_status waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                             TimePoint deadline) override;
+
+    void advance(std::chrono::nanoseconds duration);
+
+    // Total simulated time since construction.
+    std::chrono::nanoseconds elapsed() const { return std::chrono::nanoseconds(_ns.load()); }
+
+private:
+    std::atomic<int64_t> _ns{0};
+};
+
+} // namespace timing
+} // namespace adapters
@@ -5,9 +5,11 @@
 #include <iomanip>
 
 #include "NfcCppBinding.h"
+#include "../../adapters/crypto/SecureBytes.h"
 #include "../../adapters/hardware/Pn532Adapter.h"
 
 using namespace Napi;
+using adapters::crypto::SecureBox;
 
 NfcCppBinding::NfcCppBinding(const Napi::CallbackInfo& info)
     : ObjectWrap(info)
@@ -472,16 +474,27 @@ class InitCardWorker : public Napi::AsyncWorker {
 public:
     InitCardWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
                    std::shared_ptr<core::services::NfcService> service,
-                   core::ports::CardInitOptions opts)
+                   SecureBox<core::ports::CardInitOptions> opts)
         : Napi::AsyncWorker(env), _deferred(deferred), _service(std::move(service)),
-          _opts(opts) {}
+          _opts(std::move(opts)) {}
 
-    void Execute() override { _result = _service->initCard(_opts); }
+    void Execute() override { _result = _service->initCard(*_opts); }
 
     void OnOK() override {
         Napi::Env env = Env();
-        if (std::holds_alternative<bool>(_result)) {
-            _deferred.Resolve(Napi::Boolean::New(env, std::get<bool>(_result)));
+        if (std::holds_alternative<core::ports::CardInitReport>(_result)) {
+            const auto& report = std::get<core::ports::CardInitReport>(_result);
+            auto toArray = [&env](const std::vector<std::string>& steps) {
+                Napi::Array arr = Napi::Array::New(env, steps.size());
+                for (size_t i = 0; i < steps.size(); ++i)
+                    arr.Set(static_cast<uint32_t>(i), Napi::String::New(env, steps[i]));
+                return arr;
+            };
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("resumed",      Napi::Boolean::New(env, report.resumed));
+            obj.Set("stepsRun",     toArray(report.stepsRun));
+            obj.Set("stepsSkipped", toArray(report.stepsSkipped));
+            _deferred.Resolve(obj);
         } else {
             const auto& nfcErr = std::get<core::ports::NfcError>(_result);
             auto err = Napi::Error::New(env, nfcErr.message);
@@ -495,22 +508,21 @@ public:
 private:
     Napi::Promise::Deferred _deferred;
     std::shared_ptr<core::services::NfcService> _service;
-    core::ports::CardInitOptions _opts;
-    core::ports::Result<bool> _result;
+    SecureBox<core::ports::CardInitOptions> _opts; // keys stay in the secure arena
+    core::ports::Result<core::ports::CardInitReport> _result;
 };
 
-// Helper: extract an N-byte std::array from a Napi::Array argument.
+// Helper: read an N-byte Napi::Array argument into `out` in place, so key
+// bytes land straight in their SecureBox instead of a stack copy.
 template <size_t N>
-static std::array<uint8_t, N> napiArrayToStdArray(
-    Napi::Env env, const Napi::Array& arr, const char* fieldName) {
+static void napiArrayInto(
+    Napi::Env env, const Napi::Array& arr, const char* fieldName, std::array<uint8_t, N>& out) {
     if (arr.Length() != N) {
         throw Napi::TypeError::New(env,
             std::string(fieldName) + " must be exactly " + std::to_string(N) + " bytes");
     }
-    std::array<uint8_t, N> out;
     for (size_t i = 0; i < N; ++i)
         out[i] = static_cast<uint8_t>(arr.Get(i).As<Napi::Number>().Uint32Value());
-    return out;
 }
 
 Napi::Value NfcCppBinding::InitCard(const Napi::CallbackInfo& info)
@@ -524,18 +536,18 @@ Napi::Value NfcCppBinding::InitCard(const Napi::CallbackInfo& info)
     }
     Napi::Object opts = info[0].As<Napi::Object>();
 
-    core::ports::CardInitOptions cardOpts;
+    SecureBox<core::ports::CardInitOptions> cardOpts;
     try {
-        cardOpts.aid          = napiArrayToStdArray<3> (env, opts.Get("aid").As<Napi::Array>(),          "aid");
-        cardOpts.appMasterKey = napiArrayToStdArray<16>(env, opts.Get("appMasterKey").As<Napi::Array>(), "appMasterKey");
-        cardOpts.readKey      = napiArrayToStdArray<16>(env, opts.Get("readKey").As<Napi::Array>(),      "readKey");
-        cardOpts.cardSecret   = napiArrayToStdArray<16>(env, opts.Get("cardSecret").As<Napi::Array>(),   "cardSecret");
+        napiArrayInto(env, opts.Get("aid").As<Napi::Array>(),          "aid",          cardOpts->aid);
+        napiArrayInto(env, opts.Get("appMasterKey").As<Napi::Array>(), "appMasterKey", cardOpts->appMasterKey);
+        napiArrayInto(env, opts.Get("readKey").As<Napi::Array>(),      "readKey",      cardOpts->readKey);
+        napiArrayInto(env, opts.Get("cardSecret").As<Napi::Array>(),   "cardSecret",   cardOpts->cardSecret);
     } catch (const Napi::Error& e) {
         e.ThrowAsJavaScriptException();
         return env.Undefined();
     }
 
-    InitCardWorker* worker = new InitCardWorker(env, deferred, _service, cardOpts);
+    InitCardWorker* worker = new InitCardWorker(env, deferred, _service, std::move(cardOpts));
     worker->Queue();
     return deferred.Promise();
 }
@@ -546,18 +558,20 @@ class ReadCardSecretWorker : public Napi::AsyncWorker {
 public:
     ReadCardSecretWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
                          std::shared_ptr<core::services::NfcService> service,
-                         std::array<uint8_t, 16> readKey)
+                         SecureBox<std::array<uint8_t, 16>> readKey)
         : Napi::AsyncWorker(env), _deferred(deferred), _service(std::move(service)),
-          _readKey(readKey) {}
+          _readKey(std::move(readKey)) {}
 
-    void Execute() override { _result = _service->readCardSecret(_readKey); }
+    void Execute() override { _result = _service->readCardSecret(*_readKey); }
 
     void OnOK() override {
         Napi::Env env = Env();
         if (std::holds_alternative<std::vector<uint8_t>>(_result)) {
-            const auto& data = std::get<std::vector<uint8_t>>(_result);
+            auto& data = std::get<std::vector<uint8_t>>(_result);
             _deferred.Resolve(Napi::Buffer<uint8_t>::Copy(
                 env, data.data(), data.size()));
+            // The JS Buffer is now the only copy
+            adapters::crypto::secureZero(data.data(), data.size());
         } else {
             const auto& nfcErr = std::get<core::ports::NfcError>(_result);
             auto err = Napi::Error::New(env, nfcErr.message);
@@ -571,7 +585,7 @@ public:
 private:
     Napi::Promise::Deferred _deferred;
     std::shared_ptr<core::services::NfcService> _service;
-    std::array<uint8_t, 16> _readKey;
+    SecureBox<std::array<uint8_t, 16>> _readKey;
     core::ports::Result<std::vector<uint8_t>> _result;
 };
 
@@ -585,15 +599,15 @@ Napi::Value NfcCppBinding::ReadCardSecret(const Napi::CallbackInfo& info)
         return env.Undefined();
     }
 
-    std::array<uint8_t, 16> readKey;
+    SecureBox<std::array<uint8_t, 16>> readKey;
     try {
-        readKey = napiArrayToStdArray<16>(env, info[0].As<Napi::Array>(), "readKey");
+        napiArrayInto(env, info[0].As<Napi::Array>(), "readKey", *readKey);
     } catch (const Napi::Error& e) {
         e.ThrowAsJavaScriptException();
         return env.Undefined();
     }
 
-    ReadCardSecretWorker* worker = new ReadCardSecretWorker(env, deferred, _service, readKey);
+    ReadCardSecretWorker* worker = new ReadCardSecretWorker(env, deferred, _service, std::move(readKey));
     worker->Queue();
     return deferred.Promise();
 }
@@ -724,6 +738,381 @@ Napi::Value NfcCppBinding::GetCardApplicationIds(const Napi::CallbackInfo& info)
     return deferred.Promise();
 }
 
+// ─── Reader power management ──────────────────────────────────────────────────
+
+static const char* powerModeToString(core::ports::ReaderPowerMode mode) {
+    switch (mode) {
+        case core::ports::ReaderPowerMode::Latency:  return "latency";
+        case core::ports::ReaderPowerMode::Balanced: return "balanced";
+        case core::ports::ReaderPowerMode::LowPower: return "lowPower";
+    }
+    return "balanced";
+}
+
+class SetPowerPolicyWorker : public Napi::AsyncWorker {
+public:
+    SetPowerPolicyWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                         std::shared_ptr<core::services::NfcService> service,
+                         core::ports::ReaderPowerPolicy policy)
+        : Napi::AsyncWorker(env), _deferred(deferred), _service(std::move(service)),
+          _policy(policy) {}
+
+    void Execute() override { _result = _service->setPowerPolicy(_policy); }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (std::holds_alternative<bool>(_result)) {
+            _deferred.Resolve(Napi::Boolean::New(env, std::get<bool>(_result)));
+        } else {
+            const auto& nfcErr = std::get<core::ports::NfcError>(_result);
+            auto err = Napi::Error::New(env, nfcErr.message);
+            err.Set("code", Napi::String::New(env, nfcErr.code));
+            _deferred.Reject(err.Value());
+        }
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<core::services::NfcService> _service;
+    core::ports::ReaderPowerPolicy _policy;
+    core::ports::Result<bool> _result;
+};
+
+Napi::Value NfcCppBinding::SetPowerPolicy(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        Napi::TypeError::New(env, "Expected a policy object").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    Napi::Object opts = info[0].As<Napi::Object>();
+
+    core::ports::ReaderPowerPolicy policy;
+    const std::string mode = opts.Get("mode").IsString()
+        ? opts.Get("mode").As<Napi::String>().Utf8Value()
+        : "";
+    if (mode == "latency") {
+        policy.mode = core::ports::ReaderPowerMode::Latency;
+    } else if (mode == "balanced") {
+        policy.mode = core::ports::ReaderPowerMode::Balanced;
+    } else if (mode == "lowPower") {
+        policy.mode = core::ports::ReaderPowerMode::LowPower;
+    } else {
+        Napi::TypeError::New(env, "mode must be 'latency', 'balanced' or 'lowPower'")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (opts.Has("idleTimeoutMs")) {
+        if (!opts.Get("idleTimeoutMs").IsNumber()) {
+            Napi::TypeError::New(env, "idleTimeoutMs must be a number").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        policy.idleTimeoutMs = opts.Get("idleTimeoutMs").As<Napi::Number>().Uint32Value();
+    }
+
+    SetPowerPolicyWorker* worker = new SetPowerPolicyWorker(env, deferred, _service, policy);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+class GetPowerStatusWorker : public Napi::AsyncWorker {
+public:
+    GetPowerStatusWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                         std::shared_ptr<core::services::NfcService> service)
+        : Napi::AsyncWorker(env), _deferred(deferred), _service(std::move(service)) {}
+
+    void Execute() override { _result = _service->getPowerStatus(); }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (std::holds_alternative<core::ports::ReaderPowerStatus>(_result)) {
+            const auto& status = std::get<core::ports::ReaderPowerStatus>(_result);
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("mode",              Napi::String::New(env, powerModeToString(status.policy.mode)));
+            obj.Set("idleTimeoutMs",     Napi::Number::New(env, status.policy.idleTimeoutMs));
+            obj.Set("rfFieldOn",         Napi::Boolean::New(env, status.rfFieldOn));
+            obj.Set("poweredDown",       Napi::Boolean::New(env, status.poweredDown));
+            obj.Set("wakeCount",         Napi::Number::New(env, status.wakeCount));
+            obj.Set("lastWakeLatencyUs", Napi::Number::New(env, status.lastWakeLatencyUs));
+            _deferred.Resolve(obj);
+        } else {
+            const auto& nfcErr = std::get<core::ports::NfcError>(_result);
+            auto err = Napi::Error::New(env, nfcErr.message);
+            err.Set("code", Napi::String::New(env, nfcErr.code));
+            _deferred.Reject(err.Value());
+        }
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<core::services::NfcService> _service;
+    core::ports::Result<core::ports::ReaderPowerStatus> _result;
+};
+
+Napi::Value NfcCppBinding::GetPowerStatus(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    GetPowerStatusWorker* worker = new GetPowerStatusWorker(env, deferred, _service);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+class WakeReaderWorker : public Napi::AsyncWorker {
+public:
+    WakeReaderWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                     std::shared_ptr<core::services::NfcService> service)
+        : Napi::AsyncWorker(env), _deferred(deferred), _service(std::move(service)) {}
+
+    void Execute() override { _result = _service->wakeReader(); }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (std::holds_alternative<bool>(_result)) {
+            _deferred.Resolve(Napi::Boolean::New(env, std::get<bool>(_result)));
+        } else {
+            const auto& nfcErr = std::get<core::ports::NfcError>(_result);
+            auto err = Napi::Error::New(env, nfcErr.message);
+            err.Set("code", Napi::String::New(env, nfcErr.code));
+            _deferred.Reject(err.Value());
+        }
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<core::services::NfcService> _service;
+    core::ports::Result<bool> _result;
+};
+
+Napi::Value NfcCppBinding::WakeReader(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    WakeReaderWorker* worker = new WakeReaderWorker(env, deferred, _service);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── CancelPendingIo ──────────────────────────────────────────────────────────
+
+// Synchronous: it only signals the waker, and must not queue behind the
+// worker it is meant to interrupt.
+Napi::Value NfcCppBinding::CancelPendingIo(const Napi::CallbackInfo& info)
+{
+    _service->cancelPendingIo();
+    return info.Env().Undefined();
+}
+
+// ─── GetReaderHealth ──────────────────────────────────────────────────────────
+
+// Synchronous on purpose: the snapshot is cached counters only (no reader
+// I/O, no adapter lock), so a worker round trip would cost more than the call.
+Napi::Value NfcCppBinding::GetReaderHealth(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    auto result = _service->getReaderHealth();
+    if (std::holds_alternative<core::ports::NfcError>(result)) {
+        const auto& nfcErr = std::get<core::ports::NfcError>(result);
+        auto err = Napi::Error::New(env, nfcErr.message);
+        err.Set("code", Napi::String::New(env, nfcErr.code));
+        err.ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    const auto& h = std::get<core::ports::ReaderHealthSnapshot>(result);
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("connected", Napi::Boolean::New(env, h.connected));
+
+    if (h.statusValid) {
+        Napi::Object status = Napi::Object::New(env);
+        status.Set("ageMs",                Napi::Number::New(env, h.statusAgeMs));
+        status.Set("lastError",            Napi::Number::New(env, h.lastError));
+        status.Set("lastErrorName",        Napi::String::New(env, h.lastErrorName));
+        status.Set("externalFieldPresent", Napi::Boolean::New(env, h.externalFieldPresent));
+        status.Set("targetCount",          Napi::Number::New(env, h.targetCount));
+        status.Set("targetBitrateRxKbps",  Napi::Number::New(env, h.targetBitrateRxKbps));
+        status.Set("targetBitrateTxKbps",  Napi::Number::New(env, h.targetBitrateTxKbps));
+        obj.Set("status", status);
+    } else {
+        obj.Set("status", env.Null());
+    }
+
+    Napi::Object counters = Napi::Object::New(env);
+    counters.Set("bytesOut",       Napi::Number::New(env, static_cast<double>(h.bytesOut)));
+    counters.Set("bytesIn",        Napi::Number::New(env, static_cast<double>(h.bytesIn)));
+    counters.Set("framesOut",      Napi::Number::New(env, static_cast<double>(h.framesOut)));
+    counters.Set("framesIn",       Napi::Number::New(env, static_cast<double>(h.framesIn)));
+    counters.Set("acks",           Napi::Number::New(env, static_cast<double>(h.acks)));
+    counters.Set("nacks",          Napi::Number::New(env, static_cast<double>(h.nacks)));
+    counters.Set("checksumErrors", Napi::Number::New(env, static_cast<double>(h.checksumErrors)));
+    counters.Set("errorFrames",    Napi::Number::New(env, static_cast<double>(h.errorFrames)));
+    counters.Set("retries",        Napi::Number::New(env, static_cast<double>(h.retries)));
+    counters.Set("timeouts",       Napi::Number::New(env, static_cast<double>(h.timeouts)));
+    counters.Set("ioErrors",       Napi::Number::New(env, static_cast<double>(h.ioErrors)));
+    obj.Set("counters", counters);
+
+    Napi::Array tuning = Napi::Array::New(env, h.linkTuning.size());
+    for (size_t i = 0; i < h.linkTuning.size(); ++i) {
+        const auto& t = h.linkTuning[i];
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("setting", Napi::String::New(env, t.setting));
+        entry.Set("applied", Napi::Boolean::New(env, t.applied));
+        entry.Set("detail",  Napi::String::New(env, t.detail));
+        tuning.Set(static_cast<uint32_t>(i), entry);
+    }
+    obj.Set("linkTuning", tuning);
+
+    Napi::Object lock = Napi::Object::New(env);
+    lock.Set("acquisitions", Napi::Number::New(env, static_cast<double>(h.lock.acquisitions)));
+    lock.Set("contended",    Napi::Number::New(env, static_cast<double>(h.lock.contended)));
+    lock.Set("tryFailures",  Napi::Number::New(env, static_cast<double>(h.lock.tryFailures)));
+    lock.Set("waitTotalUs",  Napi::Number::New(env, static_cast<double>(h.lock.waitTotalUs)));
+    lock.Set("waitMaxUs",    Napi::Number::New(env, static_cast<double>(h.lock.waitMaxUs)));
+    lock.Set("holdTotalUs",  Napi::Number::New(env, static_cast<double>(h.lock.holdTotalUs)));
+    lock.Set("holdMaxUs",    Napi::Number::New(env, static_cast<double>(h.lock.holdMaxUs)));
+    obj.Set("lock", lock);
+    return obj;
+}
+
+// ─── GetMetrics ───────────────────────────────────────────────────────────────
+
+// Synchronous like GetReaderHealth: the snapshot only reads atomics.
+// getMetrics(true) also starts a new window.
+Napi::Value NfcCppBinding::GetMetrics(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    const bool reset = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+    const auto m = _service->getMetrics(reset);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("windowMs", Napi::Number::New(env, static_cast<double>(m.windowMs)));
+
+    Napi::Array ops = Napi::Array::New(env, m.operations.size());
+    for (size_t i = 0; i < m.operations.size(); ++i) {
+        const auto& o = m.operations[i];
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("name",  Napi::String::New(env, o.name));
+        entry.Set("calls", Napi::Number::New(env, static_cast<double>(o.calls)));
+        entry.Set("ok",    Napi::Number::New(env, static_cast<double>(o.ok)));
+
+        Napi::Object errors = Napi::Object::New(env);
+        for (const auto& [code, count] : o.errors) {
+            errors.Set(code, Napi::Number::New(env, static_cast<double>(count)));
+        }
+        entry.Set("errors", errors);
+
+        Napi::Object latency = Napi::Object::New(env);
+        latency.Set("mean", Napi::Number::New(env, o.meanUs));
+        latency.Set("p50",  Napi::Number::New(env, static_cast<double>(o.p50Us)));
+        latency.Set("p90",  Napi::Number::New(env, static_cast<double>(o.p90Us)));
+        latency.Set("p99",  Napi::Number::New(env, static_cast<double>(o.p99Us)));
+        latency.Set("p999", Napi::Number::New(env, static_cast<double>(o.p999Us)));
+        latency.Set("max",  Napi::Number::New(env, static_cast<double>(o.maxUs)));
+        entry.Set("latencyUs", latency);
+
+        Napi::Array buckets = Napi::Array::New(env, o.buckets.size());
+        for (size_t b = 0; b < o.buckets.size(); ++b) {
+            Napi::Array pair = Napi::Array::New(env, 2);
+            pair.Set(0u, Napi::Number::New(env, static_cast<double>(o.buckets[b].first)));
+            pair.Set(1u, Napi::Number::New(env, static_cast<double>(o.buckets[b].second)));
+            buckets.Set(static_cast<uint32_t>(b), pair);
+        }
+        entry.Set("buckets", buckets);
+        ops.Set(static_cast<uint32_t>(i), entry);
+    }
+    obj.Set("operations", ops);
+    return obj;
+}
+
+// ─── SetTracing / ExportTrace ─────────────────────────────────────────────────
+
+// Synchronous: neither touches the reader or waits for the adapter lock.
+Napi::Value NfcCppBinding::SetTracing(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsBoolean()) {
+        Napi::TypeError::New(env, "Expected a boolean").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    auto result = _service->setTracing(info[0].As<Napi::Boolean>().Value());
+    if (std::holds_alternative<core::ports::NfcError>(result)) {
+        const auto& nfcErr = std::get<core::ports::NfcError>(result);
+        auto err = Napi::Error::New(env, nfcErr.message);
+        err.Set("code", Napi::String::New(env, nfcErr.code));
+        err.ThrowAsJavaScriptException();
+    }
+    return env.Undefined();
+}
+
+Napi::Value NfcCppBinding::ExportTrace(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    const bool clear = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+    auto result = _service->exportTrace(clear);
+    if (std::holds_alternative<core::ports::NfcError>(result)) {
+        const auto& nfcErr = std::get<core::ports::NfcError>(result);
+        auto err = Napi::Error::New(env, nfcErr.message);
+        err.Set("code", Napi::String::New(env, nfcErr.code));
+        err.ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return Napi::String::New(env, std::get<std::string>(result));
+}
+
+// ─── GetLastFailureReport ─────────────────────────────────────────────────────
+
+// Synchronous: the report is captured when an operation fails.
+Napi::Value NfcCppBinding::GetLastFailureReport(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    auto result = _service->getLastFailureReport();
+    if (std::holds_alternative<core::ports::NfcError>(result)) {
+        const auto& nfcErr = std::get<core::ports::NfcError>(result);
+        auto err = Napi::Error::New(env, nfcErr.message);
+        err.Set("code", Napi::String::New(env, nfcErr.code));
+        err.ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    const auto& report = std::get<core::ports::FailureReport>(result);
+    if (!report.available) return env.Null();
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("operation", Napi::String::New(env, report.operation));
+    obj.Set("code",      Napi::String::New(env, report.code));
+    obj.Set("message",   Napi::String::New(env, report.message));
+    obj.Set("ageMs",     Napi::Number::New(env, report.ageMs));
+
+    Napi::Array frames = Napi::Array::New(env, report.frames.size());
+    for (size_t i = 0; i < report.frames.size(); ++i) {
+        const auto& f = report.frames[i];
+        Napi::Object frame = Napi::Object::New(env);
+        frame.Set("offsetUs",  Napi::Number::New(env, static_cast<double>(f.offsetUs)));
+        frame.Set("direction", Napi::String::New(env, f.fromHost ? "out" : "in"));
+        frame.Set("kind",      Napi::String::New(env, f.kind));
+        frame.Set("code",      Napi::Number::New(env, f.code));
+        frame.Set("desfire",   f.desfire < 0 ? env.Null() : Napi::Number::New(env, f.desfire));
+        frame.Set("length",    Napi::Number::New(env, f.length));
+        frame.Set("repeat",    Napi::Number::New(env, f.repeat));
+        frame.Set("redacted",  Napi::Boolean::New(env, f.redacted));
+        // Uppercase hex, e.g. "D5410000"
+        std::ostringstream ss;
+        ss << std::hex << std::uppercase << std::setfill('0');
+        for (uint8_t b : f.bytes) ss << std::setw(2) << static_cast<int>(b);
+        frame.Set("bytes", Napi::String::New(env, ss.str()));
+        frames.Set(static_cast<uint32_t>(i), frame);
+    }
+    obj.Set("frames", frames);
+    return obj;
+}
+
 Napi::Value NfcCppBinding::Disconnect(const Napi::CallbackInfo& info)
 {
     Napi::Env env = info.Env();
@@ -813,6 +1202,15 @@ Napi::Function NfcCppBinding::GetClass(Napi::Env env)
             InstanceMethod("cardFreeMemory",         &NfcCppBinding::CardFreeMemory),
             InstanceMethod("formatCard",             &NfcCppBinding::FormatCard),
             InstanceMethod("getCardApplicationIds",  &NfcCppBinding::GetCardApplicationIds),
+            InstanceMethod("setPowerPolicy",         &NfcCppBinding::SetPowerPolicy),
+            InstanceMethod("getPowerStatus",         &NfcCppBinding::GetPowerStatus),
+            InstanceMethod("wakeReader",             &NfcCppBinding::WakeReader),
+            InstanceMethod("cancelPendingIo",        &NfcCppBinding::CancelPendingIo),
+            InstanceMethod("getReaderHealth",        &NfcCppBinding::GetReaderHealth),
+            InstanceMethod("getMetrics",             &NfcCppBinding::GetMetrics),
+            InstanceMethod("setTracing",             &NfcCppBinding::SetTracing),
+            InstanceMethod("exportTrace",            &NfcCppBinding::ExportTrace),
+            InstanceMethod("getLastFailureReport",   &NfcCppBinding::GetLastFailureReport),
         }
     );
 }
@@ -25,6 +25,19 @@ public:
     Napi::Value FormatCard(const Napi::CallbackInfo&);
     Napi::Value GetCardApplicationIds(const Napi::CallbackInfo&);
 
+    // Reader power management
+    Napi::Value SetPowerPolicy(const Napi::CallbackInfo&);
+    Napi::Value GetPowerStatus(const Napi::CallbackInfo&);
+    Napi::Value WakeReader(const Napi::CallbackInfo&);
+    Napi::Value CancelPendingIo(const Napi::CallbackInfo&);
+
+    // Diagnostics
+    Napi::Value GetReaderHealth(const Napi::CallbackInfo&);
+    Napi::Value GetMetrics(const Napi::CallbackInfo&);
+    Napi::Value SetTracing(const Napi::CallbackInfo&);
+    Napi::Value ExportTrace(const Napi::CallbackInfo&);
+    Napi::Value GetLastFailureReport(const Napi::CallbackInfo&);
+
     static Napi::Function GetClass(Napi::Env);
 
 private:
@@ -0,0 +1,898 @@
+#include "VaultCryptoBinding.h"
+#include "../../adapters/crypto/Scrypt.h"
+#include "../../adapters/crypto/SecureArena.h"
+#include "../../adapters/crypto/WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+using namespace Napi;
+using adapters::crypto::ChunkedHeader;
+using adapters::crypto::EntryField;
+using adapters::crypto::EntryFields;
+using adapters::crypto::FieldsJob;
+using adapters::crypto::KeyBytes;
+using adapters::crypto::OpenJob;
+using adapters::crypto::RekeyJob;
+using adapters::crypto::ScryptCalibration;
+using adapters::crypto::ScryptCalibrationResult;
+using adapters::crypto::ScryptParams;
+using adapters::crypto::ScryptStatus;
+using adapters::crypto::SealJob;
+using adapters::crypto::SecureArena;
+using adapters::crypto::VaultCryptoEngine;
+using adapters::crypto::VaultKeys;
+using adapters::crypto::VaultStatus;
+using adapters::crypto::WorkStealingPool;
+
+namespace {
+
+// Buffer / Uint8Array, or a plain array of byte values (what
+// readCardSecret() resolves with).
+template <typename Bytes>
+bool readBytes(const Napi::Value& value, Bytes& out) {
+    if (value.IsTypedArray()) {
+        auto typed = value.As<Napi::TypedArray>();
+        if (typed.TypedArrayType() != napi_uint8_array) return false;
+        auto bytes = value.As<Napi::Uint8Array>();
+        out.assign(bytes.Data(), bytes.Data() + bytes.ByteLength());
+        return true;
+    }
+    if (value.IsArray()) {
+        auto arr = value.As<Napi::Array>();
+        out.resize(arr.Length());
+        for (uint32_t i = 0; i < arr.Length(); ++i) {
+            Napi::Value v = arr.Get(i);
+            if (!v.IsNumber()) return false;
+            out[i] = static_cast<uint8_t>(v.As<Napi::Number>().Uint32Value());
+        }
+        return true;
+    }
+    return false;
+}
+
+// Strings are encoded straight into zeroizing memory rather than through a
+// std::string copy.
+template <typename Bytes>
+bool readPlaintext(const Napi::Value& value, Bytes& out) {
+    if (!value.IsString()) return readBytes(value, out);
+    napi_env env = value.Env();
+    size_t length = 0;
+    if (napi_get_value_string_utf8(env, value, nullptr, 0, &length) != napi_ok) return false;
+    out.resize(length + 1);
+    if (napi_get_value_string_utf8(env, value, reinterpret_cast<char*>(out.data()), out.size(), &length) != napi_ok)
+        return false;
+    out.resize(length);
+    return true;
+}
+
+template <size_t N>
+bool readFixed(const Napi::Value& value, std::array<uint8_t, N>& out) {
+    std::vector<uint8_t> bytes;
+    if (!readBytes(value, bytes) || bytes.size() != N) return false;
+    std::memcpy(out.data(), bytes.data(), N);
+    return true;
+}
+
+// Optional non-negative integer property; false if present but not one
+bool readCount(const Napi::Object& obj, const char* name, uint64_t& out) {
+    Napi::Value v = obj.Get(name);
+    if (v.IsUndefined()) return true;
+    if (!v.IsNumber()) return false;
+    const double d = v.As<Napi::Number>().DoubleValue();
+    if (!(d >= 0) || d > 9007199254740991.0 || d != static_cast<double>(static_cast<uint64_t>(d))) return false;
+    out = static_cast<uint64_t>(d);
+    return true;
+}
+
+// Reads the entries shared by openEntries(), openEntryFields() and
+// rekeyEntries(); throws and returns false on a malformed item
+template <typename Job>
+bool readCipherRows(Napi::Env env, const Napi::Array& entries, std::vector<Job>& jobs) {
+    jobs.resize(entries.Length());
+    for (uint32_t i = 0; i < entries.Length(); ++i) {
+        Napi::Value item = entries.Get(i);
+        if (!item.IsObject()) {
+            Napi::TypeError::New(env, "Entry " + std::to_string(i) + " is not an object").ThrowAsJavaScriptException();
+            return false;
+        }
+        Napi::Object entry = item.As<Napi::Object>();
+        Napi::Value id = entry.Get("entryId");
+        Job& job = jobs[i];
+        if (!id.IsString() || !readBytes(entry.Get("ciphertext"), job.ciphertext)) {
+            Napi::TypeError::New(env, "Entry " + std::to_string(i) + " needs entryId (string) and ciphertext (Buffer)")
+                .ThrowAsJavaScriptException();
+            return false;
+        }
+        job.entryId = id.As<Napi::String>().Utf8Value();
+        // A stored row with a short IV or tag cannot authenticate; report
+        // it like a tag mismatch rather than failing the whole batch
+        if (!readFixed(entry.Get("iv"), job.iv) || !readFixed(entry.Get("authTag"), job.tag))
+            job.status = VaultStatus::BadInput;
+    }
+    return true;
+}
+
+// Longest unlock window setKeys() accepts
+constexpr uint64_t kMaxKeyTtlMs = 24ull * 60 * 60 * 1000;
+
+// Marks objects built by this class, so rekeyEntries() can unwrap its
+// target without trusting an arbitrary object
+constexpr napi_type_tag VAULT_CRYPTO_TAG = {0x5ec0e9a55a17c0deull, 0x7661756c74637279ull};
+
+void rejectWithCode(Napi::Promise::Deferred& deferred, Napi::Env env, const char* code, const char* message) {
+    auto err = Napi::Error::New(env, message);
+    err.Set("code", Napi::String::New(env, code));
+    deferred.Reject(err.Value());
+}
+
+} // anonymous namespace
+
+VaultCryptoBinding::VaultCryptoBinding(const Napi::CallbackInfo& info)
+    : ObjectWrap(info), _engine(std::make_shared<VaultCryptoEngine>())
+{
+    info.This().As<Napi::Object>().TypeTag(&VAULT_CRYPTO_TAG);
+}
+
+Napi::Value VaultCryptoBinding::SetKeys(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    KeyBytes cardSecret, machineSecret;
+    uint64_t ttlMs = 0;
+    bool ok = info.Length() >= 2 && readBytes(info[0], cardSecret) && readBytes(info[1], machineSecret) &&
+              !cardSecret.empty() && !machineSecret.empty();
+    if (ok && info.Length() >= 3 && !info[2].IsUndefined())
+        ok = info[2].IsObject() && readCount(info[2].As<Napi::Object>(), "ttlMs", ttlMs) && ttlMs <= kMaxKeyTtlMs;
+    if (!ok) {
+        Napi::TypeError::New(env, "Expected (cardSecret, machineSecret, { ttlMs? }) with non-empty byte buffers "
+                                  "and ttlMs at most 24 h")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    _engine->setKeys(cardSecret.data(), cardSecret.size(), machineSecret.data(), machineSecret.size(),
+                     std::chrono::milliseconds(static_cast<int64_t>(ttlMs)));
+    return env.Undefined();
+}
+
+Napi::Value VaultCryptoBinding::ClearKeys(const Napi::CallbackInfo& info)
+{
+    _engine->clearKeys();
+    return info.Env().Undefined();
+}
+
+Napi::Value VaultCryptoBinding::HasKeys(const Napi::CallbackInfo& info)
+{
+    return Napi::Boolean::New(info.Env(), _engine->keys() != nullptr);
+}
+
+Napi::Value VaultCryptoBinding::KeysExpireInMs(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    const auto left = _engine->keysExpireIn();
+    if (!left) return env.Null();
+    return Napi::Number::New(env, static_cast<double>(left->count()));
+}
+
+Napi::Value VaultCryptoBinding::Backend(const Napi::CallbackInfo& info)
+{
+    return Napi::String::New(info.Env(), _engine->backend());
+}
+
+// ─── SealEntries ──────────────────────────────────────────────────────────────
+
+class SealEntriesWorker : public Napi::AsyncWorker {
+public:
+    SealEntriesWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                      std::shared_ptr<VaultCryptoEngine> engine,
+                      std::shared_ptr<const VaultKeys> keys,
+                      std::vector<SealJob> jobs)
+        : Napi::AsyncWorker(env), _deferred(deferred), _engine(std::move(engine)),
+          _keys(std::move(keys)), _jobs(std::move(jobs)) {}
+
+    void Execute() override {
+        _sealed = _engine->seal(*_keys, _jobs);
+        _keys.reset();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (!_sealed) {
+            rejectWithCode(_deferred, env, "RANDOM_FAILED", "OS random source failed; nothing was encrypted");
+            return;
+        }
+        Napi::Array out = Napi::Array::New(env, _jobs.size());
+        for (size_t i = 0; i < _jobs.size(); ++i) {
+            const SealJob& job = _jobs[i];
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("ciphertext", Napi::Buffer<uint8_t>::Copy(env, job.ciphertext.data(), job.ciphertext.size()));
+            obj.Set("iv", Napi::Buffer<uint8_t>::Copy(env, job.iv.data(), job.iv.size()));
+            obj.Set("authTag", Napi::Buffer<uint8_t>::Copy(env, job.tag.data(), job.tag.size()));
+            out.Set(static_cast<uint32_t>(i), obj);
+        }
+        _deferred.Resolve(out);
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<VaultCryptoEngine> _engine;
+    std::shared_ptr<const VaultKeys> _keys;
+    std::vector<SealJob> _jobs;
+    bool _sealed = false;
+};
+
+Napi::Value VaultCryptoBinding::SealEntries(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Expected an array of { entryId, plaintext }").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Array entries = info[0].As<Napi::Array>();
+    std::vector<SealJob> jobs(entries.Length());
+    for (uint32_t i = 0; i < entries.Length(); ++i) {
+        Napi::Value item = entries.Get(i);
+        if (!item.IsObject()) {
+            Napi::TypeError::New(env, "Entry " + std::to_string(i) + " is not an object").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        Napi::Object entry = item.As<Napi::Object>();
+        Napi::Value id = entry.Get("entryId");
+        if (!id.IsString() || !readPlaintext(entry.Get("plaintext"), jobs[i].plaintext)) {
+            Napi::TypeError::New(env, "Entry " + std::to_string(i) + " needs entryId (string) and plaintext (string or Buffer)")
+                .ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        jobs[i].entryId = id.As<Napi::String>().Utf8Value();
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto keys = _engine->keys();
+    if (!keys) {
+        rejectWithCode(deferred, env, "NO_KEYS", "Vault keys are not set");
+        return deferred.Promise();
+    }
+    SealEntriesWorker* worker = new SealEntriesWorker(env, deferred, _engine, std::move(keys), std::move(jobs));
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── SealEntryFields ──────────────────────────────────────────────────────────
+
+Napi::Value VaultCryptoBinding::SealEntryFields(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Expected an array of { entryId, fields }").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    // v1 unless v2 is asked for: older builds on synced devices cannot read v2
+    uint64_t payloadVersion = 1;
+    if (info.Length() >= 2 && !info[1].IsUndefined() &&
+        (!info[1].IsObject() || !readCount(info[1].As<Napi::Object>(), "payloadVersion", payloadVersion) ||
+         (payloadVersion != 1 && payloadVersion != 2))) {
+        Napi::TypeError::New(env, "Expected { payloadVersion?: 1 | 2 }").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Array entries = info[0].As<Napi::Array>();
+    std::vector<SealJob> jobs(entries.Length());
+    for (uint32_t i = 0; i < entries.Length(); ++i) {
+        Napi::Value item = entries.Get(i);
+        Napi::Value id = item.IsObject() ? item.As<Napi::Object>().Get("entryId") : env.Undefined();
+        Napi::Value payload = item.IsObject() ? item.As<Napi::Object>().Get("fields") : env.Undefined();
+        bool ok = id.IsString() && payload.IsObject();
+        // Encoded here, on the calling thread: a few copies per entry, not
+        // worth a second pass through the pool
+        EntryFields fields;
+        for (EntryField field : adapters::crypto::kEntryFields) {
+            if (!ok) break;
+            Napi::Value value = payload.As<Napi::Object>().Get(std::string(adapters::crypto::entryFieldName(field)));
+            if (value.IsUndefined() || value.IsNull()) continue;
+            ok = value.IsString() && readPlaintext(value, fields.values[static_cast<size_t>(field)]);
+            fields.present |= adapters::crypto::entryFieldBit(field);
+        }
+        if (ok && payloadVersion == 1) {
+            adapters::crypto::encodeEntryPayloadJson(fields, jobs[i].plaintext);
+        } else if (ok) {
+            ok = adapters::crypto::encodeEntryPayload(fields, jobs[i].plaintext);
+        }
+        if (!ok) {
+            Napi::TypeError::New(env, "Entry " + std::to_string(i) + " needs entryId (string) and fields "
+                                      "({ username, password, totpSecret?, notes? } as strings)")
+                .ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        jobs[i].entryId = id.As<Napi::String>().Utf8Value();
+    }
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto keys = _engine->keys();
+    if (!keys) {
+        rejectWithCode(deferred, env, "NO_KEYS", "Vault keys are not set");
+        return deferred.Promise();
+    }
+    SealEntriesWorker* worker = new SealEntriesWorker(env, deferred, _engine, std::move(keys), std::move(jobs));
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── OpenEntries ──────────────────────────────────────────────────────────────
+
+class OpenEntriesWorker : public Napi::AsyncWorker {
+public:
+    OpenEntriesWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                      std::shared_ptr<VaultCryptoEngine> engine,
+                      std::shared_ptr<const VaultKeys> keys,
+                      std::vector<OpenJob> jobs)
+        : Napi::AsyncWorker(env), _deferred(deferred), _engine(std::move(engine)),
+          _keys(std::move(keys)), _jobs(std::move(jobs)) {}
+
+    void Execute() override {
+        _engine->open(*_keys, _jobs);
+        _keys.reset();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        // null marks an entry that failed authentication or was malformed
+        Napi::Array out = Napi::Array::New(env, _jobs.size());
+        for (size_t i = 0; i < _jobs.size(); ++i) {
+            const OpenJob& job = _jobs[i];
+            if (job.status == VaultStatus::Ok)
+                out.Set(static_cast<uint32_t>(i), Napi::Buffer<uint8_t>::Copy(env, job.plaintext.data(), job.plaintext.size()));
+            else
+                out.Set(static_cast<uint32_t>(i), env.Null());
+        }
+        _deferred.Resolve(out);
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<VaultCryptoEngine> _engine;
+    std::shared_ptr<const VaultKeys> _keys;
+    std::vector<OpenJob> _jobs;
+};
+
+Napi::Value VaultCryptoBinding::OpenEntries(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Expected an array of { entryId, ciphertext, iv, authTag }")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::vector<OpenJob> jobs;
+    if (!readCipherRows(env, info[0].As<Napi::Array>(), jobs)) return env.Null();
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto keys = _engine->keys();
+    if (!keys) {
+        rejectWithCode(deferred, env, "NO_KEYS", "Vault keys are not set");
+        return deferred.Promise();
+    }
+    OpenEntriesWorker* worker = new OpenEntriesWorker(env, deferred, _engine, std::move(keys), std::move(jobs));
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── OpenEntryFields ──────────────────────────────────────────────────────────
+
+class OpenEntryFieldsWorker : public Napi::AsyncWorker {
+public:
+    OpenEntryFieldsWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                          std::shared_ptr<VaultCryptoEngine> engine,
+                          std::shared_ptr<const VaultKeys> keys,
+                          std::vector<FieldsJob> jobs, uint32_t mask)
+        : Napi::AsyncWorker(env), _deferred(deferred), _engine(std::move(engine)),
+          _keys(std::move(keys)), _jobs(std::move(jobs)), _mask(mask) {}
+
+    void Execute() override {
+        _engine->openFields(*_keys, _jobs, _mask);
+        _keys.reset();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        // null marks an entry that failed authentication or was malformed
+        Napi::Array out = Napi::Array::New(env, _jobs.size());
+        for (size_t i = 0; i < _jobs.size(); ++i) {
+            const FieldsJob& job = _jobs[i];
+            if (job.status != VaultStatus::Ok) {
+                out.Set(static_cast<uint32_t>(i), env.Null());
+                continue;
+            }
+            Napi::Object obj = Napi::Object::New(env);
+            for (EntryField field : adapters::crypto::kEntryFields) {
+                if (!job.fields.has(field)) continue;
+                const auto& value = job.fields[field];
+                obj.Set(std::string(adapters::crypto::entryFieldName(field)),
+                        Napi::String::New(env, reinterpret_cast<const char*>(value.data()), value.size()));
+            }
+            out.Set(static_cast<uint32_t>(i), obj);
+        }
+        _deferred.Resolve(out);
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<VaultCryptoEngine> _engine;
+    std::shared_ptr<const VaultKeys> _keys;
+    std::vector<FieldsJob> _jobs;
+    uint32_t _mask;
+};
+
+Napi::Value VaultCryptoBinding::OpenEntryFields(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    uint32_t mask = 0;
+    bool ok = info.Length() >= 2 && info[0].IsArray() && info[1].IsArray();
+    if (ok) {
+        Napi::Array names = info[1].As<Napi::Array>();
+        for (uint32_t i = 0; ok && i < names.Length(); ++i) {
+            Napi::Value name = names.Get(i);
+            EntryField field;
+            ok = name.IsString() && adapters::crypto::entryFieldFromName(name.As<Napi::String>().Utf8Value(), field);
+            if (ok) mask |= adapters::crypto::entryFieldBit(field);
+        }
+        ok = ok && mask != 0;
+    }
+    if (!ok) {
+        Napi::TypeError::New(env, "Expected (entries, fields) with fields a non-empty array of "
+                                  "'username' | 'password' | 'totpSecret' | 'notes'")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::vector<FieldsJob> jobs;
+    if (!readCipherRows(env, info[0].As<Napi::Array>(), jobs)) return env.Null();
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto keys = _engine->keys();
+    if (!keys) {
+        rejectWithCode(deferred, env, "NO_KEYS", "Vault keys are not set");
+        return deferred.Promise();
+    }
+    OpenEntryFieldsWorker* worker = new OpenEntryFieldsWorker(env, deferred, _engine, std::move(keys), std::move(jobs), mask);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── RekeyEntries ─────────────────────────────────────────────────────────────
+
+class RekeyEntriesWorker : public Napi::AsyncWorker {
+public:
+    RekeyEntriesWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                       std::shared_ptr<VaultCryptoEngine> engine,
+                       std::shared_ptr<const VaultKeys> from,
+                       std::shared_ptr<const VaultKeys> to,
+                       std::vector<RekeyJob> jobs)
+        : Napi::AsyncWorker(env), _deferred(deferred), _engine(std::move(engine)),
+          _from(std::move(from)), _to(std::move(to)), _jobs(std::move(jobs)) {}
+
+    void Execute() override {
+        _rekeyed = _engine->rekey(*_from, *_to, _jobs);
+        _from.reset();
+        _to.reset();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (!_rekeyed) {
+            rejectWithCode(_deferred, env, "RANDOM_FAILED", "OS random source failed; nothing was re-encrypted");
+            return;
+        }
+        // null marks an entry the source keys could not open
+        Napi::Array out = Napi::Array::New(env, _jobs.size());
+        for (size_t i = 0; i < _jobs.size(); ++i) {
+            const RekeyJob& job = _jobs[i];
+            if (job.status != VaultStatus::Ok) {
+                out.Set(static_cast<uint32_t>(i), env.Null());
+                continue;
+            }
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("ciphertext", Napi::Buffer<uint8_t>::Copy(env, job.newCiphertext.data(), job.newCiphertext.size()));
+            obj.Set("iv", Napi::Buffer<uint8_t>::Copy(env, job.newIv.data(), job.newIv.size()));
+            obj.Set("authTag", Napi::Buffer<uint8_t>::Copy(env, job.newTag.data(), job.newTag.size()));
+            out.Set(static_cast<uint32_t>(i), obj);
+        }
+        _deferred.Resolve(out);
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<VaultCryptoEngine> _engine;
+    std::shared_ptr<const VaultKeys> _from;
+    std::shared_ptr<const VaultKeys> _to;
+    std::vector<RekeyJob> _jobs;
+    bool _rekeyed = false;
+};
+
+Napi::Value VaultCryptoBinding::RekeyEntries(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsObject() ||
+        !info[1].As<Napi::Object>().CheckTypeTag(&VAULT_CRYPTO_TAG)) {
+        Napi::TypeError::New(env, "Expected (entries, target: VaultCryptoBinding)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    VaultCryptoBinding* target = Napi::ObjectWrap<VaultCryptoBinding>::Unwrap(info[1].As<Napi::Object>());
+
+    std::vector<RekeyJob> jobs;
+    if (!readCipherRows(env, info[0].As<Napi::Array>(), jobs)) return env.Null();
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto from = _engine->keys();
+    auto to = target->_engine->keys();
+    if (!from || !to) {
+        rejectWithCode(deferred, env, "NO_KEYS", from ? "Target vault keys are not set" : "Vault keys are not set");
+        return deferred.Promise();
+    }
+    // The source engine's pool does the work; the target only lends its keys
+    RekeyEntriesWorker* worker = new RekeyEntriesWorker(env, deferred, _engine, std::move(from), std::move(to), std::move(jobs));
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── Chunked blobs ────────────────────────────────────────────────────────────
+
+Napi::Value VaultCryptoBinding::CreateChunkedHeader(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    uint64_t chunkSize = ChunkedHeader::kDefaultChunkSize;
+    if (info.Length() >= 1 && !info[0].IsUndefined() &&
+        (!info[0].IsObject() || !readCount(info[0].As<Napi::Object>(), "chunkSize", chunkSize) ||
+         chunkSize < ChunkedHeader::kMinChunkSize || chunkSize > ChunkedHeader::kMaxChunkSize)) {
+        Napi::TypeError::New(env, "Expected { chunkSize? } between 1 KiB and 16 MiB").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    ChunkedHeader header;
+    if (!ChunkedHeader::generate(static_cast<uint32_t>(chunkSize), header)) {
+        auto err = Napi::Error::New(env, "OS random source failed");
+        err.Set("code", Napi::String::New(env, "RANDOM_FAILED"));
+        err.ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    auto out = Napi::Buffer<uint8_t>::New(env, ChunkedHeader::kSize);
+    header.serialize(out.Data());
+    return out;
+}
+
+namespace {
+
+// (blobId, header, firstIndex, data, final), shared by sealChunks() and
+// openChunks(); throws and returns false on a malformed argument
+template <typename Bytes>
+bool readChunksArgs(const Napi::CallbackInfo& info, std::string& blobId, ChunkedHeader& header,
+                    uint32_t& firstIndex, Bytes& data, bool& final) {
+    Napi::Env env = info.Env();
+    std::vector<uint8_t> headerBytes;
+    bool ok = info.Length() >= 5 && info[0].IsString() && readBytes(info[1], headerBytes) &&
+              ChunkedHeader::parse(headerBytes.data(), headerBytes.size(), header) &&
+              headerBytes.size() == ChunkedHeader::kSize && info[2].IsNumber() &&
+              info[3].IsTypedArray() && readBytes(info[3], data) && info[4].IsBoolean();
+    if (ok) {
+        const double index = info[2].As<Napi::Number>().DoubleValue();
+        ok = index >= 0 && index <= 4294967295.0 && index == static_cast<double>(static_cast<uint32_t>(index));
+        firstIndex = ok ? static_cast<uint32_t>(index) : 0;
+    }
+    if (!ok) {
+        Napi::TypeError::New(env, "Expected (blobId: string, header: Buffer, firstIndex: u32, data: Buffer, "
+                                  "final: boolean) with a header from createChunkedHeader()")
+            .ThrowAsJavaScriptException();
+        return false;
+    }
+    blobId = info[0].As<Napi::String>().Utf8Value();
+    final = info[4].As<Napi::Boolean>().Value();
+    return true;
+}
+
+} // anonymous namespace
+
+class ChunksWorker : public Napi::AsyncWorker {
+public:
+    ChunksWorker(Napi::Env& env, Napi::Promise::Deferred deferred,
+                 std::shared_ptr<VaultCryptoEngine> engine, std::shared_ptr<const VaultKeys> keys,
+                 bool seal, std::string blobId, const ChunkedHeader& header, uint32_t firstIndex,
+                 adapters::crypto::SecureBytes data, bool final)
+        : Napi::AsyncWorker(env), _deferred(deferred), _engine(std::move(engine)), _keys(std::move(keys)),
+          _seal(seal), _blobId(std::move(blobId)), _header(header), _firstIndex(firstIndex),
+          _data(std::move(data)), _final(final) {}
+
+    void Execute() override {
+        if (_seal)
+            _status = _engine->sealChunks(*_keys, _blobId, _header, _firstIndex, _data.data(), _data.size(),
+                                          _final, _sealed);
+        else
+            _status = _engine->openChunks(*_keys, _blobId, _header, _firstIndex, _data.data(), _data.size(),
+                                          _final, _opened);
+        _keys.reset();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (_status == VaultStatus::BadInput) {
+            rejectWithCode(_deferred, env, "INVALID_CHUNKS",
+                           _final ? "Data does not end in a valid final chunk"
+                                  : "Data is not a whole number of chunks, or the index overflows");
+        } else if (_status != VaultStatus::Ok) {
+            _deferred.Resolve(env.Null()); // a chunk failed authentication
+        } else if (_seal) {
+            _deferred.Resolve(Napi::Buffer<uint8_t>::Copy(env, _sealed.data(), _sealed.size()));
+        } else {
+            _deferred.Resolve(Napi::Buffer<uint8_t>::Copy(env, _opened.data(), _opened.size()));
+        }
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    std::shared_ptr<VaultCryptoEngine> _engine;
+    std::shared_ptr<const VaultKeys> _keys;
+    bool _seal;
+    std::string _blobId;
+    ChunkedHeader _header;
+    uint32_t _firstIndex;
+    adapters::crypto::SecureBytes _data;
+    bool _final;
+    VaultStatus _status = VaultStatus::Ok;
+    std::vector<uint8_t> _sealed;
+    adapters::crypto::SecureBytes _opened;
+};
+
+Napi::Value VaultCryptoBinding::QueueChunks(const Napi::CallbackInfo& info, bool seal)
+{
+    Napi::Env env = info.Env();
+    std::string blobId;
+    ChunkedHeader header;
+    uint32_t firstIndex;
+    adapters::crypto::SecureBytes data;
+    bool final;
+    if (!readChunksArgs(info, blobId, header, firstIndex, data, final)) return env.Null();
+
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    auto keys = _engine->keys();
+    if (!keys) {
+        rejectWithCode(deferred, env, "NO_KEYS", "Vault keys are not set");
+        return deferred.Promise();
+    }
+    ChunksWorker* worker = new ChunksWorker(env, deferred, _engine, std::move(keys), seal, std::move(blobId),
+                                            header, firstIndex, std::move(data), final);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+Napi::Value VaultCryptoBinding::SealChunks(const Napi::CallbackInfo& info)
+{
+    return QueueChunks(info, true);
+}
+
+Napi::Value VaultCryptoBinding::OpenChunks(const Napi::CallbackInfo& info)
+{
+    return QueueChunks(info, false);
+}
+
+// ─── Scrypt ───────────────────────────────────────────────────────────────────
+
+namespace {
+
+constexpr size_t kMaxScryptKeyLen = 1024;
+constexpr size_t kDefaultScryptMaxmem = 256u * 1024 * 1024;
+
+// Lanes of every scrypt() call run here, apart from the vault engines'
+// pools so a PIN check never queues behind a re-key batch. Never freed:
+// joining threads from a static destructor at exit is not worth the risk.
+WorkStealingPool& scryptPool() {
+    static WorkStealingPool* pool = new WorkStealingPool();
+    return *pool;
+}
+
+} // anonymous namespace
+
+class ScryptWorker : public Napi::AsyncWorker {
+public:
+    ScryptWorker(Napi::Env& env, Napi::Promise::Deferred deferred, KeyBytes password,
+                 std::vector<uint8_t> salt, ScryptParams params, size_t maxmem, size_t keyLen)
+        : Napi::AsyncWorker(env), _deferred(deferred), _password(std::move(password)),
+          _salt(std::move(salt)), _params(params), _maxmem(maxmem), _key(keyLen) {}
+
+    void Execute() override {
+        _status = adapters::crypto::scrypt(_password.data(), _password.size(), _salt.data(), _salt.size(),
+                                           _params, _maxmem, _key.data(), _key.size(), &scryptPool());
+        _password.clear();
+        _password.shrink_to_fit();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        switch (_status) {
+        case ScryptStatus::Ok:
+            _deferred.Resolve(Napi::Buffer<uint8_t>::Copy(env, _key.data(), _key.size()));
+            break;
+        case ScryptStatus::BadParams:
+            rejectWithCode(_deferred, env, "INVALID_PARAMS", "N must be a power of two above 1; r and p non-zero, r * p < 2^30");
+            break;
+        case ScryptStatus::MemoryLimit:
+            rejectWithCode(_deferred, env, "MEMORY_LIMIT", "One scrypt lane needs more than maxmem bytes");
+            break;
+        case ScryptStatus::OutOfMemory:
+            rejectWithCode(_deferred, env, "OUT_OF_MEMORY", "Could not allocate the scrypt tables");
+            break;
+        }
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    KeyBytes _password;
+    std::vector<uint8_t> _salt;
+    ScryptParams _params;
+    size_t _maxmem;
+    KeyBytes _key;
+    ScryptStatus _status = ScryptStatus::BadParams;
+};
+
+Napi::Value VaultCryptoBinding::Scrypt(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    KeyBytes password;
+    std::vector<uint8_t> salt;
+    uint64_t N = 0, r = 0, p = 0, keyLen = 0, maxmem = kDefaultScryptMaxmem;
+    bool ok = info.Length() >= 3 && readPlaintext(info[0], password) && readBytes(info[1], salt) && info[2].IsObject();
+    if (ok) {
+        Napi::Object opts = info[2].As<Napi::Object>();
+        ok = readCount(opts, "N", N) && readCount(opts, "r", r) && readCount(opts, "p", p) &&
+             readCount(opts, "keyLen", keyLen) && readCount(opts, "maxmem", maxmem) &&
+             r <= UINT32_MAX && p <= UINT32_MAX && keyLen >= 1 && keyLen <= kMaxScryptKeyLen;
+    }
+    if (!ok) {
+        Napi::TypeError::New(env, "Expected (password, salt, { N, r, p, keyLen, maxmem? }) with 1 <= keyLen <= 1024")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    ScryptParams params;
+    params.N = N;
+    params.r = static_cast<uint32_t>(r);
+    params.p = static_cast<uint32_t>(p);
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    ScryptWorker* worker = new ScryptWorker(env, deferred, std::move(password), std::move(salt), params,
+                                            static_cast<size_t>(std::min<uint64_t>(maxmem, SIZE_MAX)),
+                                            static_cast<size_t>(keyLen));
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── CalibrateScrypt ──────────────────────────────────────────────────────────
+
+class CalibrateScryptWorker : public Napi::AsyncWorker {
+public:
+    CalibrateScryptWorker(Napi::Env& env, Napi::Promise::Deferred deferred, ScryptCalibration limits)
+        : Napi::AsyncWorker(env), _deferred(deferred), _limits(limits) {}
+
+    void Execute() override {
+        _status = adapters::crypto::calibrateScrypt(_limits, &scryptPool(), _result);
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        switch (_status) {
+        case ScryptStatus::Ok: {
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("N", Napi::Number::New(env, static_cast<double>(_result.params.N)));
+            obj.Set("r", Napi::Number::New(env, _result.params.r));
+            obj.Set("p", Napi::Number::New(env, _result.params.p));
+            obj.Set("measuredMs", Napi::Number::New(env, _result.measuredMs));
+            _deferred.Resolve(obj);
+            break;
+        }
+        case ScryptStatus::BadParams:
+            rejectWithCode(_deferred, env, "INVALID_PARAMS", "The floor parameters are invalid or outside maxN/maxP");
+            break;
+        case ScryptStatus::MemoryLimit:
+            rejectWithCode(_deferred, env, "MEMORY_LIMIT", "The floor parameters need more than maxmem bytes");
+            break;
+        case ScryptStatus::OutOfMemory:
+            rejectWithCode(_deferred, env, "OUT_OF_MEMORY", "Could not allocate the scrypt tables");
+            break;
+        }
+    }
+
+    void OnError(const Napi::Error& e) override { _deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred _deferred;
+    ScryptCalibration _limits;
+    ScryptCalibrationResult _result;
+    ScryptStatus _status = ScryptStatus::BadParams;
+};
+
+Napi::Value VaultCryptoBinding::CalibrateScrypt(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    ScryptCalibration limits;
+    uint64_t N = limits.floor.N, r = limits.floor.r, p = limits.floor.p;
+    uint64_t maxN = limits.maxN, maxP = limits.maxP, maxmem = limits.maxmem;
+    bool ok = info.Length() >= 1 && info[0].IsObject();
+    if (ok) {
+        Napi::Object opts = info[0].As<Napi::Object>();
+        Napi::Value target = opts.Get("targetMs");
+        ok = target.IsNumber() && target.As<Napi::Number>().DoubleValue() > 0 &&
+             readCount(opts, "minN", N) && readCount(opts, "r", r) && readCount(opts, "minP", p) &&
+             readCount(opts, "maxN", maxN) && readCount(opts, "maxP", maxP) && readCount(opts, "maxmem", maxmem) &&
+             r <= UINT32_MAX && p <= UINT32_MAX && maxP <= UINT32_MAX;
+        if (ok) limits.targetMs = target.As<Napi::Number>().DoubleValue();
+    }
+    if (!ok) {
+        Napi::TypeError::New(env, "Expected ({ targetMs, minN?, r?, minP?, maxN?, maxP?, maxmem? })")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    limits.floor.N = N;
+    limits.floor.r = static_cast<uint32_t>(r);
+    limits.floor.p = static_cast<uint32_t>(p);
+    limits.maxN = maxN;
+    limits.maxP = static_cast<uint32_t>(maxP);
+    limits.maxmem = static_cast<size_t>(std::min<uint64_t>(maxmem, SIZE_MAX));
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    CalibrateScryptWorker* worker = new CalibrateScryptWorker(env, deferred, limits);
+    worker->Queue();
+    return deferred.Promise();
+}
+
+// ─── SecureMemory ─────────────────────────────────────────────────────────────
+
+Napi::Value VaultCryptoBinding::SecureMemory(const Napi::CallbackInfo& info)
+{
+    Napi::Env env = info.Env();
+    const SecureArena::Stats stats = SecureArena::instance().stats();
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("locked", Napi::Boolean::New(env, stats.locked));
+    obj.Set("dumpExcluded", Napi::Boolean::New(env, stats.dumpExcluded));
+    obj.Set("pageSize", Napi::Number::New(env, static_cast<double>(stats.pageSize)));
+    obj.Set("capacity", Napi::Number::New(env, static_cast<double>(stats.capacity)));
+    obj.Set("inUse", Napi::Number::New(env, static_cast<double>(stats.inUse)));
+    obj.Set("peakInUse", Napi::Number::New(env, static_cast<double>(stats.peakInUse)));
+    obj.Set("heapFallbacks", Napi::Number::New(env, static_cast<double>(stats.heapFallbacks)));
+    return obj;
+}
+
+Napi::Function VaultCryptoBinding::GetClass(Napi::Env env)
+{
+    return DefineClass(
+        env,
+        "VaultCryptoBinding",
+        {
+            InstanceMethod("setKeys", &VaultCryptoBinding::SetKeys),
+            InstanceMethod("clearKeys", &VaultCryptoBinding::ClearKeys),
+            InstanceMethod("hasKeys", &VaultCryptoBinding::HasKeys),
+            InstanceMethod("keysExpireInMs", &VaultCryptoBinding::KeysExpireInMs),
+            InstanceMethod("backend", &VaultCryptoBinding::Backend),
+            InstanceMethod("sealEntries", &VaultCryptoBinding::SealEntries),
+            InstanceMethod("sealEntryFields", &VaultCryptoBinding::SealEntryFields),
+            InstanceMethod("openEntries", &VaultCryptoBinding::OpenEntries),
+            InstanceMethod("openEntryFields", &VaultCryptoBinding::OpenEntryFields),
+            InstanceMethod("rekeyEntries", &VaultCryptoBinding::RekeyEntries),
+            InstanceMethod("sealChunks", &VaultCryptoBinding::SealChunks),
+            InstanceMethod("openChunks", &VaultCryptoBinding::OpenChunks),
+            StaticMethod("createChunkedHeader", &VaultCryptoBinding::CreateChunkedHeader),
+            StaticMethod("scrypt", &VaultCryptoBinding::Scrypt),
+            StaticMethod("calibrateScrypt", &VaultCryptoBinding::CalibrateScrypt),
+            StaticMethod("secureMemory", &VaultCryptoBinding::SecureMemory)
+        }
+    );
+}
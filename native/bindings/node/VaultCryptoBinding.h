@@ -0,0 +1,36 @@
+#pragma once
+
+#include <napi.h>
+#include <memory>
+#include "../../adapters/crypto/VaultCryptoEngine.h"
+
+// Batch vault entry crypto. The entry root (cardSecret ‖ machineSecret)
+// goes in through setKeys() and stays in native memory; JS only ever sees
+// ciphertext, IVs, tags and the plaintext it asked to open.
+class VaultCryptoBinding : public Napi::ObjectWrap<VaultCryptoBinding> {
+public:
+    VaultCryptoBinding(const Napi::CallbackInfo&);
+    Napi::Value SetKeys(const Napi::CallbackInfo&);
+    Napi::Value ClearKeys(const Napi::CallbackInfo&);
+    Napi::Value HasKeys(const Napi::CallbackInfo&);
+    Napi::Value KeysExpireInMs(const Napi::CallbackInfo&);
+    Napi::Value Backend(const Napi::CallbackInfo&);
+    Napi::Value SealEntries(const Napi::CallbackInfo&);
+    Napi::Value SealEntryFields(const Napi::CallbackInfo&);
+    Napi::Value OpenEntries(const Napi::CallbackInfo&);
+    Napi::Value OpenEntryFields(const Napi::CallbackInfo&);
+    Napi::Value RekeyEntries(const Napi::CallbackInfo&);
+    Napi::Value SealChunks(const Napi::CallbackInfo&);
+    Napi::Value OpenChunks(const Napi::CallbackInfo&);
+    static Napi::Value CreateChunkedHeader(const Napi::CallbackInfo&);
+    static Napi::Value Scrypt(const Napi::CallbackInfo&);
+    static Napi::Value CalibrateScrypt(const Napi::CallbackInfo&);
+    static Napi::Value SecureMemory(const Napi::CallbackInfo&);
+
+    static Napi::Function GetClass(Napi::Env);
+
+private:
+    Napi::Value QueueChunks(const Napi::CallbackInfo&, bool seal);
+
+    std::shared_ptr<adapters::crypto::VaultCryptoEngine> _engine;
+};
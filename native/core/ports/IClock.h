@@ -0,0 +1,31 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace core {
+namespace ports {
+
+// Monotonic time for timeouts, deadlines and idle timers. Production code
+// runs on the steady clock; simulations inject a virtual clock so that a
+// 15 s "no card" wait or a retry policy costs microseconds of real time.
+class IClock {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    virtual ~IClock() = default;
+
+    virtual TimePoint now() const = 0;
+
+    // Blocks the calling thread for `duration` of this clock's time.
+    virtual void sleepFor(std::chrono::nanoseconds duration) = 0;
+
+    // condition_variable::wait_until against this clock: no_timeout when
+    // notified (or woken spuriously), timeout once `deadline` has passed.
+    virtual std::cv_status waitUntil(std::condition_variable& cv,
+                                     std::unique_lock<std::mutex>& lock,
+                                     TimePoint deadline) = 0;
+};
+
+} // namespace ports
+} // namespace core
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace core {
+namespace ports {
+
+// An AES key with its expanded schedule (and CMAC subkeys) computed once.
+// Create one per key and keep it for as long as the key is in use — a
+// DESFire session holds one for its session key, so per-command MAC and
+// cipher work never re-expands the key.
+//
+// Buffers may alias (in == out). Lengths are in bytes and must be a
+// multiple of 16 for ECB and CBC; CMAC and GCM take any length.
+class IAesKey {
+public:
+    virtual ~IAesKey() = default;
+
+    virtual size_t keySize() const = 0; // 16 or 32
+
+    virtual void encryptEcb(const uint8_t* in, uint8_t* out, size_t len) const = 0;
+    virtual void decryptEcb(const uint8_t* in, uint8_t* out, size_t len) const = 0;
+
+    // CBC with in/out IV: `iv` is updated to the last ciphertext block so
+    // callers can chain across frames (DESFire IV chaining).
+    virtual void encryptCbc(uint8_t iv[16], const uint8_t* in, uint8_t* out, size_t len) const = 0;
+    virtual void decryptCbc(uint8_t iv[16], const uint8_t* in, uint8_t* out, size_t len) const = 0;
+
+    // NIST SP 800-38B CMAC with an explicit starting IV (zero for plain
+    // CMAC; the running session IV for DESFire EV1). Writes the full
+    // 16-byte tag; callers truncate as their protocol requires.
+    virtual void cmac(const uint8_t iv[16], const uint8_t* data, size_t len, uint8_t mac[16]) const = 0;
+
+    // NIST SP 800-38D GCM with a 96-bit IV and a full 16-byte tag.
+    // gcmOpen checks the tag (in constant time) before decrypting, and on a
+    // mismatch returns false without writing to `out`.
+    virtual void gcmSeal(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                         const uint8_t* in, uint8_t* out, size_t len, uint8_t tag[16]) const = 0;
+    virtual bool gcmOpen(const uint8_t iv[12], const uint8_t* aad, size_t aadLen,
+                         const uint8_t* in, uint8_t* out, size_t len, const uint8_t tag[16]) const = 0;
+};
+
+// Factory for AES keys backed by one implementation (portable C++ or a
+// hardware instruction set). Providers are stateless and thread-safe;
+// keys are not thread-safe and belong to one session.
+class ICryptoProvider {
+public:
+    virtual ~ICryptoProvider() = default;
+
+    // Short identifier for logs and benchmarks, e.g. "portable", "aes-ni".
+    virtual const char* name() const = 0;
+
+    // Expands `key` (16 or 32 bytes). Returns nullptr for other sizes.
+    // The returned object zeroizes its schedule on destruction.
+    virtual std::unique_ptr<IAesKey> createAesKey(const uint8_t* key, size_t keyLen) const = 0;
+};
+
+} // namespace ports
+} // namespace core
@@ -10,7 +10,7 @@ namespace core {
 namespace ports {
 
 struct NfcError {
-    std::string code;    // NOT_CONNECTED, NO_CARD, NOT_DESFIRE, IO_TIMEOUT, HARDWARE_ERROR
+    std::string code;    // NOT_CONNECTED, NO_CARD, NOT_DESFIRE, IO_TIMEOUT, CANCELLED, HARDWARE_ERROR
     std::string message; // human-readable detail
 };
 
@@ -67,6 +67,119 @@ struct CardInitOptions {
     std::array<uint8_t, 16> cardSecret;    // 16 random bytes written to File 00
 };
 
+// Outcome of initCard. The adapter inspects the card before provisioning and
+// resumes an interrupted init from its first incomplete step, so a card that
+// was pulled mid-init needs one short transaction instead of format + reinit.
+// Step names: "configurePicc", "createApplication", "createFile",
+// "changeReadKey", "writeSecret", "changeMasterKey".
+struct CardInitReport {
+    bool resumed = false;                  // card already carried part of the layout
+    std::vector<std::string> stepsRun;     // in execution order
+    std::vector<std::string> stepsSkipped; // already done on the card
+};
+
+// Trade-off between idle power and first-tap latency, applied between operations.
+//   Latency  — RF field kept on so the next detection skips field/card power-up.
+//   Balanced — RF field switched off after idleTimeoutMs without activity.
+//   LowPower — PN532 PowerDown after idleTimeoutMs (wake on HSU or RF level);
+//              woken on the next operation or by wakeReader().
+// See docs/reader-power.md for latency and idle current notes per mode.
+enum class ReaderPowerMode { Latency, Balanced, LowPower };
+
+struct ReaderPowerPolicy {
+    ReaderPowerMode mode   = ReaderPowerMode::Balanced;
+    uint32_t idleTimeoutMs = 2000; // ignored in Latency mode
+};
+
+struct ReaderPowerStatus {
+    ReaderPowerPolicy policy;
+    bool rfFieldOn              = false; // last field state driven by the adapter
+    bool poweredDown            = false; // PN532 is in PowerDown
+    uint32_t wakeCount          = 0;     // PowerDown wake-ups since connect
+    uint32_t lastWakeLatencyUs  = 0;     // wake preamble sent → first command answered
+};
+
+// One serial-link setting tried at connect time, e.g. "low_latency".
+struct LinkTuningResult {
+    std::string setting;
+    bool        applied = false;
+    std::string detail;  // effect when applied, reason when not
+};
+
+// Cheap reader/link health snapshot. The status block is the latest PN532
+// GetGeneralStatus sample (taken by the adapter while idle); the counters
+// come from the serial link and run since the last connect.
+// Acquisitions of the adapter mutex that serialises every reader operation,
+// counted since the adapter was created. Bucket i of a histogram counts
+// durations in [2^(i-1), 2^i) µs; bucket 0 is under 1 µs and the last one
+// is open-ended.
+struct AdapterLockStats {
+    static constexpr size_t kBuckets = 24;
+
+    uint64_t acquisitions = 0;
+    uint64_t contended    = 0; // acquisitions that had to wait
+    uint64_t tryFailures  = 0; // try-locks that gave up (idle housekeeping)
+    uint64_t waitTotalUs  = 0; // contended acquisitions only
+    uint64_t waitMaxUs    = 0;
+    uint64_t holdTotalUs  = 0;
+    uint64_t holdMaxUs    = 0;
+    std::array<uint64_t, kBuckets> waitBuckets{};
+    std::array<uint64_t, kBuckets> holdBuckets{};
+};
+
+struct ReaderHealthSnapshot {
+    bool connected = false;
+
+    bool        statusValid          = false;
+    uint32_t    statusAgeMs          = 0;     // time since the sample was taken
+    uint8_t     lastError            = 0;     // PN532 error code, 0x00 = none
+    std::string lastErrorName;                // e.g. "CRC error"
+    bool        externalFieldPresent = false;
+    uint8_t     targetCount          = 0;
+    uint32_t    targetBitrateRxKbps  = 0;     // first listed target, 0 when none
+    uint32_t    targetBitrateTxKbps  = 0;
+
+    uint64_t bytesOut       = 0;
+    uint64_t bytesIn        = 0;
+    uint64_t framesOut      = 0;
+    uint64_t framesIn       = 0;
+    uint64_t acks           = 0;
+    uint64_t nacks          = 0; // NACK frames in either direction
+    uint64_t checksumErrors = 0; // received frames with a bad LCS/DCS
+    uint64_t errorFrames    = 0; // PN532 syntax error frames
+    uint64_t retries        = 0; // command frames re-sent before a response arrived
+    uint64_t timeouts       = 0; // serial reads that timed out
+    uint64_t ioErrors       = 0; // other serial read/write failures
+
+    std::vector<LinkTuningResult> linkTuning; // from the last connect; empty when the backend does not tune
+
+    AdapterLockStats lock; // unlike the counters above, not reset by connect
+};
+
+// One entry of the adapter's flight recorder: a PN532 frame, or a run of
+// serial read timeouts / an I/O error between frames.
+struct RecordedFrame {
+    int64_t     offsetUs = 0;   // relative to the failure; negative = before it
+    bool        fromHost = false;
+    std::string kind;           // "info", "ack", "nack", "error", "checksum", "timeout", "io"
+    uint8_t     code     = 0;   // PN532 command / response code (info frames)
+    int16_t     desfire  = -1;  // DESFire command (host) or status (card) byte, -1 when none
+    uint16_t    length   = 0;   // TFI + PD bytes of the frame
+    uint16_t    repeat   = 1;   // consecutive timeouts folded into this entry
+    bool        redacted = false;
+    std::vector<uint8_t> bytes; // leading TFI + PD bytes; header only when redacted
+};
+
+// Protocol context of the most recent failed operation.
+struct FailureReport {
+    bool        available = false;
+    std::string operation;    // e.g. "readCardSecret"
+    std::string code;         // NfcError code
+    std::string message;
+    uint32_t    ageMs = 0;    // time since the failure
+    std::vector<RecordedFrame> frames; // oldest first
+};
+
 class INfcReader {
 public:
     virtual ~INfcReader() = default;
@@ -91,8 +204,10 @@ public:
     // session — avoids the double-detection timeout.
     virtual Result<CardProbeResult> probeCard() = 0;
 
-    // Full 11-step secure init sequence — see Pn532Adapter.cc for details.
-    virtual Result<bool> initCard(const CardInitOptions& opts) = 0;
+    // Resumable secure init — see Pn532Adapter.cc for the step sequence.
+    // Safe to call again on a partially provisioned card; fails with the
+    // authentication error if the card was provisioned with other keys.
+    virtual Result<CardInitReport> initCard(const CardInitOptions& opts) = 0;
 
     // Authenticates with readKey (key 1) and returns the 16-byte card_secret
     // from File 00 bytes 0-15.
@@ -107,6 +222,47 @@ public:
 
     // Returns the list of 3-byte AIDs currently on the PICC.
     virtual Result<std::vector<std::array<uint8_t, 3>>> getCardApplicationIds() = 0;
+
+    // --- Reader power management ---
+
+    // Stores the policy; it also applies to later connections. Does not
+    // require a connected reader.
+    virtual Result<bool> setPowerPolicy(const ReaderPowerPolicy& policy) = 0;
+
+    virtual Result<ReaderPowerStatus> getPowerStatus() = 0;
+
+    // Pre-wakes the reader ahead of expected activity (lock screen shown,
+    // bridge request received): leaves PowerDown, raises the RF field and
+    // restarts the idle timer.
+    virtual Result<bool> wakeReader() = 0;
+
+    // Interrupts the serial wait of the operation in flight, from any
+    // thread; it returns CANCELLED (or IO_TIMEOUT from inside NfcCpp)
+    // instead of running out its timeout. No effect when idle: the next
+    // operation starts with the request cleared.
+    virtual void cancelPendingIo() = 0;
+
+    // --- Diagnostics ---
+
+    // Returns cached values only — never touches the reader, never waits
+    // behind an in-flight operation.
+    virtual Result<ReaderHealthSnapshot> getReaderHealth() = 0;
+
+    // Starts or stops span recording: operation, DESFire command, PN532
+    // frame and serial call. Off by default. Callable from any thread.
+    virtual Result<bool> setTracing(bool enabled) = 0;
+
+    // Recorded spans as Chrome trace_event JSON, for Perfetto or
+    // chrome://tracing. `clear` empties the buffers afterwards.
+    virtual Result<std::string> exportTrace(bool clear) = 0;
+
+    // Snapshots the recent PN532 traffic for an operation that returned
+    // `error`. NfcService calls this on every failure; the reader decides
+    // which failures are worth keeping. Must not block on the reader.
+    virtual void captureFailureReport(const std::string& operation, const NfcError& error) = 0;
+
+    // The last captured report; available = false when there is none.
+    virtual Result<FailureReport> getLastFailureReport() = 0;
 };
 
 } // namespace ports
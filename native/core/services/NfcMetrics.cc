@@ -0,0 +1,193 @@
+#include "NfcMetrics.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace core {
+namespace services {
+
+namespace {
+
+static const char* const kOperationNames[] = {
+    "connect",
+    "disconnect",
+    "getFirmwareVersion",
+    "runSelfTests",
+    "getCardVersion",
+    "peekCardUid",
+    "isCardInitialised",
+    "probeCard",
+    "initCard",
+    "readCardSecret",
+    "cardFreeMemory",
+    "formatCard",
+    "getCardApplicationIds",
+    "setPowerPolicy",
+    "getPowerStatus",
+    "wakeReader",
+    "getReaderHealth",
+};
+static_assert(sizeof(kOperationNames) / sizeof(kOperationNames[0]) == static_cast<size_t>(NfcOperation::Count),
+              "one name per NfcOperation");
+
+// FNV-1a, forced non-zero so 0 can mark a free slot
+static uint64_t codeKey(const std::string& code) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned char c : code) {
+        h ^= c;
+        h *= 0x100000001b3ull;
+    }
+    return h | 1;
+}
+
+static uint64_t take(std::atomic<uint64_t>& counter, bool reset) {
+    return reset ? counter.exchange(0, std::memory_order_relaxed) : counter.load(std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+const char* operationName(NfcOperation op) {
+    const auto i = static_cast<size_t>(op);
+    return i < static_cast<size_t>(NfcOperation::Count) ? kOperationNames[i] : "unknown";
+}
+
+// ─── LatencyHistogram ─────────────────────────────────────────────────────────
+
+size_t LatencyHistogram::bucketIndex(uint64_t us) {
+    if (us < kSubBuckets) return static_cast<size_t>(us);
+    const unsigned exponent = std::min<unsigned>(63 - std::countl_zero(us), kMaxExponent);
+    if (exponent == kMaxExponent && us >> (kMaxExponent + 1)) return kBucketCount - 1;
+    const unsigned shift = exponent - kSubBucketBits;
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + static_cast<size_t>((us >> shift) - kSubBuckets);
+}
+
+uint64_t LatencyHistogram::bucketLow(size_t index) {
+    if (index < kSubBuckets) return index;
+    const unsigned shift = static_cast<unsigned>(index / kSubBuckets) - 1;
+    return (static_cast<uint64_t>(index % kSubBuckets) + kSubBuckets) << shift;
+}
+
+uint64_t LatencyHistogram::bucketHigh(size_t index) {
+    if (index < kSubBuckets) return index;
+    const unsigned shift = static_cast<unsigned>(index / kSubBuckets) - 1;
+    return bucketLow(index) + (uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t us) {
+    _buckets[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    _sumUs.fetch_add(us, std::memory_order_relaxed);
+    uint64_t seen = _maxUs.load(std::memory_order_relaxed);
+    while (us > seen && !_maxUs.compare_exchange_weak(seen, us, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::collect(Counts& counts, uint64_t& maxUs, uint64_t& sumUs, bool reset) {
+    for (size_t i = 0; i < kBucketCount; ++i) counts[i] = take(_buckets[i], reset);
+    sumUs = take(_sumUs, reset);
+    maxUs = take(_maxUs, reset);
+}
+
+// ─── NfcMetrics ───────────────────────────────────────────────────────────────
+
+NfcMetrics::NfcMetrics(std::chrono::steady_clock::time_point now)
+    : _windowStart(now.time_since_epoch().count()) {}
+
+void NfcMetrics::record(NfcOperation op, std::chrono::nanoseconds elapsed, const ports::NfcError* error) {
+    Operation& o = _ops[static_cast<size_t>(op)];
+    o.calls.fetch_add(1, std::memory_order_relaxed);
+    if (error) {
+        recordError(o, error->code);
+    } else {
+        o.ok.fetch_add(1, std::memory_order_relaxed);
+    }
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    o.latency.record(us > 0 ? static_cast<uint64_t>(us) : 0);
+}
+
+void NfcMetrics::recordError(Operation& op, const std::string& code) {
+    const uint64_t key = codeKey(code);
+    for (ErrorSlot& slot : op.errors) {
+        uint64_t seen = slot.key.load(std::memory_order_acquire);
+        if (seen == 0) {
+            if (slot.key.compare_exchange_strong(seen, key, std::memory_order_acq_rel)) {
+                const size_t len = std::min(code.size(), kErrorNameMax - 1);
+                std::memcpy(slot.name, code.data(), len);
+                slot.name[len] = '\0';
+                slot.named.store(true, std::memory_order_release);
+                slot.count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            // Lost the race; `seen` now holds the winner's key
+        }
+        if (seen == key) {
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    op.otherErrors.fetch_add(1, std::memory_order_relaxed);
+}
+
+NfcMetricsSnapshot NfcMetrics::snapshot(std::chrono::steady_clock::time_point now, bool reset) {
+    NfcMetricsSnapshot out;
+    const auto nowTicks = now.time_since_epoch().count();
+    const auto startTicks = reset ? _windowStart.exchange(nowTicks) : _windowStart.load();
+    const auto window = std::chrono::steady_clock::duration(std::max<std::chrono::steady_clock::rep>(nowTicks - startTicks, 0));
+    out.windowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(window).count());
+
+    LatencyHistogram::Counts counts;
+    for (size_t i = 0; i < _ops.size(); ++i) {
+        Operation& o = _ops[i];
+        uint64_t maxUs = 0;
+        uint64_t sumUs = 0;
+        o.latency.collect(counts, maxUs, sumUs, reset);
+
+        OperationMetricsSnapshot s;
+        s.name = kOperationNames[i];
+        s.calls = take(o.calls, reset);
+        s.ok = take(o.ok, reset);
+
+        uint64_t other = take(o.otherErrors, reset);
+        for (ErrorSlot& slot : o.errors) {
+            const uint64_t n = take(slot.count, reset);
+            if (n == 0) continue;
+            // A slot claimed but not yet named is a call still recording
+            if (slot.named.load(std::memory_order_acquire)) {
+                s.errors.emplace_back(slot.name, n);
+            } else {
+                other += n;
+            }
+        }
+        if (other) s.errors.emplace_back("OTHER", other);
+
+        uint64_t total = 0;
+        for (size_t b = 0; b < counts.size(); ++b) {
+            if (counts[b] == 0) continue;
+            total += counts[b];
+            s.buckets.emplace_back(LatencyHistogram::bucketLow(b), counts[b]);
+        }
+        if (s.calls == 0 && total == 0) continue;
+
+        if (total) {
+            s.meanUs = static_cast<double>(sumUs) / static_cast<double>(total);
+            s.maxUs = maxUs;
+            auto percentile = [&](double q) {
+                const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+                uint64_t seen = 0;
+                for (size_t b = 0; b < counts.size(); ++b) {
+                    seen += counts[b];
+                    if (seen >= rank) return std::min(LatencyHistogram::bucketHigh(b), maxUs);
+                }
+                return maxUs;
+            };
+            s.p50Us = percentile(0.50);
+            s.p90Us = percentile(0.90);
+            s.p99Us = percentile(0.99);
+            s.p999Us = percentile(0.999);
+        }
+        out.operations.push_back(std::move(s));
+    }
+    return out;
+}
+
+} // namespace services
+} // namespace core
@@ -0,0 +1,141 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../ports/INfcReader.h"
+
+namespace core {
+namespace services {
+
+// INfcReader operations timed by NfcService. Names (operationName) match
+// the JS binding methods.
+enum class NfcOperation : uint8_t {
+    Connect,
+    Disconnect,
+    GetFirmwareVersion,
+    RunSelfTests,
+    GetCardVersion,
+    PeekCardUid,
+    IsCardInitialised,
+    ProbeCard,
+    InitCard,
+    ReadCardSecret,
+    CardFreeMemory,
+    FormatCard,
+    GetCardApplicationIds,
+    SetPowerPolicy,
+    GetPowerStatus,
+    WakeReader,
+    GetReaderHealth,
+    Count
+};
+
+const char* operationName(NfcOperation op);
+
+struct OperationMetricsSnapshot {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t ok = 0;
+    std::vector<std::pair<std::string, uint64_t>> errors; // NfcError code -> count
+
+    // Microseconds. Percentiles are bucket upper bounds (capped at max), so
+    // they overstate by at most one bucket width: 1/16 of the power of two.
+    double   meanUs = 0;
+    uint64_t p50Us = 0;
+    uint64_t p90Us = 0;
+    uint64_t p99Us = 0;
+    uint64_t p999Us = 0;
+    uint64_t maxUs = 0;
+
+    // Non-empty buckets as {lower bound µs, count}, for merging snapshots
+    // from several machines before taking percentiles.
+    std::vector<std::pair<uint64_t, uint64_t>> buckets;
+};
+
+struct NfcMetricsSnapshot {
+    uint64_t windowMs = 0; // since construction or the last reset
+    std::vector<OperationMetricsSnapshot> operations; // called at least once
+};
+
+/**
+ * Log-linear latency histogram (HDR-style): exact below 16 µs, then 16
+ * sub-buckets per power of two up to 2^36 µs (about 19 hours; longer
+ * values land in the last bucket). record() is a handful of relaxed atomic
+ * adds, no locks and no allocation.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr unsigned kSubBuckets = 1u << kSubBucketBits;
+    static constexpr unsigned kMaxExponent = 35;
+    static constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+    using Counts = std::array<uint64_t, kBucketCount>;
+
+    void record(uint64_t us);
+
+    // Copies the bucket counts and the maximum, zeroing them when `reset`.
+    void collect(Counts& counts, uint64_t& maxUs, uint64_t& sumUs, bool reset);
+
+    static size_t   bucketIndex(uint64_t us);
+    static uint64_t bucketLow(size_t index);
+    static uint64_t bucketHigh(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> _buckets{};
+    std::atomic<uint64_t> _sumUs{0};
+    std::atomic<uint64_t> _maxUs{0};
+};
+
+/**
+ * Per-operation latency histograms and success / error-code counters.
+ *
+ * record() may run on any number of threads at once and never blocks.
+ * Error codes are counted in a small fixed table per operation, claimed
+ * lock-free the first time a code is seen; codes beyond its capacity are
+ * counted as "OTHER".
+ *
+ * A snapshot taken while calls are completing may include a call in some
+ * counters and not yet in others. With `reset` each counter is swapped to
+ * zero, so every call is counted in exactly one snapshot.
+ */
+class NfcMetrics {
+public:
+    explicit NfcMetrics(std::chrono::steady_clock::time_point now);
+
+    void record(NfcOperation op, std::chrono::nanoseconds elapsed, const ports::NfcError* error);
+
+    NfcMetricsSnapshot snapshot(std::chrono::steady_clock::time_point now, bool reset);
+
+private:
+    static constexpr size_t kErrorSlots = 8;
+    static constexpr size_t kErrorNameMax = 32;
+
+    struct ErrorSlot {
+        std::atomic<uint64_t> key{0}; // hash of the code; 0 = free
+        std::atomic<bool> named{false};
+        char name[kErrorNameMax] = {};
+        std::atomic<uint64_t> count{0};
+    };
+
+    struct Operation {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> ok{0};
+        std::array<ErrorSlot, kErrorSlots> errors;
+        std::atomic<uint64_t> otherErrors{0};
+        LatencyHistogram latency;
+    };
+
+    void recordError(Operation& op, const std::string& code);
+
+    std::array<Operation, static_cast<size_t>(NfcOperation::Count)> _ops;
+    std::atomic<std::chrono::steady_clock::rep> _windowStart;
+};
+
+} // namespace services
+} // namespace core
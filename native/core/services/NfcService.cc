@@ -3,42 +3,45 @@
 namespace core {
 namespace services {
 
-NfcService::NfcService(std::unique_ptr<ports::INfcReader> reader)
-    : _reader(std::move(reader)) {}
+NfcService::NfcService(std::unique_ptr<ports::INfcReader> reader, std::shared_ptr<ports::IClock> clock)
+    : _reader(std::move(reader)),
+      _clock(std::move(clock)),
+      _metrics(now()) {}
+
+ports::IClock::TimePoint NfcService::now() const {
+    return _clock ? _clock->now() : std::chrono::steady_clock::now();
+}
+
+template <typename T, typename Call>
+ports::Result<T> NfcService::measured(NfcOperation op, Call&& call) {
+    const auto start = now();
+    ports::Result<T> result = _reader
+        ? call()
+        : ports::Result<T>(ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"});
+    const ports::NfcError* error = std::get_if<ports::NfcError>(&result);
+    _metrics.record(op, now() - start, error);
+    if (error && _reader) _reader->captureFailureReport(operationName(op), *error);
+    return result;
+}
 
 ports::Result<std::string> NfcService::connect(const std::string& port) {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->connect(port);
+    return measured<std::string>(NfcOperation::Connect, [&] { return _reader->connect(port); });
 }
 
 ports::Result<bool> NfcService::disconnect() {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->disconnect();
+    return measured<bool>(NfcOperation::Disconnect, [&] { return _reader->disconnect(); });
 }
 
 ports::Result<std::string> NfcService::getFirmwareVersion() {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->getFirmwareVersion();
+    return measured<std::string>(NfcOperation::GetFirmwareVersion, [&] { return _reader->getFirmwareVersion(); });
 }
 
 ports::Result<ports::SelfTestReport> NfcService::runSelfTests(ports::SelfTestProgressCb onResult) {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->runSelfTests(std::move(onResult));
+    return measured<ports::SelfTestReport>(NfcOperation::RunSelfTests, [&] { return _reader->runSelfTests(std::move(onResult)); });
 }
 
 ports::Result<ports::CardVersionInfo> NfcService::getCardVersion() {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->getCardVersion();
+    return measured<ports::CardVersionInfo>(NfcOperation::GetCardVersion, [&] { return _reader->getCardVersion(); });
 }
 
 void NfcService::setLogCallback(ports::NfcLogCallback callback) {
@@ -48,60 +51,82 @@ void NfcService::setLogCallback(ports::NfcLogCallback callback) {
 }
 
 ports::Result<std::vector<uint8_t>> NfcService::peekCardUid() {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->peekCardUid();
+    return measured<std::vector<uint8_t>>(NfcOperation::PeekCardUid, [&] { return _reader->peekCardUid(); });
 }
 
 ports::Result<bool> NfcService::isCardInitialised() {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->isCardInitialised();
+    return measured<bool>(NfcOperation::IsCardInitialised, [&] { return _reader->isCardInitialised(); });
 }
 
 ports::Result<ports::CardProbeResult> NfcService::probeCard() {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->probeCard();
+    return measured<ports::CardProbeResult>(NfcOperation::ProbeCard, [&] { return _reader->probeCard(); });
 }
 
-ports::Result<bool> NfcService::initCard(const ports::CardInitOptions& opts) {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->initCard(opts);
+ports::Result<ports::CardInitReport> NfcService::initCard(const ports::CardInitOptions& opts) {
+    return measured<ports::CardInitReport>(NfcOperation::InitCard, [&] { return _reader->initCard(opts); });
 }
 
 ports::Result<std::vector<uint8_t>> NfcService::readCardSecret(
     const std::array<uint8_t, 16>& readKey) {
-    if (!_reader) {
-        return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
-    }
-    return _reader->readCardSecret(readKey);
+    return measured<std::vector<uint8_t>>(NfcOperation::ReadCardSecret, [&] { return _reader->readCardSecret(readKey); });
 }
 
 ports::Result<uint32_t> NfcService::cardFreeMemory() {
+    return measured<uint32_t>(NfcOperation::CardFreeMemory, [&] { return _reader->cardFreeMemory(); });
+}
+
+ports::Result<bool> NfcService::formatCard() {
+    return measured<bool>(NfcOperation::FormatCard, [&] { return _reader->formatCard(); });
+}
+
+ports::Result<std::vector<std::array<uint8_t, 3>>> NfcService::getCardApplicationIds() {
+    return measured<std::vector<std::array<uint8_t, 3>>>(NfcOperation::GetCardApplicationIds, [&] { return _reader->getCardApplicationIds(); });
+}
+
+ports::Result<bool> NfcService::setPowerPolicy(const ports::ReaderPowerPolicy& policy) {
+    return measured<bool>(NfcOperation::SetPowerPolicy, [&] { return _reader->setPowerPolicy(policy); });
+}
+
+ports::Result<ports::ReaderPowerStatus> NfcService::getPowerStatus() {
+    return measured<ports::ReaderPowerStatus>(NfcOperation::GetPowerStatus, [&] { return _reader->getPowerStatus(); });
+}
+
+ports::Result<bool> NfcService::wakeReader() {
+    return measured<bool>(NfcOperation::WakeReader, [&] { return _reader->wakeReader(); });
+}
+
+void NfcService::cancelPendingIo() {
+    if (_reader) _reader->cancelPendingIo();
+}
+
+ports::Result<ports::ReaderHealthSnapshot> NfcService::getReaderHealth() {
+    return measured<ports::ReaderHealthSnapshot>(NfcOperation::GetReaderHealth, [&] { return _reader->getReaderHealth(); });
+}
+
+// Tracing controls are not timed: they are diagnostics of the diagnostics.
+ports::Result<bool> NfcService::setTracing(bool enabled) {
     if (!_reader) {
         return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
     }
-    return _reader->cardFreeMemory();
+    return _reader->setTracing(enabled);
 }
 
-ports::Result<bool> NfcService::formatCard() {
+ports::Result<std::string> NfcService::exportTrace(bool clear) {
     if (!_reader) {
         return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
     }
-    return _reader->formatCard();
+    return _reader->exportTrace(clear);
 }
 
-ports::Result<std::vector<std::array<uint8_t, 3>>> NfcService::getCardApplicationIds() {
+ports::Result<ports::FailureReport> NfcService::getLastFailureReport() {
     if (!_reader) {
         return ports::NfcError{"NOT_CONNECTED", "NFC Reader is not initialized"};
     }
-    return _reader->getCardApplicationIds();
+    return _reader->getLastFailureReport();
+}
+
+NfcMetricsSnapshot NfcService::getMetrics(bool reset) {
+    return _metrics.snapshot(now(), reset);
 }
 
 } // namespace services
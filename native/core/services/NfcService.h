@@ -1,14 +1,20 @@
 #pragma once
 #include <string>
 #include <memory>
+#include "../ports/IClock.h"
 #include "../ports/INfcReader.h"
+#include "NfcMetrics.h"
 
 namespace core {
 namespace services {
 
+// Forwards to the reader and records each call's latency and outcome in
+// NfcMetrics (see docs/nfc-metrics.md).
 class NfcService {
 public:
-    explicit NfcService(std::unique_ptr<ports::INfcReader> reader);
+    // Latencies are measured on `clock`; null selects the steady clock.
+    explicit NfcService(std::unique_ptr<ports::INfcReader> reader,
+                        std::shared_ptr<ports::IClock> clock = nullptr);
     ports::Result<std::string>           connect(const std::string& port);
     ports::Result<bool>                  disconnect();
     ports::Result<std::string>           getFirmwareVersion();
@@ -20,14 +26,39 @@ public:
     ports::Result<std::vector<uint8_t>>                    peekCardUid();
     ports::Result<bool>                                    isCardInitialised();
     ports::Result<ports::CardProbeResult>                  probeCard();
-    ports::Result<bool>                                    initCard(const ports::CardInitOptions& opts);
+    ports::Result<ports::CardInitReport>                   initCard(const ports::CardInitOptions& opts);
     ports::Result<std::vector<uint8_t>>                    readCardSecret(const std::array<uint8_t, 16>& readKey);
     ports::Result<uint32_t>                                cardFreeMemory();
     ports::Result<bool>                                    formatCard();
     ports::Result<std::vector<std::array<uint8_t, 3>>>     getCardApplicationIds();
 
+    // Reader power management
+    ports::Result<bool>                                    setPowerPolicy(const ports::ReaderPowerPolicy& policy);
+    ports::Result<ports::ReaderPowerStatus>                getPowerStatus();
+    ports::Result<bool>                                    wakeReader();
+    void                                                   cancelPendingIo();
+
+    // Diagnostics
+    ports::Result<ports::ReaderHealthSnapshot>             getReaderHealth();
+    ports::Result<bool>                                    setTracing(bool enabled);
+    ports::Result<std::string>                             exportTrace(bool clear);
+    // Recent PN532 frames of the last failed operation (flight recorder)
+    ports::Result<ports::FailureReport>                    getLastFailureReport();
+
+    // Per-operation latency and outcome counters; `reset` starts a new window.
+    NfcMetricsSnapshot                                     getMetrics(bool reset = false);
+
 private:
+    ports::IClock::TimePoint now() const;
+
+    // Calls `call` when a reader is present, records the outcome and hands
+    // failures to the reader's flight recorder.
+    template <typename T, typename Call>
+    ports::Result<T> measured(NfcOperation op, Call&& call);
+
     std::unique_ptr<ports::INfcReader> _reader;
+    std::shared_ptr<ports::IClock> _clock;
+    NfcMetrics _metrics;
 };
 
 } // namespace services
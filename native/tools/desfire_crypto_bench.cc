@@ -0,0 +1,178 @@
+// Host-side DESFire crypto cost per card flow, portable vs AES-NI.
+//
+//   cmake -S . -B build -DSECUREPASS_BUILD_BENCHMARKS=ON
+//   cmake --build build --target desfire_crypto_bench
+//   ./build/desfire_crypto_bench [iterations]
+//
+// readCardSecret runs the real DesfireAesSession (EV1 AuthenticateAES or
+// EV2First, then enciphered ReadData) against sim::DesfireCardModel;
+// initCardVerified adds the key-0 re-auth of initCard on an already
+// provisioned card (NonFirst on EV2). The card's own crypto time is
+// measured separately and subtracted so only host work is reported.
+// initCard replays the host crypto of the provisioning flow (two AES
+// authentications, two ChangeKey cryptograms, an enciphered 32-byte write,
+// CMACed commit and the resume check read) on the same providers.
+#include "adapters/crypto/CryptoProviderFactory.h"
+#include "adapters/hardware/DesfireAesSession.h"
+#include "sim/DesfireCardModel.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using adapters::hardware::DesfireAesSession;
+using adapters::hardware::desfireCrc32;
+using core::ports::IAesKey;
+using core::ports::ICryptoProvider;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Deterministic byte source so runs are comparable
+struct Xorshift {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    void fill(uint8_t* out, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            out[i] = static_cast<uint8_t>(state);
+        }
+    }
+};
+
+struct Sample {
+    double meanUs = 0;
+    double minUs = 0;
+};
+
+template <typename Fn>
+static Sample measure(int iterations, Fn&& fn) {
+    double total = 0;
+    double best = 1e30;
+    for (int i = 0; i < iterations; ++i) {
+        const double us = fn();
+        total += us;
+        if (us < best) best = us;
+    }
+    return {total / iterations, best};
+}
+
+// readCardSecret: authenticate key 1, enciphered 16-byte read. With
+// `reauthKey0` the flow continues like initCard's resume check on a fully
+// provisioned card: a second authentication on key 0 in the same session
+// (NonFirst on EV2).
+static double sessionFlowUs(const std::shared_ptr<const ICryptoProvider>& crypto, Xorshift& rng,
+                            bool ev2, bool reauthKey0) {
+    std::array<std::array<uint8_t, 16>, 2> keys{};
+    std::array<uint8_t, 32> file{};
+    for (auto& k : keys) rng.fill(k.data(), k.size());
+    rng.fill(file.data(), 16);
+    sim::DesfireCardModel card(keys, file, ev2);
+
+    const auto t0 = Clock::now();
+    DesfireAesSession session(crypto,
+        [&card](const std::vector<uint8_t>& f) { return card.transceive(f); },
+        [&rng](uint8_t* out, size_t len) { rng.fill(out, len); },
+        ev2);
+    auto auth = session.authenticate(1, keys[1]);
+    auto data = session.readDataEnciphered(0, 0, 16);
+    core::ports::Result<bool> reauth = true;
+    if (reauthKey0) reauth = session.authenticate(0, keys[0]);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+    const bool schemeOk = session.scheme() == (ev2 ? DesfireAesSession::Scheme::Ev2 : DesfireAesSession::Scheme::Ev1);
+    if (std::holds_alternative<core::ports::NfcError>(auth) ||
+        std::holds_alternative<core::ports::NfcError>(data) ||
+        std::holds_alternative<core::ports::NfcError>(reauth) || !schemeOk ||
+        std::memcmp(std::get<std::vector<uint8_t>>(data).data(), file.data(), 16) != 0) {
+        std::fprintf(stderr, "session round trip failed on %s (%s)\n", crypto->name(), ev2 ? "ev2" : "ev1");
+        std::exit(1);
+    }
+    return static_cast<double>(static_cast<uint64_t>(ns) - card.cardNs) / 1000.0;
+}
+
+// Host crypto of one initCard run, operation for operation.
+static double initCardUs(const std::shared_ptr<const ICryptoProvider>& crypto, Xorshift& rng) {
+    uint8_t keys[4][16];
+    uint8_t blocks[64];
+    uint8_t iv[16] = {};
+    for (auto& k : keys) rng.fill(k, 16);
+    rng.fill(blocks, sizeof(blocks));
+
+    const auto t0 = Clock::now();
+    auto authenticate = [&](const uint8_t* staticKey) {
+        auto k = crypto->createAesKey(staticKey, 16);
+        uint8_t tmp[32];
+        std::memset(iv, 0, 16);
+        k->decryptCbc(iv, blocks, tmp, 16);
+        k->encryptCbc(iv, blocks, tmp, 32);
+        k->decryptCbc(iv, blocks, tmp, 16);
+        auto s = crypto->createAesKey(tmp, 16);
+        std::memset(iv, 0, 16);
+        return s;
+    };
+    // ChangeKey: CRC over cmd + cryptogram, encrypt 32 bytes
+    auto changeKey = [&](IAesKey& s, const uint8_t* newKey) {
+        uint8_t c[32] = {};
+        std::memcpy(c, newKey, 16);
+        const uint32_t crc = desfireCrc32(c, 18);
+        std::memcpy(c + 18, &crc, 4);
+        s.encryptCbc(iv, c, c, 32);
+    };
+
+    // Resume check: key-1 auth + enciphered 16-byte read
+    {
+        auto s = authenticate(keys[1]);
+        uint8_t tmp[32];
+        s->cmac(iv, blocks, 8, iv);
+        s->decryptCbc(iv, blocks, tmp, 32);
+        (void)desfireCrc32(tmp, 17);
+    }
+    // Key-0 auth, ChangeKey 1, write 32 B enciphered, commit, ChangeKey 0
+    auto s = authenticate(keys[0]);
+    changeKey(*s, keys[2]);
+    {
+        uint8_t w[48] = {};
+        std::memcpy(w, blocks, 32);
+        const uint32_t crc = desfireCrc32(w, 32 + 8);
+        std::memcpy(w + 32, &crc, 4);
+        s->encryptCbc(iv, w, w, 48);
+    }
+    s->cmac(iv, blocks, 1, iv);
+    changeKey(*s, keys[3]);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+    return static_cast<double>(ns) / 1000.0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const std::shared_ptr<const ICryptoProvider> backends[] = {
+        adapters::crypto::createCryptoProvider(adapters::crypto::CryptoBackend::Portable),
+        adapters::crypto::createCryptoProvider(adapters::crypto::CryptoBackend::AesNi),
+    };
+    if (std::strcmp(backends[1]->name(), "aes-ni") != 0) {
+        std::printf("note: CPU has no AES-NI, both rows use the portable provider\n");
+    }
+
+    std::printf("%-22s %-10s %12s %12s\n", "flow", "backend", "mean_us", "min_us");
+    for (const auto& crypto : backends) {
+        Xorshift rng;
+        const Sample read1 = measure(iterations, [&] { return sessionFlowUs(crypto, rng, false, false); });
+        const Sample read2 = measure(iterations, [&] { return sessionFlowUs(crypto, rng, true, false); });
+        const Sample check1 = measure(iterations, [&] { return sessionFlowUs(crypto, rng, false, true); });
+        const Sample check2 = measure(iterations, [&] { return sessionFlowUs(crypto, rng, true, true); });
+        const Sample init = measure(iterations, [&] { return initCardUs(crypto, rng); });
+        std::printf("%-22s %-10s %12.2f %12.2f\n", "readCardSecret/ev1", crypto->name(), read1.meanUs, read1.minUs);
+        std::printf("%-22s %-10s %12.2f %12.2f\n", "readCardSecret/ev2", crypto->name(), read2.meanUs, read2.minUs);
+        std::printf("%-22s %-10s %12.2f %12.2f\n", "initCardVerified/ev1", crypto->name(), check1.meanUs, check1.minUs);
+        std::printf("%-22s %-10s %12.2f %12.2f\n", "initCardVerified/ev2", crypto->name(), check2.meanUs, check2.minUs);
+        std::printf("%-22s %-10s %12.2f %12.2f\n", "initCard", crypto->name(), init.meanUs, init.minUs);
+    }
+    return 0;
+}
@@ -0,0 +1,368 @@
+// NfcService operation benchmark over a real reader, the simulator or a
+// replayed capture; results as JSON.
+//
+//   cmake -S . -B build -DSECUREPASS_BUILD_BENCHMARKS=ON
+//   cmake --build build --target nfc_bench
+//   ./build/nfc_bench [--reader sim|port:<tty>|replay:<capture>] [--iterations N]
+//                     [--virtual] [--record <capture>] [--destructive]
+//                     [--master-key <hex>] [--read-key <hex>] [--out <file>]
+//                     [--trace <file>]
+//
+// Readers:
+//   sim             sim::SimulatedPn532Bus with a provisioned vault card (default)
+//   port:<tty>      the platform serial backend, i.e. a real PN532
+//   replay:<file>   a capture recorded with --record, played back with its
+//                   original timing; run it with the same flags as the
+//                   recording so the command sequence lines up
+//
+// The service runs on a stock Pn532Adapter; only the serial bus under it
+// changes. Operations, each `iterations` times in this order: connect
+// (after a disconnect), probeCard, peekCardUid, readCardSecret,
+// cardFreeMemory, getCardApplicationIds, initCard, formatCard.
+//
+// initCard runs its resume path: on a provisioned card it inspects, reads
+// the secret and re-authenticates key 0 without writing. Against a real
+// card it is skipped unless the card is already provisioned with the given
+// keys. --destructive instead runs formatCard + full initCard per
+// iteration, which erases the card; the simulator does not model
+// FormatPICC (legacy ISO authentication), so there formatCard is skipped.
+//
+// --virtual (sim and replay) runs every timeout and replayed delay on a
+// VirtualClock and charges 115200-baud wire time, so latencies are
+// simulated and the run costs almost no wall time.
+//
+// allocsPerOp counts every operator new in the process during the call,
+// including the adapter's idle thread if it wakes meanwhile.
+//
+// --trace writes the adapter's spans as Chrome trace JSON (open it in
+// Perfetto). Tracing adds its own time and, once per thread, a ring buffer
+// allocation, so compare traced runs only with traced runs.
+#include "adapters/hardware/Pn532Adapter.h"
+#include "adapters/hardware/SerialBusPlatform.h"
+#include "adapters/timing/SteadyClock.h"
+#include "adapters/timing/VirtualClock.h"
+#include "core/services/NfcService.h"
+#include "sim/DesfireCardModel.h"
+#include "sim/SerialCapture.h"
+#include "sim/SimulatedPn532Bus.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+using core::ports::IClock;
+using core::services::NfcService;
+
+// Counts every heap allocation in the process
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Simulator card keys; also the defaults for --master-key / --read-key
+const std::array<std::array<uint8_t, 16>, 2> SIM_KEYS = {{
+    {0x10, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87, 0x98, 0xA9, 0xBA, 0xCB, 0xDC, 0xED, 0xFE, 0x0F},
+    {0x5E, 0xC2, 0x37, 0x1B, 0x8A, 0x44, 0x90, 0x6D, 0xF1, 0x0C, 0x29, 0xB7, 0x73, 0xE8, 0x5A, 0xD6},
+}};
+
+struct Options {
+    std::string reader = "sim";
+    std::string record;
+    std::string out;
+    std::string trace;
+    int iterations = 50;
+    bool virtualTime = false;
+    bool destructive = false;
+    std::array<uint8_t, 16> masterKey = SIM_KEYS[0];
+    std::array<uint8_t, 16> readKey = SIM_KEYS[1];
+};
+
+bool parseKey(const char* hex, std::array<uint8_t, 16>& key) {
+    if (std::strlen(hex) != 32) return false;
+    for (size_t i = 0; i < 16; ++i) {
+        unsigned int byte = 0;
+        if (std::sscanf(hex + 2 * i, "%2x", &byte) != 1) return false;
+        key[i] = static_cast<uint8_t>(byte);
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--virtual") {
+            o.virtualTime = true;
+        } else if (arg == "--destructive") {
+            o.destructive = true;
+        } else if (arg == "--reader" && hasValue) {
+            o.reader = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            o.record = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            o.out = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            o.trace = argv[++i];
+        } else if (arg == "--iterations" && hasValue) {
+            o.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--master-key" && hasValue) {
+            if (!parseKey(argv[++i], o.masterKey)) return false;
+        } else if (arg == "--read-key" && hasValue) {
+            if (!parseKey(argv[++i], o.readKey)) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Error code of a failed call, nothing on success
+using Outcome = std::optional<std::string>;
+
+template <typename T>
+Outcome outcomeOf(const core::ports::Result<T>& r) {
+    if (const auto* err = std::get_if<core::ports::NfcError>(&r)) return err->code;
+    return std::nullopt;
+}
+
+struct OpStats {
+    std::string name;
+    std::vector<double> us;
+    uint64_t allocations = 0;
+    int ok = 0;
+    std::map<std::string, int> errors;
+    std::string skipped; // reason, when the operation did not run
+
+    double percentile(double p) const {
+        if (us.empty()) return 0;
+        std::vector<double> sorted = us;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+};
+
+// Times one call and files its outcome under `stats`.
+void timeCall(const IClock& clock, OpStats& stats, const std::function<Outcome()>& fn) {
+    const uint64_t allocBefore = g_allocations.load(std::memory_order_relaxed);
+    const auto start = clock.now();
+    const Outcome outcome = fn();
+    stats.us.push_back(std::chrono::duration<double, std::micro>(clock.now() - start).count());
+    stats.allocations += g_allocations.load(std::memory_order_relaxed) - allocBefore;
+    if (outcome) {
+        ++stats.errors[*outcome];
+    } else {
+        ++stats.ok;
+    }
+}
+
+void printJson(std::FILE* out, const Options& o, const std::string& clockName, uint64_t divergences,
+               const std::deque<OpStats>& ops) {
+    std::fprintf(out, "{\n  \"reader\": \"%s\",\n  \"clock\": \"%s\",\n  \"iterations\": %d,\n",
+                 o.reader.c_str(), clockName.c_str(), o.iterations);
+    if (o.reader.rfind("replay:", 0) == 0) {
+        std::fprintf(out, "  \"replayDivergences\": %llu,\n", static_cast<unsigned long long>(divergences));
+    }
+    std::fprintf(out, "  \"operations\": [\n");
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const OpStats& s = ops[i];
+        std::fprintf(out, "    {\"name\": \"%s\"", s.name.c_str());
+        if (!s.skipped.empty()) {
+            std::fprintf(out, ", \"skipped\": \"%s\"}", s.skipped.c_str());
+        } else {
+            double totalUs = 0;
+            for (double v : s.us) totalUs += v;
+            const double runs = static_cast<double>(s.us.size());
+            std::fprintf(out,
+                         ", \"runs\": %zu, \"ok\": %d, \"opsPerSec\": %.2f,"
+                         " \"latencyUs\": {\"mean\": %.1f, \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f},"
+                         " \"allocsPerOp\": %.1f, \"errors\": {",
+                         s.us.size(), s.ok, totalUs > 0 ? runs * 1e6 / totalUs : 0.0,
+                         runs > 0 ? totalUs / runs : 0.0, s.percentile(50), s.percentile(90), s.percentile(99),
+                         s.percentile(100), runs > 0 ? static_cast<double>(s.allocations) / runs : 0.0);
+            bool first = true;
+            for (const auto& [code, count] : s.errors) {
+                std::fprintf(out, "%s\"%s\": %d", first ? "" : ", ", code.c_str(), count);
+                first = false;
+            }
+            std::fprintf(out, "}}");
+        }
+        std::fprintf(out, "%s\n", i + 1 < ops.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseOptions(argc, argv, o)) {
+        std::fprintf(stderr,
+                     "usage: %s [--reader sim|port:<tty>|replay:<capture>] [--iterations N] [--virtual]\n"
+                     "          [--record <capture>] [--destructive] [--master-key <hex>] [--read-key <hex>]\n"
+                     "          [--out <file>] [--trace <file>]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    const bool isSim = o.reader == "sim";
+    const bool isPort = o.reader.rfind("port:", 0) == 0;
+    const bool isReplay = o.reader.rfind("replay:", 0) == 0;
+    if (!isSim && !isPort && !isReplay) {
+        std::fprintf(stderr, "unknown reader '%s'\n", o.reader.c_str());
+        return 2;
+    }
+    if (isPort && o.virtualTime) {
+        std::fprintf(stderr, "--virtual needs a simulated reader (sim or replay)\n");
+        return 2;
+    }
+
+    const std::shared_ptr<IClock> clock = o.virtualTime
+        ? std::make_shared<adapters::timing::VirtualClock>()
+        : adapters::timing::steadyClock();
+
+    std::array<uint8_t, 32> file{};
+    for (size_t i = 0; i < 16; ++i) file[i] = static_cast<uint8_t>(0xC0 + i);
+    sim::DesfireCardModel card({o.masterKey, o.readKey}, file);
+
+    auto script = std::make_shared<sim::ReplayScript>();
+    if (isReplay) {
+        std::string error;
+        if (!sim::loadCapture(o.reader.substr(7), script->records, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    std::shared_ptr<sim::CaptureWriter> capture;
+    if (!o.record.empty()) {
+        capture = sim::CaptureWriter::open(o.record, clock);
+        if (!capture) {
+            std::fprintf(stderr, "cannot write %s\n", o.record.c_str());
+            return 1;
+        }
+    }
+
+    auto adapter = std::make_unique<adapters::hardware::Pn532Adapter>(nullptr, clock);
+    adapter->setSerialBusFactory([&](const std::string& port) -> std::unique_ptr<comms::serial::ISerialBus> {
+        std::unique_ptr<comms::serial::ISerialBus> bus;
+        if (isSim) {
+            auto pn532 = std::make_unique<sim::SimulatedPn532Bus>(&card, clock);
+            if (o.virtualTime) pn532->setLineRate(115200);
+            bus = std::move(pn532);
+        } else if (isReplay) {
+            bus = std::make_unique<sim::ReplaySerialBus>(script, clock);
+        } else {
+            bus = adapters::hardware::createPlatformSerialBus(port, 115200);
+        }
+        if (bus && capture) bus = std::make_unique<sim::RecordingSerialBus>(std::move(bus), capture);
+        return bus;
+    });
+    NfcService service(std::move(adapter), clock);
+    if (!o.trace.empty()) (void)service.setTracing(true);
+
+    const std::string port = isPort ? o.reader.substr(5) : o.reader;
+    const auto connected = service.connect(port);
+    if (const auto* err = std::get_if<core::ports::NfcError>(&connected)) {
+        std::fprintf(stderr, "connect failed: %s: %s\n", err->code.c_str(), err->message.c_str());
+        return 1;
+    }
+
+    core::ports::CardInitOptions initOpts;
+    initOpts.aid = {0x50, 0x57, 0x00};
+    initOpts.appMasterKey = o.masterKey;
+    initOpts.readKey = o.readKey;
+    for (size_t i = 0; i < 16; ++i) initOpts.cardSecret[i] = static_cast<uint8_t>(0xC0 + i);
+
+    std::deque<OpStats> ops; // stable references while appending
+    auto add = [&ops](const char* name) -> OpStats& {
+        ops.emplace_back();
+        ops.back().name = name;
+        return ops.back();
+    };
+    auto repeat = [&](const char* name, const std::function<Outcome()>& fn) {
+        OpStats& s = add(name);
+        for (int i = 0; i < o.iterations; ++i) timeCall(*clock, s, fn);
+    };
+
+    {
+        OpStats& s = add("connect");
+        for (int i = 0; i < o.iterations; ++i) {
+            (void)service.disconnect();
+            timeCall(*clock, s, [&] { return outcomeOf(service.connect(port)); });
+        }
+    }
+    repeat("probeCard", [&] { return outcomeOf(service.probeCard()); });
+    repeat("peekCardUid", [&] { return outcomeOf(service.peekCardUid()); });
+    repeat("readCardSecret", [&] { return outcomeOf(service.readCardSecret(o.readKey)); });
+    repeat("cardFreeMemory", [&] { return outcomeOf(service.cardFreeMemory()); });
+    repeat("getCardApplicationIds", [&] { return outcomeOf(service.getCardApplicationIds()); });
+
+    auto initCard = [&] { return outcomeOf(service.initCard(initOpts)); };
+    auto formatCard = [&] { return outcomeOf(service.formatCard()); };
+
+    if (o.destructive && !isSim) {
+        OpStats& format = add("formatCard");
+        OpStats& init = add("initCard");
+        for (int i = 0; i < o.iterations; ++i) {
+            timeCall(*clock, format, formatCard);
+            timeCall(*clock, init, initCard);
+        }
+    } else {
+        bool provisioned = true;
+        if (!isSim) { // a replay follows the recording, which probed
+            const auto probe = service.probeCard();
+            const auto* result = std::get_if<core::ports::CardProbeResult>(&probe);
+            provisioned = result && result->isInitialised;
+        }
+        if (provisioned) {
+            repeat("initCard", initCard);
+        } else {
+            add("initCard").skipped = "card not provisioned; --destructive formats and provisions it";
+        }
+        add("formatCard").skipped = isSim ? "simulator does not model FormatPICC"
+                                          : "erases the card; pass --destructive";
+    }
+
+    (void)service.disconnect();
+
+    if (!o.trace.empty()) {
+        const auto trace = service.exportTrace(false);
+        std::FILE* traceFile = std::fopen(o.trace.c_str(), "w");
+        if (!traceFile || !std::holds_alternative<std::string>(trace)) {
+            std::fprintf(stderr, "cannot write %s\n", o.trace.c_str());
+            if (traceFile) std::fclose(traceFile);
+            return 1;
+        }
+        std::fputs(std::get<std::string>(trace).c_str(), traceFile);
+        std::fclose(traceFile);
+    }
+
+    std::FILE* out = o.out.empty() ? stdout : std::fopen(o.out.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", o.out.c_str());
+        return 1;
+    }
+    printJson(out, o, o.virtualTime ? "virtual" : "steady", script->divergences, ops);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,244 @@
+// Pn532Adapter operations over a degraded serial link: success rate and
+// latency inflation per fault profile.
+//
+//   cmake -S . -B build -DSECUREPASS_BUILD_BENCHMARKS=ON
+//   cmake --build build --target nfc_fault_bench
+//   ./build/nfc_fault_bench [--virtual] [iterations] [seed]
+//
+// No hardware needed: the adapter talks to sim::SimulatedPn532Bus holding a
+// provisioned vault card, through FaultInjectingSerialBus. Each profile gets
+// a fresh adapter and runs every operation `iterations` times, so the whole
+// stack above the serial bus (NfcCpp driver, raw channel, secure channel)
+// handles the faults exactly as it would on a real link.
+//
+// A failed operation is followed by disconnect() + connect(), which is what
+// the app does after a HARDWARE_ERROR; that recovery is reported separately
+// and not counted in the operation's latency. Inflation is the mean latency
+// of an operation divided by its mean on the clean profile.
+//
+// With --virtual the adapter, the fault decorator and the simulator share a
+// VirtualClock and the simulator charges 115200-baud wire time: every read
+// timeout and latency spike is simulated rather than slept, and latencies
+// are reported in simulated milliseconds, so timeout-heavy profiles cost
+// no wall time.
+//
+// initCard and formatCard are not run: the card model is a provisioned
+// card and rejects key and application changes.
+#include "adapters/hardware/FaultInjectingSerialBus.h"
+#include "adapters/hardware/Pn532Adapter.h"
+#include "adapters/timing/SteadyClock.h"
+#include "adapters/timing/VirtualClock.h"
+#include "sim/DesfireCardModel.h"
+#include "sim/SimulatedPn532Bus.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+using adapters::hardware::FaultCounters;
+using adapters::hardware::FaultInjectingSerialBus;
+using adapters::hardware::FaultProfile;
+using adapters::hardware::Pn532Adapter;
+using core::ports::IClock;
+
+namespace {
+
+const std::array<std::array<uint8_t, 16>, 2> CARD_KEYS = {{
+    {0x10, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87, 0x98, 0xA9, 0xBA, 0xCB, 0xDC, 0xED, 0xFE, 0x0F},
+    {0x5E, 0xC2, 0x37, 0x1B, 0x8A, 0x44, 0x90, 0x6D, 0xF1, 0x0C, 0x29, 0xB7, 0x73, 0xE8, 0x5A, 0xD6},
+}};
+
+std::array<uint8_t, 32> cardFile() {
+    std::array<uint8_t, 32> file{};
+    for (size_t i = 0; i < file.size(); ++i) file[i] = static_cast<uint8_t>(0xC0 + i);
+    return file;
+}
+
+std::vector<FaultProfile> profiles(uint32_t seed) {
+    std::vector<FaultProfile> p(6);
+    p[0].name = "clean";
+    p[1].name = "drops 0.2%";
+    p[1].dropByteRate = 0.002;
+    p[2].name = "bad checksum 5%";
+    p[2].corruptChecksumRate = 0.05;
+    p[3].name = "truncated 5%";
+    p[3].truncateFrameRate = 0.05;
+    p[4].name = "latency spikes";
+    p[4].delayProbability = 0.10;
+    p[4].delayMinMs = 5;
+    p[4].delayMaxMs = 40;
+    p[5].name = "disconnect 1%";
+    p[5].disconnectRate = 0.01;
+    for (auto& profile : p) profile.seed = seed;
+    return p;
+}
+
+template <typename T>
+bool succeeded(const core::ports::Result<T>& r) {
+    return !std::holds_alternative<core::ports::NfcError>(r);
+}
+
+// Adds its counters to a running total when the adapter drops it on
+// disconnect, so totals survive reconnects.
+class CountedFaultBus : public FaultInjectingSerialBus {
+public:
+    CountedFaultBus(std::unique_ptr<comms::serial::ISerialBus> inner, FaultProfile profile,
+                    std::shared_ptr<IClock> clock, FaultCounters& total)
+        : FaultInjectingSerialBus(std::move(inner), std::move(profile), std::move(clock)), _total(total) {}
+
+    ~CountedFaultBus() override {
+        _total.delays += counters().delays;
+        _total.droppedBytes += counters().droppedBytes;
+        _total.corruptedFrames += counters().corruptedFrames;
+        _total.truncatedFrames += counters().truncatedFrames;
+        _total.disconnects += counters().disconnects;
+    }
+
+private:
+    FaultCounters& _total;
+};
+
+struct Operation {
+    const char* name;
+    std::function<bool(Pn532Adapter&)> run;
+};
+
+std::vector<Operation> operations() {
+    return {
+        {"getFirmwareVersion",    [](Pn532Adapter& a) { return succeeded(a.getFirmwareVersion()); }},
+        {"runSelfTests",          [](Pn532Adapter& a) { return succeeded(a.runSelfTests()); }},
+        {"peekCardUid",           [](Pn532Adapter& a) { return succeeded(a.peekCardUid()); }},
+        {"probeCard",             [](Pn532Adapter& a) { return succeeded(a.probeCard()); }},
+        {"getCardVersion",        [](Pn532Adapter& a) { return succeeded(a.getCardVersion()); }},
+        {"isCardInitialised",     [](Pn532Adapter& a) { return succeeded(a.isCardInitialised()); }},
+        {"cardFreeMemory",        [](Pn532Adapter& a) { return succeeded(a.cardFreeMemory()); }},
+        {"getCardApplicationIds", [](Pn532Adapter& a) { return succeeded(a.getCardApplicationIds()); }},
+        {"readCardSecret",        [](Pn532Adapter& a) { return succeeded(a.readCardSecret(CARD_KEYS[1])); }},
+    };
+}
+
+struct Samples {
+    std::vector<double> ms;
+    int ok = 0;
+
+    double mean() const {
+        double sum = 0;
+        for (double v : ms) sum += v;
+        return ms.empty() ? 0 : sum / static_cast<double>(ms.size());
+    }
+    double p95() const {
+        if (ms.empty()) return 0;
+        std::vector<double> sorted = ms;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)];
+    }
+};
+
+double elapsedMs(const IClock& clock, IClock::TimePoint start) {
+    return std::chrono::duration<double, std::milli>(clock.now() - start).count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    bool virtualTime = false;
+    std::vector<const char*> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--virtual") == 0) {
+            virtualTime = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    const int iterations = args.size() > 0 ? std::max(1, std::atoi(args[0])) : 20;
+    const uint32_t seed = args.size() > 1 ? static_cast<uint32_t>(std::strtoul(args[1], nullptr, 0)) : 1;
+    const auto wallStart = std::chrono::steady_clock::now();
+    const auto ops = operations();
+
+    std::map<std::string, double> cleanMean;
+    std::printf("| profile           | operation              | ok %%   | mean ms | p95 ms  | inflation |\n");
+    std::printf("|---|---|---|---|---|---|\n");
+
+    for (const auto& profile : profiles(seed)) {
+        sim::DesfireCardModel card(CARD_KEYS, cardFile());
+        FaultCounters faults;
+        uint32_t connection = 0;
+        const std::shared_ptr<IClock> clock = virtualTime
+            ? std::make_shared<adapters::timing::VirtualClock>()
+            : adapters::timing::steadyClock();
+
+        Pn532Adapter adapter(nullptr, clock);
+        adapter.setSerialBusFactory([&](const std::string&) -> std::unique_ptr<comms::serial::ISerialBus> {
+            FaultProfile p = profile;
+            p.seed = profile.seed + connection++; // a reconnect must not replay the same faults
+            auto pn532 = std::make_unique<sim::SimulatedPn532Bus>(&card, clock);
+            if (virtualTime) pn532->setLineRate(115200);
+            return std::make_unique<CountedFaultBus>(std::move(pn532), p, clock, faults);
+        });
+
+        int recoveries = 0;
+        int failedRecoveries = 0;
+        double recoveryMs = 0;
+        auto recover = [&] {
+            const auto start = clock->now();
+            (void)adapter.disconnect();
+            if (!succeeded(adapter.connect("sim"))) ++failedRecoveries;
+            recoveryMs += elapsedMs(*clock, start);
+            ++recoveries;
+        };
+
+        if (!succeeded(adapter.connect("sim"))) recover();
+
+        Samples all;
+        for (const auto& op : ops) {
+            Samples s;
+            for (int i = 0; i < iterations; ++i) {
+                const auto start = clock->now();
+                const bool ok = op.run(adapter);
+                s.ms.push_back(elapsedMs(*clock, start));
+                if (ok) {
+                    ++s.ok;
+                } else {
+                    recover();
+                }
+            }
+            all.ms.insert(all.ms.end(), s.ms.begin(), s.ms.end());
+            all.ok += s.ok;
+
+            if (profile.name == "clean") cleanMean[op.name] = s.mean();
+            const double base = cleanMean.count(op.name) ? cleanMean[op.name] : 0;
+            std::printf("| %-17s | %-22s | %6.1f | %7.2f | %7.2f | %8.1fx |\n", profile.name.c_str(), op.name,
+                        100.0 * s.ok / iterations, s.mean(), s.p95(), base > 0 ? s.mean() / base : 0.0);
+        }
+
+        double cleanAll = 0;
+        for (const auto& [name, mean] : cleanMean) cleanAll += mean;
+        cleanAll /= std::max<size_t>(1, cleanMean.size());
+        std::printf("| %-17s | %-22s | %6.1f | %7.2f | %7.2f | %8.1fx |\n", profile.name.c_str(), "(all)",
+                    100.0 * all.ok / static_cast<double>(all.ms.size()), all.mean(), all.p95(),
+                    cleanAll > 0 ? all.mean() / cleanAll : 0.0);
+
+        (void)adapter.disconnect(); // settles the counters of the last connection
+        std::fprintf(stderr,
+                     "%s: %llu delays, %llu dropped bytes, %llu bad checksums, %llu truncated, %llu disconnects; "
+                     "%d recoveries (%d failed, %.1f ms total)\n",
+                     profile.name.c_str(), static_cast<unsigned long long>(faults.delays),
+                     static_cast<unsigned long long>(faults.droppedBytes),
+                     static_cast<unsigned long long>(faults.corruptedFrames),
+                     static_cast<unsigned long long>(faults.truncatedFrames),
+                     static_cast<unsigned long long>(faults.disconnects), recoveries, failedRecoveries, recoveryMs);
+    }
+    if (virtualTime) {
+        std::fprintf(stderr, "virtual time; wall clock %.1f ms\n",
+                     std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count());
+    }
+    return 0;
+}
@@ -0,0 +1,436 @@
+// Concurrency and fairness stress test: many threads calling one NfcService
+// over the simulator, the way the binding's worker pool does when the UI
+// probe loop and bridge requests overlap. Results as JSON.
+//
+//   cmake -S . -B build -DSECUREPASS_BUILD_BENCHMARKS=ON
+//   cmake --build build --target nfc_stress
+//   ./build/nfc_stress [--workers N] [--pollers N] [--poll-ms N] [--seconds S]
+//                      [--mix op=weight,...] [--think-us N] [--baud N]
+//                      [--starve-ms N] [--seed N] [--strict] [--out <file>]
+//
+// Callers:
+//   workers   back-to-back calls drawn from --mix, with an exponentially
+//             distributed think time of mean --think-us between them
+//             (0, the default, means no pause: maximum contention)
+//   pollers   peekCardUid every --poll-ms, like waitForCard() in the app
+//
+// Operations available to --mix: peekCardUid, probeCard, isCardInitialised,
+// readCardSecret, cardFreeMemory, getCardApplicationIds, getCardVersion,
+// getFirmwareVersion, getReaderHealth, getPowerStatus, wakeReader. Writes
+// (initCard, formatCard) and connect/disconnect are left out: they change
+// what every other caller sees.
+//
+// The run uses the steady clock throughout; simulated time would say
+// nothing about threads. --baud (default 115200) charges wire time so lock
+// hold times resemble a real reader; --baud 0 makes the wire free and
+// measures the software alone.
+//
+// Reported:
+//   throughput      calls/s overall and per operation, with outcomes
+//   callers         per thread: calls, latency percentiles, starved calls
+//                   (latency above --starve-ms, default 1000)
+//   fairness        Jain's index over worker call counts (1 = equal
+//                   shares), min/max worker calls, total starved calls
+//   lock            the adapter mutex over the run, from getReaderHealth():
+//                   acquisitions, contention, wait and hold times, and the
+//                   fraction of the run it was held
+//
+// --strict exits with status 3 when any call starved or failed. Against
+// the simulator every call should succeed; an error under concurrency is a
+// session or scheduling bug.
+#include "adapters/hardware/Pn532Adapter.h"
+#include "core/services/NfcService.h"
+#include "sim/DesfireCardModel.h"
+#include "sim/SimulatedPn532Bus.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using core::ports::AdapterLockStats;
+using core::services::NfcService;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Simulator card keys, as in nfc_bench
+const std::array<std::array<uint8_t, 16>, 2> SIM_KEYS = {{
+    {0x10, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87, 0x98, 0xA9, 0xBA, 0xCB, 0xDC, 0xED, 0xFE, 0x0F},
+    {0x5E, 0xC2, 0x37, 0x1B, 0x8A, 0x44, 0x90, 0x6D, 0xF1, 0x0C, 0x29, 0xB7, 0x73, 0xE8, 0x5A, 0xD6},
+}};
+
+const char* const DEFAULT_MIX =
+    "peekCardUid=30,probeCard=20,readCardSecret=20,getReaderHealth=10,"
+    "cardFreeMemory=5,getCardApplicationIds=5,getPowerStatus=5,wakeReader=5";
+
+struct Options {
+    int workers = 16;
+    int pollers = 2;
+    int pollMs = 200;
+    double seconds = 10;
+    std::string mix = DEFAULT_MIX;
+    double thinkUs = 0;
+    uint32_t baud = 115200;
+    double starveMs = 1000;
+    uint64_t seed = 1;
+    bool strict = false;
+    std::string out;
+};
+
+bool parseOptions(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--strict") {
+            o.strict = true;
+        } else if (arg == "--workers" && hasValue) {
+            o.workers = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--pollers" && hasValue) {
+            o.pollers = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--poll-ms" && hasValue) {
+            o.pollMs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seconds" && hasValue) {
+            o.seconds = std::max(0.1, std::atof(argv[++i]));
+        } else if (arg == "--mix" && hasValue) {
+            o.mix = argv[++i];
+        } else if (arg == "--think-us" && hasValue) {
+            o.thinkUs = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--baud" && hasValue) {
+            o.baud = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--starve-ms" && hasValue) {
+            o.starveMs = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            o.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--out" && hasValue) {
+            o.out = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return o.workers + o.pollers > 0;
+}
+
+// Error code of a failed call, empty on success
+template <typename T>
+std::string outcomeOf(const core::ports::Result<T>& r) {
+    if (const auto* err = std::get_if<core::ports::NfcError>(&r)) return err->code;
+    return {};
+}
+
+struct Operation {
+    const char* name;
+    std::function<std::string(NfcService&)> call;
+};
+
+std::vector<Operation> operations(const std::array<uint8_t, 16>& readKey) {
+    return {
+        {"peekCardUid",           [](NfcService& s) { return outcomeOf(s.peekCardUid()); }},
+        {"probeCard",             [](NfcService& s) { return outcomeOf(s.probeCard()); }},
+        {"isCardInitialised",     [](NfcService& s) { return outcomeOf(s.isCardInitialised()); }},
+        {"readCardSecret",        [readKey](NfcService& s) { return outcomeOf(s.readCardSecret(readKey)); }},
+        {"cardFreeMemory",        [](NfcService& s) { return outcomeOf(s.cardFreeMemory()); }},
+        {"getCardApplicationIds", [](NfcService& s) { return outcomeOf(s.getCardApplicationIds()); }},
+        {"getCardVersion",        [](NfcService& s) { return outcomeOf(s.getCardVersion()); }},
+        {"getFirmwareVersion",    [](NfcService& s) { return outcomeOf(s.getFirmwareVersion()); }},
+        {"getReaderHealth",       [](NfcService& s) { return outcomeOf(s.getReaderHealth()); }},
+        {"getPowerStatus",        [](NfcService& s) { return outcomeOf(s.getPowerStatus()); }},
+        {"wakeReader",            [](NfcService& s) { return outcomeOf(s.wakeReader()); }},
+    };
+}
+
+// "name=weight,..." -> weight per entry of `ops`; false on an unknown name.
+bool parseMix(const std::string& mix, const std::vector<Operation>& ops, std::vector<double>& weights) {
+    weights.assign(ops.size(), 0.0);
+    std::stringstream ss(mix);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        const size_t eq = item.find('=');
+        const std::string name = item.substr(0, eq);
+        const double weight = eq == std::string::npos ? 1.0 : std::atof(item.c_str() + eq + 1);
+        auto it = std::find_if(ops.begin(), ops.end(), [&](const Operation& op) { return name == op.name; });
+        if (it == ops.end() || weight < 0) return false;
+        weights[static_cast<size_t>(it - ops.begin())] = weight;
+    }
+    return std::any_of(weights.begin(), weights.end(), [](double w) { return w > 0; });
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    const size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+// Upper bound in µs of the bucket holding percentile `p` of a lock histogram.
+double bucketPercentile(const std::array<uint64_t, AdapterLockStats::kBuckets>& buckets, double p) {
+    uint64_t total = 0;
+    for (uint64_t n : buckets) total += n;
+    if (total == 0) return 0;
+    const double target = p / 100.0 * static_cast<double>(total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (static_cast<double>(seen) >= target) return std::ldexp(1.0, static_cast<int>(i));
+    }
+    return std::ldexp(1.0, static_cast<int>(buckets.size()));
+}
+
+// Lock activity between two snapshots; maxima are since the adapter started.
+AdapterLockStats lockDelta(const AdapterLockStats& before, const AdapterLockStats& after) {
+    AdapterLockStats d = after;
+    d.acquisitions -= before.acquisitions;
+    d.contended -= before.contended;
+    d.tryFailures -= before.tryFailures;
+    d.waitTotalUs -= before.waitTotalUs;
+    d.holdTotalUs -= before.holdTotalUs;
+    for (size_t i = 0; i < AdapterLockStats::kBuckets; ++i) {
+        d.waitBuckets[i] -= before.waitBuckets[i];
+        d.holdBuckets[i] -= before.holdBuckets[i];
+    }
+    return d;
+}
+
+AdapterLockStats lockStats(NfcService& service) {
+    const auto health = service.getReaderHealth();
+    if (const auto* h = std::get_if<core::ports::ReaderHealthSnapshot>(&health)) return h->lock;
+    return {};
+}
+
+// One thread's results. Only its own thread writes it during the run.
+struct Caller {
+    std::string role;
+    std::vector<std::vector<double>> usByOp; // indexed like operations()
+    std::vector<uint64_t> errorsByOp;
+    std::map<std::string, uint64_t> errors;  // by code
+    uint64_t ok = 0;
+    uint64_t starved = 0;
+};
+
+struct OpTotals {
+    std::vector<double> us;
+    uint64_t errors = 0;
+};
+
+void printErrors(std::FILE* out, const std::map<std::string, uint64_t>& errors) {
+    std::fprintf(out, "{");
+    bool first = true;
+    for (const auto& [code, count] : errors) {
+        std::fprintf(out, "%s\"%s\": %llu", first ? "" : ", ", code.c_str(), static_cast<unsigned long long>(count));
+        first = false;
+    }
+    std::fprintf(out, "}");
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    const std::vector<Operation> ops = operations(SIM_KEYS[1]);
+    std::vector<double> weights;
+    if (!parseOptions(argc, argv, o) || !parseMix(o.mix, ops, weights)) {
+        std::fprintf(stderr,
+                     "usage: %s [--workers N] [--pollers N] [--poll-ms N] [--seconds S] [--mix op=weight,...]\n"
+                     "          [--think-us N] [--baud N] [--starve-ms N] [--seed N] [--strict] [--out <file>]\n",
+                     argv[0]);
+        return 2;
+    }
+    size_t peekIndex = 0;
+    while (std::strcmp(ops[peekIndex].name, "peekCardUid") != 0) ++peekIndex;
+
+    std::array<uint8_t, 32> file{};
+    for (size_t i = 0; i < 16; ++i) file[i] = static_cast<uint8_t>(0xC0 + i);
+    sim::DesfireCardModel card({SIM_KEYS[0], SIM_KEYS[1]}, file);
+
+    auto adapter = std::make_unique<adapters::hardware::Pn532Adapter>();
+    adapter->setSerialBusFactory([&](const std::string&) -> std::unique_ptr<comms::serial::ISerialBus> {
+        auto bus = std::make_unique<sim::SimulatedPn532Bus>(&card);
+        bus->setLineRate(o.baud);
+        return bus;
+    });
+    NfcService service(std::move(adapter));
+    const auto connected = service.connect("sim");
+    if (const auto* err = std::get_if<core::ports::NfcError>(&connected)) {
+        std::fprintf(stderr, "connect failed: %s: %s\n", err->code.c_str(), err->message.c_str());
+        return 1;
+    }
+
+    const size_t callerCount = static_cast<size_t>(o.workers + o.pollers);
+    std::vector<Caller> callers(callerCount);
+    for (size_t i = 0; i < callerCount; ++i) {
+        callers[i].role = i < static_cast<size_t>(o.workers) ? "worker" : "poller";
+        callers[i].usByOp.resize(ops.size());
+        callers[i].errorsByOp.resize(ops.size());
+    }
+
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    Clock::time_point deadline;
+
+    auto timedCall = [&](Caller& c, size_t op) {
+        const auto start = Clock::now();
+        const std::string outcome = ops[op].call(service);
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        c.usByOp[op].push_back(us);
+        if (us > o.starveMs * 1000.0) ++c.starved;
+        if (outcome.empty()) {
+            ++c.ok;
+        } else {
+            ++c.errorsByOp[op];
+            ++c.errors[outcome];
+        }
+    };
+    auto waitForStart = [&] {
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < callerCount; ++i) {
+        threads.emplace_back([&, i] {
+            Caller& c = callers[i];
+            std::mt19937_64 rng(o.seed * 1000003u + i);
+            std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+            std::exponential_distribution<double> think(o.thinkUs > 0 ? 1.0 / o.thinkUs : 1.0);
+            waitForStart();
+            if (c.role == "poller") {
+                auto next = Clock::now();
+                while (Clock::now() < deadline) {
+                    timedCall(c, peekIndex);
+                    next += std::chrono::milliseconds(o.pollMs);
+                    std::this_thread::sleep_until(std::min(std::max(next, Clock::now()), deadline));
+                }
+                return;
+            }
+            while (Clock::now() < deadline) {
+                timedCall(c, pick(rng));
+                if (o.thinkUs > 0) {
+                    std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(think(rng)));
+                }
+            }
+        });
+    }
+
+    while (ready.load() < callerCount) std::this_thread::yield();
+    const AdapterLockStats lockBefore = lockStats(service);
+    const auto start = Clock::now();
+    deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(o.seconds));
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    const double wallUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    const AdapterLockStats lock = lockDelta(lockBefore, lockStats(service));
+    (void)service.disconnect();
+
+    // Aggregate per operation and overall
+    std::vector<OpTotals> byOp(ops.size());
+    uint64_t totalCalls = 0, totalErrors = 0, totalStarved = 0;
+    for (const Caller& c : callers) {
+        for (size_t op = 0; op < ops.size(); ++op) {
+            byOp[op].us.insert(byOp[op].us.end(), c.usByOp[op].begin(), c.usByOp[op].end());
+            byOp[op].errors += c.errorsByOp[op];
+            totalCalls += c.usByOp[op].size();
+            totalErrors += c.errorsByOp[op];
+        }
+        totalStarved += c.starved;
+    }
+
+    // Jain's fairness index over worker call counts
+    double sum = 0, sumSq = 0;
+    uint64_t minCalls = UINT64_MAX, maxCalls = 0;
+    for (int w = 0; w < o.workers; ++w) {
+        uint64_t n = 0;
+        for (const auto& v : callers[static_cast<size_t>(w)].usByOp) n += v.size();
+        sum += static_cast<double>(n);
+        sumSq += static_cast<double>(n) * static_cast<double>(n);
+        minCalls = std::min(minCalls, n);
+        maxCalls = std::max(maxCalls, n);
+    }
+    const double jain = sumSq > 0 ? sum * sum / (static_cast<double>(o.workers) * sumSq) : 1.0;
+    if (o.workers == 0) minCalls = 0;
+
+    std::FILE* out = o.out.empty() ? stdout : std::fopen(o.out.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", o.out.c_str());
+        return 1;
+    }
+    const double wallS = wallUs / 1e6;
+    std::fprintf(out,
+                 "{\n  \"workers\": %d,\n  \"pollers\": %d,\n  \"pollMs\": %d,\n  \"thinkUs\": %.0f,\n"
+                 "  \"baud\": %u,\n  \"mix\": \"%s\",\n  \"seconds\": %.3f,\n  \"calls\": %llu,\n"
+                 "  \"errors\": %llu,\n  \"callsPerSec\": %.1f,\n",
+                 o.workers, o.pollers, o.pollMs, o.thinkUs, o.baud, o.mix.c_str(), wallS,
+                 static_cast<unsigned long long>(totalCalls), static_cast<unsigned long long>(totalErrors),
+                 static_cast<double>(totalCalls) / wallS);
+
+    std::fprintf(out, "  \"operations\": [\n");
+    bool firstOp = true;
+    for (size_t op = 0; op < ops.size(); ++op) {
+        std::vector<double>& us = byOp[op].us;
+        if (us.empty()) continue;
+        std::sort(us.begin(), us.end());
+        std::fprintf(out,
+                     "%s    {\"name\": \"%s\", \"calls\": %zu, \"errors\": %llu, \"callsPerSec\": %.1f,"
+                     " \"latencyUs\": {\"p50\": %.0f, \"p99\": %.0f, \"p999\": %.0f, \"max\": %.0f}}",
+                     firstOp ? "" : ",\n", ops[op].name, us.size(), static_cast<unsigned long long>(byOp[op].errors),
+                     static_cast<double>(us.size()) / wallS,
+                     percentile(us, 50), percentile(us, 99), percentile(us, 99.9), us.back());
+        firstOp = false;
+    }
+    std::fprintf(out, "\n  ],\n  \"callers\": [\n");
+    for (size_t i = 0; i < callers.size(); ++i) {
+        const Caller& c = callers[i];
+        std::vector<double> us;
+        for (const auto& v : c.usByOp) us.insert(us.end(), v.begin(), v.end());
+        std::sort(us.begin(), us.end());
+        std::fprintf(out,
+                     "    {\"thread\": %zu, \"role\": \"%s\", \"calls\": %zu, \"ok\": %llu, \"starved\": %llu,"
+                     " \"latencyUs\": {\"p50\": %.0f, \"p99\": %.0f, \"p999\": %.0f, \"max\": %.0f}, \"errors\": ",
+                     i, c.role.c_str(), us.size(), static_cast<unsigned long long>(c.ok),
+                     static_cast<unsigned long long>(c.starved), percentile(us, 50), percentile(us, 99),
+                     percentile(us, 99.9), us.empty() ? 0.0 : us.back());
+        printErrors(out, c.errors);
+        std::fprintf(out, "}%s\n", i + 1 < callers.size() ? "," : "");
+    }
+    std::fprintf(out,
+                 "  ],\n  \"fairness\": {\"jainIndex\": %.3f, \"minWorkerCalls\": %llu, \"maxWorkerCalls\": %llu,"
+                 " \"starveMs\": %.0f, \"starvedCalls\": %llu},\n",
+                 jain, static_cast<unsigned long long>(minCalls), static_cast<unsigned long long>(maxCalls),
+                 o.starveMs, static_cast<unsigned long long>(totalStarved));
+
+    const double acquisitions = static_cast<double>(lock.acquisitions);
+    const double contended = static_cast<double>(lock.contended);
+    std::fprintf(out,
+                 "  \"lock\": {\"acquisitions\": %llu, \"contended\": %llu, \"contendedPct\": %.1f,"
+                 " \"tryFailures\": %llu, \"heldPct\": %.1f,\n"
+                 "           \"holdUs\": {\"mean\": %.0f, \"p50\": %.0f, \"p99\": %.0f, \"maxEver\": %llu},\n"
+                 "           \"waitUs\": {\"mean\": %.0f, \"p50\": %.0f, \"p99\": %.0f, \"maxEver\": %llu}}\n}\n",
+                 static_cast<unsigned long long>(lock.acquisitions), static_cast<unsigned long long>(lock.contended),
+                 acquisitions > 0 ? 100.0 * contended / acquisitions : 0.0,
+                 static_cast<unsigned long long>(lock.tryFailures),
+                 wallUs > 0 ? 100.0 * static_cast<double>(lock.holdTotalUs) / wallUs : 0.0,
+                 acquisitions > 0 ? static_cast<double>(lock.holdTotalUs) / acquisitions : 0.0,
+                 bucketPercentile(lock.holdBuckets, 50), bucketPercentile(lock.holdBuckets, 99),
+                 static_cast<unsigned long long>(lock.holdMaxUs),
+                 contended > 0 ? static_cast<double>(lock.waitTotalUs) / contended : 0.0,
+                 bucketPercentile(lock.waitBuckets, 50), bucketPercentile(lock.waitBuckets, 99),
+                 static_cast<unsigned long long>(lock.waitMaxUs));
+    if (out != stdout) std::fclose(out);
+
+    if (o.strict && (totalStarved > 0 || totalErrors > 0)) {
+        std::fprintf(stderr, "strict: %llu starved, %llu failed calls\n",
+                     static_cast<unsigned long long>(totalStarved), static_cast<unsigned long long>(totalErrors));
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,224 @@
+// PN532 receive-path cost per command: bus calls and heap allocations,
+// byte-wise reads (the raw channel before the frame assembler) vs
+// Pn532FrameAssembler.
+//
+//   cmake -S . -B build -DSECUREPASS_BUILD_BENCHMARKS=ON
+//   cmake --build build --target pn532_frame_bench
+//   ./build/pn532_frame_bench [iterations]
+//
+// Runs against an in-process PN532 model on an ISerialBus: every command
+// frame written is answered with an ACK packet and a response packet, each
+// becoming readable only after the previous one is drained, like bulk
+// transfers from a USB-serial bridge. Each bus read() and available() on a
+// real backend is at least one syscall, so the call counts are the syscall
+// floor per command.
+#include "adapters/hardware/Pn532Frames.h"
+#include "adapters/hardware/Pn532RawChannel.h"
+#include "Comms/Serial/ISerialBus.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <variant>
+#include <vector>
+
+using namespace adapters::hardware;
+using Clock = std::chrono::steady_clock;
+
+// Counts every heap allocation in the process
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr uint8_t PN532_CMD_GET_FIRMWARE_VERSION = 0x02;
+
+// PN532 model: GetFirmwareVersion, and InDataExchange answered with a
+// DESFire-sized response of `exchangeBytes` card bytes. Responses are
+// built once up front so the model itself never allocates per command.
+class SimulatedPn532Bus : public comms::serial::ISerialBus {
+public:
+    explicit SimulatedPn532Bus(size_t exchangeBytes) {
+        _firmware = buildResponse(PN532_CMD_GET_FIRMWARE_VERSION, {0x32, 0x01, 0x06, 0x07});
+        std::vector<uint8_t> exchange(1 + exchangeBytes, 0xA5);
+        exchange[0] = 0x00; // PN532 status OK
+        _exchange = buildResponse(PN532_CMD_IN_DATA_EXCHANGE, exchange);
+        _tx.reserve(512);
+    }
+
+    uint64_t reads = 0;
+    uint64_t availables = 0;
+
+    etl::expected<void, error::Error> init() override { return {}; }
+
+    etl::expected<void, error::Error> write(const etl::ivector<uint8_t>& data) override {
+        _tx.insert(_tx.end(), data.begin(), data.end());
+        const FrameScan scan = scanFrame(_tx.data(), _tx.size());
+        if (scan.status != FrameScanStatus::Information) return {};
+        const uint8_t command = _tx[scan.dataOffset + 1];
+        _tx.clear();
+
+        _packets[0] = &ACK;
+        _packets[1] = command == PN532_CMD_GET_FIRMWARE_VERSION ? &_firmware : &_exchange;
+        _packetCount = 2;
+        _packetIndex = 0;
+        _offset = 0;
+        return {};
+    }
+
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t) override {
+        ++reads;
+        if (visible() == 0 && _packetIndex < _packetCount) { // next bulk transfer arrives
+            ++_packetIndex;
+            _offset = 0;
+        }
+        if (visible() == 0) {
+            return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Timeout));
+        }
+        size_t n = 0;
+        const std::vector<uint8_t>& packet = *_packets[_packetIndex - 1];
+        while (n < length && _offset < packet.size() && buffer.size() < buffer.max_size()) {
+            buffer.push_back(packet[_offset++]);
+            ++n;
+        }
+        return n;
+    }
+
+    etl::expected<size_t, error::Error> available() override {
+        ++availables;
+        return visible();
+    }
+
+    etl::expected<void, error::Error> flush() override { return {}; }
+    void close() override {}
+
+private:
+    static inline const std::vector<uint8_t> ACK = {0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00};
+
+    // Bytes of the current packet not read yet; the first packet becomes
+    // current on the first read after a command
+    size_t visible() const {
+        if (_packetIndex == 0 || _packetIndex > _packetCount) return 0;
+        return _packets[_packetIndex - 1]->size() - _offset;
+    }
+
+    static std::vector<uint8_t> buildResponse(uint8_t command, const std::vector<uint8_t>& params) {
+        std::vector<uint8_t> data = {PN532_TFI_PN532_TO_HOST, static_cast<uint8_t>(command + 1)};
+        data.insert(data.end(), params.begin(), params.end());
+        std::vector<uint8_t> frame = {0x00, 0x00, 0xFF, static_cast<uint8_t>(data.size()),
+                                      static_cast<uint8_t>(0x100 - data.size())};
+        uint8_t sum = 0;
+        for (auto b : data) sum = static_cast<uint8_t>(sum + b);
+        frame.insert(frame.end(), data.begin(), data.end());
+        frame.push_back(static_cast<uint8_t>(0x100 - sum));
+        frame.push_back(0x00);
+        return frame;
+    }
+
+    std::vector<uint8_t> _firmware;
+    std::vector<uint8_t> _exchange;
+    std::vector<uint8_t> _tx;
+    const std::vector<uint8_t>* _packets[2] = {nullptr, nullptr};
+    size_t _packetCount = 0;
+    size_t _packetIndex = 0; // 1-based current packet, 0 before the first read
+    size_t _offset = 0;
+};
+
+// The raw channel's receive loop before Pn532FrameAssembler: one byte per
+// read(), appended to a std::vector and rescanned after every byte.
+std::vector<uint8_t> byteWiseTransceive(comms::serial::ISerialBus& bus, uint8_t command,
+                                        const std::vector<uint8_t>& params) {
+    const std::vector<uint8_t> frame = buildCommandFrame(command, params.data(), params.size());
+    etl::vector<uint8_t, 300> out;
+    for (auto b : frame) out.push_back(b);
+    (void)bus.write(out);
+
+    std::vector<uint8_t> rx;
+    bool acked = false;
+    for (int guard = 0; guard < 4096; ++guard) {
+        const FrameScan scan = scanFrame(rx.data(), rx.size());
+        if (scan.status == FrameScanStatus::Ack) {
+            rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(scan.start + scan.length));
+            acked = true;
+            continue;
+        }
+        if (scan.status == FrameScanStatus::Information && acked) {
+            return std::vector<uint8_t>(rx.begin() + static_cast<std::ptrdiff_t>(scan.dataOffset + 2),
+                                        rx.begin() + static_cast<std::ptrdiff_t>(scan.dataOffset + scan.dataLength));
+        }
+        rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(scan.start));
+        etl::vector<uint8_t, 1> chunk;
+        if (!bus.read(chunk, 1, 50).has_value()) break;
+        for (auto b : chunk) rx.push_back(b);
+    }
+    return {};
+}
+
+struct Row {
+    double busCalls = 0;
+    double allocations = 0;
+    double ns = 0;
+};
+
+template <typename Fn>
+Row measure(SimulatedPn532Bus& bus, int iterations, Fn&& fn) {
+    bus.reads = bus.availables = 0;
+    const uint64_t allocBefore = g_allocations.load();
+    const auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    const auto ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    Row r;
+    r.busCalls = static_cast<double>(bus.reads + bus.availables) / iterations;
+    r.allocations = static_cast<double>(g_allocations.load() - allocBefore) / iterations;
+    r.ns = ns / iterations;
+    return r;
+}
+
+void print(const char* command, const char* path, const Row& r) {
+    std::printf("| %-22s | %-18s | %7.1f | %6.1f | %8.0f |\n", command, path, r.busCalls, r.allocations, r.ns);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+
+    struct Case {
+        const char* name;
+        uint8_t command;
+        std::vector<uint8_t> params;
+        size_t exchangeBytes;
+    };
+    const std::vector<Case> cases = {
+        {"GetFirmwareVersion", PN532_CMD_GET_FIRMWARE_VERSION, {}, 0},
+        {"InDataExchange 17 B", PN532_CMD_IN_DATA_EXCHANGE, {0x01, 0xBD, 0x00}, 17},
+        {"InDataExchange 60 B", PN532_CMD_IN_DATA_EXCHANGE, {0x01, 0xBD, 0x00}, 60},
+    };
+
+    std::printf("| command                | path               | calls   | allocs | ns/cmd   |\n");
+    std::printf("|---|---|---|---|---|\n");
+    for (const auto& c : cases) {
+        SimulatedPn532Bus bus(c.exchangeBytes);
+        Pn532RawChannel channel(bus);
+
+        print(c.name, "byte-wise", measure(bus, iterations, [&] {
+            (void)byteWiseTransceive(bus, c.command, c.params);
+        }));
+        print(c.name, "assembler/vector", measure(bus, iterations, [&] {
+            (void)channel.transceive(c.command, c.params, 50);
+        }));
+        print(c.name, "assembler/view", measure(bus, iterations, [&] {
+            (void)channel.transceiveView(c.command, c.params.data(), c.params.size(), 50);
+        }));
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Native scrypt wall-clock time per derivation, lanes serial vs on the pool.
+//
+//   cmake -S . -B build -DSECUREPASS_BUILD_BENCHMARKS=ON
+//   cmake --build build --target scrypt_bench
+//   ./build/scrypt_bench [rounds]
+//
+// Rows cover the PIN verifier and vault passphrase parameters (N=2^15, r=8,
+// p=1) and higher-p variants of them. With p > 1 the lanes are independent,
+// so on the pool the wall-clock time should stay close to the p=1 row while
+// the total work grows with p. Compare with crypto.scryptSync() through
+// `node -e` on the same machine; the outputs are identical. The last line is
+// what calibrateScrypt() picks here for the sync key envelope settings.
+#include "adapters/crypto/Scrypt.h"
+#include "adapters/crypto/WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using adapters::crypto::ScryptParams;
+using adapters::crypto::ScryptStatus;
+using adapters::crypto::WorkStealingPool;
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 5;
+    const ScryptParams grid[] = {
+        {1 << 14, 8, 1}, {1 << 15, 8, 1}, {1 << 15, 8, 2}, {1 << 15, 8, 4}, {1 << 16, 8, 1},
+    };
+    const size_t maxmem = size_t(1) << 30;
+
+    WorkStealingPool pool;
+    std::printf("backend %s, %u hardware threads, pool concurrency %zu, best of %d rounds\n",
+                adapters::crypto::scryptBackend(), std::thread::hardware_concurrency(), pool.concurrency(), rounds);
+    std::printf("%8s %3s %3s %8s %12s %12s\n", "N", "r", "p", "mem_MiB", "serial_ms", "pool_ms");
+
+    const uint8_t password[] = "123456";
+    const uint8_t salt[16] = {};
+    uint8_t key[32];
+    for (const ScryptParams& params : grid) {
+        double best[2] = {1e300, 1e300};
+        for (int r = 0; r < rounds; ++r) {
+            for (int usePool = 0; usePool < 2; ++usePool) {
+                const auto start = Clock::now();
+                const ScryptStatus status = adapters::crypto::scrypt(
+                    password, sizeof(password) - 1, salt, sizeof(salt), params, maxmem, key, sizeof(key),
+                    usePool ? &pool : nullptr);
+                const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                if (status != ScryptStatus::Ok) {
+                    std::fprintf(stderr, "scrypt failed (status %d)\n", static_cast<int>(status));
+                    return 1;
+                }
+                best[usePool] = std::min(best[usePool], ms);
+            }
+        }
+        std::printf("%8llu %3u %3u %8.0f %12.1f %12.1f\n", static_cast<unsigned long long>(params.N), params.r,
+                    params.p, 128.0 * double(params.N) * params.r / (1024 * 1024), best[0], best[1]);
+    }
+
+    adapters::crypto::ScryptCalibration limits;
+    limits.floor = {1 << 15, 8, 1};
+    adapters::crypto::ScryptCalibrationResult picked;
+    if (adapters::crypto::calibrateScrypt(limits, &pool, picked) != ScryptStatus::Ok) {
+        std::fprintf(stderr, "calibration failed\n");
+        return 1;
+    }
+    std::printf("calibrated for %.0f ms within %zu MiB: N=%llu r=%u p=%u, measured %.1f ms\n", limits.targetMs,
+                limits.maxmem >> 20, static_cast<unsigned long long>(picked.params.N), picked.params.r,
+                picked.params.p, picked.measuredMs);
+    return 0;
+}
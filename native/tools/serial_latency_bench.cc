@@ -0,0 +1,179 @@
+// PN532 command round-trip latency: termios backend, event backend without
+// low-latency tty tuning, and event backend with it.
+//
+//   cmake -S . -B build -DSECUREPASS_BUILD_BENCHMARKS=ON
+//   cmake --build build --target serial_latency_bench
+//   ./build/serial_latency_bench /dev/ttyUSB0 [iterations]
+//
+// Needs a PN532 on the given port. Each backend opens the port, wakes the
+// PN532 with the HSU preamble and runs the same command mix through
+// Pn532RawChannel, so only the serial layer differs between the rows. A
+// round trip is write → ACK → response, timed on the host; rt/s is the
+// sequential round-trip rate (1 / mean). The untuned event row runs first
+// so the FTDI latency timer is still at its default for it; the tuned bus
+// restores it on close.
+//
+// The event backend additionally reports cancel latency: a wait with no
+// command in flight is interrupted by SerialWaker::wake() from another
+// thread, and the time from wake() to the CANCELLED return is measured.
+#include "adapters/hardware/Pn532Frames.h"
+#include "adapters/hardware/Pn532RawChannel.h"
+#include "adapters/hardware/SerialBusLinux.h"
+#include "adapters/hardware/SerialBusPlatform.h"
+#include "adapters/hardware/SerialWaker.h"
+#include "Comms/Serial/ISerialBus.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using adapters::hardware::Pn532RawChannel;
+using adapters::hardware::SerialBackend;
+using adapters::hardware::SerialWaker;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr uint8_t PN532_CMD_GET_FIRMWARE_VERSION = 0x02;
+constexpr uint32_t COMMAND_TIMEOUT_MS = 1000;
+
+struct Command {
+    const char* name;
+    uint8_t code;
+    std::vector<uint8_t> params;
+};
+
+const std::vector<Command>& commandMix() {
+    static const std::vector<Command> mix = {
+        {"GetFirmwareVersion", PN532_CMD_GET_FIRMWARE_VERSION, {}},
+        {"GetGeneralStatus",   adapters::hardware::PN532_CMD_GET_GENERAL_STATUS, {}},
+        {"SAMConfiguration",   adapters::hardware::PN532_CMD_SAM_CONFIGURATION, {0x01, 0x14, 0x01}},
+    };
+    return mix;
+}
+
+struct Stats {
+    double meanUs = 0;
+    double p50Us = 0;
+    double p99Us = 0;
+    double maxUs = 0;
+};
+
+Stats summarize(std::vector<double> samples) {
+    Stats s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double v : samples) sum += v;
+    s.meanUs = sum / static_cast<double>(samples.size());
+    s.p50Us = samples[samples.size() / 2];
+    s.p99Us = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    s.maxUs = samples.back();
+    return s;
+}
+
+double elapsedUs(Clock::time_point from) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - from).count();
+}
+
+bool runBackend(const char* label, std::unique_ptr<comms::serial::ISerialBus> serial,
+                std::shared_ptr<SerialWaker> waker, bool measureCancel, int iterations) {
+    if (!serial || !serial->init().has_value()) {
+        std::fprintf(stderr, "%s: cannot open the port\n", label);
+        return false;
+    }
+    for (const auto& t : adapters::hardware::serialLinkTuning(*serial)) {
+        std::fprintf(stderr, "%s: %-13s %s  %s\n", label, t.setting.c_str(),
+                     t.applied ? "on " : "off", t.detail.c_str());
+    }
+    Pn532RawChannel raw(*serial, waker.get());
+
+    // The first command carries the wake preamble and is not timed
+    auto warm = raw.transceive(adapters::hardware::PN532_CMD_SAM_CONFIGURATION, {0x01, 0x14, 0x01},
+                               COMMAND_TIMEOUT_MS, true);
+    if (std::holds_alternative<core::ports::NfcError>(warm)) {
+        std::fprintf(stderr, "%s: PN532 did not answer: %s\n", label,
+                     std::get<core::ports::NfcError>(warm).message.c_str());
+        return false;
+    }
+
+    for (const auto& cmd : commandMix()) {
+        std::vector<double> samples;
+        samples.reserve(static_cast<size_t>(iterations));
+        int failures = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto start = Clock::now();
+            auto res = raw.transceive(cmd.code, cmd.params, COMMAND_TIMEOUT_MS);
+            if (std::holds_alternative<core::ports::NfcError>(res)) {
+                ++failures;
+                continue;
+            }
+            samples.push_back(elapsedUs(start));
+        }
+        const Stats s = summarize(std::move(samples));
+        std::printf("| %-14s | %-18s | %8.0f | %8.0f | %8.0f | %8.0f | %6.0f | %d |\n",
+                    label, cmd.name, s.meanUs, s.p50Us, s.p99Us, s.maxUs,
+                    s.meanUs > 0 ? 1e6 / s.meanUs : 0.0, failures);
+    }
+
+    if (measureCancel) {
+        // Nothing is sent, so the wait can only end through the waker
+        std::vector<double> samples;
+        for (int i = 0; i < std::min(iterations, 50); ++i) {
+            waker->clear();
+            Clock::time_point wokeAt;
+            std::thread canceller([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                wokeAt = Clock::now();
+                waker->wake();
+            });
+            auto res = raw.transceive(PN532_CMD_GET_FIRMWARE_VERSION, {}, COMMAND_TIMEOUT_MS, false);
+            const auto returnedAt = Clock::now();
+            canceller.join();
+            (void)res;
+            samples.push_back(std::chrono::duration<double, std::micro>(returnedAt - wokeAt).count());
+            // The PN532 may still answer the interrupted command
+            waker->clear();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            (void)serial->flush();
+        }
+        const Stats s = summarize(std::move(samples));
+        std::printf("| %-14s | %-18s | %8.0f | %8.0f | %8.0f | %8.0f | - | - |\n",
+                    label, "cancel", s.meanUs, s.p50Us, s.p99Us, s.maxUs);
+    }
+
+    serial->close();
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <port> [iterations]\n", argv[0]);
+        return 2;
+    }
+    const std::string port = argv[1];
+    const int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 500;
+
+    std::printf("| backend        | command            | mean µs  | p50 µs   | p99 µs   | max µs   | rt/s   | failures |\n");
+    std::printf("|---|---|---|---|---|---|---|---|\n");
+    auto waker = std::make_shared<SerialWaker>();
+    bool ok = runBackend("termios",
+                         adapters::hardware::createPlatformSerialBus(port, 115200, SerialBackend::Termios),
+                         waker, false, iterations);
+#if defined(__linux__)
+    ok = runBackend("event/untuned",
+                    std::make_unique<adapters::hardware::SerialBusLinux>(port, 115200, waker, false),
+                    waker, false, iterations) && ok;
+    ok = runBackend("event",
+                    adapters::hardware::createPlatformSerialBus(port, 115200, SerialBackend::Event, waker),
+                    waker, true, iterations) && ok;
+#endif
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,303 @@
+#include "DesfireCardModel.h"
+#include "adapters/hardware/DesfireAesSession.h"
+#include <chrono>
+#include <cstring>
+
+using adapters::hardware::desfireCrc32;
+using core::ports::IAesKey;
+
+namespace sim {
+
+namespace {
+
+constexpr uint8_t ST_OK                = 0x00;
+constexpr uint8_t ST_ILLEGAL_COMMAND   = 0x1C;
+constexpr uint8_t ST_INTEGRITY_ERROR   = 0x1E;
+constexpr uint8_t ST_LENGTH_ERROR      = 0x7E;
+constexpr uint8_t ST_PERMISSION_DENIED = 0x9D;
+constexpr uint8_t ST_APP_NOT_FOUND     = 0xA0;
+constexpr uint8_t ST_AUTH_ERROR        = 0xAE;
+constexpr uint8_t ST_ADDITIONAL_FRAME  = 0xAF;
+constexpr uint8_t ST_FILE_NOT_FOUND    = 0xF0;
+
+constexpr uint32_t FREE_MEMORY = 7456; // 8 KB EV1 with one small application
+
+} // anonymous namespace
+
+DesfireCardModel::DesfireCardModel(const std::array<std::array<uint8_t, 16>, 2>& keys,
+                                   const std::array<uint8_t, 32>& file,
+                                   bool ev2Hardware)
+    : _file(file), _ev2Hardware(ev2Hardware) {
+    for (size_t i = 0; i < keys.size(); ++i) _keys[i] = _crypto.createAesKey(keys[i].data(), 16);
+}
+
+core::ports::Result<std::vector<uint8_t>> DesfireCardModel::transceive(const std::vector<uint8_t>& frame) {
+    const auto t0 = std::chrono::steady_clock::now();
+    std::vector<uint8_t> out;
+    if (frame.size() >= 5 && frame[0] == 0x90 && frame[2] == 0x00 && frame[3] == 0x00) {
+        // ISO 7816 wrapping: 90 INS 00 00 Lc data [Le] -> data 91 status
+        const size_t lc = frame[4];
+        std::vector<uint8_t> native{frame[1]};
+        if (frame.size() >= 5 + lc) native.insert(native.end(), frame.begin() + 5, frame.begin() + 5 + static_cast<std::ptrdiff_t>(lc));
+        const std::vector<uint8_t> answer = handle(native);
+        out.assign(answer.begin() + 1, answer.end());
+        out.push_back(0x91);
+        out.push_back(answer[0]);
+    } else if (frame.size() >= 4 && frame[0] == 0x00 && frame[1] == 0xA4) {
+        out = {0x90, 0x00}; // ISO SELECT of the DESFire DF name
+    } else if (!frame.empty()) {
+        out = handle(frame);
+    }
+    cardNs += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - t0).count());
+    return out;
+}
+
+void DesfireCardModel::activate() {
+    _selected = 0;
+    _pendingCmd = 0;
+    dropAuth();
+}
+
+std::vector<uint8_t> DesfireCardModel::handle(const std::vector<uint8_t>& frame) {
+    const uint8_t cmd = frame[0];
+
+    if (cmd == 0xAF) {
+        if (_pendingCmd == 0x60) return getVersion(++_versionPart);
+        if ((_pendingCmd == 0xAA || _pendingCmd == 0x71 || _pendingCmd == 0x77) && frame.size() == 33) {
+            return finishAuth(frame);
+        }
+        _pendingCmd = 0;
+        return {ST_ILLEGAL_COMMAND};
+    }
+    _pendingCmd = 0;
+
+    switch (cmd) {
+        case 0x60:
+            _pendingCmd = 0x60;
+            _versionPart = 0;
+            return getVersion(0);
+
+        case 0x5A: { // SelectApplication
+            if (frame.size() != 4) return {ST_LENGTH_ERROR};
+            const uint32_t aid = frame[1] | (frame[2] << 8) | (frame[3] << 16);
+            if (aid != 0 && aid != VAULT_AID) return {ST_APP_NOT_FOUND};
+            _selected = aid;
+            dropAuth();
+            return {ST_OK};
+        }
+
+        case 0x6A: // GetApplicationIDs
+            if (_selected != 0) return {ST_PERMISSION_DENIED};
+            return {ST_OK, 0x50, 0x57, 0x00};
+
+        case 0x6E: // GetFreeMemory
+            return {ST_OK, static_cast<uint8_t>(FREE_MEMORY), static_cast<uint8_t>(FREE_MEMORY >> 8), 0x00};
+
+        case 0x64: // GetKeyVersion
+            if (frame.size() != 2) return {ST_LENGTH_ERROR};
+            if (!vaultSelected()) return {ST_OK, 0x00}; // PICC master key, never changed
+            if (frame[1] > 1) return {ST_PERMISSION_DENIED};
+            return {ST_OK, _keyVersions[frame[1]]};
+
+        case 0x6F: // GetFileIDs
+            if (!vaultSelected()) return {ST_PERMISSION_DENIED};
+            return {ST_OK, 0x00};
+
+        case 0xAA:
+        case 0x71:
+            return startAuth(frame);
+
+        case 0x77:
+            if (!_ev2) return {ST_PERMISSION_DENIED};
+            return startAuth(frame);
+
+        case 0xBD: // ReadData
+            if (!vaultSelected()) return {ST_FILE_NOT_FOUND};
+            if (frame.size() < 8 || frame[1] != 0x00) return {ST_FILE_NOT_FOUND};
+            if (!_enc || _keyNo != 1) return {ST_AUTH_ERROR};
+            return _ev2 ? readEv2(frame) : readEv1(frame);
+    }
+    return {ST_ILLEGAL_COMMAND};
+}
+
+std::vector<uint8_t> DesfireCardModel::getVersion(uint8_t part) {
+    switch (part) {
+        case 0: { // hardware: vendor NXP, type DESFire, major 0x01 (EV1) or 0x12 (EV2)
+            const uint8_t major = _ev2Hardware ? 0x12 : 0x01;
+            return {ST_ADDITIONAL_FRAME, 0x04, 0x01, 0x01, major, 0x00, 0x18, 0x05};
+        }
+        case 1: {
+            const uint8_t major = _ev2Hardware ? 0x12 : 0x01;
+            return {ST_ADDITIONAL_FRAME, 0x04, 0x01, 0x01, major, 0x00, 0x18, 0x05};
+        }
+        default: {
+            _pendingCmd = 0;
+            std::vector<uint8_t> out{ST_OK};
+            out.insert(out.end(), _uid.begin(), _uid.end());
+            const uint8_t batch[7] = {0xBA, 0x55, 0x0F, 0xB1, 0x10, 0x26, 0x14};
+            out.insert(out.end(), batch, batch + 7);
+            return out;
+        }
+    }
+}
+
+std::vector<uint8_t> DesfireCardModel::startAuth(const std::vector<uint8_t>& frame) {
+    const uint8_t cmd = frame[0];
+    if (frame.size() < 2) return {ST_LENGTH_ERROR};
+    if (cmd == 0x71 && !_ev2Hardware) return {ST_ILLEGAL_COMMAND};
+    if (!vaultSelected() || frame[1] > 1) return {ST_PERMISSION_DENIED};
+
+    _pendingCmd = cmd;
+    _keyNo = frame[1] & 0x01;
+    random(_rndB, 16);
+    std::memset(_iv, 0, 16);
+    std::vector<uint8_t> out(17);
+    out[0] = ST_ADDITIONAL_FRAME;
+    _keys[_keyNo]->encryptCbc(_iv, _rndB, out.data() + 1, 16);
+    if (cmd != 0xAA) std::memset(_iv, 0, 16);
+    return out;
+}
+
+std::vector<uint8_t> DesfireCardModel::finishAuth(const std::vector<uint8_t>& frame) {
+    const uint8_t pending = _pendingCmd;
+    _pendingCmd = 0;
+    IAesKey& key = *_keys[_keyNo];
+    uint8_t plain[32];
+    key.decryptCbc(_iv, frame.data() + 1, plain, 32);
+
+    // RndB' must come back rotated; anything else is a wrong key
+    for (int i = 0; i < 15; ++i) {
+        if (plain[16 + i] != _rndB[i + 1]) {
+            dropAuth();
+            return {ST_AUTH_ERROR};
+        }
+    }
+    if (plain[31] != _rndB[0]) {
+        dropAuth();
+        return {ST_AUTH_ERROR};
+    }
+
+    uint8_t answer[32] = {};
+    size_t answerLen = 16;
+    uint8_t* rotA = answer;
+    if (pending == 0x71) {
+        random(_ti, 4);
+        _ctr = 0;
+        std::memcpy(answer, _ti, 4);
+        rotA = answer + 4;
+        answerLen = 32;
+    }
+    for (int i = 0; i < 15; ++i) rotA[i] = plain[i + 1];
+    rotA[15] = plain[0];
+    std::vector<uint8_t> out(1 + answerLen);
+    out[0] = ST_OK;
+    if (pending != 0xAA) std::memset(_iv, 0, 16);
+    key.encryptCbc(_iv, answer, out.data() + 1, answerLen);
+
+    if (pending == 0xAA) {
+        uint8_t sk[16];
+        std::memcpy(sk, plain, 4);
+        std::memcpy(sk + 4, _rndB, 4);
+        std::memcpy(sk + 8, plain + 12, 4);
+        std::memcpy(sk + 12, _rndB + 12, 4);
+        _enc = _crypto.createAesKey(sk, 16);
+        _mac.reset();
+        _ev2 = false;
+    } else {
+        uint8_t sv[32] = {0xA5, 0x5A, 0x00, 0x01, 0x00, 0x80};
+        std::memcpy(sv + 6, plain, 2);
+        for (int i = 0; i < 6; ++i) sv[8 + i] = plain[2 + i] ^ _rndB[i];
+        std::memcpy(sv + 14, _rndB + 6, 10);
+        std::memcpy(sv + 24, plain + 8, 8);
+        const uint8_t zero[16] = {};
+        uint8_t k[16];
+        key.cmac(zero, sv, 32, k);
+        _enc = _crypto.createAesKey(k, 16);
+        sv[0] = 0x5A;
+        sv[1] = 0xA5;
+        key.cmac(zero, sv, 32, k);
+        _mac = _crypto.createAesKey(k, 16);
+        _ev2 = true;
+    }
+    std::memset(_iv, 0, 16);
+    return out;
+}
+
+std::vector<uint8_t> DesfireCardModel::plainFile(const std::vector<uint8_t>& frame, size_t& len) {
+    const size_t offset = frame[2] | (frame[3] << 8) | (frame[4] << 16);
+    len = frame[5] | (frame[6] << 8) | (frame[7] << 16);
+    if (offset >= _file.size()) {
+        len = 0;
+        return {};
+    }
+    if (len == 0 || offset + len > _file.size()) len = _file.size() - offset;
+    return std::vector<uint8_t>(_file.begin() + static_cast<std::ptrdiff_t>(offset),
+                                _file.begin() + static_cast<std::ptrdiff_t>(offset + len));
+}
+
+std::vector<uint8_t> DesfireCardModel::readEv1(const std::vector<uint8_t>& frame) {
+    _enc->cmac(_iv, frame.data(), frame.size(), _iv);
+    size_t len = 0;
+    std::vector<uint8_t> plain = plainFile(frame, len);
+    plain.resize(((len + 4 + 15) / 16) * 16, 0);
+    const uint8_t status = ST_OK;
+    const uint32_t crc = desfireCrc32(&status, 1, desfireCrc32(plain.data(), len));
+    for (int i = 0; i < 4; ++i) plain[len + i] = static_cast<uint8_t>(crc >> (8 * i));
+    std::vector<uint8_t> out(1 + plain.size());
+    out[0] = ST_OK;
+    _enc->encryptCbc(_iv, plain.data(), out.data() + 1, plain.size());
+    return out;
+}
+
+void DesfireCardModel::mac(uint8_t code, const uint8_t* data, size_t len, uint8_t mact[8]) const {
+    std::vector<uint8_t> in{code, static_cast<uint8_t>(_ctr), static_cast<uint8_t>(_ctr >> 8)};
+    in.insert(in.end(), _ti, _ti + 4);
+    in.insert(in.end(), data, data + len);
+    const uint8_t zero[16] = {};
+    uint8_t full[16];
+    _mac->cmac(zero, in.data(), in.size(), full);
+    for (int i = 0; i < 8; ++i) mact[i] = full[2 * i + 1];
+}
+
+std::vector<uint8_t> DesfireCardModel::readEv2(const std::vector<uint8_t>& frame) {
+    uint8_t expected[8];
+    if (frame.size() != 16) return {ST_INTEGRITY_ERROR};
+    mac(frame[0], frame.data() + 1, 7, expected);
+    if (std::memcmp(expected, frame.data() + 8, 8) != 0) return {ST_INTEGRITY_ERROR};
+    ++_ctr;
+    size_t len = 0;
+    std::vector<uint8_t> plain = plainFile(frame, len);
+    plain.push_back(0x80);
+    plain.resize(((len + 16) / 16) * 16, 0);
+    uint8_t ivBlock[16] = {0x5A, 0xA5};
+    std::memcpy(ivBlock + 2, _ti, 4);
+    ivBlock[6] = static_cast<uint8_t>(_ctr);
+    ivBlock[7] = static_cast<uint8_t>(_ctr >> 8);
+    uint8_t iv[16];
+    _enc->encryptEcb(ivBlock, iv, 16);
+    std::vector<uint8_t> out(1 + plain.size() + 8);
+    out[0] = ST_OK;
+    _enc->encryptCbc(iv, plain.data(), out.data() + 1, plain.size());
+    mac(ST_OK, out.data() + 1, plain.size(), out.data() + 1 + plain.size());
+    return out;
+}
+
+// xorshift64: deterministic so runs are comparable
+void DesfireCardModel::random(uint8_t* out, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        _rng ^= _rng << 13;
+        _rng ^= _rng >> 7;
+        _rng ^= _rng << 17;
+        out[i] = static_cast<uint8_t>(_rng);
+    }
+}
+
+void DesfireCardModel::dropAuth() {
+    _enc.reset();
+    _mac.reset();
+    _ev2 = false;
+    std::memset(_iv, 0, 16);
+}
+
+} // namespace sim
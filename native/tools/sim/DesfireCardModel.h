@@ -0,0 +1,83 @@
+#pragma once
+#include "core/ports/ICryptoProvider.h"
+#include "core/ports/INfcReader.h"
+#include "adapters/crypto/PortableAesProvider.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sim {
+
+/**
+ * In-process DESFire card for benchmarks: EV1 AuthenticateAES and EV2
+ * First/NonFirst, enciphered ReadData in both schemes, and the plain
+ * commands the adapter's flows issue (GetVersion, SelectApplication,
+ * GetApplicationIDs, GetFreeMemory, GetKeyVersion, GetFileIDs). Frames
+ * are accepted native (command byte + data) or ISO 7816 wrapped (CLA 0x90)
+ * and answered in the same form.
+ *
+ * Commands that change the card (ChangeKey, CreateApplication, WriteData,
+ * FormatPICC, ...) are answered with ILLEGAL_COMMAND; the model is a
+ * provisioned vault card, not a blank one.
+ *
+ * Card-side crypto always runs on the portable provider. Its time is
+ * accumulated in `cardNs` so host-side measurements can subtract it.
+ */
+class DesfireCardModel {
+public:
+    // Vault card: application 50 57 00 with AES keys 0/1 and File 00
+    // (32 bytes, fully enciphered, read with key 1), left selected.
+    DesfireCardModel(const std::array<std::array<uint8_t, 16>, 2>& keys,
+                     const std::array<uint8_t, 32>& file,
+                     bool ev2Hardware = false);
+
+    uint64_t cardNs = 0;
+
+    // One native or ISO-wrapped frame in, the card's answer out.
+    core::ports::Result<std::vector<uint8_t>> transceive(const std::vector<uint8_t>& frame);
+
+    // RF activation: drops authentication and selects the PICC level, as a
+    // fresh ISO 14443-4 session does.
+    void activate();
+
+    const std::array<uint8_t, 7>& uid() const { return _uid; }
+
+private:
+    std::vector<uint8_t> handle(const std::vector<uint8_t>& frame);
+    std::vector<uint8_t> startAuth(const std::vector<uint8_t>& frame);
+    std::vector<uint8_t> finishAuth(const std::vector<uint8_t>& frame);
+    std::vector<uint8_t> getVersion(uint8_t part);
+    std::vector<uint8_t> plainFile(const std::vector<uint8_t>& frame, size_t& len);
+    std::vector<uint8_t> readEv1(const std::vector<uint8_t>& frame);
+    std::vector<uint8_t> readEv2(const std::vector<uint8_t>& frame);
+    void mac(uint8_t code, const uint8_t* data, size_t len, uint8_t mact[8]) const;
+    void random(uint8_t* out, size_t len);
+    void dropAuth();
+
+    bool vaultSelected() const { return _selected == VAULT_AID; }
+
+    static constexpr uint32_t VAULT_AID = 0x005750; // 50 57 00, LSB first
+
+    adapters::crypto::PortableAesProvider _crypto;
+    std::unique_ptr<core::ports::IAesKey> _keys[2];
+    uint8_t _keyVersions[2] = {1, 1};
+    std::array<uint8_t, 32> _file;
+    std::array<uint8_t, 7> _uid = {0x04, 0x53, 0x50, 0x4D, 0x32, 0x80, 0x11};
+    bool _ev2Hardware;
+    uint32_t _selected = VAULT_AID;
+
+    std::unique_ptr<core::ports::IAesKey> _enc;
+    std::unique_ptr<core::ports::IAesKey> _mac;
+    uint64_t _rng = 0x1234567ull;
+    uint8_t _pendingCmd = 0; // command awaiting an 0xAF continuation
+    uint8_t _versionPart = 0;
+    uint8_t _keyNo = 0;
+    bool _ev2 = false;
+    uint8_t _rndB[16] = {};
+    uint8_t _iv[16] = {};
+    uint8_t _ti[4] = {};
+    uint16_t _ctr = 0;
+};
+
+} // namespace sim
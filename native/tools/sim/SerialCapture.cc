@@ -0,0 +1,195 @@
+#include "SerialCapture.h"
+#include "adapters/timing/SteadyClock.h"
+#include "Error/Error.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace sim {
+
+namespace {
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool parseHex(const std::string& text, std::vector<uint8_t>& out) {
+    if (text.size() % 2 != 0) return false;
+    out.clear();
+    for (size_t i = 0; i < text.size(); i += 2) {
+        const int hi = hexValue(text[i]);
+        const int lo = hexValue(text[i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        out.push_back(static_cast<uint8_t>((hi << 4) | lo));
+    }
+    return true;
+}
+
+static etl::unexpected<error::Error> timeoutError() {
+    return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Timeout));
+}
+
+} // anonymous namespace
+
+bool loadCapture(const std::string& path, std::vector<CaptureRecord>& records, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    records.clear();
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string dir;
+        std::string hex;
+        CaptureRecord record;
+        if (!(fields >> dir >> record.atUs >> hex) || (dir != ">" && dir != "<") || !parseHex(hex, record.bytes)) {
+            error = path + ":" + std::to_string(lineNo) + ": malformed record";
+            return false;
+        }
+        record.fromHost = dir == ">";
+        records.push_back(std::move(record));
+    }
+    return true;
+}
+
+CaptureWriter::CaptureWriter(std::FILE* file, std::shared_ptr<core::ports::IClock> clock)
+    : _file(file),
+      _clock(clock ? std::move(clock) : adapters::timing::steadyClock()),
+      _start(_clock->now()) {}
+
+CaptureWriter::~CaptureWriter() {
+    if (_file) std::fclose(_file);
+}
+
+std::shared_ptr<CaptureWriter> CaptureWriter::open(const std::string& path,
+                                                   std::shared_ptr<core::ports::IClock> clock) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return nullptr;
+    std::fputs("# PN532 serial capture: > host->pn532, < pn532->host; <us since start> <hex>\n", file);
+    return std::make_shared<CaptureWriter>(file, std::move(clock));
+}
+
+uint64_t CaptureWriter::stamp() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(_clock->now() - _start).count());
+}
+
+void CaptureWriter::append(bool fromHost, const uint8_t* data, size_t len, uint64_t atUs) {
+    if (len == 0) return;
+    std::fprintf(_file, "%c %" PRIu64 " ", fromHost ? '>' : '<', atUs);
+    for (size_t i = 0; i < len; ++i) std::fprintf(_file, "%02x", data[i]);
+    std::fputc('\n', _file);
+}
+
+RecordingSerialBus::RecordingSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner,
+                                       std::shared_ptr<CaptureWriter> writer)
+    : SerialBusDecorator(std::move(inner)), _writer(std::move(writer)) {}
+
+etl::expected<void, error::Error> RecordingSerialBus::write(const etl::ivector<uint8_t>& data) {
+    // Stamped before the call: a blocking write's own transfer time belongs
+    // to the wait for the reply, which the replay reproduces
+    const uint64_t issuedAt = _writer->stamp();
+    auto result = inner().write(data);
+    if (result.has_value()) _writer->append(true, data.data(), data.size(), issuedAt);
+    return result;
+}
+
+etl::expected<size_t, error::Error> RecordingSerialBus::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    auto result = inner().read(buffer, length, timeoutMs);
+    if (result.has_value()) {
+        // New bytes are the last `count`, whether the backend appends or refills
+        const size_t count = std::min(result.value(), buffer.size());
+        _writer->append(false, buffer.data() + buffer.size() - count, count, _writer->stamp());
+    }
+    return result;
+}
+
+ReplaySerialBus::ReplaySerialBus(std::shared_ptr<ReplayScript> script, std::shared_ptr<core::ports::IClock> clock)
+    : _script(std::move(script)), _clock(clock ? std::move(clock) : adapters::timing::steadyClock()) {}
+
+etl::expected<void, error::Error> ReplaySerialBus::init() {
+    _pending.clear();
+    return {};
+}
+
+etl::expected<void, error::Error> ReplaySerialBus::write(const etl::ivector<uint8_t>& data) {
+    auto& records = _script->records;
+    size_t& next = _script->next;
+
+    // PN532 bytes the host never read in the recording (flushed, or left
+    // behind by a timeout) are skipped, not delivered late.
+    while (next < records.size() && !records[next].fromHost) ++next;
+    if (next >= records.size()) {
+        ++_script->divergences; // capture exhausted: the PN532 goes silent
+        return {};
+    }
+
+    const CaptureRecord& sent = records[next++];
+    if (sent.bytes.size() != data.size() || !std::equal(sent.bytes.begin(), sent.bytes.end(), data.begin())) {
+        ++_script->divergences;
+    }
+
+    const auto writtenAt = _clock->now();
+    while (next < records.size() && !records[next].fromHost) {
+        const CaptureRecord& reply = records[next++];
+        Chunk chunk;
+        chunk.due = writtenAt + std::chrono::microseconds(reply.atUs - std::min(reply.atUs, sent.atUs));
+        chunk.bytes = reply.bytes;
+        _pending.push_back(std::move(chunk));
+    }
+    return {};
+}
+
+etl::expected<size_t, error::Error> ReplaySerialBus::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    const auto deadline = _clock->now() + std::chrono::milliseconds(timeoutMs);
+    if (_pending.empty() || _pending.front().due > deadline) {
+        _clock->sleepFor(deadline - _clock->now());
+        return timeoutError();
+    }
+    const auto now = _clock->now();
+    if (_pending.front().due > now) _clock->sleepFor(_pending.front().due - now);
+
+    size_t n = 0;
+    const auto ready = _clock->now();
+    while (n < length && !_pending.empty() && _pending.front().due <= ready && buffer.size() < buffer.max_size()) {
+        Chunk& chunk = _pending.front();
+        while (n < length && chunk.offset < chunk.bytes.size() && buffer.size() < buffer.max_size()) {
+            buffer.push_back(chunk.bytes[chunk.offset++]);
+            ++n;
+        }
+        if (chunk.offset == chunk.bytes.size()) _pending.pop_front();
+    }
+    return n;
+}
+
+etl::expected<size_t, error::Error> ReplaySerialBus::available() {
+    const auto now = _clock->now();
+    size_t n = 0;
+    for (const auto& chunk : _pending) {
+        if (chunk.due > now) break;
+        n += chunk.bytes.size() - chunk.offset;
+    }
+    return n;
+}
+
+etl::expected<void, error::Error> ReplaySerialBus::flush() {
+    _pending.clear();
+    return {};
+}
+
+void ReplaySerialBus::close() {
+    _pending.clear();
+}
+
+} // namespace sim
@@ -0,0 +1,106 @@
+#pragma once
+#include "adapters/hardware/SerialBusDecorator.h"
+#include "core/ports/IClock.h"
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+/**
+ * Serial traffic capture, one record per bus call that moved bytes:
+ *
+ *   > <µs since capture start> <hex>     host -> PN532, stamped when written
+ *   < <µs since capture start> <hex>     PN532 -> host, stamped when read
+ *
+ * Lines starting with '#' are comments. Read timeouts are not recorded;
+ * a replay reproduces them by having nothing due.
+ */
+struct CaptureRecord {
+    bool fromHost = false;
+    uint64_t atUs = 0;
+    std::vector<uint8_t> bytes;
+};
+
+// Returns false with `error` set when the file cannot be read or a line
+// does not parse.
+bool loadCapture(const std::string& path, std::vector<CaptureRecord>& records, std::string& error);
+
+// Appends records to a capture file. Shared by every RecordingSerialBus of
+// one run so reconnects land in the same capture.
+class CaptureWriter {
+public:
+    CaptureWriter(std::FILE* file, std::shared_ptr<core::ports::IClock> clock);
+    ~CaptureWriter();
+
+    static std::shared_ptr<CaptureWriter> open(const std::string& path,
+                                               std::shared_ptr<core::ports::IClock> clock = nullptr);
+
+    // Microseconds since the capture started.
+    uint64_t stamp() const;
+
+    void append(bool fromHost, const uint8_t* data, size_t len, uint64_t atUs);
+
+private:
+    std::FILE* _file;
+    std::shared_ptr<core::ports::IClock> _clock;
+    core::ports::IClock::TimePoint _start;
+};
+
+// Decorator that records everything written and read through it.
+class RecordingSerialBus : public adapters::hardware::SerialBusDecorator {
+public:
+    RecordingSerialBus(std::unique_ptr<comms::serial::ISerialBus> inner, std::shared_ptr<CaptureWriter> writer);
+
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+
+private:
+    std::shared_ptr<CaptureWriter> _writer;
+};
+
+// Playback position in a capture, shared by the ReplaySerialBus of every
+// connection in a run.
+struct ReplayScript {
+    std::vector<CaptureRecord> records;
+    size_t next = 0;
+    uint64_t divergences = 0; // writes that did not match the capture
+};
+
+/**
+ * Plays a capture back as the PN532. Each write consumes the next host
+ * record (counting a divergence when the bytes differ) and schedules the
+ * PN532 records that follow it at their captured offsets from that write,
+ * on `clock`. Reads deliver bytes once they are due, waiting up to the
+ * timeout for them, so replayed latency matches the recording.
+ *
+ * init() and close() do not rewind: a reconnect continues the script, as
+ * the recorded session did.
+ */
+class ReplaySerialBus : public comms::serial::ISerialBus {
+public:
+    ReplaySerialBus(std::shared_ptr<ReplayScript> script, std::shared_ptr<core::ports::IClock> clock = nullptr);
+
+    etl::expected<void, error::Error>   init() override;
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+    etl::expected<size_t, error::Error> available() override;
+    etl::expected<void, error::Error>   flush() override;
+    void                                close() override;
+
+private:
+    struct Chunk {
+        core::ports::IClock::TimePoint due;
+        std::vector<uint8_t> bytes;
+        size_t offset = 0;
+    };
+
+    std::shared_ptr<ReplayScript> _script;
+    std::shared_ptr<core::ports::IClock> _clock;
+    std::deque<Chunk> _pending;
+};
+
+} // namespace sim
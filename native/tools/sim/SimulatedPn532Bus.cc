@@ -0,0 +1,258 @@
+#include "SimulatedPn532Bus.h"
+#include "adapters/hardware/Pn532Frames.h"
+#include "adapters/timing/SteadyClock.h"
+#include "Error/Error.h"
+#include <chrono>
+#include <variant>
+
+using namespace adapters::hardware;
+
+namespace sim {
+
+namespace {
+
+constexpr uint8_t CMD_DIAGNOSE               = 0x00;
+constexpr uint8_t CMD_GET_FIRMWARE_VERSION   = 0x02;
+constexpr uint8_t CMD_READ_REGISTER          = 0x06;
+constexpr uint8_t CMD_WRITE_REGISTER         = 0x08;
+constexpr uint8_t CMD_SET_PARAMETERS         = 0x12;
+constexpr uint8_t CMD_IN_COMMUNICATE_THRU    = 0x42;
+constexpr uint8_t CMD_IN_DESELECT            = 0x44;
+constexpr uint8_t CMD_IN_LIST_PASSIVE_TARGET = 0x4A;
+constexpr uint8_t CMD_IN_RELEASE             = 0x52;
+constexpr uint8_t CMD_IN_SELECT              = 0x54;
+
+// PN532 status codes (user manual §7.1)
+constexpr uint8_t PN_OK        = 0x00;
+constexpr uint8_t PN_TIMEOUT   = 0x01;
+constexpr uint8_t PN_NOT_READY = 0x27; // command not acceptable in context
+
+static etl::unexpected<error::Error> timeoutError() {
+    return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Timeout));
+}
+
+static etl::unexpected<error::Error> ioError() {
+    return etl::unexpected<error::Error>(error::Error::fromHardware(error::HardwareError::Io));
+}
+
+} // anonymous namespace
+
+SimulatedPn532Bus::SimulatedPn532Bus(DesfireCardModel* card, std::shared_ptr<core::ports::IClock> clock)
+    : _card(card), _clock(clock ? std::move(clock) : adapters::timing::steadyClock()) {}
+
+void SimulatedPn532Bus::insertCard(DesfireCardModel* card) {
+    _card = card;
+    _targetActive = false;
+}
+
+etl::expected<void, error::Error> SimulatedPn532Bus::init() {
+    _open = true;
+    _rx.clear();
+    _tx.clear();
+    return {};
+}
+
+etl::expected<void, error::Error> SimulatedPn532Bus::write(const etl::ivector<uint8_t>& data) {
+    if (!_open) return ioError();
+    ++_writes;
+    chargeWire(data.size());
+    for (auto b : data) {
+        if (_asleep && b == 0x55) _asleep = false; // HSU wake-up
+        if (!_asleep) _rx.push_back(b);
+    }
+    processInput();
+    return {};
+}
+
+etl::expected<size_t, error::Error> SimulatedPn532Bus::read(
+    etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) {
+    if (!_open) return ioError();
+    ++_reads;
+    if (_tx.empty()) {
+        _clock->sleepFor(std::chrono::milliseconds(timeoutMs));
+        return timeoutError();
+    }
+    size_t n = 0;
+    while (n < length && !_tx.empty() && buffer.size() < buffer.max_size()) {
+        buffer.push_back(_tx.front());
+        _tx.pop_front();
+        ++n;
+    }
+    chargeWire(n);
+    return n;
+}
+
+etl::expected<size_t, error::Error> SimulatedPn532Bus::available() {
+    if (!_open) return ioError();
+    return _tx.size();
+}
+
+etl::expected<void, error::Error> SimulatedPn532Bus::flush() {
+    _tx.clear();
+    return {};
+}
+
+void SimulatedPn532Bus::close() {
+    _open = false;
+    _rx.clear();
+    _tx.clear();
+}
+
+void SimulatedPn532Bus::processInput() {
+    for (;;) {
+        const FrameScan scan = scanFrame(_rx.data(), _rx.size());
+        if (scan.status == FrameScanStatus::Incomplete) {
+            _rx.erase(_rx.begin(), _rx.begin() + static_cast<std::ptrdiff_t>(scan.start));
+            return;
+        }
+        const std::vector<uint8_t> data(_rx.begin() + static_cast<std::ptrdiff_t>(scan.dataOffset),
+                                        _rx.begin() + static_cast<std::ptrdiff_t>(scan.dataOffset + scan.dataLength));
+        const FrameScanStatus status = scan.status;
+        _rx.erase(_rx.begin(), _rx.begin() + static_cast<std::ptrdiff_t>(scan.start + scan.length));
+
+        // Host ACK/NACK (abort, resend request) and corrupt frames get no answer
+        if (status != FrameScanStatus::Information) continue;
+        if (data.size() < 2 || data[0] != PN532_TFI_HOST_TO_PN532) continue;
+
+        ++_commands;
+        static const std::vector<uint8_t> ack = {0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00};
+        _tx.insert(_tx.end(), ack.begin(), ack.end());
+
+        bool syntaxError = false;
+        std::vector<uint8_t> payload = execute(data[1], data.data() + 2, data.size() - 2, syntaxError);
+        if (syntaxError) {
+            static const std::vector<uint8_t> errorFrame = {0x00, 0x00, 0xFF, 0x01, 0xFF, 0x7F, 0x81, 0x00};
+            _tx.insert(_tx.end(), errorFrame.begin(), errorFrame.end());
+            continue;
+        }
+        std::vector<uint8_t> response{PN532_TFI_PN532_TO_HOST, static_cast<uint8_t>(data[1] + 1)};
+        response.insert(response.end(), payload.begin(), payload.end());
+        queueFrame(response);
+        if (data[1] == PN532_CMD_POWER_DOWN) _asleep = true; // after answering
+    }
+}
+
+std::vector<uint8_t> SimulatedPn532Bus::execute(uint8_t command, const uint8_t* params, size_t len,
+                                                bool& syntaxError) {
+    switch (command) {
+        case CMD_DIAGNOSE:
+            if (len >= 1 && params[0] == 0x00) return std::vector<uint8_t>(params, params + len); // line test echoes
+            return {PN_OK};
+
+        case CMD_GET_FIRMWARE_VERSION:
+            return {0x32, 0x01, 0x06, 0x07};
+
+        case PN532_CMD_GET_GENERAL_STATUS: {
+            std::vector<uint8_t> out{_lastError, static_cast<uint8_t>(_fieldOn ? 1 : 0),
+                                     static_cast<uint8_t>(_targetActive ? 1 : 0)};
+            if (_targetActive) out.insert(out.end(), {0x01, 0x00, 0x00, 0x10}); // Tg 1, 106 kbps, ISO 14443-4A
+            out.push_back(0x00); // SAM status
+            return out;
+        }
+
+        case CMD_READ_REGISTER:
+            return std::vector<uint8_t>(len / 2, 0x00);
+
+        case CMD_WRITE_REGISTER:
+        case CMD_SET_PARAMETERS:
+        case PN532_CMD_SAM_CONFIGURATION:
+            return {};
+
+        case PN532_CMD_POWER_DOWN:
+            _fieldOn = false;
+            _targetActive = false;
+            return {PN_OK};
+
+        case PN532_CMD_RF_CONFIGURATION:
+            if (len >= 2 && params[0] == 0x01) {
+                _fieldOn = (params[1] & 0x01) != 0;
+                if (!_fieldOn) _targetActive = false;
+            }
+            return {};
+
+        case CMD_IN_LIST_PASSIVE_TARGET: {
+            _fieldOn = true;
+            if (!_card) {
+                _targetActive = false;
+                return {0x00}; // NbTg = 0
+            }
+            _card->activate();
+            _targetActive = true;
+            std::vector<uint8_t> out{0x01, 0x01, 0x03, 0x44, 0x20, 0x07};
+            out.insert(out.end(), _card->uid().begin(), _card->uid().end());
+            out.insert(out.end(), {0x06, 0x75, 0x77, 0x81, 0x02, 0x80}); // DESFire ATS
+            return out;
+        }
+
+        case PN532_CMD_IN_DATA_EXCHANGE:
+            if (len < 1) {
+                syntaxError = true;
+                return {};
+            }
+            return exchange(params + 1, len - 1);
+
+        case CMD_IN_COMMUNICATE_THRU:
+            return exchange(params, len);
+
+        case CMD_IN_DESELECT:
+        case CMD_IN_RELEASE:
+            _targetActive = false;
+            return {PN_OK};
+
+        case CMD_IN_SELECT:
+            if (!_card) return {PN_TIMEOUT};
+            _card->activate();
+            _targetActive = true;
+            return {PN_OK};
+    }
+    syntaxError = true;
+    return {};
+}
+
+std::vector<uint8_t> SimulatedPn532Bus::exchange(const uint8_t* frame, size_t len) {
+    if (!_targetActive) {
+        _lastError = PN_NOT_READY;
+        return {PN_NOT_READY};
+    }
+    if (!_card) {
+        _lastError = PN_TIMEOUT;
+        return {PN_TIMEOUT};
+    }
+    auto res = _card->transceive(std::vector<uint8_t>(frame, frame + len));
+    if (std::holds_alternative<core::ports::NfcError>(res)) {
+        _lastError = PN_TIMEOUT;
+        return {PN_TIMEOUT};
+    }
+    _lastError = PN_OK;
+    const auto& answer = std::get<std::vector<uint8_t>>(res);
+    std::vector<uint8_t> out{PN_OK};
+    out.insert(out.end(), answer.begin(), answer.end());
+    return out;
+}
+
+void SimulatedPn532Bus::chargeWire(size_t bytes) {
+    if (_baud == 0 || bytes == 0) return;
+    _clock->sleepFor(std::chrono::nanoseconds(bytes * 10ull * 1000000000ull / _baud));
+}
+
+void SimulatedPn532Bus::queueFrame(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> frame;
+    const size_t len = data.size();
+    frame.insert(frame.end(), {0x00, 0x00, 0xFF});
+    if (len <= 0xFF) {
+        frame.push_back(static_cast<uint8_t>(len));
+        frame.push_back(static_cast<uint8_t>(0x100 - len));
+    } else {
+        const uint8_t lenM = static_cast<uint8_t>(len >> 8);
+        const uint8_t lenL = static_cast<uint8_t>(len & 0xFF);
+        frame.insert(frame.end(), {0xFF, 0xFF, lenM, lenL, static_cast<uint8_t>(0x100 - ((lenM + lenL) & 0xFF))});
+    }
+    uint8_t sum = 0;
+    for (auto b : data) sum = static_cast<uint8_t>(sum + b);
+    frame.insert(frame.end(), data.begin(), data.end());
+    frame.push_back(static_cast<uint8_t>(0x100 - sum));
+    frame.push_back(0x00);
+    _tx.insert(_tx.end(), frame.begin(), frame.end());
+}
+
+} // namespace sim
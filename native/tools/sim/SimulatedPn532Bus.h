@@ -0,0 +1,80 @@
+#pragma once
+#include "DesfireCardModel.h"
+#include "Comms/Serial/ISerialBus.hpp"
+#include "core/ports/IClock.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace sim {
+
+/**
+ * PN532 on the far end of an HSU link, in process. Every complete command
+ * frame written is answered with an ACK and then a response frame, which
+ * become readable together. Supported commands:
+ *
+ *   Diagnose, GetFirmwareVersion, GetGeneralStatus, Read/WriteRegister,
+ *   SetParameters, SAMConfiguration, PowerDown (woken by 0x55),
+ *   RFConfiguration, InListPassiveTarget (one ISO 14443-4 DESFire target),
+ *   InDataExchange / InCommunicateThru relayed to the card model,
+ *   InDeselect, InRelease, InSelect.
+ *
+ * Anything else gets the PN532 syntax error frame. Frames with a bad
+ * checksum are ignored without an ACK, as the chip does.
+ *
+ * With no bytes queued, read() sleeps out its timeout on the bus clock:
+ * nothing can arrive asynchronously, so that is exactly what a silent
+ * reader costs. On a VirtualClock that sleep only advances simulated time.
+ * setLineRate() additionally charges each byte's transfer time (10 bits
+ * per byte) to the clock as it is written or read.
+ */
+class SimulatedPn532Bus : public comms::serial::ISerialBus {
+public:
+    // `card` may be null for an empty field; the bus does not own it.
+    // A null `clock` selects the steady clock.
+    explicit SimulatedPn532Bus(DesfireCardModel* card = nullptr,
+                               std::shared_ptr<core::ports::IClock> clock = nullptr);
+
+    // 0 (the default) makes the wire free.
+    void setLineRate(uint32_t baud) { _baud = baud; }
+
+    void insertCard(DesfireCardModel* card);
+    void removeCard() { insertCard(nullptr); }
+
+    etl::expected<void, error::Error>   init() override;
+    etl::expected<void, error::Error>   write(const etl::ivector<uint8_t>& data) override;
+    etl::expected<size_t, error::Error> read(etl::ivector<uint8_t>& buffer, size_t length, uint32_t timeoutMs) override;
+    etl::expected<size_t, error::Error> available() override;
+    etl::expected<void, error::Error>   flush() override;
+    void                                close() override;
+
+    // Command frames answered since construction, and bus calls made.
+    uint64_t commands() const { return _commands; }
+    uint64_t reads() const { return _reads; }
+    uint64_t writes() const { return _writes; }
+
+private:
+    // Answers every complete frame in _rx and drops the consumed bytes.
+    void processInput();
+    std::vector<uint8_t> execute(uint8_t command, const uint8_t* params, size_t len, bool& syntaxError);
+    std::vector<uint8_t> exchange(const uint8_t* frame, size_t len);
+    void queueFrame(const std::vector<uint8_t>& data);
+    void chargeWire(size_t bytes);
+
+    DesfireCardModel* _card;
+    std::shared_ptr<core::ports::IClock> _clock;
+    uint32_t _baud = 0;
+    bool _targetActive = false;
+    bool _fieldOn = false;
+    bool _asleep = false;
+    bool _open = false;
+    uint8_t _lastError = 0;
+    std::vector<uint8_t> _rx;  // host -> PN532, not yet framed
+    std::deque<uint8_t> _tx;   // PN532 -> host, not yet read
+    uint64_t _commands = 0;
+    uint64_t _reads = 0;
+    uint64_t _writes = 0;
+};
+
+} // namespace sim
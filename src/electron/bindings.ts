@@ -3,6 +3,8 @@ import path from 'path';
 import fs from 'fs';
 import { fileURLToPath } from 'url';
 
+import type { EntryPayloadVersion } from './keyDerivation.js';
+
 const require = createRequire(import.meta.url);
 const __filename = fileURLToPath(import.meta.url);
 const __dirname = path.dirname(__filename);
@@ -36,14 +38,168 @@ if (!addonPath) {
 // eslint-disable-next-line @typescript-eslint/no-explicit-any
 const addon: any = require(addonPath);
 
-export interface MyLibraryBinding {
-    greet(guestName: string): string;
-    add(a: number, b: number): number;
+export interface SealEntryInput {
+    entryId: string;
+    /** Strings are encoded as UTF-8; see sealEntryFields() for v2 payloads. */
+    plaintext: string | Buffer;
+}
+
+export interface SealEntryFieldsInput {
+    entryId: string;
+    fields: Partial<Record<EntryFieldName, string>>;
+}
+
+export interface OpenEntryInput {
+    entryId: string;
+    ciphertext: Buffer;
+    iv: Buffer;
+    authTag: Buffer;
+}
+
+/** Fields of the EntryPayload JSON that openEntryFields() can extract. */
+export type EntryFieldName = 'username' | 'password' | 'totpSecret' | 'notes';
+
+/**
+ * Batch HKDF-SHA256 + AES-256-GCM over vault entries, byte-compatible with
+ * deriveEntryKey()/encryptEntry()/decryptEntry() in keyDerivation.ts.
+ * The entry root stays in native memory: zeroize the Buffers passed to
+ * setKeys() once it returns. Batches run on the libuv pool.
+ */
+export interface VaultCryptoBinding {
+    /**
+     * With ttlMs (at most 24 h) the keys expire: a native timer drops and
+     * wipes them once it elapses, and calls after that see no keys.
+     */
+    setKeys(cardSecret: Buffer | number[], machineSecret: Buffer, options?: { ttlMs?: number }): void;
+    clearKeys(): void;
+    /** False once a ttlMs set with the keys has elapsed. */
+    hasKeys(): boolean;
+    /** Time left before the keys expire; null when none are set or no ttlMs was given. */
+    keysExpireInMs(): number | null;
+    /** "aes-ni" or "portable". */
+    backend(): string;
+    /** Rejects with code NO_KEYS when no keys are set. */
+    sealEntries(entries: SealEntryInput[]): Promise<EncryptedBlobDto[]>;
+    /**
+     * Encodes each payload natively and seals it: as v1 JSON, byte for byte
+     * JSON.stringify(), or with payloadVersion 2 as a v2 payload (see
+     * encodeEntryPayload() in keyDerivation.ts). Pass entryPayloadVersion()
+     * from syncService.ts. Throws a TypeError when a field is neither a
+     * string nor absent.
+     */
+    sealEntryFields(
+        entries: SealEntryFieldsInput[],
+        options?: { payloadVersion?: EntryPayloadVersion }
+    ): Promise<EncryptedBlobDto[]>;
+    /** One result per input; null where the tag does not verify. */
+    openEntries(entries: OpenEntryInput[]): Promise<(Buffer | null)[]>;
+    /**
+     * Like openEntries(), but the plaintext is parsed natively as a v1 or v2
+     * entry payload and wiped there: each result holds only the requested fields
+     * the payload has, as strings. null where the tag does not verify or the
+     * payload is malformed.
+     */
+    openEntryFields(entries: OpenEntryInput[], fields: readonly EntryFieldName[]):
+        Promise<(Partial<Record<EntryFieldName, string>> | null)[]>;
+    /**
+     * Opens each entry under this instance's keys and seals it again, with a
+     * fresh IV, under `target`'s keys. Spread over the native thread pool.
+     * null where the entry does not open under this instance's keys.
+     */
+    rekeyEntries(entries: OpenEntryInput[], target: VaultCryptoBinding): Promise<(EncryptedBlobDto | null)[]>;
+    /**
+     * Seals `data` as chunks firstIndex, firstIndex + 1, … of the blob
+     * `header` describes, under blobId's key, spread over the native pool.
+     * Unless `final`, `data` must be a non-zero multiple of the chunk size;
+     * with it, the last chunk takes the rest. Rejects with INVALID_CHUNKS
+     * otherwise.
+     */
+    sealChunks(blobId: string, header: Buffer, firstIndex: number, data: Buffer, final: boolean): Promise<Buffer>;
+    /**
+     * The inverse: `sealed` holds whole sealed chunks from firstIndex on, the
+     * last of them final when `final`. null if any chunk fails to authenticate.
+     */
+    openChunks(blobId: string, header: Buffer, firstIndex: number, sealed: Buffer, final: boolean):
+        Promise<Buffer | null>;
+}
+
+export interface EncryptedBlobDto {
+    ciphertext: Buffer;
+    iv: Buffer;       // 12 bytes
+    authTag: Buffer;  // 16 bytes
 }
 
-export const MyLibraryBinding: {
-    new(name: string): MyLibraryBinding;
-} = addon.MyLibraryBinding;
+/** RFC 7914 parameters; the result matches crypto.scrypt() with the same values. */
+export interface ScryptOptions {
+    N: number;
+    r: number;
+    p: number;
+    /** 1 to 1024 bytes. */
+    keyLen: number;
+    /** Cap on scrypt tables alive at once, default 256 MiB. Each lane needs 128 * N * r bytes. */
+    maxmem?: number;
+}
+
+/** Bounds for calibrateScrypt(); omitted fields default to N=2^15, r=8, p=1, maxN=2^20, maxP=16, 256 MiB. */
+export interface ScryptCalibrationOptions {
+    /** Wall-clock budget for one derivation on this machine. */
+    targetMs: number;
+    /** Floor: the result is never weaker than { minN, r, minP }. */
+    minN?: number;
+    r?: number;
+    minP?: number;
+    maxN?: number;
+    maxP?: number;
+    /** The maxmem later passed to scrypt(). */
+    maxmem?: number;
+}
+
+export interface ScryptCalibrationDto {
+    N: number;
+    r: number;
+    p: number;
+    /** One derivation with these parameters, as timed during calibration. */
+    measuredMs: number;
+}
+
+/** Native key memory: the locked, guard-paged arena that holds keys and AES schedules. */
+export interface SecureMemoryDto {
+    /** Pages pinned in RAM; false when RLIMIT_MEMLOCK (or the working set limit) refused them. */
+    locked: boolean;
+    /** Pages left out of core dumps (Linux MADV_DONTDUMP). */
+    dumpExcluded: boolean;
+    pageSize: number;
+    /** Bytes of cell pages reserved at startup. */
+    capacity: number;
+    inUse: number;
+    peakInUse: number;
+    /** Allocations served by the zeroizing heap instead: oversized, or the arena was full. */
+    heapFallbacks: number;
+}
+
+export const VaultCryptoBinding: {
+    new(): VaultCryptoBinding;
+    /**
+     * scrypt off the main thread. The p lanes run side by side on a native
+     * thread pool. Strings are encoded as UTF-8. Rejects with code
+     * INVALID_PARAMS, MEMORY_LIMIT or OUT_OF_MEMORY.
+     */
+    scrypt(password: string | Buffer, salt: Buffer, options: ScryptOptions): Promise<Buffer>;
+    /**
+     * Times scrypt on this machine and picks the strongest { N, r, p } that
+     * stays within targetMs: N first, then p once N is at its cap. Takes about
+     * twice targetMs. Rejects with INVALID_PARAMS or MEMORY_LIMIT when the
+     * floor itself is out of bounds.
+     */
+    calibrateScrypt(options: ScryptCalibrationOptions): Promise<ScryptCalibrationDto>;
+    /** Current state of the secure arena, for diagnostics. */
+    secureMemory(): SecureMemoryDto;
+    /**
+     * A fresh 28-byte header for one chunked blob: random salt and nonce
+     * prefix, chunkSize (1 KiB to 16 MiB, default 64 KiB). See chunkedBlob.ts.
+     */
+    createChunkedHeader(options?: { chunkSize?: number }): Buffer;
+} = addon.VaultCryptoBinding;
 
 export interface NfcCppBinding {
     connect(port: string): Promise<string>;
@@ -60,8 +216,8 @@ export interface NfcCppBinding {
     isCardInitialised(): Promise<boolean>;
     /** Single-scan probe: one InListPassiveTarget returning uid + isInitialised. */
     probeCard(): Promise<{ uid: string | null; isInitialised: boolean }>;
-    /** Runs the 11-step secure init sequence. */
-    initCard(opts: CardInitOptsDto): Promise<boolean>;
+    /** Runs the secure init sequence, resuming a partially provisioned card. */
+    initCard(opts: CardInitOptsDto): Promise<CardInitReportDto>;
     /** Authenticates with readKey and returns the 16-byte card secret as a Buffer. */
     readCardSecret(readKey: number[]): Promise<Buffer>;
     /** Returns free EEPROM bytes remaining on the PICC. */
@@ -70,6 +226,151 @@ export interface NfcCppBinding {
     formatCard(): Promise<boolean>;
     /** Returns AIDs as uppercase hex strings, e.g. ["505700"]. */
     getCardApplicationIds(): Promise<string[]>;
+
+    // Reader power management
+    /** Stores the idle power policy; applies to later connections too. */
+    setPowerPolicy(policy: ReaderPowerPolicyDto): Promise<boolean>;
+    getPowerStatus(): Promise<ReaderPowerStatusDto>;
+    /** Leaves PowerDown and raises the RF field ahead of an expected tap. */
+    wakeReader(): Promise<boolean>;
+    /** Interrupts the in-flight reader command; it rejects with CANCELLED or IO_TIMEOUT. */
+    cancelPendingIo(): void;
+
+    // Diagnostics
+    /** Synchronous cached snapshot — never waits on the reader. */
+    getReaderHealth(): ReaderHealthDto;
+    /** Synchronous per-operation latency/outcome snapshot; `reset` starts a new window. */
+    getMetrics(reset?: boolean): NfcMetricsDto;
+    /** Starts or stops span recording (see docs/nfc-tracing.md). Off by default. */
+    setTracing(enabled: boolean): void;
+    /** Recorded spans as Chrome trace_event JSON; open in Perfetto. `clear` empties the buffers. */
+    exportTrace(clear?: boolean): string;
+    /** PN532 frames leading up to the last failed operation, or null (see docs/nfc-tracing.md). */
+    getLastFailureReport(): FailureReportDto | null;
+}
+
+/** Flight-recorder snapshot taken when an operation failed. */
+export interface FailureReportDto {
+    /** Binding method name, e.g. "readCardSecret". */
+    operation: string;
+    /** NfcError code and message the operation returned. */
+    code: string;
+    message: string;
+    /** Time since the failure. */
+    ageMs: number;
+    /** Up to 64 entries, oldest first. */
+    frames: RecordedFrameDto[];
+}
+
+export interface RecordedFrameDto {
+    /** Microseconds relative to the failure (negative: before it). */
+    offsetUs: number;
+    /** "out" host -> PN532, "in" PN532 -> host. */
+    direction: 'out' | 'in';
+    kind: 'info' | 'ack' | 'nack' | 'error' | 'checksum' | 'timeout' | 'io';
+    /** PN532 command or response code (info frames). */
+    code: number;
+    /** DESFire command ("out") or card status ("in"), null when the frame carries none. */
+    desfire: number | null;
+    /** TFI + PD bytes of the frame. */
+    length: number;
+    /** Consecutive read timeouts folded into this entry. */
+    repeat: number;
+    /** Card payload withheld: only the header is in `bytes`. */
+    redacted: boolean;
+    /** Leading TFI + PD bytes as uppercase hex, at most 16 bytes. */
+    bytes: string;
+}
+
+/** See docs/nfc-metrics.md. */
+export interface NfcMetricsDto {
+    /** Time covered: since the addon loaded or the last reset. */
+    windowMs: number;
+    /** Operations called at least once in the window. */
+    operations: NfcOperationMetricsDto[];
+}
+
+export interface NfcOperationMetricsDto {
+    /** Binding method name, e.g. "readCardSecret". */
+    name: string;
+    calls: number;
+    ok: number;
+    /** NfcError code -> count, e.g. { NO_CARD: 3 }. */
+    errors: Record<string, number>;
+    /** Bucket upper bounds, at most 1/16 of the power of two above the true value. */
+    latencyUs: { mean: number; p50: number; p90: number; p99: number; p999: number; max: number };
+    /** Non-empty histogram buckets as [lower bound µs, count]; merge these across machines. */
+    buckets: Array<[number, number]>;
+}
+
+/** Reader/link health; counters run since the last connect. */
+export interface ReaderHealthDto {
+    connected: boolean;
+    /** Latest PN532 GetGeneralStatus sample, null until the first idle sample. */
+    status: {
+        ageMs: number;
+        lastError: number;
+        lastErrorName: string;
+        externalFieldPresent: boolean;
+        targetCount: number;
+        targetBitrateRxKbps: number;
+        targetBitrateTxKbps: number;
+    } | null;
+    counters: {
+        bytesOut: number;
+        bytesIn: number;
+        framesOut: number;
+        framesIn: number;
+        acks: number;
+        nacks: number;
+        checksumErrors: number;
+        errorFrames: number;
+        retries: number;
+        timeouts: number;
+        ioErrors: number;
+    };
+    /** Serial-link settings tried at connect (see docs/serial-backend.md); empty on termios. */
+    linkTuning: LinkTuningDto[];
+    /** Adapter mutex since the addon loaded; every reader operation holds it (see docs/nfc-stress.md). */
+    lock: {
+        acquisitions: number;
+        /** Acquisitions that had to wait; waitTotalUs/waitMaxUs cover only these. */
+        contended: number;
+        /** Idle housekeeping skipped because an operation held the lock. */
+        tryFailures: number;
+        waitTotalUs: number;
+        waitMaxUs: number;
+        holdTotalUs: number;
+        holdMaxUs: number;
+    };
+}
+
+export interface LinkTuningDto {
+    /** "vmin_vtime" | "exclusive" | "low_latency" | "latency_timer" */
+    setting: string;
+    applied: boolean;
+    /** Effect when applied, reason when not. */
+    detail: string;
+}
+
+/** See docs/reader-power.md for the trade-offs of each mode. */
+export type ReaderPowerMode = 'latency' | 'balanced' | 'lowPower';
+
+export interface ReaderPowerPolicyDto {
+    mode: ReaderPowerMode;
+    /** Quiet time before the idle state is applied (default 2000; ignored in latency mode). */
+    idleTimeoutMs?: number;
+}
+
+export interface ReaderPowerStatusDto {
+    mode: ReaderPowerMode;
+    idleTimeoutMs: number;
+    rfFieldOn: boolean;
+    poweredDown: boolean;
+    /** PowerDown wake-ups since connect. */
+    wakeCount: number;
+    /** Wake preamble sent → first command answered, for the most recent wake. */
+    lastWakeLatencyUs: number;
 }
 
 /** Options passed to initCard — all keys are raw AES-128 byte arrays. */
@@ -84,6 +385,14 @@ export interface CardInitOptsDto {
     cardSecret: number[];
 }
 
+/** Step names: configurePicc, createApplication, createFile, changeReadKey, writeSecret, changeMasterKey. */
+export interface CardInitReportDto {
+    /** True when the card already carried part of the vault layout. */
+    resumed: boolean;
+    stepsRun: string[];
+    stepsSkipped: string[];
+}
+
 export const NfcCppBinding: {
     new(): NfcCppBinding;
 } = addon.NfcCppBinding;
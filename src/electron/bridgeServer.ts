@@ -22,10 +22,12 @@ import net from 'node:net';
 import fs from 'node:fs';
 import path from 'node:path';
 import { NfcCppBinding } from './bindings.js';
-import { getMachineSecret } from './main.js';
-import { deriveCardKey, deriveEntryKey, decryptEntry, zeroizeBuffer } from './keyDerivation.js';
+import { getCryptoRootSecret } from './main.js';
+import { deriveCardKey, zeroizeBuffer } from './keyDerivation.js';
+import { decryptEntryFields } from './entryFields.js';
 import { listEntries, getEntryRow } from './vault.js';
 import { beginCardWait } from './nfcCancel.js';
+import { openSession, decryptWithSession } from './sessionKeyring.js';
 
 // ─── Constants ────────────────────────────────────────────────────────────────
 
@@ -105,6 +107,8 @@ function matchesDomain(entryUrl: string, requestedDomain: string): boolean {
 
 async function waitForCard(nfcBinding: NfcCppBinding, signal: AbortSignal): Promise<string> {
   const deadline = Date.now() + PROBE_TIMEOUT;
+  // A tap is imminent: bring the reader out of its idle power state now.
+  await nfcBinding.wakeReader().catch(() => undefined);
   while (Date.now() < deadline) {
     if (signal.aborted) throw Object.assign(new Error('Cancelled'), { code: 'CANCELLED' });
     const uid = await nfcBinding.peekCardUid();
@@ -118,6 +122,9 @@ function uidToBuffer(uidHex: string): Buffer {
   return Buffer.from(uidHex.replace(/:/g, ''), 'hex');
 }
 
+// The form fill needs no more than this; notes and TOTP secrets stay sealed
+const LOGIN_FIELDS = ['username', 'password'] as const;
+
 async function decryptEntryById(
   nfcBinding: NfcCppBinding,
   entryId:    string,
@@ -130,30 +137,35 @@ async function decryptEntryById(
     throw Object.assign(new Error('Selected entry does not match the current site domain'), { code: 'DOMAIN_MISMATCH' });
   }
 
-  log('info', `[bridge] tap card to decrypt "${row.label}"…`);
+  // Inside an open unlock window the entry key comes from native memory
+  const cached = await decryptWithSession(row, LOGIN_FIELDS);
+  if (cached) return cached;
 
-  const signal        = beginCardWait();
-  const machineSecret = getMachineSecret();
-  const uidHex        = await waitForCard(nfcBinding, signal);
-  const uidBuf        = uidToBuffer(uidHex);
+  log('info', `[bridge] tap card to decrypt "${row.label}"…`);
 
-  const readKey = deriveCardKey(machineSecret, uidBuf, 0x02);
-  let cardSecretBuf: Buffer;
+  const signal     = beginCardWait();
+  const rootSecret = getCryptoRootSecret();
   try {
-    const raw = await nfcBinding.readCardSecret(Array.from(readKey));
-    cardSecretBuf = Buffer.from(raw);
-  } finally {
-    zeroizeBuffer(readKey);
-  }
+    const uidHex = await waitForCard(nfcBinding, signal);
+    const uidBuf = uidToBuffer(uidHex);
 
-  const entryKey = deriveEntryKey(cardSecretBuf, machineSecret, entryId);
-  zeroizeBuffer(cardSecretBuf);
+    const readKey = deriveCardKey(rootSecret, uidBuf, 0x02);
+    let cardSecretBuf: Buffer;
+    try {
+      const raw = await nfcBinding.readCardSecret(Array.from(readKey));
+      cardSecretBuf = Buffer.from(raw);
+    } finally {
+      zeroizeBuffer(readKey);
+    }
 
-  try {
-    const payload = decryptEntry(entryKey, row.ciphertext, row.iv, row.authTag);
-    return { username: payload.username, password: payload.password };
+    try {
+      openSession(cardSecretBuf, rootSecret, uidHex, nfcBinding);
+      return await decryptEntryFields(cardSecretBuf, rootSecret, row, LOGIN_FIELDS);
+    } finally {
+      zeroizeBuffer(cardSecretBuf);
+    }
   } finally {
-    zeroizeBuffer(entryKey);
+    zeroizeBuffer(rootSecret);
   }
 }
 
@@ -6,7 +6,7 @@
  *
  * card:peekUid        — lightweight UID probe, null when no card
  * card:isInitialised  — true if vault AID 505700 exists on card
- * card:init           — full 11-step secure init (derives keys from active root secret + UID)
+ * card:init           — secure init, resumes an interrupted one (derives keys from active root secret + UID)
  * card:freeMemory     — free EEPROM bytes on the PICC
  * card:format         - FormatPICC only (card reset)
  * card:getAids        — list of AIDs on the card
@@ -20,6 +20,7 @@ import { NfcCppBinding } from './bindings.js';
 import { getCryptoRootSecret } from './main.js';
 import { deriveCardKey, zeroizeBuffer } from './keyDerivation.js';
 import { beginCardWait } from './nfcCancel.js';
+import { endSession } from './sessionKeyring.js';
 
 const VAULT_AID: [number, number, number] = [0x50, 0x57, 0x00];
 const PROBE_INTERVAL_MS = 200;
@@ -37,6 +38,8 @@ async function waitForCard(
   timeoutMs = PROBE_TIMEOUT_MS
 ): Promise<string> {
   const deadline = Date.now() + timeoutMs;
+  // A tap is imminent: bring the reader out of its idle power state now.
+  await nfcBinding.wakeReader().catch(() => undefined);
   while (Date.now() < deadline) {
     if (signal.aborted)
       throw Object.assign(new Error('Card tap cancelled'), { code: 'CANCELLED' });
@@ -135,6 +138,8 @@ export function registerCardHandlers(
     log('info', 'card:init — waiting for card tap...');
     const uidHex = await waitForCard(nfcBinding, signal);
     log('info', `card:init — card detected (${uidHex}), deriving keys...`);
+    // A new card secret invalidates any open unlock window
+    endSession();
 
     const rootSecret = getCryptoRootSecret();
     const uidBuf        = uidToBuffer(uidHex);
@@ -144,14 +149,17 @@ export function registerCardHandlers(
     const cardSecret   = crypto.randomBytes(16);
 
     try {
-      const result = await nfcBinding.initCard({
+      const report = await nfcBinding.initCard({
         aid:          Array.from(VAULT_AID),
         appMasterKey: Array.from(appMasterKey),
         readKey:      Array.from(readKey),
         cardSecret:   Array.from(cardSecret),
       });
-      log('info', 'card:init — card initialised successfully.');
-      return result;
+      if (report.resumed) {
+        log('info', `card:init — resumed interrupted init; skipped: ${report.stepsSkipped.join(', ') || 'none'}.`);
+      }
+      log('info', `card:init — card initialised successfully (ran: ${report.stepsRun.join(', ') || 'none'}).`);
+      return true;
     } finally {
       zeroizeBuffer(appMasterKey);
       zeroizeBuffer(readKey);
@@ -168,6 +176,7 @@ export function registerCardHandlers(
   // ── card:format ─────────────────────────────────────────────────────────────
   ipcMain.handle('card:format', async (): Promise<boolean> => {
     log('warn', 'card:format - FormatPICC requested; card data will be destroyed.');
+    endSession();
     const result = await nfcBinding.formatCard();
     if (result) {
       log('warn', 'card:format - card formatted to factory state (vault database unchanged).');
@@ -0,0 +1,228 @@
+/**
+ * chunkedBlob.ts
+ *
+ * Streams over the native chunked AES-256-GCM format (ChunkedAead.h) for
+ * payloads too large to seal as one GCM message: attachments such as SSH
+ * keys or recovery PDFs, and long notes. Each blob is keyed by its own id
+ * (HKDF from the vault entry root, like an entry key) and stored as
+ *
+ *   header (28 B) ‖ chunk 0 ‖ chunk 1 ‖ … ‖ final chunk,   chunk = ciphertext ‖ tag (16 B)
+ *
+ * Every chunk authenticates on its own, bound to its index, to whether it
+ * is the last one, and to the header. The streams below therefore hold at
+ * most one batch of chunks in memory, whatever the blob size, and each batch
+ * is sealed or opened across the native thread pool. openBlobChunk() reads
+ * and opens a single chunk from a file, without touching the rest.
+ *
+ * Must only run in the main process.
+ */
+
+import { Transform, type TransformCallback } from 'node:stream';
+import type { FileHandle } from 'node:fs/promises';
+import { VaultCryptoBinding } from './bindings.js';
+import { zeroizeBuffer } from './keyDerivation.js';
+
+export const CHUNKED_HEADER_SIZE = 28;
+export const CHUNK_TAG_SIZE = 16;
+/** Chunks per native call in the streams: 1 MiB at the default chunk size. */
+const DEFAULT_BATCH_CHUNKS = 16;
+
+export interface ChunkedBlobOptions {
+  /** Plaintext bytes per chunk, 1 KiB to 16 MiB. Defaults to 64 KiB. */
+  chunkSize?: number;
+  /** Chunks handed to the native pool at once by the streams. */
+  batchChunks?: number;
+}
+
+function decryptFailed(): Error {
+  return Object.assign(new Error('Blob failed authentication'), { code: 'DECRYPT_FAILED' });
+}
+
+function malformed(message: string): Error {
+  return Object.assign(new Error(message), { code: 'MALFORMED_BLOB' });
+}
+
+function headerChunkSize(header: Buffer): number {
+  return header.readUInt32LE(1);
+}
+
+/**
+ * Splits the first `length` bytes off the buffered list. With `wipe`, the
+ * buffers are ours and the tail left behind by the copy is zeroized.
+ */
+function take(buffered: Buffer[], length: number, wipe = false): Buffer {
+  const all = buffered.length === 1 ? buffered[0] : Buffer.concat(buffered);
+  if (wipe && buffered.length > 1) buffered.forEach(zeroizeBuffer);
+  buffered.length = 0;
+  if (all.length > length) {
+    buffered.push(Buffer.from(all.subarray(length)));
+    if (wipe) all.fill(0, length);
+  }
+  return all.subarray(0, length);
+}
+
+// ── Whole blobs ───────────────────────────────────────────────────────────────
+
+/** Seals `data` in one native call; the chunks are spread over the pool. */
+export async function sealBlob(
+  vault:   VaultCryptoBinding,
+  blobId:  string,
+  data:    Buffer,
+  options: ChunkedBlobOptions = {}
+): Promise<Buffer> {
+  const header = VaultCryptoBinding.createChunkedHeader({ chunkSize: options.chunkSize });
+  const chunks = await vault.sealChunks(blobId, header, 0, data, true);
+  return Buffer.concat([header, chunks]);
+}
+
+/** Opens a whole blob. Rejects with DECRYPT_FAILED if any chunk fails. */
+export async function openBlob(vault: VaultCryptoBinding, blobId: string, blob: Buffer): Promise<Buffer> {
+  if (blob.length < CHUNKED_HEADER_SIZE) throw malformed('Blob is shorter than its header');
+  const header = blob.subarray(0, CHUNKED_HEADER_SIZE);
+  const plain = await vault.openChunks(blobId, header, 0, blob.subarray(CHUNKED_HEADER_SIZE), true);
+  if (!plain) throw decryptFailed();
+  return plain;
+}
+
+// ── Streams ───────────────────────────────────────────────────────────────────
+
+/**
+ * Transform from plaintext to a sealed blob. Holds back the bytes after the
+ * last whole chunk until more arrive, so the final chunk is only sealed,
+ * and flagged, at the end of the input.
+ */
+export function createSealStream(
+  vault:   VaultCryptoBinding,
+  blobId:  string,
+  options: ChunkedBlobOptions = {}
+): Transform {
+  const header = VaultCryptoBinding.createChunkedHeader({ chunkSize: options.chunkSize });
+  const chunkSize = headerChunkSize(header);
+  const batchBytes = chunkSize * (options.batchChunks ?? DEFAULT_BATCH_CHUNKS);
+  const buffered: Buffer[] = [];
+  let bufferedBytes = 0;
+  let nextIndex = 0;
+
+  const seal = async (length: number, final: boolean): Promise<Buffer> => {
+    const data = take(buffered, length, true);
+    bufferedBytes -= length;
+    try {
+      const sealed = await vault.sealChunks(blobId, header, nextIndex, data, final);
+      // The header leads the first output
+      const out = nextIndex === 0 ? Buffer.concat([header, sealed]) : sealed;
+      nextIndex += length / chunkSize;
+      return out;
+    } finally {
+      zeroizeBuffer(data);
+    }
+  };
+
+  return new Transform({
+    transform(chunk: Buffer, _encoding, callback: TransformCallback) {
+      buffered.push(Buffer.from(chunk));
+      bufferedBytes += chunk.length;
+      if (bufferedBytes <= batchBytes) return callback();
+      // Whole chunks only, keeping at least one byte for the final chunk
+      const whole = Math.floor((bufferedBytes - 1) / chunkSize) * chunkSize;
+      seal(whole, false).then(sealed => callback(null, sealed), callback);
+    },
+    flush(callback: TransformCallback) {
+      // Up to one batch of chunks remains; the last of them is final
+      seal(bufferedBytes, true).then(sealed => callback(null, sealed), callback);
+    },
+  });
+}
+
+/**
+ * Transform from a sealed blob to plaintext. Errors with DECRYPT_FAILED on
+ * the first chunk that fails, before any of its batch is passed on; with
+ * MALFORMED_BLOB when the input ends inside the header, and INVALID_CHUNKS
+ * (from the binding) when it ends inside a chunk.
+ */
+export function createOpenStream(
+  vault:   VaultCryptoBinding,
+  blobId:  string,
+  options: Pick<ChunkedBlobOptions, 'batchChunks'> = {}
+): Transform {
+  const buffered: Buffer[] = [];
+  let bufferedBytes = 0;
+  let header: Buffer | null = null;
+  let sealedChunkSize = 0;
+  let nextIndex = 0;
+
+  const open = async (length: number, final: boolean): Promise<Buffer> => {
+    const sealed = take(buffered, length);
+    bufferedBytes -= length;
+    const plain = await vault.openChunks(blobId, header!, nextIndex, sealed, final);
+    if (!plain) throw decryptFailed();
+    nextIndex += length / sealedChunkSize;
+    return plain;
+  };
+
+  return new Transform({
+    transform(chunk: Buffer, _encoding, callback: TransformCallback) {
+      buffered.push(chunk);
+      bufferedBytes += chunk.length;
+      if (!header) {
+        if (bufferedBytes < CHUNKED_HEADER_SIZE) return callback();
+        header = Buffer.from(take(buffered, CHUNKED_HEADER_SIZE));
+        bufferedBytes -= CHUNKED_HEADER_SIZE;
+        sealedChunkSize = headerChunkSize(header) + CHUNK_TAG_SIZE;
+      }
+      if (bufferedBytes <= sealedChunkSize * (options.batchChunks ?? DEFAULT_BATCH_CHUNKS)) return callback();
+      // The last whole chunk may be the final one: keep it until more arrives
+      const whole = Math.floor((bufferedBytes - 1) / sealedChunkSize) * sealedChunkSize;
+      open(whole, false).then(plain => callback(null, plain), callback);
+    },
+    flush(callback: TransformCallback) {
+      if (!header) return callback(malformed('Blob is shorter than its header'));
+      open(bufferedBytes, true).then(plain => callback(null, plain), callback);
+    },
+  });
+}
+
+// ── Random access ─────────────────────────────────────────────────────────────
+
+/**
+ * Opens chunk `index` of the blob stored in `file`, reading only the header
+ * and that chunk. Plaintext offsets map to chunks by the chunk size, which
+ * chunkedBlobInfo() reports.
+ */
+export async function openBlobChunk(
+  vault:  VaultCryptoBinding,
+  blobId: string,
+  file:   FileHandle,
+  index:  number
+): Promise<Buffer> {
+  const { header, chunkSize, chunkCount, sealedSize } = await chunkedBlobInfo(file);
+  if (!Number.isInteger(index) || index < 0 || index >= chunkCount) {
+    throw new RangeError(`Chunk ${index} is outside the blob's ${chunkCount} chunks`);
+  }
+  const sealedChunkSize = chunkSize + CHUNK_TAG_SIZE;
+  const offset = CHUNKED_HEADER_SIZE + index * sealedChunkSize;
+  const final = index === chunkCount - 1;
+  const sealed = Buffer.alloc(final ? sealedSize - offset : sealedChunkSize);
+  const { bytesRead } = await file.read(sealed, 0, sealed.length, offset);
+  if (bytesRead !== sealed.length) throw malformed('Blob file changed while reading');
+
+  const plain = await vault.openChunks(blobId, header, index, sealed, final);
+  if (!plain) throw decryptFailed();
+  return plain;
+}
+
+/** Header and chunk layout of the blob stored in `file`. */
+export async function chunkedBlobInfo(file: FileHandle): Promise<{
+  header: Buffer; chunkSize: number; chunkCount: number; sealedSize: number;
+}> {
+  const { size } = await file.stat();
+  const header = Buffer.alloc(CHUNKED_HEADER_SIZE);
+  const { bytesRead } = await file.read(header, 0, CHUNKED_HEADER_SIZE, 0);
+  if (bytesRead !== CHUNKED_HEADER_SIZE || size < CHUNKED_HEADER_SIZE + CHUNK_TAG_SIZE) {
+    throw malformed('Blob is shorter than a header and one chunk');
+  }
+  const chunkSize = headerChunkSize(header);
+  const body = size - CHUNKED_HEADER_SIZE;
+  // A final chunk is 0 to chunkSize bytes plus its tag
+  const chunkCount = Math.floor((body - CHUNK_TAG_SIZE) / (chunkSize + CHUNK_TAG_SIZE)) + 1;
+  return { header, chunkSize, chunkCount, sealedSize: size };
+}
@@ -0,0 +1,61 @@
+/**
+ * entryFields.ts
+ *
+ * Decrypts vault rows straight to the payload fields a caller asked for.
+ * Key derivation, AES-GCM and the payload parse all run in the native engine
+ * (VaultCryptoBinding.openEntryFields): the decrypted JSON is read and wiped
+ * in native memory, and only the requested fields reach the JS heap. The
+ * bridge, which fills a login form, never sees notes or TOTP secrets.
+ *
+ * Must only run in the main process.
+ */
+
+import { VaultCryptoBinding } from './bindings.js';
+import type { EntryPayload } from './keyDerivation.js';
+import type { EntryRow } from './vault.js';
+
+export type EntryField = keyof EntryPayload;
+
+export const ALL_ENTRY_FIELDS: readonly EntryField[] = ['username', 'password', 'totpSecret', 'notes'];
+
+/**
+ * Opens `row` under `binding`'s keys. Rejects with DECRYPT_FAILED when the
+ * row does not authenticate or its payload does not parse, as decryptEntry()
+ * would throw; with NO_KEYS when `binding` holds none.
+ */
+export async function openFieldsWith<F extends EntryField>(
+  binding: VaultCryptoBinding,
+  row:     EntryRow,
+  fields:  readonly F[]
+): Promise<Pick<EntryPayload, F>> {
+  const [opened] = await binding.openEntryFields([{
+    entryId:    row.id,
+    ciphertext: row.ciphertext,
+    iv:         row.iv,
+    authTag:    row.authTag,
+  }], fields);
+  if (!opened) {
+    throw Object.assign(new Error('Entry failed authentication'), { code: 'DECRYPT_FAILED' });
+  }
+  return opened as Pick<EntryPayload, F>;
+}
+
+/**
+ * One-shot variant for the card-tap path: the secrets go into a throwaway
+ * native instance and are wiped there before this resolves. The caller still
+ * zeroizes its own buffers.
+ */
+export async function decryptEntryFields<F extends EntryField>(
+  cardSecret: Buffer,
+  rootSecret: Buffer,
+  row:        EntryRow,
+  fields:     readonly F[]
+): Promise<Pick<EntryPayload, F>> {
+  const binding = new VaultCryptoBinding();
+  try {
+    binding.setKeys(cardSecret, rootSecret);
+    return await openFieldsWith(binding, row, fields);
+  } finally {
+    binding.clearKeys();
+  }
+}
@@ -87,24 +87,93 @@ export function deriveEntryKey(
   );
 }
 
+// ── Payload codec ────────────────────────────────────────────────────────────
+//
+// v1 payloads are the UTF-8 JSON of an EntryPayload. v2 is a version byte
+// (0x02; JSON always starts with '{') and one record per present field in
+// tag order: tag byte, LEB128 value length, UTF-8 value. Byte-identical to
+// encodeEntryPayload() in native/adapters/crypto. Both are always read; v2
+// is only written once every synced device can read it (entryPayloadVersion()
+// in syncService.ts).
+
+export type EntryPayloadVersion = 1 | 2;
+
+const PAYLOAD_V2 = 0x02;
+const PAYLOAD_FIELDS = ['username', 'password', 'totpSecret', 'notes'] as const;
+
+export function encodeEntryPayload(payload: EntryPayload): Buffer {
+  const parts: Buffer[] = [Buffer.from([PAYLOAD_V2])];
+  PAYLOAD_FIELDS.forEach((field, tag) => {
+    const value = payload[field];
+    if (value === undefined || value === null) return;
+    const bytes = Buffer.from(value, 'utf8');
+    const header = [tag];
+    let length = bytes.length;
+    while (length >= 0x80) {
+      header.push((length & 0x7f) | 0x80);
+      length >>>= 7;
+    }
+    header.push(length);
+    parts.push(Buffer.from(header), bytes);
+  });
+  const out = Buffer.concat(parts);
+  parts.forEach(zeroizeBuffer);
+  return out;
+}
+
+/** Reads a v1 or v2 payload. Throws on a malformed one. */
+export function decodeEntryPayload(plaintext: Buffer): EntryPayload {
+  if (plaintext[0] !== PAYLOAD_V2) return JSON.parse(plaintext.toString('utf8')) as EntryPayload;
+
+  const payload: Partial<Record<(typeof PAYLOAD_FIELDS)[number], string>> = {};
+  let pos = 1;
+  let lastTag = -1;
+  while (pos < plaintext.length) {
+    const tag = plaintext[pos++];
+    let length = 0;
+    let shift = 0;
+    let byte: number;
+    do {
+      if (pos >= plaintext.length || shift > 28) throw new Error('Malformed entry payload');
+      byte = plaintext[pos++];
+      length += (byte & 0x7f) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    if (tag <= lastTag || length > plaintext.length - pos) throw new Error('Malformed entry payload');
+    lastTag = tag;
+    // Tags past notes belong to newer writers and are skipped
+    if (tag < PAYLOAD_FIELDS.length) payload[PAYLOAD_FIELDS[tag]] = plaintext.toString('utf8', pos, pos + length);
+    pos += length;
+  }
+  return payload as EntryPayload;
+}
+
 // ── AES-256-GCM encrypt / decrypt ────────────────────────────────────────────
 
 /**
- * Encrypts an EntryPayload with AES-256-GCM.
+ * Encrypts an EntryPayload with AES-256-GCM, as v1 JSON unless v2 is asked for.
  * A fresh random 12-byte nonce is generated for every call — never reused.
  */
-export function encryptEntry(key: Buffer, payload: EntryPayload): EncryptedBlob {
+export function encryptEntry(
+  key: Buffer,
+  payload: EntryPayload,
+  version: EntryPayloadVersion = 1
+): EncryptedBlob {
   const iv = crypto.randomBytes(12);
   const cipher = crypto.createCipheriv('aes-256-gcm', key, iv);
-  const ciphertext = Buffer.concat([
-    cipher.update(JSON.stringify(payload), 'utf8'),
-    cipher.final(),
-  ]);
-  return { ciphertext, iv, authTag: cipher.getAuthTag() };
+  const plaintext = version === 2
+    ? encodeEntryPayload(payload)
+    : Buffer.from(JSON.stringify(payload), 'utf8');
+  try {
+    const ciphertext = Buffer.concat([cipher.update(plaintext), cipher.final()]);
+    return { ciphertext, iv, authTag: cipher.getAuthTag() };
+  } finally {
+    zeroizeBuffer(plaintext);
+  }
 }
 
 /**
- * Decrypts an AES-256-GCM blob.
+ * Decrypts an AES-256-GCM blob holding a v1 or v2 payload.
  * Throws if the auth tag does not match (tampered ciphertext or wrong key).
  * The caller is responsible for zeroizing the key buffer after this returns.
  */
@@ -116,11 +185,15 @@ export function decryptEntry(
 ): EntryPayload {
   const decipher = crypto.createDecipheriv('aes-256-gcm', key, iv);
   decipher.setAuthTag(authTag);
-  const json = Buffer.concat([
+  const plaintext = Buffer.concat([
     decipher.update(ciphertext),
     decipher.final(),
-  ]).toString('utf8');
-  return JSON.parse(json) as EntryPayload;
+  ]);
+  try {
+    return decodeEntryPayload(plaintext);
+  } finally {
+    zeroizeBuffer(plaintext);
+  }
 }
 
 // ── Memory hygiene ────────────────────────────────────────────────────────────
@@ -1,4 +1,4 @@
-import { app, BrowserWindow, ipcMain, IpcMainInvokeEvent, dialog, safeStorage, clipboard, shell, nativeImage } from 'electron'
+import { app, BrowserWindow, ipcMain, IpcMainInvokeEvent, dialog, safeStorage, clipboard, shell, nativeImage, powerMonitor } from 'electron'
 import { SerialPort } from 'serialport';
 import fs from 'fs';
 import path from 'node:path';
@@ -23,8 +23,9 @@ import {
 import { clearUnlockedVaultRootKey, getUnlockedVaultRootKey } from './vaultKeyManager.js';
 import { startBridgeServer }    from './bridgeServer.js';
 import { cancelCardWait } from './nfcCancel.js';
+import { endSession } from './sessionKeyring.js';
 import { registerNativeHost }   from './nativeHostRegistrar.js';
-import { hasPinConfigured, setPin, verifyPin, changePin, startPinRecovery, completePinRecovery, resetPin } from './pinManager.js';
+import { hasPinConfigured, setPinIfAbsent, verifyPin, changePin, startPinRecovery, completePinRecovery, resetPin } from './pinManager.js';
 import type { NfcCppBinding as NfcCppBindingType } from './bindings.js';
 import { registerUpdateManager, type UpdateManagerController } from './updateManager.js';
 
@@ -95,6 +96,7 @@ function isVaultUnlocked(): boolean {
 function setVaultLocked(): void {
   vaultUnlocked = false;
   cancelCardWait();
+  endSession();
 }
 
 function setVaultUnlocked(): void {
@@ -876,6 +878,10 @@ app.on('ready', async () => {
   // Start the named-pipe bridge that feeds the browser extension.
   bridgeServer = startBridgeServer(nfcBinding, nfcLog, { isVaultUnlocked });
 
+  // The card-tap unlock window must not outlive the user stepping away.
+  powerMonitor.on('suspend', endSession);
+  powerMonitor.on('lock-screen', endSession);
+
   // Keep the native messaging host registration up-to-date so the browser
   // extension always points to the correct install location.
   registerNativeHost((msg) => nfcLog('info', msg));
@@ -892,20 +898,23 @@ app.on('ready', async () => {
   });
 
   // Allow the renderer to abort any in-progress card-wait polling loop.
-  ipcMain.handle('nfc:cancel', () => { cancelCardWait(); });
+  ipcMain.handle('nfc:cancel', () => {
+    cancelCardWait();
+    nfcBinding?.cancelPendingIo();
+  });
 
   // App-lock PIN handlers (main-process only; renderer never sees verifier data).
   ipcMain.handle('pin:has', () => hasPinConfigured());
-  ipcMain.handle('pin:set', (_event: IpcMainInvokeEvent, pin: string) => {
-    if (hasPinConfigured()) {
+  ipcMain.handle('pin:set', async (_event: IpcMainInvokeEvent, pin: string) => {
+    const result = await setPinIfAbsent(pin);
+    if (!result.ok) {
       throw new Error('PIN is already configured. Use Change PIN or PIN recovery.');
     }
-    setPin(pin);
     setVaultUnlocked();
     return { ok: true as const };
   });
-  ipcMain.handle('pin:verify', (_event: IpcMainInvokeEvent, pin: string) => {
-    const result = verifyPin(pin);
+  ipcMain.handle('pin:verify', async (_event: IpcMainInvokeEvent, pin: string) => {
+    const result = await verifyPin(pin);
     if (result.ok) {
       setVaultUnlocked();
     }
@@ -982,13 +991,13 @@ app.on('ready', async () => {
     cancelCardWait();
     clearSyncConfigAndSession();
     wipeVault();
-    resetPin();
+    await resetPin();
     return { ok: true as const };
   });
-  ipcMain.handle('pin:recovery:complete', (_event: IpcMainInvokeEvent, payload: PinRecoveryCompleteDto) => {
+  ipcMain.handle('pin:recovery:complete', async (_event: IpcMainInvokeEvent, payload: PinRecoveryCompleteDto) => {
     const token = typeof payload?.token === 'string' ? payload.token : '';
     const newPin = typeof payload?.newPin === 'string' ? payload.newPin : '';
-    const result = completePinRecovery(token, newPin);
+    const result = await completePinRecovery(token, newPin);
     if (result.ok) {
       setVaultUnlocked();
     }
@@ -1125,22 +1134,6 @@ app.on('ready', async () => {
   }
 });
 
-ipcMain.handle('greet', async (_event: IpcMainInvokeEvent, name: string) => {
-  const { MyLibraryBinding } = await import('./bindings.js');
-  const obj = new MyLibraryBinding('Electron');
-  const result = obj.greet(name);
-  console.log('greet result:', result);
-  return result;
-});
-
-ipcMain.handle('add', async (_event: IpcMainInvokeEvent, a: number, b: number) => {
-  const { MyLibraryBinding } = await import('./bindings.js');
-  const obj = new MyLibraryBinding('Electron');
-  const result = obj.add(a, b);
-  console.log('add result:', result);
-  return result;
-});
-
 ipcMain.handle('nfc:getConnectionState', () => {
   return getNfcConnectionState('startup');
 });
@@ -3,6 +3,8 @@ import crypto from 'node:crypto';
 import fs from 'node:fs';
 import path from 'node:path';
 
+import { VaultCryptoBinding } from './bindings.js';
+
 const PIN_STATE_FILE = 'pin-state.bin';
 const PIN_LENGTH = 6;
 const PIN_REGEX = new RegExp(`^[0-9]{${PIN_LENGTH}}$`);
@@ -12,12 +14,19 @@ const MAX_ATTEMPTS = 5;
 const LOCK_BASE_MS = 30_000;
 const LOCK_MAX_MS = 15 * 60_000;
 const RECOVERY_TOKEN_TTL_MS = 2 * 60_000;
+const PIN_SCRYPT_MAXMEM = 64 * 1024 * 1024;
+const PIN_KDF_TARGET_MS = 250;
+const PIN_SCRYPT_FLOOR = { N: 1 << 15, r: 8, p: 1 } as const;
 
 type PinVerifyResult =
   | { ok: true }
   | { ok: false; reason: 'INVALID'; attemptsRemaining: number }
   | { ok: false; reason: 'LOCKED'; retryAfterMs: number };
 
+type PinSetResult =
+  | { ok: true }
+  | { ok: false; reason: 'ALREADY_SET' };
+
 type PinChangeResult =
   | { ok: true }
   | { ok: false; reason: 'NO_PIN' }
@@ -53,6 +62,18 @@ type PersistedPinStateV1 = {
 let recoveryTokenHash: Buffer | null = null;
 let recoveryTokenExpiresAt = 0;
 
+// PIN state is read, hashed and written back across an await; calls run one
+// at a time so concurrent attempts cannot overwrite each other's counters.
+let pinQueue: Promise<unknown> = Promise.resolve();
+
+let calibratedPinKdf: Promise<PersistedPinStateV1['kdf']> | null = null;
+
+function serialized<T>(fn: () => Promise<T>): Promise<T> {
+  const run = pinQueue.then(fn, fn);
+  pinQueue = run.catch(() => undefined);
+  return run;
+}
+
 function pinStatePath(): string {
   return path.join(app.getPath('userData'), PIN_STATE_FILE);
 }
@@ -106,15 +127,41 @@ function writeState(state: PersistedPinStateV1): void {
   fs.writeFileSync(pinStatePath(), encrypted);
 }
 
-function derivePinHash(pin: string, salt: Buffer, params: PersistedPinStateV1['kdf']): Buffer {
-  return crypto.scryptSync(pin, salt, params.keyLen, {
+// Native scrypt, off the main thread; same bytes as crypto.scryptSync()
+function derivePinHash(pin: string, salt: Buffer, params: PersistedPinStateV1['kdf']): Promise<Buffer> {
+  return VaultCryptoBinding.scrypt(pin, salt, {
     N: params.N,
     r: params.r,
     p: params.p,
-    maxmem: 64 * 1024 * 1024,
+    keyLen: params.keyLen,
+    maxmem: PIN_SCRYPT_MAXMEM,
   });
 }
 
+// The verifier never leaves this machine, so its cost can follow the
+// hardware: the strongest parameters that verify within PIN_KDF_TARGET_MS,
+// never below PIN_SCRYPT_FLOOR. Measured once per process.
+function pinKdfParams(): Promise<PersistedPinStateV1['kdf']> {
+  calibratedPinKdf ??= VaultCryptoBinding.calibrateScrypt({
+    targetMs: PIN_KDF_TARGET_MS,
+    minN: PIN_SCRYPT_FLOOR.N,
+    r: PIN_SCRYPT_FLOOR.r,
+    minP: PIN_SCRYPT_FLOOR.p,
+    maxmem: PIN_SCRYPT_MAXMEM,
+  }).then(
+    ({ N, r, p }) => ({ N, r, p, keyLen: HASH_BYTES }),
+    () => {
+      calibratedPinKdf = null;
+      return { ...PIN_SCRYPT_FLOOR, keyLen: HASH_BYTES };
+    }
+  );
+  return calibratedPinKdf;
+}
+
+function sameVerifier(a: PersistedPinStateV1, b: PersistedPinStateV1): boolean {
+  return a.salt === b.salt && a.hash === b.hash;
+}
+
 function assertPinFormat(pin: string): void {
   if (!PIN_REGEX.test(pin)) {
     throw new Error(`PIN must be exactly ${PIN_LENGTH} digits`);
@@ -141,17 +188,23 @@ export function hasPinConfigured(): boolean {
   return readState() !== null;
 }
 
-export function setPin(pin: string): void {
+// The check and the write share one turn of the queue, so two first-time
+// setups cannot both pass the check and the later silently win.
+export function setPinIfAbsent(pin: string): Promise<PinSetResult> {
   assertPinFormat(pin);
+  return serialized(async () => {
+    if (hasPinConfigured()) {
+      return { ok: false, reason: 'ALREADY_SET' };
+    }
+    await storePin(pin);
+    return { ok: true };
+  });
+}
 
+async function storePin(pin: string): Promise<void> {
   const salt = crypto.randomBytes(SALT_BYTES);
-  const kdf: PersistedPinStateV1['kdf'] = {
-    N: 1 << 15,
-    r: 8,
-    p: 1,
-    keyLen: HASH_BYTES,
-  };
-  const hash = derivePinHash(pin, salt, kdf);
+  const kdf = await pinKdfParams();
+  const hash = await derivePinHash(pin, salt, kdf);
 
   try {
     writeState({
@@ -169,9 +222,12 @@ export function setPin(pin: string): void {
   }
 }
 
-export function verifyPin(pin: string): PinVerifyResult {
+export function verifyPin(pin: string): Promise<PinVerifyResult> {
   assertPinFormat(pin);
+  return serialized(() => checkPin(pin));
+}
 
+async function checkPin(pin: string): Promise<PinVerifyResult> {
   const state = readState();
   if (!state) {
     return { ok: false, reason: 'INVALID', attemptsRemaining: 0 };
@@ -192,35 +248,42 @@ export function verifyPin(pin: string): PinVerifyResult {
     throw new Error('Stored PIN verifier has invalid hash length');
   }
 
-  const candidateHash = derivePinHash(pin, salt, state.kdf);
+  const candidateHash = await derivePinHash(pin, salt, state.kdf);
 
   try {
+    // The verifier may have been reset or replaced during the derivation.
+    // Never write the old one back, and never unlock against it.
+    const current = readState();
+    if (!current || !sameVerifier(current, state)) {
+      return { ok: false, reason: 'INVALID', attemptsRemaining: 0 };
+    }
+
     const isMatch = crypto.timingSafeEqual(candidateHash, expectedHash);
     if (isMatch) {
-      if (state.failedAttempts !== 0 || state.lockUntil !== 0 || state.lockLevel !== 0) {
-        state.failedAttempts = 0;
-        state.lockUntil = 0;
-        state.lockLevel = 0;
-        writeState(state);
+      if (current.failedAttempts !== 0 || current.lockUntil !== 0 || current.lockLevel !== 0) {
+        current.failedAttempts = 0;
+        current.lockUntil = 0;
+        current.lockLevel = 0;
+        writeState(current);
       }
       return { ok: true };
     }
 
-    state.failedAttempts += 1;
-    if (state.failedAttempts >= MAX_ATTEMPTS) {
-      state.failedAttempts = 0;
-      state.lockLevel += 1;
-      const durationMs = nextLockDurationMs(state.lockLevel);
-      state.lockUntil = now + durationMs;
-      writeState(state);
+    current.failedAttempts += 1;
+    if (current.failedAttempts >= MAX_ATTEMPTS) {
+      current.failedAttempts = 0;
+      current.lockLevel += 1;
+      const durationMs = nextLockDurationMs(current.lockLevel);
+      current.lockUntil = now + durationMs;
+      writeState(current);
       return { ok: false, reason: 'LOCKED', retryAfterMs: durationMs };
     }
 
-    writeState(state);
+    writeState(current);
     return {
       ok: false,
       reason: 'INVALID',
-      attemptsRemaining: Math.max(0, MAX_ATTEMPTS - state.failedAttempts),
+      attemptsRemaining: Math.max(0, MAX_ATTEMPTS - current.failedAttempts),
     };
   } finally {
     candidateHash.fill(0);
@@ -229,15 +292,18 @@ export function verifyPin(pin: string): PinVerifyResult {
   }
 }
 
-export function changePin(currentPin: string, newPin: string): PinChangeResult {
+export function changePin(currentPin: string, newPin: string): Promise<PinChangeResult> {
   assertPinFormat(currentPin);
   assertPinFormat(newPin);
+  return serialized(() => replacePin(currentPin, newPin));
+}
 
+async function replacePin(currentPin: string, newPin: string): Promise<PinChangeResult> {
   if (!hasPinConfigured()) {
     return { ok: false, reason: 'NO_PIN' };
   }
 
-  const verifyResult = verifyPin(currentPin);
+  const verifyResult = await checkPin(currentPin);
   if (!verifyResult.ok) {
     if (verifyResult.reason === 'LOCKED') {
       return { ok: false, reason: 'LOCKED', retryAfterMs: verifyResult.retryAfterMs };
@@ -249,7 +315,7 @@ export function changePin(currentPin: string, newPin: string): PinChangeResult {
     };
   }
 
-  setPin(newPin);
+  await storePin(newPin);
   return { ok: true };
 }
 
@@ -265,7 +331,11 @@ export function startPinRecovery(): PinRecoveryStartResult {
   };
 }
 
-export function completePinRecovery(token: string, newPin: string): PinRecoveryCompleteResult {
+export function completePinRecovery(token: string, newPin: string): Promise<PinRecoveryCompleteResult> {
+  return serialized(() => finishPinRecovery(token, newPin));
+}
+
+async function finishPinRecovery(token: string, newPin: string): Promise<PinRecoveryCompleteResult> {
   if (!PIN_REGEX.test(newPin)) {
     return { ok: false, reason: 'INVALID_NEW_PIN' };
   }
@@ -293,13 +363,17 @@ export function completePinRecovery(token: string, newPin: string): PinRecoveryC
     return { ok: false, reason: 'INVALID_TOKEN' };
   }
 
-  setPin(newPin);
+  await storePin(newPin);
   clearRecoveryToken();
   return { ok: true };
 }
 
-export function resetPin(): void {
-  const filePath = pinStatePath();
-  if (!fs.existsSync(filePath)) return;
-  fs.unlinkSync(filePath);
+// Queued behind any in-flight verify or set, which would otherwise write
+// the old verifier back after the reset.
+export function resetPin(): Promise<void> {
+  return serialized(async () => {
+    const filePath = pinStatePath();
+    if (!fs.existsSync(filePath)) return;
+    fs.unlinkSync(filePath);
+  });
 }
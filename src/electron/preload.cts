@@ -1,8 +1,6 @@
 const electron = require('electron');
 
 electron.contextBridge.exposeInMainWorld("electron", {
-    greet: (name: string) => ipcInvoke("greet", name),
-    add: (a: number, b: number) => ipcInvoke("add", a, b),
     connect: (port: string) => ipcInvoke("connect", port),
     disconnect: () => ipcInvoke("disconnect"),
     'nfc:getConnectionState': () => ipcInvoke('nfc:getConnectionState'),
@@ -35,6 +33,8 @@ electron.contextBridge.exposeInMainWorld("electron", {
     'vault:deleteEntry':  (id: string) => ipcInvoke('vault:deleteEntry', id),
     'vault:export':       () => ipcInvoke('vault:export'),
     'vault:import':       () => ipcInvoke('vault:import'),
+    'vault:getSessionPolicy': () => ipcInvoke('vault:getSessionPolicy'),
+    'vault:setSessionPolicy': (policy: SessionKeyringPolicyDto) => ipcInvoke('vault:setSessionPolicy', policy),
 
     // Cancel any in-progress card-wait operation
     'nfc:cancel': () => ipcInvoke('nfc:cancel'),
@@ -0,0 +1,162 @@
+/**
+ * sessionKeyring.ts
+ *
+ * Opt-in unlock window for card-gated decrypts. After a card tap, the card
+ * secret and the active root secret go into a native VaultCryptoBinding with
+ * a TTL. Until the window closes, decrypts derive the entry key natively from
+ * those secrets and never touch the reader: microseconds instead of a tap, an
+ * RF read and an authenticated DESFire session. The secrets stay in the
+ * native secure arena (locked, left out of core dumps); JS never holds them
+ * past the tap that opened the window.
+ *
+ * The window is measured from the last tap, never extended by use, and
+ * closes (native keys dropped and wiped) on:
+ *   - TTL expiry        native timer, fires even with the event loop idle
+ *   - app lock, OS lock screen, suspend        wired in main.ts
+ *   - root secret change                       vaultKeyManager.ts
+ *   - card init / format                       cardHandlers.ts
+ *   - card removal      only with endOnCardRemoval: the card must then stay
+ *                       on the reader, which is polled once per second
+ *
+ * Off by default; the policy persists in userData/session-keyring.json.
+ *
+ * Must only run in the main process.
+ */
+
+import { app } from 'electron';
+import fs from 'node:fs';
+import path from 'node:path';
+import { VaultCryptoBinding, type NfcCppBinding } from './bindings.js';
+import { openFieldsWith, type EntryField } from './entryFields.js';
+import type { EntryPayload } from './keyDerivation.js';
+import type { EntryRow } from './vault.js';
+
+const SESSION_POLICY_FILE = 'session-keyring.json';
+const MAX_SESSION_TTL_MS = 30 * 60 * 1000;
+const CARD_PRESENCE_INTERVAL_MS = 1_000;
+
+type SessionPolicy = {
+  /** 0 disables the keyring. */
+  ttlMs: number;
+  endOnCardRemoval: boolean;
+};
+
+const DEFAULT_POLICY: SessionPolicy = { ttlMs: 0, endOnCardRemoval: false };
+
+const keyring = new VaultCryptoBinding();
+let policy: SessionPolicy | null = null;
+let sessionUid: string | null = null;
+let presenceTimer: NodeJS.Timeout | null = null;
+let presenceCheckInFlight = false;
+
+// ── Policy ────────────────────────────────────────────────────────────────────
+
+function sessionPolicyPath(): string {
+  return path.join(app.getPath('userData'), SESSION_POLICY_FILE);
+}
+
+function normalizePolicy(raw: Partial<SessionPolicy> | null | undefined): SessionPolicy {
+  const ttlMs = Number(raw?.ttlMs);
+  return {
+    ttlMs: Number.isInteger(ttlMs) && ttlMs > 0 ? Math.min(ttlMs, MAX_SESSION_TTL_MS) : 0,
+    endOnCardRemoval: Boolean(raw?.endOnCardRemoval),
+  };
+}
+
+function currentPolicy(): SessionPolicy {
+  if (!policy) {
+    try {
+      policy = normalizePolicy(JSON.parse(fs.readFileSync(sessionPolicyPath(), 'utf8')) as Partial<SessionPolicy>);
+    } catch {
+      policy = { ...DEFAULT_POLICY };
+    }
+  }
+  return policy;
+}
+
+export function getSessionPolicy(): SessionKeyringPolicyDto {
+  const { ttlMs, endOnCardRemoval } = currentPolicy();
+  return { ttlMs, endOnCardRemoval, maxTtlMs: MAX_SESSION_TTL_MS };
+}
+
+/** Persists the policy; any open window closes so the new one applies from the next tap. */
+export function setSessionPolicy(next: SessionKeyringPolicyDto): SessionKeyringPolicyDto {
+  policy = normalizePolicy(next);
+  endSession();
+  fs.writeFileSync(sessionPolicyPath(), JSON.stringify(policy, null, 2), 'utf8');
+  return getSessionPolicy();
+}
+
+// ── Window ────────────────────────────────────────────────────────────────────
+
+/**
+ * Opens (or restarts) the window after a successful card read. No-op when
+ * the keyring is disabled. Copies the secrets into native memory; the caller
+ * still zeroizes its own buffers.
+ */
+export function openSession(
+  cardSecret: Buffer,
+  rootSecret: Buffer,
+  uidHex: string,
+  nfcBinding: NfcCppBinding
+): void {
+  const { ttlMs, endOnCardRemoval } = currentPolicy();
+  if (ttlMs === 0) return;
+
+  keyring.setKeys(cardSecret, rootSecret, { ttlMs });
+  sessionUid = uidHex;
+  stopPresenceWatch();
+  if (endOnCardRemoval) startPresenceWatch(nfcBinding);
+}
+
+/** Closes the window and wipes the native keys. Safe to call at any time. */
+export function endSession(): void {
+  stopPresenceWatch();
+  sessionUid = null;
+  keyring.clearKeys();
+}
+
+/**
+ * Decrypts `fields` of `row` under the open window. Resolves null when no
+ * window is open, so the caller falls back to a card tap. A row that does not
+ * authenticate rejects with DECRYPT_FAILED, as decryptEntry() would throw.
+ */
+export async function decryptWithSession<F extends EntryField>(
+  row:    EntryRow,
+  fields: readonly F[]
+): Promise<Pick<EntryPayload, F> | null> {
+  if (!keyring.hasKeys()) return null;
+  try {
+    return await openFieldsWith(keyring, row, fields);
+  } catch (err) {
+    // The window closed between the check and the batch
+    if ((err as { code?: string }).code === 'NO_KEYS') return null;
+    throw err;
+  }
+}
+
+// ── Card presence ─────────────────────────────────────────────────────────────
+
+function startPresenceWatch(nfcBinding: NfcCppBinding): void {
+  presenceTimer = setInterval(() => {
+    if (presenceCheckInFlight) return;
+    if (!keyring.hasKeys()) {
+      endSession();
+      return;
+    }
+    presenceCheckInFlight = true;
+    nfcBinding.peekCardUid()
+      .then((uid) => { if (uid !== sessionUid) endSession(); })
+      // A reader that cannot answer cannot vouch for the card either
+      .catch(() => endSession())
+      .finally(() => { presenceCheckInFlight = false; });
+  }, CARD_PRESENCE_INTERVAL_MS);
+  presenceTimer.unref();
+}
+
+function stopPresenceWatch(): void {
+  if (presenceTimer) {
+    clearInterval(presenceTimer);
+    presenceTimer = null;
+  }
+}
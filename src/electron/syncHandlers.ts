@@ -48,7 +48,7 @@ export function registerSyncHandlers(
     if (existing === null) {
       // Re-wrap existing local machine secret so previously-encrypted entries remain readable.
       const existingSecret = deps?.getMachineSecret ? deps.getMachineSecret() : undefined;
-      const { envelope, rootKey } = createVaultRootKeyEnvelope(password, {
+      const { envelope, rootKey } = await createVaultRootKeyEnvelope(password, {
         keyVersion: 2,
         rootKey: existingSecret,
       });
@@ -61,7 +61,7 @@ export function registerSyncHandlers(
       return 'initialized';
     }
 
-    const rootKey = decryptVaultRootKeyFromEnvelope(password, existing);
+    const rootKey = await decryptVaultRootKeyFromEnvelope(password, existing);
     try {
       setUnlockedVaultRootKey(rootKey, existing.keyVersion);
     } finally {
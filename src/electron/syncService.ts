@@ -26,6 +26,11 @@ const LAST_SYNC_ATTEMPT_AT_KEY = 'sync_last_attempt_at';
 const LAST_SYNC_ERROR_KEY = 'sync_last_error';
 const INITIAL_SEED_DONE_KEY = 'sync_initial_seed_done';
 const ACTIVE_USER_ID_KEY = 'sync_active_user_id';
+const PAYLOAD_V2_READY_KEY = 'sync_payload_v2_ready';
+
+// Advertised to the sync server with every login and token refresh
+export const ENTRY_PAYLOAD_V2_CAPABILITY = 'entry-payload-v2';
+const CLIENT_CAPABILITIES = [ENTRY_PAYLOAD_V2_CAPABILITY];
 
 let activeSyncRun: Promise<{ push: SyncPushResult; pull: SyncPullResult }> | null = null;
 
@@ -226,6 +231,8 @@ export interface SyncDevice {
   name: string;
   createdAt: string;
   lastSeenAt: string;
+  /** Absent from servers that predate device capabilities. */
+  capabilities?: string[];
   active: boolean;
   isCurrent: boolean;
 }
@@ -373,6 +380,8 @@ function clearSession(): void {
 }
 
 function writeSessionFromToken(payload: TokenResponse): void {
+  // A fresh sign-in may join a different set of devices: v1 until the next sync
+  setSyncStateValue(PAYLOAD_V2_READY_KEY, '');
   writeSession({
     userId: payload.userId,
     deviceId: payload.deviceId,
@@ -428,6 +437,7 @@ function clearSyncTelemetry(): void {
   setSyncStateValue(LAST_SYNC_ATTEMPT_AT_KEY, '');
   setSyncStateValue(LAST_SYNC_ERROR_KEY, '');
   setSyncStateValue(INITIAL_SEED_DONE_KEY, '');
+  setSyncStateValue(PAYLOAD_V2_READY_KEY, '');
 }
 
 function getActiveSyncUserId(): string | null {
@@ -505,7 +515,7 @@ async function requestRaw(
 async function refreshSession(config: SyncConfig, current: SyncSession): Promise<SyncSession> {
   const response = await requestRaw(config, '/v1/auth/refresh', {
     method: 'POST',
-    body: JSON.stringify({ refreshToken: current.refreshToken }),
+    body: JSON.stringify({ refreshToken: current.refreshToken, capabilities: CLIENT_CAPABILITIES }),
   });
   if (!response.ok) {
     clearSession();
@@ -732,6 +742,33 @@ export async function revokeSyncInvite(id: string): Promise<void> {
   });
 }
 
+/**
+ * Which payload format new and edited entries are written in. v2 only once
+ * the last sync saw every signed-in device of the account advertise it:
+ * synced rows carry their ciphertext as is, and builds from before v2 cannot
+ * read it. Local-only vaults stay on v1 too, since an older build may sign
+ * in later.
+ */
+export function entryPayloadVersion(): 1 | 2 {
+  return readSession() && getSyncStateValue(PAYLOAD_V2_READY_KEY) === '1' ? 2 : 1;
+}
+
+// Re-evaluated after every sync run, so a device joining on an older build
+// moves writers back to v1 from its next sync on.
+async function refreshPayloadFormatGate(): Promise<void> {
+  let ready = false;
+  try {
+    const devices = await getSyncDevices();
+    ready = devices.some((device) => device.isCurrent)
+      && devices
+        .filter((device) => device.active)
+        .every((device) => device.capabilities?.includes(ENTRY_PAYLOAD_V2_CAPABILITY) ?? false);
+  } catch {
+    // Unknown device set: stay on v1 without failing the sync run.
+  }
+  setSyncStateValue(PAYLOAD_V2_READY_KEY, ready ? '1' : '');
+}
+
 export async function getSyncDevices(): Promise<SyncDevice[]> {
   const config = requireConfig();
   const response = await requestAuthedJson<SyncDevicesResponse>(config, '/v1/auth/devices');
@@ -781,6 +818,7 @@ export async function bootstrapSync(password: string, bootstrapToken: string): P
       password,
       deviceName: config.deviceName,
       clientId: config.clientId,
+      capabilities: CLIENT_CAPABILITIES,
     }),
   });
   if (!response.ok) throw await throwApiError(response);
@@ -806,6 +844,7 @@ export async function registerSync(password: string, inviteToken?: string): Prom
       password,
       deviceName: config.deviceName,
       clientId: config.clientId,
+      capabilities: CLIENT_CAPABILITIES,
     }),
   });
   if (!response.ok) throw await throwApiError(response);
@@ -822,12 +861,14 @@ export async function loginSync(password: string, mfaCode?: string): Promise<Syn
     password: string;
     deviceName: string;
     clientId: string;
+    capabilities: string[];
     mfaCode?: string;
   } = {
     username: config.username,
     password,
     deviceName: config.deviceName,
     clientId: config.clientId,
+    capabilities: CLIENT_CAPABILITIES,
   };
   if (mfaCode && mfaCode.trim().length > 0) {
     requestBody.mfaCode = mfaCode.trim();
@@ -1153,6 +1194,7 @@ export async function runFullSync(): Promise<{
     try {
       const push = await pushSync();
       const pull = await pullSync();
+      await refreshPayloadFormatGate();
       recordSyncSuccess();
       return { push, pull };
     } catch (error) {
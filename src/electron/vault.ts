@@ -586,3 +586,128 @@ export function clearOutbox(ids: readonly string[]): void {
   });
   tx(ids);
 }
+
+// ── Whole-vault re-encryption ─────────────────────────────────────────────────
+//
+// A re-key writes the new blobs into a connection-local TEMP table in batched
+// transactions, then swaps them into `entries` in a single transaction. The
+// vault itself is untouched until that swap, so an aborted run leaves nothing
+// behind.
+
+/** Encrypted blob of one entry, as read for re-encryption. */
+export interface EntryCryptoRow {
+  id: string;
+  updatedAt: number;
+  ciphertext: Buffer;
+  iv: Buffer;
+  authTag: Buffer;
+}
+
+/** Re-encrypted blob, with the updated_at it was read at. */
+export interface StagedEntryBlob {
+  id: string;
+  sourceUpdatedAt: number;
+  ciphertext: Buffer;
+  iv: Buffer;
+  authTag: Buffer;
+}
+
+export function countEntries(): number {
+  const db = getDb();
+  return (db.prepare('SELECT COUNT(*) AS n FROM entries').get() as { n: number }).n;
+}
+
+/** Keyset page of encrypted blobs ordered by id, starting after `afterId`. */
+export function getEntryCryptoPage(afterId: string, limit: number): EntryCryptoRow[] {
+  const db = getDb();
+  return db.prepare(`
+    SELECT id,
+           updated_at AS updatedAt,
+           ciphertext,
+           iv,
+           auth_tag   AS authTag
+    FROM   entries
+    WHERE  id > ?
+    ORDER  BY id ASC
+    LIMIT  ?
+  `).all(afterId, limit) as EntryCryptoRow[];
+}
+
+export function beginRekeyStaging(): void {
+  const db = getDb();
+  db.exec(`
+    CREATE TEMP TABLE IF NOT EXISTS rekey_staging (
+      id                 TEXT    PRIMARY KEY,
+      source_updated_at  INTEGER NOT NULL,
+      ciphertext         BLOB    NOT NULL,
+      iv                 BLOB    NOT NULL,
+      auth_tag           BLOB    NOT NULL
+    );
+    DELETE FROM temp.rekey_staging;
+  `);
+}
+
+export function stageRekeyedBlobs(rows: readonly StagedEntryBlob[]): void {
+  if (rows.length === 0) return;
+  const db = getDb();
+  const tx = db.transaction((items: readonly StagedEntryBlob[]) => {
+    const stmt = db.prepare(`
+      INSERT INTO temp.rekey_staging (id, source_updated_at, ciphertext, iv, auth_tag)
+      VALUES (?, ?, ?, ?, ?)
+    `);
+    for (const row of items) {
+      stmt.run(row.id, row.sourceUpdatedAt, row.ciphertext, row.iv, row.authTag);
+    }
+  });
+  tx(rows);
+}
+
+export function discardRekeyStaging(): void {
+  getDb().exec('DROP TABLE IF EXISTS temp.rekey_staging');
+}
+
+/**
+ * Swaps every staged blob into `entries` in one transaction and queues the
+ * rows for sync, as updateEntry() does. Throws with code REKEY_CONFLICT, and
+ * changes nothing, if an entry was added, deleted or edited after it was
+ * read. Returns the number of rows rewritten.
+ */
+export function commitRekeyStaging(): number {
+  const db = getDb();
+  const now = Date.now();
+  const tx = db.transaction((ts: number) => {
+    const staged = (db.prepare('SELECT COUNT(*) AS n FROM temp.rekey_staging').get() as { n: number }).n;
+    const unmatched = (db.prepare(`
+      SELECT COUNT(*) AS n
+      FROM   entries e
+      LEFT   JOIN temp.rekey_staging s ON s.id = e.id
+      WHERE  s.id IS NULL OR s.source_updated_at <> e.updated_at
+    `).get() as { n: number }).n;
+    if (unmatched > 0 || staged !== countEntries()) {
+      throw Object.assign(
+        new Error('Vault changed while it was being re-encrypted; nothing was written'),
+        { code: 'REKEY_CONFLICT' }
+      );
+    }
+
+    db.prepare(`
+      UPDATE entries
+      SET    ciphertext = s.ciphertext,
+             iv         = s.iv,
+             auth_tag   = s.auth_tag,
+             updated_at = ?
+      FROM   temp.rekey_staging AS s
+      WHERE  entries.id = s.id
+    `).run(ts);
+    db.prepare(`
+      INSERT INTO sync_outbox (id, updated_at, deleted)
+      SELECT id, ?, 0 FROM entries WHERE true
+      ON CONFLICT(id) DO UPDATE SET
+        updated_at = excluded.updated_at,
+        deleted = 0
+    `).run(ts);
+    db.exec('DELETE FROM temp.rekey_staging');
+    return staged;
+  });
+  return tx(now);
+}
@@ -8,7 +8,9 @@
  * wait for a card tap, read the 16-byte card_secret via an authenticated DESFire
  * ReadData, derive a per-entry AES-256 key from card_secret + active root
  * secret, then encrypt/decrypt in the main process. card_secret and derived
- * key buffers are zeroized after use.
+ * key buffers are zeroized after use. With the unlock window enabled
+ * (sessionKeyring.ts), each tap also opens the window and vault:getEntry
+ * decrypts without a tap while it is open.
  *
  * Must only run in the main process.
  */
@@ -22,7 +24,6 @@ import {
   deriveCardKey,
   deriveEntryKey,
   encryptEntry,
-  decryptEntry,
   zeroizeBuffer,
   EntryPayload,
 } from './keyDerivation.js';
@@ -37,6 +38,14 @@ import {
   EntryRow,
 } from './vault.js';
 import { beginCardWait } from './nfcCancel.js';
+import { entryPayloadVersion } from './syncService.js';
+import { ALL_ENTRY_FIELDS, decryptEntryFields } from './entryFields.js';
+import {
+  openSession,
+  decryptWithSession,
+  getSessionPolicy,
+  setSessionPolicy,
+} from './sessionKeyring.js';
 
 const PROBE_INTERVAL_MS = 200;
 const PROBE_TIMEOUT_MS  = 15_000;
@@ -69,20 +78,17 @@ function uidToBuffer(uidHex: string): Buffer {
 }
 
 /**
- * Core card-gated key derivation flow:
+ * Core card-gated secret flow:
  *   1. Wait for card tap  →  get UID
  *   2. Derive read key from active root secret + UID
  *   3. Read 16-byte card_secret from File 00 (authenticated via read key)
- *   4. Derive per-entry AES-256 key from cardSecret + active root secret + entryId
- *   5. Call fn(entryKey) — synchronous crypto only
+ *   4. Open the unlock window with cardSecret + active root secret, if enabled
+ *   5. Call fn(cardSecret, rootSecret)
  *   6. Zeroize all sensitive buffers
- *
- * entryId must be the stable UUID for the entry (pre-generated for creates).
  */
-async function withEntryKey<T>(
+async function withCardSecrets<T>(
   nfcBinding: NfcCppBinding,
-  entryId:    string,
-  fn:         (entryKey: Buffer) => T
+  fn:         (cardSecret: Buffer, rootSecret: Buffer) => T | Promise<T>
 ): Promise<T> {
   const signal        = beginCardWait();
   const rootSecret    = getCryptoRootSecret();
@@ -100,19 +106,39 @@ async function withEntryKey<T>(
       zeroizeBuffer(readKey);
     }
 
-    // Derive per-entry key then invoke the crypto function
-    const entryKey = deriveEntryKey(cardSecretBuf, rootSecret, entryId);
-    zeroizeBuffer(cardSecretBuf);
     try {
-      return fn(entryKey);
+      openSession(cardSecretBuf, rootSecret, uidHex, nfcBinding);
+      return await fn(cardSecretBuf, rootSecret);
     } finally {
-      zeroizeBuffer(entryKey);
+      zeroizeBuffer(cardSecretBuf);
     }
   } finally {
     zeroizeBuffer(rootSecret);
   }
 }
 
+/**
+ * withCardSecrets() narrowed to one entry: derives the per-entry AES-256 key
+ * from cardSecret + active root secret + entryId and calls fn(entryKey),
+ * synchronous crypto only.
+ *
+ * entryId must be the stable UUID for the entry (pre-generated for creates).
+ */
+async function withEntryKey<T>(
+  nfcBinding: NfcCppBinding,
+  entryId:    string,
+  fn:         (entryKey: Buffer) => T
+): Promise<T> {
+  return withCardSecrets(nfcBinding, (cardSecret, rootSecret) => {
+    const entryKey = deriveEntryKey(cardSecret, rootSecret, entryId);
+    try {
+      return fn(entryKey);
+    } finally {
+      zeroizeBuffer(entryKey);
+    }
+  });
+}
+
 // ── Registration ──────────────────────────────────────────────────────────────
 
 export function registerVaultHandlers(
@@ -149,22 +175,26 @@ export function registerVaultHandlers(
       if (!row) {
         throw Object.assign(new Error(`Entry ${id} not found`), { code: 'NOT_FOUND' });
       }
-      log('info', `vault:getEntry — tap card to decrypt "${row.label}"...`);
-      return withEntryKey(nfcBinding, id, (entryKey): EntryPayloadDto => {
-        const payload = decryptEntry(entryKey, row.ciphertext, row.iv, row.authTag);
-        return {
-          id:          row.id,
-          label:       row.label,
-          url:         row.url,
-          category:    row.category,
-          username:    payload.username,
-          password:    payload.password,
-          totpSecret:  payload.totpSecret,
-          notes:       payload.notes,
-          createdAt:   row.createdAt,
-          updatedAt:   row.updatedAt,
-        };
+      const toDto = (payload: EntryPayload): EntryPayloadDto => ({
+        id:          row.id,
+        label:       row.label,
+        url:         row.url,
+        category:    row.category,
+        username:    payload.username,
+        password:    payload.password,
+        totpSecret:  payload.totpSecret,
+        notes:       payload.notes,
+        createdAt:   row.createdAt,
+        updatedAt:   row.updatedAt,
       });
+
+      const cached = await decryptWithSession(row, ALL_ENTRY_FIELDS);
+      if (cached) return toDto(cached);
+
+      log('info', `vault:getEntry — tap card to decrypt "${row.label}"...`);
+      return withCardSecrets(nfcBinding, async (cardSecret, rootSecret): Promise<EntryPayloadDto> =>
+        toDto(await decryptEntryFields(cardSecret, rootSecret, row, ALL_ENTRY_FIELDS))
+      );
     }
   );
 
@@ -183,7 +213,7 @@ export function registerVaultHandlers(
           password:   params.password,
           totpSecret: params.totpSecret,
           notes:      params.notes,
-        } as EntryPayload);
+        } as EntryPayload, entryPayloadVersion());
         return insertEntry(newId, {
           label:      params.label,
           url:        params.url ?? '',
@@ -215,7 +245,7 @@ export function registerVaultHandlers(
           password:   params.password,
           totpSecret: params.totpSecret,
           notes:      params.notes,
-        } as EntryPayload);
+        } as EntryPayload, entryPayloadVersion());
         const updated = updateEntry(id, {
           label:      params.label,
           url:        params.url ?? '',
@@ -244,6 +274,21 @@ export function registerVaultHandlers(
     }
   );
 
+  // ── vault:getSessionPolicy / vault:setSessionPolicy ────────────────────────
+  // Unlock window after a card tap; off until the user opts in.
+  ipcMain.handle('vault:getSessionPolicy', (): SessionKeyringPolicyDto => getSessionPolicy());
+  ipcMain.handle(
+    'vault:setSessionPolicy',
+    (_ev: IpcMainInvokeEvent, next: SessionKeyringPolicyDto): SessionKeyringPolicyDto => {
+      const applied = setSessionPolicy(next);
+      log('info', applied.ttlMs > 0
+        ? `vault:setSessionPolicy — unlock window ${Math.round(applied.ttlMs / 1000)} s` +
+          (applied.endOnCardRemoval ? ', ends on card removal.' : '.')
+        : 'vault:setSessionPolicy — unlock window off.');
+      return applied;
+    }
+  );
+
   // ── vault:export ────────────────────────────────────────────────────────────
   // Dumps all encrypted rows to a JSON file chosen by the user.
   // No card tap needed — the blobs are already encrypted at rest.
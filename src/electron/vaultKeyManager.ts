@@ -1,6 +1,8 @@
 import crypto from 'node:crypto';
 
+import { VaultCryptoBinding } from './bindings.js';
 import { zeroizeBuffer } from './keyDerivation.js';
+import { endSession } from './sessionKeyring.js';
 import type { SyncKeyEnvelope } from './syncService.js';
 
 const ROOT_KEY_BYTES = 32;
@@ -15,6 +17,19 @@ const DEFAULT_SCRYPT_PARAMS = {
   dkLen: 32,
 } as const;
 
+// What assertScryptParams() accepts, and so what calibration may pick
+const SCRYPT_LIMITS = {
+  minN: 16_384,
+  maxN: 1_048_576,
+  maxR: 32,
+  maxP: 16,
+} as const;
+
+const WRAP_KEY_MAXMEM = 256 * 1024 * 1024;
+const KDF_TARGET_MS = 250;
+
+let calibratedScryptParams: Promise<SyncKeyEnvelope['kdfParams']> | null = null;
+
 let unlockedVaultRootKey: Buffer | null = null;
 let unlockedAt: number | null = null;
 let unlockedKeyVersion: number | null = null;
@@ -33,13 +48,13 @@ function assertEnvelopeKdf(envelope: SyncKeyEnvelope): void {
 
 function assertScryptParams(params: SyncKeyEnvelope['kdfParams']): void {
   const isInt = (value: number) => Number.isInteger(value) && Number.isFinite(value);
-  if (!isInt(params.N) || params.N < 16_384 || params.N > 1_048_576) {
+  if (!isInt(params.N) || params.N < SCRYPT_LIMITS.minN || params.N > SCRYPT_LIMITS.maxN) {
     throw new Error('Invalid scrypt N parameter');
   }
-  if (!isInt(params.r) || params.r < 1 || params.r > 32) {
+  if (!isInt(params.r) || params.r < 1 || params.r > SCRYPT_LIMITS.maxR) {
     throw new Error('Invalid scrypt r parameter');
   }
-  if (!isInt(params.p) || params.p < 1 || params.p > 16) {
+  if (!isInt(params.p) || params.p < 1 || params.p > SCRYPT_LIMITS.maxP) {
     throw new Error('Invalid scrypt p parameter');
   }
   if (!isInt(params.dkLen) || params.dkLen < 32 || params.dkLen > 64) {
@@ -55,23 +70,50 @@ function fromBase64(value: string): Buffer {
   return Buffer.from(value, 'base64');
 }
 
+// Native scrypt: runs off the main thread, lanes in parallel
 function deriveWrapKey(
   passphrase: string,
   salt: Buffer,
   params: SyncKeyEnvelope['kdfParams']
-): Buffer {
-  return crypto.scryptSync(passphrase, salt, params.dkLen, {
+): Promise<Buffer> {
+  return VaultCryptoBinding.scrypt(passphrase, salt, {
     N: params.N,
     r: params.r,
     p: params.p,
-    maxmem: 256 * 1024 * 1024,
+    keyLen: params.dkLen,
+    maxmem: WRAP_KEY_MAXMEM,
   });
 }
 
-export function createVaultRootKeyEnvelope(
+/**
+ * scrypt parameters for new envelopes: the strongest this machine derives
+ * within KDF_TARGET_MS, never weaker than DEFAULT_SCRYPT_PARAMS and always
+ * inside what assertScryptParams() accepts. Measured once per process; if
+ * calibration fails the defaults are used and it is retried next time.
+ */
+export function getEnvelopeScryptParams(): Promise<SyncKeyEnvelope['kdfParams']> {
+  calibratedScryptParams ??= VaultCryptoBinding.calibrateScrypt({
+    targetMs: KDF_TARGET_MS,
+    minN: DEFAULT_SCRYPT_PARAMS.N,
+    r: DEFAULT_SCRYPT_PARAMS.r,
+    minP: DEFAULT_SCRYPT_PARAMS.p,
+    maxN: SCRYPT_LIMITS.maxN,
+    maxP: SCRYPT_LIMITS.maxP,
+    maxmem: WRAP_KEY_MAXMEM,
+  }).then(
+    ({ N, r, p }) => ({ N, r, p, dkLen: DEFAULT_SCRYPT_PARAMS.dkLen }),
+    () => {
+      calibratedScryptParams = null;
+      return { ...DEFAULT_SCRYPT_PARAMS };
+    }
+  );
+  return calibratedScryptParams;
+}
+
+export async function createVaultRootKeyEnvelope(
   passphrase: string,
   options?: { keyVersion?: number; rootKey?: Buffer }
-): { envelope: SyncKeyEnvelope; rootKey: Buffer } {
+): Promise<{ envelope: SyncKeyEnvelope; rootKey: Buffer }> {
   assertPassphrase(passphrase);
 
   const keyVersion = options?.keyVersion ?? 2;
@@ -86,8 +128,8 @@ export function createVaultRootKeyEnvelope(
 
   const salt = crypto.randomBytes(SALT_BYTES);
   const nonce = crypto.randomBytes(NONCE_BYTES);
-  const params = { ...DEFAULT_SCRYPT_PARAMS };
-  const wrapKey = deriveWrapKey(passphrase, salt, params);
+  const params = await getEnvelopeScryptParams();
+  const wrapKey = await deriveWrapKey(passphrase, salt, params);
 
   try {
     const cipher = crypto.createCipheriv('aes-256-gcm', wrapKey, nonce);
@@ -110,10 +152,10 @@ export function createVaultRootKeyEnvelope(
   }
 }
 
-export function decryptVaultRootKeyFromEnvelope(
+export async function decryptVaultRootKeyFromEnvelope(
   passphrase: string,
   envelope: SyncKeyEnvelope
-): Buffer {
+): Promise<Buffer> {
   assertPassphrase(passphrase);
   assertEnvelopeKdf(envelope);
   assertScryptParams(envelope.kdfParams);
@@ -128,7 +170,7 @@ export function decryptVaultRootKeyFromEnvelope(
   if (authTag.length !== AUTH_TAG_BYTES) throw new Error('Invalid envelope authTag');
   if (ciphertext.length === 0) throw new Error('Invalid envelope ciphertext');
 
-  const wrapKey = deriveWrapKey(passphrase, salt, envelope.kdfParams);
+  const wrapKey = await deriveWrapKey(passphrase, salt, envelope.kdfParams);
   try {
     const decipher = crypto.createDecipheriv('aes-256-gcm', wrapKey, nonce);
     decipher.setAuthTag(authTag);
@@ -155,6 +197,8 @@ export function setUnlockedVaultRootKey(rootKey: Buffer, keyVersion: number): vo
   unlockedVaultRootKey = Buffer.from(rootKey);
   unlockedAt = Date.now();
   unlockedKeyVersion = keyVersion;
+  // The unlock window holds entry keys for the previous root
+  endSession();
 }
 
 export function getUnlockedVaultRootKey(): Buffer | null {
@@ -169,6 +213,7 @@ export function clearUnlockedVaultRootKey(): void {
   }
   unlockedAt = null;
   unlockedKeyVersion = null;
+  endSession();
 }
 
 export function getVaultKeyUnlockState(): {
@@ -0,0 +1,136 @@
+/**
+ * vaultRekey.ts
+ *
+ * Whole-vault re-encryption, for moving to a new card or rotating the root
+ * secret. Every entry key is HKDF(cardSecret ‖ rootSecret, entryId), so a
+ * change to either secret means opening every row under the old keys and
+ * sealing it again under the new ones.
+ *
+ * Rows are streamed out of SQLite in keyset pages. Each page goes to the
+ * native engine (VaultCryptoBinding.rekeyEntries), which spreads it over its
+ * work-stealing pool, and the page's results are staged while the next page
+ * is processed. Nothing in `entries` changes until every row has been
+ * re-encrypted and staged; the swap is then one transaction, so the vault
+ * ends up fully on the new keys or untouched.
+ *
+ * Must only run in the main process.
+ */
+
+import { VaultCryptoBinding, type OpenEntryInput, type EncryptedBlobDto } from './bindings.js';
+import {
+  countEntries,
+  getEntryCryptoPage,
+  beginRekeyStaging,
+  stageRekeyedBlobs,
+  commitRekeyStaging,
+  discardRekeyStaging,
+  type EntryCryptoRow,
+  type StagedEntryBlob,
+} from './vault.js';
+
+// ── Types ────────────────────────────────────────────────────────────────────
+
+/** The two secrets entry keys are derived from. */
+export interface VaultKeyMaterial {
+  cardSecret: Buffer | number[];  // 16 B — card File 00
+  rootSecret: Buffer;             // 32 B — machine secret or unlocked synced root key
+}
+
+export interface RekeyProgress {
+  phase: 'reencrypt' | 'commit' | 'done';
+  done: number;   // rows re-encrypted and staged
+  total: number;  // rows in the vault when the run started
+}
+
+export interface RekeyOptions {
+  from: VaultKeyMaterial;
+  to: VaultKeyMaterial;
+  /** Rows per native call and per staging transaction. */
+  batchSize?: number;
+  onProgress?: (progress: RekeyProgress) => void;
+}
+
+const DEFAULT_BATCH_SIZE = 512;
+
+let rekeyInFlight = false;
+
+// ── Re-key ───────────────────────────────────────────────────────────────────
+
+function toInputs(rows: readonly EntryCryptoRow[]): OpenEntryInput[] {
+  return rows.map(r => ({ entryId: r.id, ciphertext: r.ciphertext, iv: r.iv, authTag: r.authTag }));
+}
+
+function toStaged(rows: readonly EntryCryptoRow[], blobs: readonly (EncryptedBlobDto | null)[]): StagedEntryBlob[] {
+  return rows.map((row, i) => {
+    const blob = blobs[i];
+    if (!blob) {
+      throw Object.assign(
+        new Error(`Entry ${row.id} does not decrypt with the current keys; nothing was written`),
+        { code: 'REKEY_AUTH_FAILED' }
+      );
+    }
+    return { id: row.id, sourceUpdatedAt: row.updatedAt, ...blob };
+  });
+}
+
+/**
+ * Re-encrypts every entry from `from` to `to`. Resolves with the number of
+ * rows rewritten once the swap has committed.
+ *
+ * Rejects, leaving the vault unchanged, with code:
+ *   REKEY_IN_PROGRESS — another re-key is running
+ *   REKEY_AUTH_FAILED — a row does not open under `from` (wrong card or root secret)
+ *   REKEY_CONFLICT    — an entry was added, edited or deleted during the run
+ *
+ * The caller still owns and must zeroize the secrets in `from` and `to`;
+ * they are copied into native memory and wiped there when the run ends.
+ */
+export async function rekeyVault(opts: RekeyOptions): Promise<{ rekeyed: number }> {
+  if (rekeyInFlight) {
+    throw Object.assign(new Error('A vault re-encryption is already running'), { code: 'REKEY_IN_PROGRESS' });
+  }
+  rekeyInFlight = true;
+
+  const source = new VaultCryptoBinding();
+  const target = new VaultCryptoBinding();
+  let pending: Promise<(EncryptedBlobDto | null)[]> | null = null;
+  try {
+    source.setKeys(opts.from.cardSecret, opts.from.rootSecret);
+    target.setKeys(opts.to.cardSecret, opts.to.rootSecret);
+
+    const batchSize = Math.max(1, opts.batchSize ?? DEFAULT_BATCH_SIZE);
+    const total = countEntries();
+    let done = 0;
+    opts.onProgress?.({ phase: 'reencrypt', done, total });
+    beginRekeyStaging();
+
+    let rows = getEntryCryptoPage('', batchSize);
+    pending = rows.length > 0 ? source.rekeyEntries(toInputs(rows), target) : null;
+    while (pending) {
+      const blobs = await pending;
+      // Queue the next page before staging this one, so the pool and the
+      // SQLite writes overlap
+      const next = getEntryCryptoPage(rows[rows.length - 1].id, batchSize);
+      pending = next.length > 0 ? source.rekeyEntries(toInputs(next), target) : null;
+
+      stageRekeyedBlobs(toStaged(rows, blobs));
+      done += rows.length;
+      opts.onProgress?.({ phase: 'reencrypt', done, total: Math.max(total, done) });
+      rows = next;
+    }
+
+    opts.onProgress?.({ phase: 'commit', done, total: Math.max(total, done) });
+    const rekeyed = commitRekeyStaging();
+    opts.onProgress?.({ phase: 'done', done: rekeyed, total: rekeyed });
+    return { rekeyed };
+  } catch (err) {
+    // A page may still be in flight; its result is no longer wanted
+    pending?.catch(() => undefined);
+    throw err;
+  } finally {
+    source.clearKeys();
+    target.clearKeys();
+    try { discardRekeyStaging(); } catch { /* vault already closed */ }
+    rekeyInFlight = false;
+  }
+}
@@ -1,15 +1,43 @@
 declare module '../../build/myaddon.node' {
-  export class MyLibraryBinding {
-    constructor(name: string);
-    greet(str: string): string;
-    add(a: number, b: number): number;
-  }
   export class NfcCppBinding {
     constructor();
     connect(port: string): Promise<string>;
     disconnect(): Promise<boolean>;
     setLogCallback(callback?: (level: string, message: string) => void): void;
   }
+  export class VaultCryptoBinding {
+    constructor();
+    static scrypt(password: string | Buffer, salt: Buffer,
+      options: { N: number; r: number; p: number; keyLen: number; maxmem?: number }): Promise<Buffer>;
+    static calibrateScrypt(options: {
+      targetMs: number; minN?: number; r?: number; minP?: number; maxN?: number; maxP?: number; maxmem?: number;
+    }): Promise<{ N: number; r: number; p: number; measuredMs: number }>;
+    static createChunkedHeader(options?: { chunkSize?: number }): Buffer;
+    static secureMemory(): {
+      locked: boolean; dumpExcluded: boolean; pageSize: number; capacity: number;
+      inUse: number; peakInUse: number; heapFallbacks: number;
+    };
+    setKeys(cardSecret: Buffer | number[], machineSecret: Buffer, options?: { ttlMs?: number }): void;
+    clearKeys(): void;
+    hasKeys(): boolean;
+    keysExpireInMs(): number | null;
+    backend(): string;
+    sealEntries(entries: { entryId: string; plaintext: string | Buffer }[]):
+      Promise<{ ciphertext: Buffer; iv: Buffer; authTag: Buffer }[]>;
+    sealEntryFields(entries: {
+      entryId: string; fields: { username?: string; password?: string; totpSecret?: string; notes?: string };
+    }[], options?: { payloadVersion?: 1 | 2 }): Promise<{ ciphertext: Buffer; iv: Buffer; authTag: Buffer }[]>;
+    openEntries(entries: { entryId: string; ciphertext: Buffer; iv: Buffer; authTag: Buffer }[]):
+      Promise<(Buffer | null)[]>;
+    openEntryFields(entries: { entryId: string; ciphertext: Buffer; iv: Buffer; authTag: Buffer }[],
+      fields: readonly ('username' | 'password' | 'totpSecret' | 'notes')[]):
+      Promise<({ username?: string; password?: string; totpSecret?: string; notes?: string } | null)[]>;
+    rekeyEntries(entries: { entryId: string; ciphertext: Buffer; iv: Buffer; authTag: Buffer }[], target: VaultCryptoBinding):
+      Promise<({ ciphertext: Buffer; iv: Buffer; authTag: Buffer } | null)[]>;
+    sealChunks(blobId: string, header: Buffer, firstIndex: number, data: Buffer, final: boolean): Promise<Buffer>;
+    openChunks(blobId: string, header: Buffer, firstIndex: number, sealed: Buffer, final: boolean):
+      Promise<Buffer | null>;
+  }
 }
 
 declare module '*.node' {
@@ -2,23 +2,11 @@ import { useState } from 'react';
 import { DebugTerminal } from './DebugTerminal';
 
 export const MainPage = () => {
-  const [greeting, setGreeting] = useState<string>('');
-  const [sum, setSum] = useState<number | null>(null);
   const [port, setPort] = useState<string>('COM3');
   const [connectResult, setConnectResult] = useState<string>('');
   const [isConnected, setIsConnected] = useState<boolean>(false);
   const [isTerminalOpen, setIsTerminalOpen] = useState<boolean>(false);
 
-  const handleGreet = async () => {
-    const result = await window.electron.greet('React User');
-    setGreeting(result);
-  };
-
-  const handleAdd = async () => {
-    const result = await window.electron.add(5, 7);
-    setSum(result);
-  };
-
   const handleConnect = async () => {
     try {
       setConnectResult('Connecting...');
@@ -46,26 +34,6 @@ export const MainPage = () => {
     <div className="p-8 text-white">
       <h1 className="text-2xl font-bold mb-4">Electron C++ Template</h1>
       
-      <div className="mb-6">
-        <button 
-          onClick={handleGreet}
-          className="bg-blue-600 hover:bg-blue-700 text-white px-4 py-2 rounded mr-4"
-        >
-          Test Greet (C++)
-        </button>
-        {greeting && <span className="ml-2">Result: {greeting}</span>}
-      </div>
-
-      <div className="mb-6">
-        <button 
-          onClick={handleAdd}
-          className="bg-green-600 hover:bg-green-700 text-white px-4 py-2 rounded mr-4"
-        >
-          Test Add 5 + 7 (C++)
-        </button>
-        {sum !== null && <span className="ml-2">Result: {sum}</span>}
-      </div>
-
       <div className="mt-8 p-4 border border-gray-600 rounded">
         <div className="flex items-center justify-between mb-4">
           <h2 className="text-xl font-bold">PN532 Connection</h2>
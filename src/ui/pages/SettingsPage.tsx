@@ -172,6 +172,7 @@ export const SettingsPage = ({ theme, onToggleTheme, terminalEnabled, onToggleTe
   const [extFolderFeedback, setExtFolderFeedback] = useState<{ type: 'ok' | 'err'; message: string } | null>(null);
   const [autoDownloadUpdates, setAutoDownloadUpdates] = useState(true);
   const [autoDownloadBusy, setAutoDownloadBusy] = useState(false);
+  const [sessionPolicy, setSessionPolicyState] = useState<SessionKeyringPolicyDto>({ ttlMs: 0, endOnCardRemoval: false });
 
   const [syncStatus, setSyncStatus] = useState<SyncStatusDto | null>(null);
   const [syncMode, setSyncMode] = useState<'local' | 'synced'>(
@@ -403,12 +404,34 @@ export const SettingsPage = ({ theme, onToggleTheme, terminalEnabled, onToggleTe
     }
   };
 
+  const refreshSessionPolicy = async () => {
+    try {
+      setSessionPolicyState(await window.electron['vault:getSessionPolicy']());
+    } catch (error) {
+      const message = error instanceof Error ? error.message : String(error);
+      console.warn('[settings] Failed to load unlock window policy:', message);
+    }
+  };
+
+  const updateSessionPolicy = async (next: SessionKeyringPolicyDto) => {
+    const previous = sessionPolicy;
+    setSessionPolicyState(next);
+    try {
+      setSessionPolicyState(await window.electron['vault:setSessionPolicy'](next));
+    } catch (error) {
+      setSessionPolicyState(previous);
+      const message = error instanceof Error ? error.message : String(error);
+      console.warn('[settings] Failed to persist unlock window policy:', message);
+    }
+  };
+
   useEffect(() => {
     const init = async () => {
       const status = await refreshSyncStatus();
       await refreshVaultKeyStatus();
       await refreshMfaStatus(status);
       await refreshUpdatePreferences();
+      await refreshSessionPolicy();
     };
     void init();
   }, []); // eslint-disable-line react-hooks/exhaustive-deps
@@ -500,7 +523,9 @@ export const SettingsPage = ({ theme, onToggleTheme, terminalEnabled, onToggleTe
     appearance: show('Light Mode', 'Switch between dark and light theme'),
     security:   show('Require PIN on Wake', 'Re-lock vault when the app regains focus')
              || show('Auto-lock After', 'Automatically lock after this period of inactivity')
-             || show('Change PIN', 'Verify your current PIN before setting a new one'),
+             || show('Change PIN', 'Verify your current PIN before setting a new one')
+             || show('Card Unlock Window', 'Decrypt again without a tap for this long after tapping your card')
+             || show('End on Card Removal', 'Close the unlock window as soon as the card leaves the reader'),
     clipboard:  show('Password Reveal Duration', 'How long a password stays visible after clicking Show')
              || show('Auto-clear Clipboard', 'Remove copied password from clipboard automatically')
              || show('Clear After'),
@@ -644,6 +669,29 @@ export const SettingsPage = ({ theme, onToggleTheme, terminalEnabled, onToggleTe
                 onChange={v => sel('setting-autolock', v, setAutoLock)}
               />
             )}
+            {show('Card Unlock Window', 'Decrypt again without a tap for this long after tapping your card') && (
+              <SelectRow
+                label="Card Unlock Window"
+                description="Decrypt again without a tap for this long after tapping your card"
+                value={String(sessionPolicy.ttlMs)}
+                options={[
+                  { value: '0',       label: 'Off'        },
+                  { value: '60000',   label: '1 minute'   },
+                  { value: '300000',  label: '5 minutes'  },
+                  { value: '900000',  label: '15 minutes' },
+                  { value: '1800000', label: '30 minutes' },
+                ]}
+                onChange={v => void updateSessionPolicy({ ...sessionPolicy, ttlMs: Number(v) })}
+              />
+            )}
+            {sessionPolicy.ttlMs > 0 && show('End on Card Removal', 'Close the unlock window as soon as the card leaves the reader') && (
+              <ToggleRow
+                label="End on Card Removal"
+                description="Close the unlock window as soon as the card leaves the reader"
+                value={sessionPolicy.endOnCardRemoval}
+                onChange={() => void updateSessionPolicy({ ...sessionPolicy, endOnCardRemoval: !sessionPolicy.endOnCardRemoval })}
+              />
+            )}
             {show('Change PIN', 'Verify your current PIN before setting a new one') && (
               <ButtonRow
                 label="Change PIN"
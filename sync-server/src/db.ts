@@ -70,6 +70,11 @@ async function runMigrations(pool: Pool): Promise<void> {
     ALTER TABLE devices
       ADD COLUMN IF NOT EXISTS client_id TEXT;
 
+    -- Formats and features the device's build understands, as it last
+    -- reported them; older builds report none.
+    ALTER TABLE devices
+      ADD COLUMN IF NOT EXISTS capabilities TEXT[] NOT NULL DEFAULT '{}';
+
     CREATE UNIQUE INDEX IF NOT EXISTS idx_devices_user_client_id_unique
       ON devices (user_id, client_id);
 
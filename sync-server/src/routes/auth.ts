@@ -24,12 +24,16 @@ const passwordSchema = z.string().min(10).max(256);
 const deviceNameSchema = z.string().min(1).max(120).default('desktop');
 const clientIdSchema = z.string().trim().min(16).max(128).regex(/^[A-Za-z0-9._:-]+$/);
 const mfaCodeSchema = z.string().trim().regex(/^[0-9]{6}$/);
+// Client-declared build capabilities (e.g. "entry-payload-v2"); stored per
+// device so clients can tell when every device reads a new format.
+const capabilitiesSchema = z.array(z.string().trim().min(1).max(64).regex(/^[a-z0-9.-]+$/)).max(32);
 
 const registerSchema = z.object({
   username: usernameSchema,
   password: passwordSchema,
   deviceName: deviceNameSchema,
   clientId: clientIdSchema.optional(),
+  capabilities: capabilitiesSchema.default([]),
 });
 
 const loginSchema = z.object({
@@ -37,11 +41,14 @@ const loginSchema = z.object({
   password: passwordSchema,
   deviceName: deviceNameSchema,
   clientId: clientIdSchema.optional(),
+  capabilities: capabilitiesSchema.default([]),
   mfaCode: mfaCodeSchema.optional(),
 });
 
 const refreshSchema = z.object({
   refreshToken: z.string().min(20),
+  // Sent by updated builds on every refresh; absent leaves the stored set
+  capabilities: capabilitiesSchema.optional(),
 });
 
 const userExistsQuerySchema = z.object({
@@ -70,25 +77,27 @@ async function createDevice(
   client: PoolClient,
   userId: string,
   deviceName: string,
+  capabilities: string[],
   clientId?: string
 ): Promise<string> {
   if (clientId) {
     const upserted = await client.query<{ id: string }>(
-      `INSERT INTO devices (user_id, name, client_id, last_seen_at)
-       VALUES ($1, $2, $3, now())
+      `INSERT INTO devices (user_id, name, client_id, capabilities, last_seen_at)
+       VALUES ($1, $2, $3, $4, now())
        ON CONFLICT (user_id, client_id)
        DO UPDATE SET
          name = EXCLUDED.name,
+         capabilities = EXCLUDED.capabilities,
          last_seen_at = now()
        RETURNING id`,
-      [userId, deviceName, clientId]
+      [userId, deviceName, clientId, capabilities]
     );
     return upserted.rows[0].id;
   }
 
   const inserted = await client.query<{ id: string }>(
-    `INSERT INTO devices (user_id, name, last_seen_at) VALUES ($1, $2, now()) RETURNING id`,
-    [userId, deviceName]
+    `INSERT INTO devices (user_id, name, capabilities, last_seen_at) VALUES ($1, $2, $3, now()) RETURNING id`,
+    [userId, deviceName, capabilities]
   );
   return inserted.rows[0].id;
 }
@@ -127,6 +136,7 @@ async function createUserSession(
     password: string;
     deviceName: string;
     clientId?: string;
+    capabilities: string[];
     isAdmin?: boolean;
   }
 ): Promise<NewSession> {
@@ -139,7 +149,7 @@ async function createUserSession(
   );
 
   const user = userResult.rows[0];
-  const deviceId = await createDevice(client, user.id, input.deviceName, input.clientId);
+  const deviceId = await createDevice(client, user.id, input.deviceName, input.capabilities, input.clientId);
   const tokenPair = issueTokenPair(config, user.id, deviceId);
   await persistRefreshToken(client, user.id, deviceId, tokenPair.refreshToken, tokenPair.refreshExpiresAt);
 
@@ -337,7 +347,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
       return;
     }
 
-    const { username, password, deviceName, clientId, mfaCode } = parsed.data;
+    const { username, password, deviceName, clientId, capabilities, mfaCode } = parsed.data;
     const userResult = await pool.query<{
       id: string;
       password_hash: string;
@@ -382,7 +392,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
     const client = await pool.connect();
     try {
       await client.query('BEGIN');
-      const deviceId = await createDevice(client, user.id, deviceName, clientId);
+      const deviceId = await createDevice(client, user.id, deviceName, capabilities, clientId);
       const tokenPair = issueTokenPair(config, user.id, deviceId);
       await persistRefreshToken(client, user.id, deviceId, tokenPair.refreshToken, tokenPair.refreshExpiresAt);
       await client.query(
@@ -416,7 +426,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
       return;
     }
 
-    const { refreshToken } = parsed.data;
+    const { refreshToken, capabilities } = parsed.data;
     let tokenClaims;
     try {
       tokenClaims = verifyRefreshToken(config, refreshToken);
@@ -477,8 +487,8 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
         nextPair.refreshExpiresAt
       );
       await client.query(
-        `UPDATE devices SET last_seen_at = now() WHERE id = $1`,
-        [row.device_id]
+        `UPDATE devices SET last_seen_at = now(), capabilities = COALESCE($2, capabilities) WHERE id = $1`,
+        [row.device_id, capabilities ?? null]
       );
 
       await client.query('COMMIT');
@@ -528,6 +538,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
       name: string;
       created_at: Date;
       last_seen_at: Date;
+      capabilities: string[];
       active: boolean;
     }>(
       `SELECT
@@ -535,6 +546,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
          d.name,
          d.created_at,
          d.last_seen_at,
+         d.capabilities,
          EXISTS(
            SELECT 1
            FROM refresh_tokens rt
@@ -555,6 +567,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
         name: row.name,
         createdAt: row.created_at.toISOString(),
         lastSeenAt: row.last_seen_at.toISOString(),
+        capabilities: row.capabilities,
         active: Boolean(row.active),
         isCurrent: row.id === currentDeviceId,
       })),
@@ -580,6 +593,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
       name: string;
       created_at: Date;
       last_seen_at: Date;
+      capabilities: string[];
       active: boolean;
     }>(
       `UPDATE devices d
@@ -592,6 +606,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
          d.name,
          d.created_at,
          d.last_seen_at,
+         d.capabilities,
          EXISTS(
            SELECT 1
            FROM refresh_tokens rt
@@ -615,6 +630,7 @@ export function registerAuthRoutes({ pool, config }: AuthRouteDeps): Router {
         name: row.name,
         createdAt: row.created_at.toISOString(),
         lastSeenAt: row.last_seen_at.toISOString(),
+        capabilities: row.capabilities,
         active: Boolean(row.active),
         isCurrent: true,
       },
@@ -1,21 +1,278 @@
+import crypto from 'node:crypto';
+import fs from 'node:fs/promises';
+import os from 'node:os';
+import path from 'node:path';
+import { Readable, type Transform } from 'node:stream';
+import { pipeline } from 'node:stream/promises';
 import { describe, it, expect } from 'vitest';
-import { MyLibraryBinding } from '../src/electron/bindings';
+import { VaultCryptoBinding } from '../src/electron/bindings';
+import { deriveEntryKey, encryptEntry, decryptEntry, encodeEntryPayload, decodeEntryPayload } from '../src/electron/keyDerivation';
+import {
+  CHUNKED_HEADER_SIZE, CHUNK_TAG_SIZE, sealBlob, openBlob, createSealStream, createOpenStream, openBlobChunk, chunkedBlobInfo,
+} from '../src/electron/chunkedBlob';
+
+const cardSecret = crypto.randomBytes(16);
+const machineSecret = crypto.randomBytes(32);
+
+function withKeys(): VaultCryptoBinding {
+  const vault = new VaultCryptoBinding();
+  vault.setKeys(cardSecret, machineSecret);
+  return vault;
+}
 
 describe('Native C++ Addon', () => {
   it('should load the addon successfully', () => {
-    const myObject = new MyLibraryBinding('Test');
-    expect(myObject).toBeDefined();
+    const vault = new VaultCryptoBinding();
+    expect(vault).toBeDefined();
+    expect(vault.hasKeys()).toBe(false);
+    expect(['aes-ni', 'portable']).toContain(vault.backend());
+  });
+
+  it('should round-trip a batch of entries', async () => {
+    const vault = withKeys();
+    const entries = Array.from({ length: 50 }, (_, i) => ({
+      entryId: crypto.randomUUID(),
+      plaintext: JSON.stringify({ username: `user${i}`, password: 'x'.repeat(i) }),
+    }));
+    const sealed = await vault.sealEntries(entries);
+    expect(sealed).toHaveLength(entries.length);
+    expect(sealed[0].iv).toHaveLength(12);
+    expect(sealed[0].authTag).toHaveLength(16);
+
+    const opened = await vault.openEntries(sealed.map((blob, i) => ({ entryId: entries[i].entryId, ...blob })));
+    expect(opened.map(b => b?.toString('utf8'))).toEqual(entries.map(e => e.plaintext));
+  });
+
+  it('should stay byte-compatible with keyDerivation.ts', async () => {
+    const vault = withKeys();
+    const entryId = crypto.randomUUID();
+    const payload = { username: 'alice', password: 'hunter2', notes: 'ünïcödé' };
+
+    const [native] = await vault.sealEntries([{ entryId, plaintext: JSON.stringify(payload) }]);
+    const key = deriveEntryKey(cardSecret, machineSecret, entryId);
+    expect(decryptEntry(key, native.ciphertext, native.iv, native.authTag)).toEqual(payload);
+
+    // v1 unless v2 is asked for
+    const js = encryptEntry(key, payload);
+    const [opened] = await vault.openEntries([{ entryId, ...js }]);
+    expect(opened!.toString('utf8')).toBe(JSON.stringify(payload));
+    const [openedV2] = await vault.openEntries([{ entryId, ...encryptEntry(key, payload, 2) }]);
+    expect(decodeEntryPayload(openedV2!)).toEqual(payload);
+  });
+
+  it('should return null for entries that fail authentication', async () => {
+    const vault = withKeys();
+    const entryId = crypto.randomUUID();
+    const [blob] = await vault.sealEntries([{ entryId, plaintext: 'secret' }]);
+    const tampered = Buffer.from(blob.ciphertext);
+    tampered[0] ^= 1;
+
+    const opened = await vault.openEntries([
+      { entryId, ...blob, ciphertext: tampered },
+      { entryId: crypto.randomUUID(), ...blob },
+      { entryId, ...blob, iv: blob.iv.subarray(0, 8) },
+      { entryId, ...blob },
+    ]);
+    expect(opened.slice(0, 3)).toEqual([null, null, null]);
+    expect(opened[3]?.toString('utf8')).toBe('secret');
+  });
+
+  it('should open only the requested payload fields', async () => {
+    const vault = withKeys();
+    const payloads = [
+      { username: 'alice', password: 'p\u00e4ss "quoted"\n', totpSecret: 'JBSWY3DPEHPK3PXP', notes: '\ud83d\udd11 \ud800' },
+      { username: 'bob', password: '' },
+    ];
+    const entries = payloads.map(p => ({ entryId: crypto.randomUUID(), plaintext: JSON.stringify(p) }));
+    entries.push({ entryId: crypto.randomUUID(), plaintext: 'not json' });
+    const sealed = await vault.sealEntries(entries);
+    const rows = sealed.map((blob, i) => ({ entryId: entries[i].entryId, ...blob }));
+
+    const login = await vault.openEntryFields(rows, ['username', 'password']);
+    expect(login).toEqual([
+      { username: 'alice', password: payloads[0].password },
+      { username: 'bob', password: '' },
+      null,
+    ]);
+    const all = await vault.openEntryFields(rows.slice(0, 2), ['username', 'password', 'totpSecret', 'notes']);
+    expect(all[0]).toEqual({ ...payloads[0], notes: Buffer.from(payloads[0].notes).toString('utf8') });
+    expect(all[1]).toEqual(payloads[1]);
+
+    const tampered = Buffer.from(rows[0].ciphertext);
+    tampered[0] ^= 1;
+    expect(await vault.openEntryFields([{ ...rows[0], ciphertext: tampered }], ['notes'])).toEqual([null]);
+    expect(() => vault.openEntryFields(rows, [])).toThrow(TypeError);
+    expect(() => vault.openEntryFields(rows, ['label' as 'notes'])).toThrow(TypeError);
+  });
+
+  it('should encode v2 payloads natively, byte for byte as keyDerivation.ts', async () => {
+    const vault = withKeys();
+    const payload = { username: 'alice', password: 'x'.repeat(200), notes: 'ünïcödé \ud800' };
+    const entryId = crypto.randomUUID();
+
+    const [sealed] = await vault.sealEntryFields([{ entryId, fields: payload }], { payloadVersion: 2 });
+    const [plain] = await vault.openEntries([{ entryId, ...sealed }]);
+    expect(plain).toEqual(encodeEntryPayload(payload));
+    expect(plain!.length).toBeLessThan(Buffer.byteLength(JSON.stringify(payload)));
+    expect(plain![0]).toBe(0x02);
+
+    const key = deriveEntryKey(cardSecret, machineSecret, entryId);
+    expect(decryptEntry(key, sealed.ciphertext, sealed.iv, sealed.authTag))
+      .toEqual({ ...payload, notes: 'ünïcödé \ufffd' });
+    expect(await vault.openEntryFields([{ entryId, ...sealed }], ['password', 'totpSecret']))
+      .toEqual([{ password: payload.password }]);
+
+    // v1 rows keep opening
+    const [v1] = await vault.sealEntries([{ entryId, plaintext: JSON.stringify(payload) }]);
+    expect(await vault.openEntryFields([{ entryId, ...v1 }], ['username'])).toEqual([{ username: 'alice' }]);
+    expect(() => vault.sealEntryFields([{ entryId, fields: { username: 1 as unknown as string } }])).toThrow(TypeError);
+    expect(() => vault.sealEntryFields([{ entryId, fields: payload }], { payloadVersion: 3 as 2 })).toThrow(TypeError);
+  });
+
+  it('should encode v1 payloads natively, byte for byte as JSON.stringify()', async () => {
+    const vault = withKeys();
+    const payload = { username: 'al"ice\\', password: 'tab\there\u0001\n', totpSecret: 'JBSWY3DP', notes: 'ünïcödé \u2028 😀' };
+    const entryId = crypto.randomUUID();
+
+    const [sealed] = await vault.sealEntryFields([{ entryId, fields: payload }]);
+    const [plain] = await vault.openEntries([{ entryId, ...sealed }]);
+    expect(plain!.toString('utf8')).toBe(JSON.stringify(payload));
+    const key = deriveEntryKey(cardSecret, machineSecret, entryId);
+    expect(decryptEntry(key, sealed.ciphertext, sealed.iv, sealed.authTag)).toEqual(payload);
+  });
+
+  it('should re-encrypt entries onto another instance\'s keys', async () => {
+    const source = withKeys();
+    const target = new VaultCryptoBinding();
+    target.setKeys(crypto.randomBytes(16), crypto.randomBytes(32));
+
+    const entries = Array.from({ length: 100 }, (_, i) => ({ entryId: crypto.randomUUID(), plaintext: `entry ${i}` }));
+    const sealed = await source.sealEntries(entries);
+    const rows = sealed.map((blob, i) => ({ entryId: entries[i].entryId, ...blob }));
+    rows[7] = { ...rows[7], entryId: crypto.randomUUID() };
+
+    const rekeyed = await source.rekeyEntries(rows, target);
+    expect(rekeyed[7]).toBeNull();
+
+    const opened = await target.openEntries(rekeyed.map((blob, i) => ({ entryId: rows[i].entryId, ...(blob ?? sealed[i]) })));
+    expect(opened.map(b => b?.toString('utf8') ?? null))
+      .toEqual(entries.map((e, i) => (i === 7 ? null : e.plaintext)));
+    expect((await source.openEntries([{ entryId: rows[0].entryId, ...rekeyed[0]! }]))[0]).toBeNull();
+  });
+
+  it('should seal and open chunked blobs whole, streamed and by chunk', async () => {
+    const vault = withKeys();
+    const blobId = crypto.randomUUID();
+    const data = crypto.randomBytes(10 * 1024 + 123);
+
+    const blob = await sealBlob(vault, blobId, data, { chunkSize: 1024 });
+    expect(blob).toHaveLength(CHUNKED_HEADER_SIZE + data.length + 11 * CHUNK_TAG_SIZE);
+    await expect(openBlob(vault, blobId, blob)).resolves.toEqual(data);
+    await expect(openBlob(vault, blobId, await sealBlob(vault, blobId, Buffer.alloc(0)))).resolves.toHaveLength(0);
+
+    // Streamed in uneven pieces, in batches of two chunks
+    const collect = async (input: Buffer, stream: Transform) => {
+      const pieces = Array.from({ length: Math.ceil(input.length / 700) }, (_, i) => input.subarray(i * 700, (i + 1) * 700));
+      const out: Buffer[] = [];
+      await pipeline(Readable.from(pieces), stream, async function* (source) {
+        for await (const piece of source) out.push(piece);
+      });
+      return Buffer.concat(out);
+    };
+    const streamed = await collect(data, createSealStream(vault, blobId, { chunkSize: 1024, batchChunks: 2 }));
+    expect(streamed).toHaveLength(blob.length);
+    await expect(openBlob(vault, blobId, streamed)).resolves.toEqual(data);
+    await expect(collect(blob, createOpenStream(vault, blobId, { batchChunks: 2 }))).resolves.toEqual(data);
+
+    const dir = await fs.mkdtemp(path.join(os.tmpdir(), 'blob-'));
+    const file = await fs.open(path.join(dir, 'blob'), 'w+');
+    try {
+      await file.writeFile(blob);
+      await expect(chunkedBlobInfo(file)).resolves.toMatchObject({ chunkSize: 1024, chunkCount: 11 });
+      await expect(openBlobChunk(vault, blobId, file, 3)).resolves.toEqual(data.subarray(3072, 4096));
+      await expect(openBlobChunk(vault, blobId, file, 10)).resolves.toEqual(data.subarray(10240));
+    } finally {
+      await file.close();
+      await fs.rm(dir, { recursive: true });
+    }
+
+    const tampered = Buffer.from(blob);
+    tampered[CHUNKED_HEADER_SIZE + 5000] ^= 1;
+    await expect(openBlob(vault, blobId, tampered)).rejects.toMatchObject({ code: 'DECRYPT_FAILED' });
+    await expect(collect(tampered, createOpenStream(vault, blobId))).rejects.toMatchObject({ code: 'DECRYPT_FAILED' });
+    // Cut at a chunk boundary: the new last chunk was not sealed as final
+    await expect(openBlob(vault, blobId, blob.subarray(0, CHUNKED_HEADER_SIZE + 10 * (1024 + CHUNK_TAG_SIZE))))
+      .rejects.toMatchObject({ code: 'DECRYPT_FAILED' });
+    await expect(openBlob(vault, crypto.randomUUID(), blob)).rejects.toMatchObject({ code: 'DECRYPT_FAILED' });
+    expect(() => VaultCryptoBinding.createChunkedHeader({ chunkSize: 512 })).toThrow(TypeError);
   });
 
-  it('should return the correct string from greet', () => {
-    const myObject = new MyLibraryBinding('Test');
-    const result = myObject.greet('World');
-    expect(result).toBe('Hello World, my name is Test');
+  it('should derive the same scrypt keys as node:crypto', async () => {
+    const salt = crypto.randomBytes(16);
+    for (const [N, r, p, keyLen] of [[1024, 8, 1, 32], [1024, 8, 4, 64], [16, 1, 3, 33]]) {
+      const expected = crypto.scryptSync('123456', salt, keyLen, { N, r, p });
+      await expect(VaultCryptoBinding.scrypt('123456', salt, { N, r, p, keyLen })).resolves.toEqual(expected);
+    }
+    const password = Buffer.from('correct horse battery staple');
+    await expect(VaultCryptoBinding.scrypt(password, salt, { N: 2048, r: 2, p: 2, keyLen: 32 }))
+      .resolves.toEqual(crypto.scryptSync(password, salt, 32, { N: 2048, r: 2, p: 2 }));
   });
 
-  it('should return the correct sum from add', () => {
-    const myObject = new MyLibraryBinding('Test');
-    const result = myObject.add(5, 7);
-    expect(result).toBe(12);
+  it('should reject invalid scrypt parameters', async () => {
+    const salt = crypto.randomBytes(16);
+    await expect(VaultCryptoBinding.scrypt('pin', salt, { N: 1000, r: 8, p: 1, keyLen: 32 }))
+      .rejects.toMatchObject({ code: 'INVALID_PARAMS' });
+    await expect(VaultCryptoBinding.scrypt('pin', salt, { N: 1 << 15, r: 8, p: 1, keyLen: 32, maxmem: 1 << 20 }))
+      .rejects.toMatchObject({ code: 'MEMORY_LIMIT' });
+    expect(() => VaultCryptoBinding.scrypt('pin', salt, { N: 1024, r: 8, p: 1, keyLen: 0 })).toThrow(TypeError);
+  });
+
+  it('should calibrate scrypt no weaker than the floor', async () => {
+    const picked = await VaultCryptoBinding.calibrateScrypt({ targetMs: 40, minN: 1024, r: 8, minP: 1, maxN: 1 << 16 });
+    expect(picked.r).toBe(8);
+    expect(picked.N).toBeGreaterThanOrEqual(1024);
+    expect(picked.N & (picked.N - 1)).toBe(0);
+    expect(picked.p).toBeGreaterThanOrEqual(1);
+    expect(picked.measuredMs).toBeGreaterThan(0);
+    await expect(VaultCryptoBinding.calibrateScrypt({ targetMs: 40, minN: 1 << 15, maxmem: 1 << 20 }))
+      .rejects.toMatchObject({ code: 'MEMORY_LIMIT' });
+  });
+
+  it('should keep keys in the secure arena', async () => {
+    const vault = withKeys();
+    const before = VaultCryptoBinding.secureMemory();
+    expect(before.capacity).toBeGreaterThan(0);
+    expect(before.capacity % before.pageSize).toBe(0);
+    expect(before.inUse).toBeGreaterThan(0); // the entry root set by withKeys()
+
+    const entries = [{ entryId: crypto.randomUUID(), plaintext: 'secret' }];
+    await vault.sealEntries(entries);
+    const after = VaultCryptoBinding.secureMemory();
+    expect(after.peakInUse).toBeGreaterThanOrEqual(after.inUse);
+    expect(after.inUse).toBeLessThanOrEqual(before.inUse); // per-batch keys and schedules released
+  });
+
+  it('should reject batches when no keys are set', async () => {
+    const vault = withKeys();
+    vault.clearKeys();
+    expect(vault.hasKeys()).toBe(false);
+    await expect(vault.sealEntries([{ entryId: 'a', plaintext: 'b' }])).rejects.toMatchObject({ code: 'NO_KEYS' });
+  });
+
+  it('should drop session keys once their ttl elapses', async () => {
+    const vault = withKeys();
+    expect(vault.keysExpireInMs()).toBeNull();
+
+    vault.setKeys(cardSecret, machineSecret, { ttlMs: 100 });
+    const left = vault.keysExpireInMs();
+    expect(left).toBeGreaterThan(0);
+    expect(left).toBeLessThanOrEqual(100);
+    const [blob] = await vault.sealEntries([{ entryId: 'a', plaintext: 'b' }]);
+
+    await new Promise(resolve => setTimeout(resolve, 150));
+    expect(vault.hasKeys()).toBe(false);
+    expect(vault.keysExpireInMs()).toBeNull();
+    await expect(vault.openEntries([{ entryId: 'a', ...blob }])).rejects.toMatchObject({ code: 'NO_KEYS' });
+    expect(() => vault.setKeys(cardSecret, machineSecret, { ttlMs: -1 })).toThrow(TypeError);
   });
 });
@@ -304,6 +304,16 @@ type AppUpdatePreferencesDto = {
   autoDownloadEnabled: boolean;
 };
 
+/** Unlock window after a card tap; see src/electron/sessionKeyring.ts. */
+type SessionKeyringPolicyDto = {
+  /** How long decrypts skip the card after a tap; 0 turns the window off. */
+  ttlMs: number;
+  /** Close the window as soon as the card leaves the reader. */
+  endOnCardRemoval: boolean;
+  /** Longest ttlMs accepted; filled in by the main process. */
+  maxTtlMs?: number;
+};
+
 type PinSetResultDto = {
   ok: true;
 };
@@ -365,8 +375,6 @@ type RendererEvents = {
 
 // 1) canonical single source: define your IPC handlers here
 type IPCHandlers = {
-  greet: (name: string) => Promise<string>;
-  add: (a: number, b: number) => Promise<number>;
   connect: (port: string) => Promise<string>;
   disconnect: () => Promise<boolean>;
   'nfc:getConnectionState': () => Promise<NfcConnectionStateDto>;
@@ -442,6 +450,10 @@ type IPCHandlers = {
   'vault:export': () => Promise<VaultExportResultDto>;
   /** Imports entries from a JSON backup file, merging with existing vault. No card needed. */
   'vault:import': () => Promise<VaultImportResultDto>;
+  /** Returns the persisted unlock-window policy. */
+  'vault:getSessionPolicy': () => Promise<SessionKeyringPolicyDto>;
+  /** Persists the unlock-window policy and closes any open window. */
+  'vault:setSessionPolicy': (policy: SessionKeyringPolicyDto) => Promise<SessionKeyringPolicyDto>;
 
   // ── Browser extension helpers ────────────────────────────────────────
   /** Opens the bundled extension folder in the OS file manager. */